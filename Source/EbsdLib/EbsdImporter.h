@@ -39,9 +39,17 @@
 
 #include "hdf5.h"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <QtCore/QtDebug>
 
+#include "H5Support/QH5Lite.h"
+
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdReader.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
 
 /**
@@ -75,6 +83,25 @@ class EbsdLib_EXPORT EbsdImporter
      */
     EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, Cancel)
 
+    /**
+     * @brief Sets the deflate level (1-9) used for the data arrays of each slice. A value
+     * of 0 writes contiguous, uncompressed data sets.
+     */
+    EBSD_INSTANCE_PROPERTY(int, CompressionLevel)
+
+    /**
+     * @brief Sets the most threads parseFile() may use for the data block of one file. Set it
+     * to 1 when several files are parsed at the same time.
+     */
+    void setMaxParseThreads(size_t value)
+    {
+      m_MaxParseThreads = value;
+    }
+    size_t getMaxParseThreads() const
+    {
+      return m_MaxParseThreads;
+    }
+
     /**
      * @brief Either prints a message or sends the message to the User Interface
      * @param message The message to print
@@ -105,6 +132,24 @@ class EbsdLib_EXPORT EbsdImporter
      */
     virtual int importFile(hid_t fileId, int64_t index, const QString& ebsd) = 0;
 
+    /**
+     * @brief Parses the EBSD file into memory. Implementations must not touch the HDF5 file
+     * or any state of the importer so that several files can be parsed concurrently.
+     * @param ebsdFile The raw data file from the manufacturer (.ang, .ctf)
+     * @param reader The reader holding the parsed data (out)
+     * @param message A description of the error if the file could not be parsed (out)
+     * @return Negative error code if the file could not be parsed
+     */
+    virtual int parseFile(const QString& ebsdFile, std::shared_ptr<EbsdReader>& reader, QString& message) const = 0;
+
+    /**
+     * @brief Writes a file that was parsed with parseFile() into the HDF5 file.
+     * @param fileId HDF5 fileId of an open HDF5 file that the data will be stored into
+     * @param index The integer index value of this EBSD data file
+     * @param reader The reader returned by parseFile()
+     */
+    virtual int writeFile(hid_t fileId, int64_t index, EbsdReader* reader) = 0;
+
     /**
      * @brief Returns the dimensions for the EBSD Data set
      * @param x Number of X Voxels (out)
@@ -135,16 +180,82 @@ class EbsdLib_EXPORT EbsdImporter
   protected:
     EbsdImporter() :
       m_ErrorCondition(0),
-      m_Cancel(false)
+      m_Cancel(false),
+      m_CompressionLevel(0),
+      m_MaxParseThreads(std::thread::hardware_concurrency())
     {
       m_PipelineMessage = "";
     }
 
+    /**
+     * @brief Writes a data array, either as a contiguous data set or, if a compression level
+     * is set, as a chunked data set with the shuffle and deflate filters applied.
+     * @param gid Valid HDF5 Group ID
+     * @param name The name of the data set
+     * @param rank The rank of the data set
+     * @param dims The dimensions of the data set
+     * @param data The data to write
+     * @return error condition
+     */
+    template <typename T>
+    herr_t writeDataArray(hid_t gid, const QString& name, int32_t rank, hsize_t* dims, T* data)
+    {
+      hsize_t numElements = 1;
+      for(int32_t i = 0; i < rank; i++)
+      {
+        numElements *= dims[i];
+      }
+      if(m_CompressionLevel <= 0 || numElements == 0)
+      {
+        return QH5Lite::writePointerDataset(gid, name, rank, dims, data);
+      }
+
+      // Chunks of about 64K values along the slowest dimension keep the per-chunk
+      // overhead small while still letting readers decompress only what they touch
+      const hsize_t chunkElements = 65536;
+      std::vector<hsize_t> chunkDims(dims, dims + rank);
+      hsize_t innerElements = numElements / dims[0];
+      chunkDims[0] = std::min(dims[0], std::max(static_cast<hsize_t>(1), chunkElements / innerElements));
+
+      T value = static_cast<T>(0);
+      hid_t dataType = QH5Lite::HDFTypeForPrimitive(value);
+      hid_t dataspaceId = H5Screate_simple(rank, dims, nullptr);
+      hid_t propId = H5Pcreate(H5P_DATASET_CREATE);
+      herr_t err = H5Pset_chunk(propId, rank, chunkDims.data());
+      if(err >= 0)
+      {
+        err = H5Pset_shuffle(propId);
+      }
+      if(err >= 0)
+      {
+        err = H5Pset_deflate(propId, static_cast<unsigned>(std::min(m_CompressionLevel, 9)));
+      }
+      if(err >= 0)
+      {
+        hid_t datasetId = H5Dcreate2(gid, name.toLatin1().data(), dataType, dataspaceId, H5P_DEFAULT, propId, H5P_DEFAULT);
+        if(datasetId < 0)
+        {
+          err = -1;
+        }
+        else
+        {
+          err = H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+          H5Dclose(datasetId);
+        }
+      }
+      H5Pclose(propId);
+      H5Sclose(dataspaceId);
+      return err;
+    }
+
   public:
     EbsdImporter(const EbsdImporter&) = delete;   // Copy Constructor Not Implemented
     EbsdImporter(EbsdImporter&&) = delete;        // Move Constructor Not Implemented
     EbsdImporter& operator=(const EbsdImporter&) = delete; // Copy Assignment Not Implemented
     EbsdImporter& operator=(EbsdImporter&&) = delete;      // Move Assignment Not Implemented
+
+  private:
+    size_t m_MaxParseThreads;
 };
 
 
@@ -35,6 +35,8 @@
 
 #include "EbsdReader.h"
 
+#include <thread>
+
 
 // -----------------------------------------------------------------------------
 //
@@ -50,7 +52,8 @@ EbsdReader::EbsdReader() :
   m_OriginalHeader(""),
   m_ManageMemory(true),
   m_HeaderIsComplete(false),
-  m_NumberOfElements(0)
+  m_NumberOfElements(0),
+  m_MaxParseThreads(std::thread::hardware_concurrency())
 {
   m_EulerTransformationAxis.resize(3);
   m_SampleTransformationAxis.resize(3);
@@ -101,6 +101,8 @@ class EbsdLib_EXPORT EbsdReader
     EBSD_INSTANCE_PROPERTY(bool, HeaderIsComplete)
     /** @brief The number of elements in a column of data. This should be rows * columns */
     EBSD_INSTANCE_PROPERTY(size_t, NumberOfElements)
+    /** @brief The most threads the data block of a single file is parsed with. Set to 1 when several files are read at once */
+    EBSD_INSTANCE_PROPERTY(size_t, MaxParseThreads)
 
     /*
      * Different manufacturers call this value different thingsl. TSL = NumRows | NumCols,
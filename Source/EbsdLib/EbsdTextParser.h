@@ -0,0 +1,433 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+namespace Ebsd
+{
+/**
+ * @brief The TextParser namespace holds the allocation free tokenizing and numeric conversion
+ * routines that the ASCII EBSD readers (.ang, .ctf) use to parse their data blocks directly out
+ * of a memory mapped file. The data block is cut into blocks of whole lines so that each block
+ * can be parsed by a separate thread into the reader's column arrays.
+ */
+namespace TextParser
+{
+/**
+ * @brief A contiguous run of whole lines from a data block.
+ */
+struct LineBlock
+{
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  size_t firstLine = 0;
+  size_t numLines = 0;
+};
+
+inline bool isBlank(char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+inline bool isDigit(char c)
+{
+  return (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Advances past the current line and returns a pointer to the first character of the next line
+ * @param begin
+ * @param end
+ * @return
+ */
+inline const char* nextLine(const char* begin, const char* end)
+{
+  const char* eol = static_cast<const char*>(::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+  return (nullptr == eol) ? end : eol + 1;
+}
+
+/**
+ * @brief Returns the end of the current line, not including the line terminator
+ * @param begin
+ * @param end
+ * @return
+ */
+inline const char* endOfLine(const char* begin, const char* end)
+{
+  const char* eol = static_cast<const char*>(::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+  if(nullptr == eol)
+  {
+    eol = end;
+  }
+  if(eol > begin && eol[-1] == '\r')
+  {
+    --eol;
+  }
+  return eol;
+}
+
+/**
+ * @brief Trims leading and trailing white space from the range [first, last)
+ */
+inline void trim(const char*& first, const char*& last)
+{
+  while(first < last && isBlank(*first))
+  {
+    ++first;
+  }
+  while(last > first && isBlank(last[-1]))
+  {
+    --last;
+  }
+}
+
+/**
+ * @brief Finds the next white space delimited token starting at 'pos'. On return 'pos' points just
+ * past the token.
+ * @return false if there are no more tokens on the line
+ */
+inline bool nextToken(const char*& pos, const char* last, const char*& tokenBegin, const char*& tokenEnd)
+{
+  while(pos < last && isBlank(*pos))
+  {
+    ++pos;
+  }
+  if(pos == last)
+  {
+    return false;
+  }
+  tokenBegin = pos;
+  while(pos < last && !isBlank(*pos))
+  {
+    ++pos;
+  }
+  tokenEnd = pos;
+  return true;
+}
+
+/**
+ * @brief Returns the end of the field that starts at 'pos' and is terminated by 'delimiter' or by 'last'
+ */
+inline const char* fieldEnd(const char* pos, const char* last, char delimiter)
+{
+  const char* delim = static_cast<const char*>(::memchr(pos, delimiter, static_cast<size_t>(last - pos)));
+  return (nullptr == delim) ? last : delim;
+}
+
+/**
+ * @brief Converts the range [first, last) with QByteArray::toFloat(). This is only used for the
+ * tokens that the fast path below does not handle (nan, inf, very long mantissas)
+ */
+inline bool parseFloatFallback(const char* first, const char* last, float& value, bool acceptComma)
+{
+  QByteArray token(first, static_cast<int>(last - first));
+  if(acceptComma)
+  {
+    token.replace(',', '.');
+  }
+  bool ok = false;
+  value = token.toFloat(&ok);
+  return ok;
+}
+
+/**
+ * @brief Converts the range [first, last) into a float without allocating any memory. Up to 19
+ * significant digits are accumulated into an integer mantissa which is then scaled by an exactly
+ * representable power of 10 so the result is correctly rounded to double before being narrowed to float.
+ * @param first
+ * @param last
+ * @param value Output value. Set to 0.0 if the conversion fails.
+ * @param acceptComma Accept ',' as the decimal separator (European locales)
+ * @return true if the entire range was a valid number
+ */
+inline bool parseFloat(const char* first, const char* last, float& value, bool acceptComma = false)
+{
+  static const double k_Pow10[] = {1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,  1.0e10, 1.0e11,
+                                   1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+  const char* p = first;
+  bool negative = false;
+  if(p < last && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  uint64_t mantissa = 0;
+  int32_t exponent = 0;
+  int32_t sigDigits = 0;
+  bool sawDigit = false;
+  bool truncated = false;
+  while(p < last && isDigit(*p))
+  {
+    sawDigit = true;
+    if(sigDigits < 19)
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      sigDigits += (mantissa != 0) ? 1 : 0;
+    }
+    else
+    {
+      ++exponent;
+      truncated = true;
+    }
+    ++p;
+  }
+  if(p < last && (*p == '.' || (acceptComma && *p == ',')))
+  {
+    ++p;
+    while(p < last && isDigit(*p))
+    {
+      sawDigit = true;
+      if(sigDigits < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        sigDigits += (mantissa != 0) ? 1 : 0;
+        --exponent;
+      }
+      else
+      {
+        truncated = true;
+      }
+      ++p;
+    }
+  }
+  if(!sawDigit)
+  {
+    return parseFloatFallback(first, last, value, acceptComma);
+  }
+  if(p < last && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negExp = false;
+    if(p < last && (*p == '-' || *p == '+'))
+    {
+      negExp = (*p == '-');
+      ++p;
+    }
+    if(p == last || !isDigit(*p))
+    {
+      value = 0.0f;
+      return false;
+    }
+    int32_t e = 0;
+    while(p < last && isDigit(*p))
+    {
+      if(e < 10000)
+      {
+        e = e * 10 + (*p - '0');
+      }
+      ++p;
+    }
+    exponent += negExp ? -e : e;
+  }
+  if(p != last)
+  {
+    value = 0.0f;
+    return false;
+  }
+
+  if(mantissa == 0)
+  {
+    value = negative ? -0.0f : 0.0f;
+    return true;
+  }
+  if(truncated || mantissa > (1ULL << 53) || exponent < -22 || exponent > 22)
+  {
+    return parseFloatFallback(first, last, value, acceptComma);
+  }
+
+  double d = static_cast<double>(mantissa);
+  d = (exponent < 0) ? d / k_Pow10[-exponent] : d * k_Pow10[exponent];
+  value = static_cast<float>(negative ? -d : d);
+  return true;
+}
+
+/**
+ * @brief Converts the range [first, last) into a 32 bit signed integer without allocating any memory.
+ * @param value Output value. Set to 0 if the conversion fails.
+ * @return true if the entire range was a valid integer that fits into 32 bits
+ */
+inline bool parseInt32(const char* first, const char* last, int32_t& value)
+{
+  const char* p = first;
+  bool negative = false;
+  if(p < last && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  if(p == last || (last - p) > 10)
+  {
+    value = 0;
+    return false;
+  }
+  int64_t v = 0;
+  for(; p < last; ++p)
+  {
+    if(!isDigit(*p))
+    {
+      value = 0;
+      return false;
+    }
+    v = v * 10 + (*p - '0');
+  }
+  v = negative ? -v : v;
+  if(v < INT32_MIN || v > INT32_MAX)
+  {
+    value = 0;
+    return false;
+  }
+  value = static_cast<int32_t>(v);
+  return true;
+}
+
+/**
+ * @brief Runs func(i) for every i in [0, count) on at most 'maxThreads' threads. The loop runs
+ * inline on the calling thread when there is only one item or only one thread is allowed, so a
+ * caller that already parses several files at once can pass 1 to keep each file serial.
+ * @param count
+ * @param func
+ * @param maxThreads Upper limit on the number of threads. hardware_concurrency() returns ZERO if
+ * it is not defined on this platform, which also runs the loop inline.
+ */
+template <typename Func> void parallelFor(size_t count, Func func, size_t maxThreads = std::thread::hardware_concurrency())
+{
+  size_t numThreads = maxThreads;
+  if(numThreads > count)
+  {
+    numThreads = count;
+  }
+  if(numThreads < 2)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for(size_t t = 0; t < numThreads; t++)
+  {
+    threads.emplace_back([&]() {
+      for(size_t i = next++; i < count; i = next++)
+      {
+        func(i);
+      }
+    });
+  }
+  for(auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Cuts [begin, end) into blocks of whole lines of at least 'minBlockSize' bytes and
+ * assigns the index of the first line of each block. Trailing white space at the end of the range
+ * is not counted as a line. With 'maxThreads' of 1 the range stays a single block.
+ * @param begin
+ * @param end
+ * @param maxThreads Upper limit on the number of threads the blocks will be parsed with
+ * @param minBlockSize
+ * @return
+ */
+inline std::vector<LineBlock> splitIntoLineBlocks(const char* begin, const char* end, size_t maxThreads = std::thread::hardware_concurrency(), size_t minBlockSize = 1048576)
+{
+  while(end > begin && isBlank(end[-1]))
+  {
+    --end;
+  }
+
+  std::vector<LineBlock> blocks;
+  size_t blockSize = static_cast<size_t>(end - begin);
+  if(maxThreads > 1)
+  {
+    blockSize = blockSize / (maxThreads * 4 + 1);
+  }
+  if(blockSize < minBlockSize)
+  {
+    blockSize = minBlockSize;
+  }
+
+  const char* pos = begin;
+  while(pos < end)
+  {
+    LineBlock block;
+    block.begin = pos;
+    pos = (static_cast<size_t>(end - pos) > blockSize) ? nextLine(pos + blockSize, end) : end;
+    block.end = pos;
+    blocks.push_back(block);
+  }
+
+  parallelFor(blocks.size(), [&](size_t b) {
+    LineBlock& block = blocks[b];
+    size_t numLines = 0;
+    for(const char* p = block.begin; p < block.end; p = nextLine(p, block.end))
+    {
+      numLines++;
+    }
+    block.numLines = numLines;
+  }, maxThreads);
+
+  size_t firstLine = 0;
+  for(auto& block : blocks)
+  {
+    block.firstLine = firstLine;
+    firstLine += block.numLines;
+  }
+  return blocks;
+}
+
+/**
+ * @brief Returns the total number of lines held in 'blocks'
+ */
+inline size_t countLines(const std::vector<LineBlock>& blocks)
+{
+  return blocks.empty() ? 0 : blocks.back().firstLine + blocks.back().numLines;
+}
+
+} // namespace TextParser
+} // namespace Ebsd
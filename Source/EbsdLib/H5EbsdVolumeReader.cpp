@@ -36,6 +36,7 @@
 
 #include "H5EbsdVolumeReader.h"
 
+#include "H5Support/H5Lite.h"
 
 
 #if defined (H5Support_NAMESPACE)
@@ -130,3 +131,59 @@ void H5EbsdVolumeReader::readAllArrays(bool b)
 {
   m_ReadAllArrays = b;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EbsdVolumeReader::readSliceIntoVolume(hid_t dataGid, const QString& name, hid_t memType, void* planePtr, int64_t xpoints, int64_t ypoints, int64_t xStart, int64_t yStart, int64_t xSlice,
+                                            int64_t ySlice)
+{
+  if(xStart < 0 || yStart < 0 || xStart + xSlice > xpoints || yStart + ySlice > ypoints)
+  {
+    return -1;
+  }
+
+  hid_t datasetId = H5Dopen(dataGid, name.toLatin1().data(), H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    return -1;
+  }
+  hid_t fileSpaceId = H5Dget_space(datasetId);
+  hssize_t numFileElements = H5Sget_simple_extent_npoints(fileSpaceId);
+  hsize_t numSliceElements = static_cast<hsize_t>(xSlice * ySlice);
+
+  herr_t err = -1;
+  if(numFileElements >= 0 && static_cast<hsize_t>(numFileElements) >= numSliceElements)
+  {
+    // The slice data sets are stored as flat arrays. Only the first xSlice * ySlice values are used.
+    if(H5Sget_simple_extent_ndims(fileSpaceId) == 1)
+    {
+      hsize_t fileStart[1] = {0};
+      hsize_t fileCount[1] = {numSliceElements};
+      err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, fileStart, nullptr, fileCount, nullptr);
+    }
+    else if(static_cast<hsize_t>(numFileElements) == numSliceElements)
+    {
+      err = H5Sselect_all(fileSpaceId);
+    }
+
+    // The destination is the whole Z plane and the slice is a centered window in that plane
+    hsize_t memDims[2] = {static_cast<hsize_t>(ypoints), static_cast<hsize_t>(xpoints)};
+    hsize_t memStart[2] = {static_cast<hsize_t>(yStart), static_cast<hsize_t>(xStart)};
+    hsize_t memCount[2] = {static_cast<hsize_t>(ySlice), static_cast<hsize_t>(xSlice)};
+    hid_t memSpaceId = H5Screate_simple(2, memDims, nullptr);
+    if(err >= 0)
+    {
+      err = H5Sselect_hyperslab(memSpaceId, H5S_SELECT_SET, memStart, nullptr, memCount, nullptr);
+    }
+    if(err >= 0)
+    {
+      err = H5Dread(datasetId, memType, memSpaceId, fileSpaceId, H5P_DEFAULT, planePtr);
+    }
+    H5Sclose(memSpaceId);
+  }
+
+  H5Sclose(fileSpaceId);
+  H5Dclose(datasetId);
+  return err;
+}
@@ -145,6 +145,24 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
   protected:
     H5EbsdVolumeReader();
 
+    /**
+     * @brief Reads a single slice data set directly into its final location inside of a volume array
+     * using an HDF5 hyperslab selection on the destination buffer, avoiding any temporary copy of the slice.
+     * The slice is placed at (xStart, yStart) inside of the xpoints * ypoints plane that starts at 'planePtr'.
+     * @param dataGid The HDF5 group that holds the slice data sets
+     * @param name The name of the data set
+     * @param memType The HDF5 native type of the destination buffer
+     * @param planePtr Pointer to the first element of the destination Z plane
+     * @param xpoints Number of X voxels in the volume
+     * @param ypoints Number of Y voxels in the volume
+     * @param xStart X offset of the slice inside of the plane
+     * @param yStart Y offset of the slice inside of the plane
+     * @param xSlice Number of X points in the slice
+     * @param ySlice Number of Y points in the slice
+     * @return Negative value on error
+     */
+    int readSliceIntoVolume(hid_t dataGid, const QString& name, hid_t memType, void* planePtr, int64_t xpoints, int64_t ypoints, int64_t xStart, int64_t yStart, int64_t xSlice, int64_t ySlice);
+
   private:
     QSet<QString>         m_ArrayNames;
     bool                  m_ReadAllArrays;
@@ -43,10 +43,13 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "CtfPhase.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 
 
@@ -402,6 +405,23 @@ int CtfReader::readData(QFile& in)
 
   }
 
+  // Parse the data block straight out of a memory mapped view of the file if we can, otherwise
+  // fall back to reading the file line by line.
+  qint64 dataOffset = in.pos();
+  uchar* mappedFile = in.map(0, in.size());
+  if(nullptr != mappedFile)
+  {
+    const char* fileBegin = reinterpret_cast<const char*>(mappedFile);
+    // Make sure the current position really is the start of the line following the column headers
+    if(dataOffset > 0 && dataOffset <= in.size() && fileBegin[dataOffset - 1] == '\n')
+    {
+      int err = readMappedData(fileBegin + dataOffset, fileBegin + in.size(), xCells, yCells, totalScanPoints);
+      in.unmap(mappedFile);
+      return err;
+    }
+    in.unmap(mappedFile);
+  }
+
   // Now start reading the data line by line
   int err = 0;
   size_t counter = 0;
@@ -453,6 +473,133 @@ int CtfReader::readData(QFile& in)
   return 0;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::readMappedData(const char* dataBegin, const char* dataEnd, size_t xCells, size_t yCells, size_t totalScanPoints)
+{
+  // Line up the column parsers with the columns of each data line
+  std::vector<DataParser*> columnParsers(static_cast<size_t>(m_NamePointerMap.size()), nullptr);
+  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
+  while(iter.hasNext())
+  {
+    iter.next();
+    size_t columnIndex = static_cast<size_t>(iter.value()->getColumnIndex());
+    if(columnIndex < columnParsers.size())
+    {
+      columnParsers[columnIndex] = iter.value().get();
+    }
+  }
+
+  std::vector<Ebsd::TextParser::LineBlock> blocks = Ebsd::TextParser::splitIntoLineBlocks(dataBegin, dataEnd, getMaxParseThreads());
+  size_t numLines = Ebsd::TextParser::countLines(blocks);
+
+  // When reading a single slice only the lines belonging to that slice are parsed.
+  size_t firstLine = 0;
+  if(m_SingleSliceRead >= 0)
+  {
+    firstLine = static_cast<size_t>(m_SingleSliceRead) * xCells * yCells;
+  }
+  size_t lastLine = firstLine + totalScanPoints;
+  if(lastLine > numLines)
+  {
+    lastLine = (numLines > firstLine) ? numLines : firstLine;
+  }
+
+  // Each block remembers the first line that had the wrong number of columns
+  struct BlockError
+  {
+    size_t line = std::numeric_limits<size_t>::max();
+    size_t numFields = 0;
+  };
+  std::vector<BlockError> errors(blocks.size());
+
+  Ebsd::TextParser::parallelFor(blocks.size(), [&](size_t b) {
+    const Ebsd::TextParser::LineBlock& block = blocks[b];
+    if(block.firstLine + block.numLines <= firstLine || block.firstLine >= lastLine)
+    {
+      return;
+    }
+    size_t i = block.firstLine;
+    for(const char* line = block.begin; line < block.end && i < lastLine; ++i)
+    {
+      const char* lineEnd = Ebsd::TextParser::endOfLine(line, block.end);
+      const char* next = Ebsd::TextParser::nextLine(lineEnd, block.end);
+      if(i < firstLine)
+      {
+        line = next;
+        continue;
+      }
+      const char* first = line;
+      const char* last = lineEnd;
+      Ebsd::TextParser::trim(first, last);
+
+      size_t numFields = 0;
+      const char* pos = first;
+      while(true)
+      {
+        const char* fieldEnd = Ebsd::TextParser::fieldEnd(pos, last, '\t');
+        if(numFields < columnParsers.size() && nullptr != columnParsers[numFields])
+        {
+          columnParsers[numFields]->parse(pos, fieldEnd, i - firstLine);
+        }
+        numFields++;
+        if(fieldEnd == last)
+        {
+          break;
+        }
+        pos = fieldEnd + 1;
+      }
+      if(numFields != columnParsers.size())
+      {
+        errors[b].line = i;
+        errors[b].numFields = numFields;
+        return;
+      }
+      line = next;
+    }
+  }, getMaxParseThreads());
+
+  for(const auto& error : errors)
+  {
+    if(error.line != std::numeric_limits<size_t>::max())
+    {
+      size_t row = ((error.line - firstLine) / xCells) % yCells;
+      return setColumnCountError(static_cast<int>(error.numFields), row);
+    }
+  }
+
+  size_t counter = lastLine - firstLine;
+  if(counter != getNumberOfElements())
+  {
+    QString msg;
+    QTextStream ss(&msg);
+    ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter << "\nTotal Data Points Read=" << counter << "\n";
+    setErrorMessage(msg);
+    setErrorCode(-105);
+    return -105;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int CtfReader::setColumnCountError(int numColumns, size_t row)
+{
+  setErrorCode(-107);
+  QString msg;
+  QTextStream ss(&msg);
+  ss << "The number of tab delimited data columns (" << numColumns << ") does not match the number of tab delimited header columns (";
+  ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes.";
+  ss << "The error occurred at data row " << row << " which is " << row << " past ";
+  ss << "the column header row.";
+  ss << "\nThe CTF Reader will now abort reading any further in the file.";
+
+  setErrorMessage(msg);
+  return -106; // Could not allocate the memory
+}
+
 #if 0
 #define PRINT_HTML_TABLE_ROW(p)\
   std::cout << "<tr>\n    <td>" << p->getKey() << "</td>\n    <td>" << p->getHDFType() << "</td>\n";\
@@ -599,17 +746,7 @@ int CtfReader::parseDataLine(QByteArray& line, size_t row, size_t col, size_t of
   QList<QByteArray> tokens = line.split('\t');
   if(tokens.size() != m_NamePointerMap.size())
   {
-    setErrorCode(-107);
-    QString msg;
-    QTextStream ss(&msg);
-    ss << "The number of tab delimited data columns (" << tokens.size() << ") does not match the number of tab delimited header columns (";
-    ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes.";
-    ss << "The error occurred at data row " << row << " which is " << row << " past ";
-    ss << "the column header row.";
-    ss << "\nThe CTF Reader will now abort reading any further in the file.";
-
-    setErrorMessage(msg);
-    return -106; // Could not allocate the memory
+    return setColumnCountError(tokens.size(), row);
   }
   QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
   while (iter.hasNext())
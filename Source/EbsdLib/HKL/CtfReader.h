@@ -242,6 +242,26 @@ private:
    */
   int parseDataLine(QByteArray& line, size_t row, size_t col, size_t i, size_t xCells, size_t yCells);
 
+  /**
+   * @brief Parses the data block directly out of a memory mapped view of the file. The data block
+   * is split into blocks of whole lines that are parsed in parallel.
+   * @param dataBegin The first character of the first line of data
+   * @param dataEnd The end of the mapped file
+   * @param xCells Number of X Data Points
+   * @param yCells Number of Y Data Points
+   * @param totalScanPoints Number of data points to read
+   * @return Error code
+   */
+  int readMappedData(const char* dataBegin, const char* dataEnd, size_t xCells, size_t yCells, size_t totalScanPoints);
+
+  /**
+   * @brief Sets the error message for a data line whose number of columns does not match the column headers
+   * @param numColumns The number of columns found on the data line
+   * @param row The current row of data
+   * @return Error code
+   */
+  int setColumnCountError(int numColumns, size_t row);
+
 public:
   CtfReader(const CtfReader&) = delete;            // Copy Constructor Not Implemented
   CtfReader(CtfReader&&) = delete;                 // Move Constructor Not Implemented
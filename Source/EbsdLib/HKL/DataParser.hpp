@@ -38,6 +38,7 @@
 #include <QtCore/QString>
 
 #include "EbsdLib/EbsdSetGetMacros.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 class DataParser
 {
@@ -58,6 +59,12 @@ class DataParser
 
 
     virtual void parse(const QByteArray& token, size_t index) {}
+
+    /**
+     * @brief Parses the token held in [first, last) without any intermediate allocations.
+     * @return true if the token was a valid value for this column
+     */
+    virtual bool parse(const char* first, const char* last, size_t index) { return false; }
   protected:
     DataParser()
     : m_ManageMemory(false)
@@ -138,6 +145,12 @@ class Int32Parser : public DataParser
       m_Ptr[index] = token.toInt(&ok, 10);
     }
 
+    bool parse(const char* first, const char* last, size_t index) override
+    {
+      Q_ASSERT(index < getSize());
+      return Ebsd::TextParser::parseInt32(first, last, m_Ptr[index]);
+    }
+
   protected:
     Int32Parser(int32_t* ptr, size_t size, const QString& name, int index) :
       m_Ptr(ptr)
@@ -221,6 +234,12 @@ class FloatParser : public DataParser
       m_Ptr[index] = token.toFloat(&ok);
     }
 
+    bool parse(const char* first, const char* last, size_t index) override
+    {
+      Q_ASSERT(index < getSize());
+      return Ebsd::TextParser::parseFloat(first, last, m_Ptr[index], true);
+    }
+
   protected:
     FloatParser(float* ptr, size_t size, const QString& name, int index) :
       m_Ptr(ptr)
@@ -83,7 +83,7 @@ using namespace H5Support_NAMESPACE;
 #define WRITE_EBSD_DATA_ARRAY(reader, m_msgType, gid, key)\
   {\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataArray(gid, key, rank, dims, dataPtr);\
       if (err < 0) {\
         QString ss = \
                      QObject::tr("H5CtfImporter Error: Could not write Ctf Data array for '%1' to the HDF5 file with data set name '%2'\n")\
@@ -146,17 +146,38 @@ int H5CtfImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCondition(0);
   setPipelineMessage("");
 
   //  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
-  CtfReader reader;
-  reader.setFileName(ctfFile);
+  std::shared_ptr<EbsdReader> reader;
+  QString message;
+  int err = parseFile(ctfFile, reader, message);
+  if (err < 0)
+  {
+    setPipelineMessage(message);
+    setErrorCondition(err);
+    progressMessage(message, 100);
+    return -1;
+  }
+
+  return writeFile(fileId, z, reader.get());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::parseFile(const QString& ctfFile, std::shared_ptr<EbsdReader>& ebsdReader, QString& message) const
+{
+  ebsdReader.reset();
+
+  std::shared_ptr<CtfReader> reader = std::make_shared<CtfReader>();
+  reader->setFileName(ctfFile);
+  reader->setMaxParseThreads(getMaxParseThreads());
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader->readFile();
 
   // Check for errors
   if (err < 0)
@@ -171,25 +192,44 @@ int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
     {
       ss = "H5CtfImporter Error: The Ctf file could not be opened.";
     }
-    else if (reader.getXStep() == 0.0f)
+    else if (reader->getXStep() == 0.0f)
     {
       ss = "H5CtfImporter Error: X Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
     }
-    else if(reader.getYStep() == 0.0f)
+    else if(reader->getYStep() == 0.0f)
     {
       ss = "H5CtfImporter Error: Y Step value equals 0.0. This is bad. Please check the validity of the CTF file.";
     }
     else
     {
-      ss = reader.getErrorMessage();
+      ss = reader->getErrorMessage();
     }
-    setPipelineMessage(ss);
-    setErrorCondition(err);
-    progressMessage(ss, 100);
+    message = ss;
+    return err;
+  }
 
+  ebsdReader = reader;
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeFile(hid_t fileId, int64_t z, EbsdReader* ebsdReader)
+{
+  herr_t err = -1;
+  setErrorCondition(0);
+  setPipelineMessage("");
 
+  CtfReader* ctfReader = dynamic_cast<CtfReader*>(ebsdReader);
+  if (nullptr == ctfReader)
+  {
+    QString ss = QObject::tr("H5CtfImporter Error: The parsed data for Z index %1 does not come from a .ctf file.").arg(z);
+    setPipelineMessage(ss);
+    setErrorCondition(-800);
     return -1;
   }
+  CtfReader& reader = *ctfReader;
 
   // Write the fileversion attribute if it does not exist
   {
@@ -37,6 +37,8 @@
 
 #include "hdf5.h"
 
+#include <memory>
+
 #include <QtCore/QVector>
 #include <QtCore/QString>
 
@@ -71,7 +73,25 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
      * @param index The slice index for the file
      * @param angFile The absolute path to the input .ang file
      */
-    int importFile(hid_t fileId, int64_t index, const QString& angFile);
+    int importFile(hid_t fileId, int64_t index, const QString& angFile) override;
+
+    /**
+     * @brief Parses the .ctf file into a new CtfReader without touching the HDF5 file
+     * @param ctfFile The absolute path to the input .ctf file
+     * @param reader The CtfReader holding the parsed data (out)
+     * @param message A description of the error if the file could not be parsed (out)
+     * @return Negative error code if the file could not be parsed
+     */
+    int parseFile(const QString& ctfFile, std::shared_ptr<EbsdReader>& reader, QString& message) const override;
+
+    /**
+     * @brief Writes a .ctf file parsed with parseFile() into the HDF5 file. A 3D .ctf file
+     * is written as one slice per Z cell starting at the given index.
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     * @param reader The CtfReader returned by parseFile()
+     */
+    int writeFile(hid_t fileId, int64_t index, EbsdReader* reader) override;
 
     /**
      * @brief Writes the phase data into the HDF5 file
@@ -210,108 +210,91 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
-// Initialize all the pointers
+  // Initialize all the pointers. Only the arrays in ArraysToRead are allocated and only those are read.
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int64_t xpointsslice = 0;
-  int64_t ypointsslice = 0;
-  int64_t xpointstemp = 0;
-  int64_t ypointstemp = 0;
-  int zval = 0;
-
+  err = readVolumeInfo();
 
-  int xstartspot = 0;
-  int ystartspot = 0;
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
 
-  err = readVolumeInfo();
+  // These are the arrays that are stored for each slice. Every array is 4 bytes wide (float or int)
+  // so the destination planes can be computed the same way.
+  const size_t k_NumArrays = 9;
+  const QString names[k_NumArrays] = {Ebsd::Ctf::Phase,  Ebsd::Ctf::Bands, Ebsd::Ctf::Error, Ebsd::Ctf::Euler1, Ebsd::Ctf::Euler2,
+                                      Ebsd::Ctf::Euler3, Ebsd::Ctf::MAD,   Ebsd::Ctf::BC,    Ebsd::Ctf::BS};
+  char* volumes[k_NumArrays] = {reinterpret_cast<char*>(m_Phase),  reinterpret_cast<char*>(m_Bands), reinterpret_cast<char*>(m_Error),
+                                reinterpret_cast<char*>(m_Euler1), reinterpret_cast<char*>(m_Euler2), reinterpret_cast<char*>(m_Euler3),
+                                reinterpret_cast<char*>(m_MAD),    reinterpret_cast<char*>(m_BC),     reinterpret_cast<char*>(m_BS)};
+  hid_t memTypes[k_NumArrays] = {H5T_NATIVE_INT32, H5T_NATIVE_INT32, H5T_NATIVE_INT32, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT,
+                                 H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, H5T_NATIVE_INT32, H5T_NATIVE_INT32};
+  size_t planeBytes = static_cast<size_t>(xpoints * ypoints) * sizeof(float);
+
+  // Open the file once for the entire stack instead of once per slice
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
+  {
+    std::cout << "H5CtfVolumeReader Error: Could not open .h5ebsd file for reading." << std::endl;
+    return -77000;
+  }
 
-  for (int slice = 0; slice < zpoints; ++slice)
+  for(int slice = 0; slice < zpoints; ++slice)
   {
+    if(getCancel())
+    {
+      break;
+    }
+    QString hdfPath = QString::number(slice + getSliceStart());
+    hid_t gid = H5Gopen(fileId, hdfPath.toLatin1().data(), H5P_DEFAULT);
     H5CtfReader::Pointer reader = H5CtfReader::New();
     reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-
-    err = reader->readFile();
-    if (err < 0)
+    reader->setHDF5Path(hdfPath);
+    err = (gid < 0) ? -1 : reader->readHeader(gid);
+    int64_t xpointsslice = reader->getXCells();
+    int64_t ypointsslice = reader->getYCells();
+    hid_t dataGid = (err < 0) ? -1 : H5Gopen(gid, Ebsd::H5::Data.toLatin1().data(), H5P_DEFAULT);
+    if(dataGid < 0 || xpointsslice * ypointsslice == 0)
     {
       std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+      if(dataGid >= 0) { err = H5Gclose(dataGid); }
+      if(gid >= 0) { err = H5Gclose(gid); }
+      err = QH5Utilities::closeFile(fileId);
       return -77000;
     }
-    readerIndex = 0;
-    xpointsslice = reader->getXCells();
-    ypointsslice = reader->getYCells();
-    int* phasePtr = reader->getPhasePointer();
-    float* xPtr = reader->getXPointer();
-    float* yPtr = reader->getYPointer();
-    int* bandPtr = reader->getBandCountPointer();
-    int* errorPtr = reader->getErrorPointer();
-    float* euler1Ptr = reader->getEuler1Pointer();
-    float* euler2Ptr = reader->getEuler2Pointer();
-    float* euler3Ptr = reader->getEuler3Pointer();
-    float* madPtr = reader->getMeanAngularDeviationPointer();
-    int* bcPtr = reader->getBandContrastPointer();
-    int* bsPtr = reader->getBandSlopePointer();
 
-    xpointstemp = xpoints;
-    ypointstemp = ypoints;
-    xstartspot = static_cast<int>( (xpointstemp - xpointsslice) / 2 );
-    ystartspot = static_cast<int>( (ypointstemp - ypointsslice) / 2 );
+    int64_t xstartspot = (xpoints - xpointsslice) / 2;
+    int64_t ystartspot = (ypoints - ypointsslice) / 2;
 
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
+    int64_t zval = 0;
     if (ZDir == 0) { zval = slice; }
-    if (ZDir == 1) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    if (ZDir == 1) { zval = (zpoints - 1) - slice; }
 
-    // Copy the data from the current storage into the Storage Location
-    for (int j = 0; j < ypointsslice; j++)
+    // Read each requested array straight into its Z plane of the volume
+    for(size_t a = 0; a < k_NumArrays; a++)
     {
-      for (int i = 0; i < xpointsslice; i++)
+      if(nullptr == volumes[a])
       {
-        index = static_cast<int>( (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
-        if (nullptr != phasePtr) {m_Phase[index] = phasePtr[readerIndex];}
-        if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (nullptr != bandPtr) {m_Bands[index] = bandPtr[readerIndex];}
-        if (nullptr != errorPtr) {m_Error[index] = errorPtr[readerIndex];}
-        if (nullptr != euler1Ptr) {m_Euler1[index] = euler1Ptr[readerIndex];}
-        if (nullptr != euler2Ptr) {m_Euler2[index] = euler2Ptr[readerIndex];}
-        if (nullptr != euler3Ptr) {m_Euler3[index] = euler3Ptr[readerIndex];}
-        if (nullptr != madPtr) {m_MAD[index] = madPtr[readerIndex];}
-        if (nullptr != bcPtr) {m_BC[index] = bcPtr[readerIndex];}
-        if (nullptr != bsPtr) {m_BS[index] = bsPtr[readerIndex];}
-
-        /* For HKL OIM Files if there is a single phase then the value of the phase
-         * data is one (1). If there are 2 or more phases then the lowest value
-         * of phase is also one (1). However, if there are "zero solutions" in the data
-         * then those points are assigned a phase of zero.  Since those points can be identified
-         * by other methods, the phase of these points should be changed to one since in the rest
-         * of the reconstruction code we follow the convention that the lowest value is One (1)
-         * even if there is only a single phase. The next if statement converts all zeros to ones
-         * if there is a single phase in the OIM data.
-         */
-//        if(nullptr != phasePtr && m_Phase[index] < 1)
-//        {
-//          m_Phase[index] = 1;
-//        }
-
-        ++readerIndex;
+        continue;
+      }
+      err = readSliceIntoVolume(dataGid, names[a], memTypes[a], volumes[a] + zval * planeBytes, xpoints, ypoints, xstartspot, ystartspot, xpointsslice, ypointsslice);
+      if(err < 0)
+      {
+        std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+        err = H5Gclose(dataGid);
+        err = H5Gclose(gid);
+        err = QH5Utilities::closeFile(fileId);
+        return -77000;
       }
     }
+    err = H5Gclose(dataGid);
+    err = H5Gclose(gid);
   }
-  return err;
 
+  err = QH5Utilities::closeFile(fileId);
+  return err;
 }
 
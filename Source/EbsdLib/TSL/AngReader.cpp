@@ -36,6 +36,8 @@
 #include "AngReader.h"
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <QtCore/QFile>
 #include <QtCore/QObject>
@@ -44,6 +46,7 @@
 #include "AngConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/EbsdTextParser.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -426,37 +429,32 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  size_t counter = 1; // Because we are on the first line now.
+  // Parse the data block straight out of a memory mapped view of the file if we can, otherwise
+  // fall back to reading the file line by line.
+  size_t counter = 0;
+  uchar* mappedFile = in.map(0, in.size());
+  if(nullptr != mappedFile)
+  {
+    const char* fileBegin = reinterpret_cast<const char*>(mappedFile);
+    counter = readMappedData(fileBegin, fileBegin + in.size(), totalDataPoints, buf);
+    in.unmap(mappedFile);
+  }
+  else
+  {
+    counter = readDataLines(in, buf, totalDataPoints);
+  }
 
+  // Figure out where in the grid the parsing stopped so any error message can point at it
   bool onEvenRow = false;
   int col = 0;
-
   int yChange = 0;
   float oldY = m_Y[0];
   int nxOdd = 0;
   int nxEven = 0;
   // int nRows = 0;
-
-  for(size_t i = 0; i < totalDataPoints; ++i)
+  size_t numParsed = (getErrorCode() < 0) ? counter - 1 : counter;
+  for(size_t i = 0; i < numParsed; ++i)
   {
-    if(i > 0)
-    {
-      //  ::memset(buf, 0, bufSize); // Clear the buffer
-      buf = in.readLine();
-      ++counter;
-    }
-    this->parseDataLine(buf, i);
-    if(getErrorCode() < 0)
-    {
-      ss.string()->clear();
-
-      ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
-         << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
-         << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
-      setErrorMessage(*(ss.string()));
-      break;
-    }
-
     if(fabs(m_Y[i] - oldY) > 1e-6)
     {
       ++yChange;
@@ -476,10 +474,16 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     {
       ++nxEven;
     }
-    if(in.atEnd())
-    {
-      break;
-    }
+  }
+
+  if(getErrorCode() < 0)
+  {
+    ss.string()->clear();
+
+    ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
+       << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
+       << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
+    setErrorMessage(*(ss.string()));
   }
 
 #if 0
@@ -502,7 +506,7 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  if(counter != totalDataPoints && in.atEnd())
+  if(counter != totalDataPoints)
   {
     ss.string()->clear();
 
@@ -641,10 +645,100 @@ std::cout << "m_HeaderMap[Ebsd::Ang::" << word << "] = AngHeaderEntry<float>::Ne
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t AngReader::readDataLines(QFile& in, QByteArray& buf, size_t totalDataPoints)
+{
+  size_t counter = 0;
+  for(size_t i = 0; i < totalDataPoints; ++i)
+  {
+    if(i > 0)
+    {
+      buf = in.readLine();
+    }
+    ++counter;
+    int errorColumn = 0;
+    int err = parseDataLine(buf.constData(), buf.constData() + buf.size(), i, errorColumn);
+    if(err < 0)
+    {
+      setErrorCode(err);
+      m_ErrorColumn = errorColumn;
+      break;
+    }
+    if(in.atEnd())
+    {
+      break;
+    }
+  }
+  return counter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t AngReader::readMappedData(const char* fileBegin, const char* fileEnd, size_t totalDataPoints, QByteArray& buf)
+{
+  // Every header line starts with a '#'. The first line that does not is the first line of data.
+  const char* dataBegin = fileBegin;
+  while(dataBegin < fileEnd && *dataBegin == '#')
+  {
+    dataBegin = Ebsd::TextParser::nextLine(dataBegin, fileEnd);
+  }
+
+  std::vector<Ebsd::TextParser::LineBlock> blocks = Ebsd::TextParser::splitIntoLineBlocks(dataBegin, fileEnd, getMaxParseThreads());
+  size_t numLines = std::min(Ebsd::TextParser::countLines(blocks), totalDataPoints);
+
+  // Each block remembers the first (lowest) line that failed to parse so that we report the same
+  // line the serial reader would have stopped at.
+  struct BlockError
+  {
+    size_t line = std::numeric_limits<size_t>::max();
+    int code = 0;
+    int column = 0;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+  };
+  std::vector<BlockError> errors(blocks.size());
+
+  Ebsd::TextParser::parallelFor(blocks.size(), [&](size_t b) {
+    const Ebsd::TextParser::LineBlock& block = blocks[b];
+    size_t i = block.firstLine;
+    for(const char* line = block.begin; line < block.end && i < numLines; ++i)
+    {
+      const char* lineEnd = Ebsd::TextParser::endOfLine(line, block.end);
+      int errorColumn = 0;
+      int err = parseDataLine(line, lineEnd, i, errorColumn);
+      if(err < 0)
+      {
+        errors[b].line = i;
+        errors[b].code = err;
+        errors[b].column = errorColumn;
+        errors[b].begin = line;
+        errors[b].end = lineEnd;
+        break;
+      }
+      line = Ebsd::TextParser::nextLine(lineEnd, block.end);
+    }
+  }, getMaxParseThreads());
+
+  for(const auto& error : errors)
+  {
+    if(error.code < 0)
+    {
+      setErrorCode(error.code);
+      m_ErrorColumn = error.column;
+      buf = QByteArray(error.begin, static_cast<int>(error.end - error.begin));
+      return error.line + 1;
+    }
+  }
+  return numLines;
+}
+
 // -----------------------------------------------------------------------------
 //  Read the data part of the ANG file
 // -----------------------------------------------------------------------------
-void AngReader::parseDataLine(QByteArray& line, size_t i)
+int AngReader::parseDataLine(const char* first, const char* last, size_t i, int& errorColumn)
 {
   /* When reading the data there should be at least 8 cols of data. There may even
    * be 10 columns of data. The column names should be the following:
@@ -662,126 +756,56 @@ void AngReader::parseDataLine(QByteArray& line, size_t i)
    * Some TSL ang files do NOT have all 10 columns. Assume these are lacking the last
    * 2 columns and all the other columns are the same as above.
    */
-  m_ErrorColumn = 0;
-  float p1 = 0.0f, p = 0.0f, p2 = 0.0f, x = -1.0f, y = -1.0f, iqual = -1.0f, conf = -1.0f, semSignal = -1.0f, fit = -1.0f;
-  int ph = 0;
-  size_t offset = 0;
-  QList<QByteArray> tokens = line.trimmed().simplified().split(' ');
-  bool ok = true;
-  offset = i;
-  if(!tokens.empty())
-  {
-    p1 = tokens[0].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2501);
-      m_ErrorColumn = 0;
-    }
-    m_Phi1[offset] = p1;
-  }
-  if(tokens.size() >= 2)
-  {
-    p = tokens[1].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2502);
-      m_ErrorColumn = 1;
-    }
-    m_Phi[offset] = p;
-  }
-  if(tokens.size() >= 3)
-  {
-    p2 = tokens[2].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2503);
-      m_ErrorColumn = 2;
-    }
-    m_Phi2[offset] = p2;
-  }
-  if(tokens.size() >= 4)
-  {
-    x = tokens[3].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2504);
-      m_ErrorColumn = 3;
-    }
-    m_X[offset] = x;
-  }
-  if(tokens.size() >= 5)
-  {
-    y = tokens[4].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2505);
-      m_ErrorColumn = 4;
-    }
-    m_Y[offset] = y;
-  }
-  if(tokens.size() >= 6)
+  float* floatColumns[10] = {m_Phi1, m_Phi, m_Phi2, m_X, m_Y, m_Iq, m_Ci, nullptr, m_SEMSignal, m_Fit};
+  const int32_t k_PhaseColumn = 7;
+
+  // Like the original QByteArray based parser every column is converted and the last column that
+  // fails is the one reported. A phase that only converts as a float clears any earlier error.
+  int err = 0;
+  const char* pos = first;
+  const char* tokenBegin = nullptr;
+  const char* tokenEnd = nullptr;
+  int32_t column = 0;
+  for(; column < 10; column++)
   {
-    iqual = tokens[5].toFloat(&ok);
-    if(!ok)
+    if(!Ebsd::TextParser::nextToken(pos, last, tokenBegin, tokenEnd))
     {
-      setErrorCode(-2506);
-      m_ErrorColumn = 5;
+      break;
     }
-    m_Iq[offset] = iqual;
-  }
-  if(tokens.size() >= 7)
-  {
-    conf = tokens[6].toFloat(&ok);
-    if(!ok)
+    if(column == k_PhaseColumn)
     {
-      setErrorCode(-2507);
-      m_ErrorColumn = 6;
-    }
-    m_Ci[offset] = conf;
-  }
-  if(tokens.size() >= 8)
-  {
-    ph = tokens[7].toInt(&ok);
-    if(!ok)
-    { 
-      setErrorCode(-2508);
-      m_ErrorColumn = 7;
-      // Some have floats instead of integers so lets try that.
-      float f = tokens[7].toFloat(&ok);
-      if(!ok)
+      int32_t ph = 0;
+      if(!Ebsd::TextParser::parseInt32(tokenBegin, tokenEnd, ph))
       {
-        setErrorCode(-2588);
-        m_ErrorColumn = 7;
-      }
-      else
-      {
-        setErrorCode(0);
+        // Some have floats instead of integers so lets try that.
+        float f = 0.0f;
+        if(!Ebsd::TextParser::parseFloat(tokenBegin, tokenEnd, f))
+        {
+          errorColumn = column;
+          err = -2588;
+        }
+        else
+        {
+          err = 0;
+        }
         ph = static_cast<int32_t>(f);
       }
+      m_PhaseData[i] = ph;
     }
-    m_PhaseData[offset] = ph;
-  }
-
-  if(tokens.size() >= 9)
-  {
-    semSignal = tokens[8].toFloat(&ok);
-    if(!ok)
+    else if(!Ebsd::TextParser::parseFloat(tokenBegin, tokenEnd, floatColumns[column][i]))
     {
-      setErrorCode(-2509);
-      m_ErrorColumn = 8;
+      errorColumn = column;
+      err = -2501 - column;
     }
-    m_SEMSignal[offset] = semSignal;
   }
-  if(tokens.size() >= 10)
+
+  // An empty line can not be converted into the first column
+  if(column == 0)
   {
-    fit = tokens[9].toFloat(&ok);
-    if(!ok)
-    {
-      setErrorCode(-2510);
-      m_ErrorColumn = 9;
-    }
-    m_Fit[offset] = fit;
+    errorColumn = 0;
+    return -2501;
   }
+  return err;
 }
 
 // -----------------------------------------------------------------------------
@@ -167,10 +167,31 @@ private:
    */
   void parseHeaderLine(QByteArray& buf);
 
+  /**
+   * @brief Reads the data block one line at a time. This is used when the file can not be memory mapped.
+   * @return The number of data lines that were read
+   */
+  size_t readDataLines(QFile& in, QByteArray& buf, size_t totalDataPoints);
+
+  /**
+   * @brief Parses the data block directly out of a memory mapped view of the entire file. The data
+   * block is split into blocks of whole lines that are parsed in parallel.
+   * @param fileBegin Start of the mapped file
+   * @param fileEnd End of the mapped file
+   * @param totalDataPoints The number of data points computed from the header
+   * @param buf Receives the offending line if a parse error occurs
+   * @return The number of data lines that were read
+   */
+  size_t readMappedData(const char* fileBegin, const char* fileEnd, size_t totalDataPoints, QByteArray& buf);
+
   /** @brief Parses the data from a line of data from the TSL .ang file
-   * @param line The line of data to parse
+   * @param first Start of the line of data to parse
+   * @param last End of the line of data to parse
+   * @param i The index of the data point
+   * @param errorColumn Receives the zero based column that could not be converted
+   * @return 0 on success or the error code for the column that could not be converted
    */
-  void parseDataLine(QByteArray& line, size_t i);
+  int parseDataLine(const char* first, const char* last, size_t i, int& errorColumn);
 
 public:
   AngReader(const AngReader&) = delete;            // Copy Constructor Not Implemented
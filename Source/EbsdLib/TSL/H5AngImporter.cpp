@@ -100,7 +100,7 @@ H5AngImporter::~H5AngImporter() = default;
   {\
     m_msgType* dataPtr = reader.get##prpty##Pointer();\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataArray(gid, key, rank, dims, dataPtr);\
       if (err < 0) {\
         ss.string()->clear();\
         ss << "H5AngImporter Error: Could not write Ang Data array for '" << key\
@@ -143,19 +143,40 @@ int H5AngImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
 {
-  herr_t err = -1;
   setCancel(false);
   setErrorCondition(0);
   setPipelineMessage("");
+
+  //  std::cout << "H5AngImporter: Importing " << angFile;
+  std::shared_ptr<EbsdReader> reader;
+  QString message;
+  int err = parseFile(angFile, reader, message);
+  if (err < 0)
+  {
+    setPipelineMessage(message);
+    setErrorCondition(err);
+    progressMessage(message, 100);
+    return -1;
+  }
+
+  return writeFile(fileId, z, reader.get());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::parseFile(const QString& angFile, std::shared_ptr<EbsdReader>& ebsdReader, QString& message) const
+{
+  ebsdReader.reset();
   QString streamBuf;
   QTextStream ss(&streamBuf);
 
-  //  std::cout << "H5AngImporter: Importing " << angFile;
-  AngReader reader;
-  reader.setFileName(angFile);
+  std::shared_ptr<AngReader> reader = std::make_shared<AngReader>();
+  reader->setFileName(angFile);
+  reader->setMaxParseThreads(getMaxParseThreads());
 
   // Now actually read the file
-  err = reader.readFile();
+  int err = reader->readFile();
 
   // Check for errors
   if (err < 0)
@@ -176,11 +197,11 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     {
       ss << "H5AngImporter Error: The Ang file could not be opened.'" << angFile << "'";
     }
-    else if (reader.getXStep() == 0.0f)
+    else if (reader->getXStep() == 0.0f)
     {
       ss << "H5AngImporter Error: X Step value equals 0.0. This is bad. Please check the validity of the ANG file.";
     }
-    else if(reader.getYStep() == 0.0f)
+    else if(reader->getYStep() == 0.0f)
     {
       ss << "H5AngImporter Error: Y Step value equals 0.0. This is bad. Please check the validity of the ANG file.";
     }
@@ -188,12 +209,35 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     {
       ss << "H5AngImporter Error: Unknown error [" << err << "]";
     }
-    setPipelineMessage( *(ss.string()));
+    message = *(ss.string());
+    return err;
+  }
 
-    setErrorCondition(err);
-    progressMessage(*(ss.string()), 100);
+  ebsdReader = reader;
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeFile(hid_t fileId, int64_t z, EbsdReader* ebsdReader)
+{
+  herr_t err = -1;
+  setErrorCondition(0);
+  setPipelineMessage("");
+  QString streamBuf;
+  QTextStream ss(&streamBuf);
+
+  AngReader* angReader = dynamic_cast<AngReader*>(ebsdReader);
+  if (nullptr == angReader)
+  {
+    ss << "H5AngImporter Error: The parsed data for Z index " << z << " does not come from an .ang file.";
+    setPipelineMessage(*(ss.string()));
+    setErrorCondition(-800);
     return -1;
   }
+  AngReader& reader = *angReader;
+  QString angFile = reader.getFileName();
 
   // Write the file Version number to the file
   {
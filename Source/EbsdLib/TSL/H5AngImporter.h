@@ -42,6 +42,7 @@
 
 #include "hdf5.h"
 
+#include <memory>
 #include <vector>
 #include <QtCore/QString>
 
@@ -74,7 +75,24 @@ class EbsdLib_EXPORT H5AngImporter : public EbsdImporter
      * @param index The slice index for the file
      * @param angFile The absolute path to the input .ang file
      */
-    int importFile(hid_t fileId, int64_t index, const QString& angFile);
+    int importFile(hid_t fileId, int64_t index, const QString& angFile) override;
+
+    /**
+     * @brief Parses the .ang file into a new AngReader without touching the HDF5 file
+     * @param angFile The absolute path to the input .ang file
+     * @param reader The AngReader holding the parsed data (out)
+     * @param message A description of the error if the file could not be parsed (out)
+     * @return Negative error code if the file could not be parsed
+     */
+    int parseFile(const QString& angFile, std::shared_ptr<EbsdReader>& reader, QString& message) const override;
+
+    /**
+     * @brief Writes an .ang file parsed with parseFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     * @param reader The AngReader returned by parseFile()
+     */
+    int writeFile(hid_t fileId, int64_t index, EbsdReader* reader) override;
 
     /**
      * @brief Writes the phase data into the HDF5 file
@@ -210,107 +210,151 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir )
 {
-  int index = 0;
   int err = -1;
-  // Initialize all the pointers
+  // Initialize all the pointers. Only the arrays in ArraysToRead are allocated and only those are read.
   initPointers(xpoints * ypoints * zpoints);
 
+  if(getArraysToRead().empty() && !getReadAllArrays())
+  {
+    setErrorMessage("H5AngVolumeReader Error: ReadAllArrays was FALSE and no other arrays were requested to be read.");
+    setErrorCode(-90013);
+    return getErrorCode();
+  }
 
-  int readerIndex = 0;
-  int xpointsslice = 0;
-  int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
-  int zval = 0;
-
-  int xstartspot = 0;
-  int ystartspot = 0;
   int numPhases = getNumPhases();
   err = readVolumeInfo();
-  for (int slice = 0; slice < zpoints; ++slice)
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+  // Every array is 4 bytes wide (float or int) so the destination planes can be computed the same way
+  const size_t k_NumArrays = 10;
+  const QString names[k_NumArrays] = {Ebsd::Ang::Phi1,      Ebsd::Ang::Phi,       Ebsd::Ang::Phi2,      Ebsd::Ang::XPosition, Ebsd::Ang::YPosition,
+                                      Ebsd::Ang::ImageQuality, Ebsd::Ang::ConfidenceIndex, Ebsd::Ang::PhaseData, Ebsd::Ang::SEMSignal, Ebsd::Ang::Fit};
+  char* volumes[k_NumArrays] = {reinterpret_cast<char*>(m_Phi1), reinterpret_cast<char*>(m_Phi), reinterpret_cast<char*>(m_Phi2),      reinterpret_cast<char*>(m_X),
+                                reinterpret_cast<char*>(m_Y),    reinterpret_cast<char*>(m_Iq),  reinterpret_cast<char*>(m_Ci),        reinterpret_cast<char*>(m_PhaseData),
+                                reinterpret_cast<char*>(m_SEMSignal), reinterpret_cast<char*>(m_Fit)};
+  hid_t memTypes[k_NumArrays] = {H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT,
+                                 H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, H5T_NATIVE_INT32, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT};
+  size_t planeBytes = static_cast<size_t>(xpoints * ypoints) * sizeof(float);
+
+  // Open the file once for the entire stack instead of once per slice
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
   {
+    setErrorMessage("Error: Could not open .h5ebsd file for reading.");
+    setErrorCode(-90000);
+    return getErrorCode();
+  }
+
+  for(int slice = 0; slice < zpoints; ++slice)
+  {
+    if(getCancel())
+    {
+      break;
+    }
+    QString hdfPath = QString::number(slice + getSliceStart());
+    hid_t gid = H5Gopen(fileId, hdfPath.toLatin1().data(), H5P_DEFAULT);
+    if(gid < 0)
+    {
+      setErrorMessage(QString("H5AngVolumeReader Error: Could not open path '%1'").arg(hdfPath));
+      setErrorCode(-90001);
+      err = QH5Utilities::closeFile(fileId);
+      return getErrorCode();
+    }
+
+    // Only the header of the slice is needed to know where its data goes
     H5AngReader::Pointer reader = H5AngReader::New();
     reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
+    reader->setHDF5Path(hdfPath);
+    err = reader->readHeader(gid);
     if(err < 0)
     {
-      setErrorCode(reader->getErrorCode());
+      setErrorCode(reader->getErrorCode() < 0 ? reader->getErrorCode() : err);
       setErrorMessage(reader->getErrorMessage());
+      err = H5Gclose(gid);
+      err = QH5Utilities::closeFile(fileId);
       return getErrorCode();
     }
-    readerIndex = 0;
-    xpointsslice = reader->getNumEvenCols();
-    ypointsslice = reader->getNumRows();
-    float* euler1Ptr = reader->getPhi1Pointer();
-    if (nullptr == euler1Ptr) { setErrorCode(-99090); setErrorMessage("Euler1 Pointer was nullptr from Reader"); return getErrorCode(); }
-    float* euler2Ptr = reader->getPhiPointer();
-    float* euler3Ptr = reader->getPhi2Pointer();
-    float* xPtr = reader->getXPositionPointer();
-    float* yPtr = reader->getYPositionPointer();
-    float* iqPtr = reader->getImageQualityPointer();
-    float* ciPtr = reader->getConfidenceIndexPointer();
-    int* phasePtr = reader->getPhaseDataPointer();
-    float* sigPtr = reader->getSEMSignalPointer();
-    float* fitPtr = reader->getFitPointer();
-
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+    if(reader->getGrid().startsWith(Ebsd::Ang::HexGrid))
     {
-      ZDir = getStackingOrder();
+      setErrorCode(-90400);
+      setErrorMessage("Ang Files with Hex Grids Are NOT currently supported. Please convert them to Square Grid files first");
+      err = H5Gclose(gid);
+      err = QH5Utilities::closeFile(fileId);
+      return getErrorCode();
     }
+
+    int64_t xpointsslice = reader->getNumEvenCols();
+    int64_t ypointsslice = reader->getNumRows();
+    int64_t xstartspot = (xpoints - xpointsslice) / 2;
+    int64_t ystartspot = (ypoints - ypointsslice) / 2;
+
+    int64_t zval = 0;
     if(ZDir == SIMPL::RefFrameZDir::LowtoHigh) { zval = slice; }
-    if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+    if(ZDir == SIMPL::RefFrameZDir::HightoLow) { zval = (zpoints - 1) - slice; }
+
+    hid_t dataGid = H5Gopen(gid, Ebsd::H5::Data.toLatin1().data(), H5P_DEFAULT);
+    if(dataGid < 0)
+    {
+      setErrorMessage("H5AngVolumeReader Error: Could not open 'Data' Group");
+      setErrorCode(-90012);
+      err = H5Gclose(gid);
+      err = QH5Utilities::closeFile(fileId);
+      return getErrorCode();
+    }
 
-    // Copy the data from the current storage into the new memory Location
-    for (int j = 0; j < ystop; j++)
+    // Read each requested array straight into its Z plane of the volume
+    for(size_t a = 0; a < k_NumArrays; a++)
     {
-      for (int i = 0; i < xstop; i++)
+      if(nullptr == volumes[a])
+      {
+        continue;
+      }
+      err = readSliceIntoVolume(dataGid, names[a], memTypes[a], volumes[a] + zval * planeBytes, xpoints, ypoints, xstartspot, ystartspot, xpointsslice, ypointsslice);
+      if(err < 0)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
-        if (nullptr != euler1Ptr) {m_Phi1[index] = euler1Ptr[readerIndex];}
-        if (nullptr != euler2Ptr) {m_Phi[index] = euler2Ptr[readerIndex];}
-        if (nullptr != euler3Ptr) {m_Phi2[index] = euler3Ptr[readerIndex];}
-        if (nullptr != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (nullptr != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (nullptr != iqPtr) {m_Iq[index] = iqPtr[readerIndex];}
-        if (nullptr != ciPtr) {m_Ci[index] = ciPtr[readerIndex];}
-        if (nullptr != phasePtr) {m_PhaseData[index] = phasePtr[readerIndex];} // Phase
-        if (nullptr != sigPtr) {m_SEMSignal[index] = sigPtr[readerIndex];}
-        if (nullptr != fitPtr) {m_Fit[index] = fitPtr[readerIndex];}
-
-        /* For TSL OIM Files if there is a single phase then the value of the phase
-         * data is zero (0). If there are 2 or more phases then the lowest value
-         * of phase is one (1). In the rest of the reconstruction code we follow the
-         * convention that the lowest value is One (1) even if there is only a single
-         * phase. The next if statement converts all zeros to ones if there is a single
-         * phase in the OIM data.
-         */
-        if (numPhases == 1 && nullptr != phasePtr && m_PhaseData[index] < 1)
+        setErrorCode(-90020);
+        setErrorMessage(QString("Error reading dataset '%1' from slice %2 of the HDF5 file. This data set is required to be in the file because either "
+                                "the program is set to read ALL the Data arrays or the program was instructed to read this array.")
+                            .arg(names[a])
+                            .arg(hdfPath));
+        err = H5Gclose(dataGid);
+        err = H5Gclose(gid);
+        err = QH5Utilities::closeFile(fileId);
+        return getErrorCode();
+      }
+    }
+    err = H5Gclose(dataGid);
+    err = H5Gclose(gid);
+
+    /* For TSL OIM Files if there is a single phase then the value of the phase
+     * data is zero (0). If there are 2 or more phases then the lowest value
+     * of phase is one (1). In the rest of the reconstruction code we follow the
+     * convention that the lowest value is One (1) even if there is only a single
+     * phase. The next if statement converts all zeros to ones if there is a single
+     * phase in the OIM data.
+     */
+    if(numPhases == 1 && nullptr != m_PhaseData)
+    {
+      for(int64_t j = 0; j < ypointsslice; j++)
+      {
+        int* phases = m_PhaseData + (zval * xpoints * ypoints) + ((j + ystartspot) * xpoints) + xstartspot;
+        for(int64_t i = 0; i < xpointsslice; i++)
         {
-          m_PhaseData[index] = 1;
+          if(phases[i] < 1)
+          {
+            phases[i] = 1;
+          }
         }
-
-        ++readerIndex;
       }
     }
   }
+
+  err = QH5Utilities::closeFile(fileId);
   return err;
 }
 
@@ -35,6 +35,9 @@
 
 #include "CubicOps.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -52,7 +55,6 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
-#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
 
 namespace Detail
 {
@@ -338,6 +340,80 @@ float CubicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n
   return _calcMisoQuat(CubicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+namespace
+{
+/**
+ * @brief cubicMisoCosHalfAngle Returns the largest |w| of all the cubic symmetric equivalents of qr. With the
+ * absolute components sorted so that a >= b >= c >= d the 24 equivalents reduce to the three candidates
+ * a, (a + b) / sqrt(2) and (a + b + c + d) / 2 used by CubicOps::_calcMisoQuat.
+ */
+inline float cubicMisoCosHalfAngle(const QuatF& qr)
+{
+  const float x = std::fabs(qr.x);
+  const float y = std::fabs(qr.y);
+  const float z = std::fabs(qr.z);
+  const float w = std::fabs(qr.w);
+
+  // Branch free sorting network
+  const float hi1 = std::max(x, y);
+  const float lo1 = std::min(x, y);
+  const float hi2 = std::max(z, w);
+  const float lo2 = std::min(z, w);
+  const float a = std::max(hi1, hi2);
+  const float b = std::max(std::min(hi1, hi2), std::max(lo1, lo2));
+
+  float cosHalf = std::max(a, (a + b) / static_cast<float>(SIMPLib::Constants::k_Sqrt2));
+  cosHalf = std::max(cosHalf, (x + y + z + w) * 0.5f);
+  return cosHalf;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuats(const QuatF* q1, const QuatF* q2, size_t numPairs, float* angles, float* axes)
+{
+  // The axes need the type of the winning operator, so fall back to the scalar kernel for them
+  if(nullptr != axes)
+  {
+    int numsym = 24;
+    QuatF qa;
+    QuatF qb;
+    for(size_t i = 0; i < numPairs; i++)
+    {
+      QuaternionMathF::Copy(q1[i], qa);
+      QuaternionMathF::Copy(q2[i], qb);
+      angles[i] = _calcMisoQuat(CubicQuatSym, numsym, qa, qb, axes[3 * i], axes[3 * i + 1], axes[3 * i + 2]);
+    }
+    return;
+  }
+
+  QuatF qr;
+  QuatF q2inv;
+  for(size_t i = 0; i < numPairs; i++)
+  {
+    QuaternionMathF::Conjugate(q2[i], q2inv);
+    QuaternionMathF::Multiply(q1[i], q2inv, qr);
+    angles[i] = 2.0f * acosf(std::min(cubicMisoCosHalfAngle(qr), 1.0f));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CubicOps::isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float tolerance)
+{
+  QuatF qr;
+  QuatF q2inv;
+  QuaternionMathF::Conjugate(q2, q2inv);
+  QuaternionMathF::Multiply(q1, q2inv, qr);
+  // 2 * acos(|w|) < tolerance is the same as |w| > cos(tolerance / 2)
+  return cubicMisoCosHalfAngle(qr) > cosf(0.5f * tolerance);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1808,50 +1884,20 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   if(config.labels.size() > 1) { label1 = config.labels.at(1); }
   if(config.labels.size() > 2) { label2 = config.labels.at(2); }
 
-  int numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  QVector<size_t> dims(1, 3);
-  FloatArrayType::Pointer xyz001 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize0, dims, label0 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <011> Family
-  FloatArrayType::Pointer xyz011 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize1, dims, label1 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <111> Family
-  FloatArrayType::Pointer xyz111 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize2, dims, label2 + QString("xyzCoords"));
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
   DoubleArrayType::Pointer intensity001 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 
+  // Stream the orientations through the sphere coordinates and into the modified Lambert projections **** Parallelized
+  generatePoleFigureIntensities(config, Detail::CubicHigh::symSize0, Detail::CubicHigh::symSize1, Detail::CubicHigh::symSize2, intensity001.get(), intensity011.get(), intensity111.get());
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
 #endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
   double max = std::numeric_limits<double>::min();
@@ -1903,7 +1949,7 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   config.minScale = min;
   config.maxScale = max;
 
-  dims[0] = 4;
+  QVector<size_t> dims(1, 4);
   UInt8ArrayType::Pointer image001 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0);
   UInt8ArrayType::Pointer image011 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1);
   UInt8ArrayType::Pointer image111 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2);
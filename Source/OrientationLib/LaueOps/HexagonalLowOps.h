@@ -97,6 +97,8 @@ class OrientationLib_EXPORT HexagonalLowOps : public LaueOps
 
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuats(const QuatF* q1, const QuatF* q2, size_t numPairs, float* angles, float* axes);
+    virtual bool isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float tolerance);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
@@ -35,16 +35,26 @@
 
 #include "LaueOps.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <limits>
 #include <random>
 
 #include <QtCore/QDateTime>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
 
 #include "OrientationLib/LaueOps/CubicLowOps.h"
 #include "OrientationLib/LaueOps/CubicOps.h"
@@ -60,6 +70,11 @@
 
 namespace Detail
 {
+// Number of quaternion pairs processed together by the batched misorientation kernels
+static const size_t k_MisoBlockSize = 64;
+
+// Number of orientations whose sphere coordinates are generated at once when building pole figures
+static const size_t k_PoleFigureChunkSize = 65536;
 
 // const static float m_OnePointThree = 1.33333333333f;
 
@@ -77,6 +92,51 @@ namespace Detail
 // const static float CosOfZero = cosf(0.0f);
 }
 
+/**
+ * @brief The AccumulatePoleFigureImpl class bins one chunk of sphere coordinates for all three pole families. Each
+ * family's coordinates are split into as many slices as there are accumulators and every slice is binned into its own
+ * accumulator, so no two tasks ever write to the same projection.
+ */
+class AccumulatePoleFigureImpl
+{
+  public:
+    AccumulatePoleFigureImpl(std::vector<StereographicProjectionAccumulator>* accumulators, FloatArrayType* xyzCoords[3], const size_t numCoords[3])
+    : m_Accumulators(accumulators)
+    {
+      for(int i = 0; i < 3; i++)
+      {
+        m_XYZCoords[i] = xyzCoords[i];
+        m_NumCoords[i] = numCoords[i];
+      }
+    }
+    virtual ~AccumulatePoleFigureImpl() = default;
+
+    void accumulate(size_t start, size_t end) const
+    {
+      size_t numSlices = m_Accumulators[0].size();
+      for(size_t task = start; task < end; task++)
+      {
+        size_t family = task / numSlices;
+        size_t slice = task % numSlices;
+        size_t first = m_NumCoords[family] * slice / numSlices;
+        size_t last = m_NumCoords[family] * (slice + 1) / numSlices;
+        m_Accumulators[family][slice].addCoords(m_XYZCoords[family]->getPointer(0) + first * 3, last - first);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      accumulate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    std::vector<StereographicProjectionAccumulator>* m_Accumulators;
+    FloatArrayType* m_XYZCoords[3];
+    size_t m_NumCoords[3];
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -154,6 +214,109 @@ float LaueOps::_calcMisoQuat(const QuatF quatsym[24], int numsym, QuatF& q1, Qua
   return wmin;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::_calcMisoQuats(const QuatF* quatsym, int numsym, const QuatF* q1, const QuatF* q2, size_t numPairs, float* angles, float* axes)
+{
+  float rx[Detail::k_MisoBlockSize];
+  float ry[Detail::k_MisoBlockSize];
+  float rz[Detail::k_MisoBlockSize];
+  float rw[Detail::k_MisoBlockSize];
+  float wmax[Detail::k_MisoBlockSize];
+  int32_t best[Detail::k_MisoBlockSize];
+  QuatF qr;
+  QuatF qc;
+  QuatF q2inv;
+
+  for(size_t start = 0; start < numPairs; start += Detail::k_MisoBlockSize)
+  {
+    size_t count = std::min(Detail::k_MisoBlockSize, numPairs - start);
+
+    // Store the relative rotations as a structure of arrays so the symmetry loop vectorizes
+    for(size_t j = 0; j < count; j++)
+    {
+      QuaternionMathF::Conjugate(q2[start + j], q2inv);
+      QuaternionMathF::Multiply(q1[start + j], q2inv, qr);
+      rx[j] = qr.x;
+      ry[j] = qr.y;
+      rz[j] = qr.z;
+      rw[j] = qr.w;
+      wmax[j] = -1.0f;
+      best[j] = 0;
+    }
+
+    // The rotation angle of sym * qr is 2 * acos(|w|), so only the scalar part of the product
+    // is needed to find the symmetry operator giving the smallest angle
+    for(int i = 0; i < numsym; i++)
+    {
+      const float sx = quatsym[i].x;
+      const float sy = quatsym[i].y;
+      const float sz = quatsym[i].z;
+      const float sw = quatsym[i].w;
+      for(size_t j = 0; j < count; j++)
+      {
+        float w = std::fabs(sw * rw[j] - sx * rx[j] - sy * ry[j] - sz * rz[j]);
+        best[j] = (w > wmax[j]) ? i : best[j];
+        wmax[j] = (w > wmax[j]) ? w : wmax[j];
+      }
+    }
+
+    for(size_t j = 0; j < count; j++)
+    {
+      angles[start + j] = 2.0f * acosf(std::min(wmax[j], 1.0f));
+    }
+
+    if(nullptr == axes)
+    {
+      continue;
+    }
+    for(size_t j = 0; j < count; j++)
+    {
+      float* n = axes + 3 * (start + j);
+      qr.x = rx[j];
+      qr.y = ry[j];
+      qr.z = rz[j];
+      qr.w = rw[j];
+      QuaternionMathF::Multiply(quatsym[best[j]], qr, qc);
+      float denom = sqrtf(qc.x * qc.x + qc.y * qc.y + qc.z * qc.z);
+      if(denom == 0.0f || angles[start + j] == 0.0f)
+      {
+        n[0] = 0.0f, n[1] = 0.0f, n[2] = 1.0f;
+      }
+      else
+      {
+        n[0] = qc.x / denom;
+        n[1] = qc.y / denom;
+        n[2] = qc.z / denom;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool LaueOps::_calcIsMisoQuatBelow(const QuatF* quatsym, int numsym, const QuatF& q1, const QuatF& q2, float tolerance)
+{
+  // 2 * acos(|w|) < tolerance is the same as |w| > cos(tolerance / 2)
+  const float threshold = cosf(0.5f * tolerance);
+  QuatF qr;
+  QuatF q2inv;
+
+  QuaternionMathF::Conjugate(q2, q2inv);
+  QuaternionMathF::Multiply(q1, q2inv, qr);
+  for(int i = 0; i < numsym; i++)
+  {
+    float w = quatsym[i].w * qr.w - quatsym[i].x * qr.x - quatsym[i].y * qr.y - quatsym[i].z * qr.z;
+    if(std::fabs(w) > threshold)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -413,6 +576,79 @@ std::vector<QString> LaueOps::GetLaueNames()
   return names;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::generatePoleFigureIntensities(PoleFigureConfiguration_t& config, int symSize0, int symSize1, int symSize2, DoubleArrayType* intensity0, DoubleArrayType* intensity1,
+                                            DoubleArrayType* intensity2)
+{
+  size_t numOrientations = config.eulers->getNumberOfTuples();
+  size_t chunkSize = std::min(numOrientations, Detail::k_PoleFigureChunkSize);
+  size_t numSlices = 1;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  numSlices = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#endif
+
+  // Every slice of every family owns its own projection which are summed after the last chunk
+  std::vector<StereographicProjectionAccumulator> accumulators[3];
+  for(int i = 0; i < 3; i++)
+  {
+    accumulators[i].reserve(numSlices);
+    for(size_t s = 0; s < numSlices; s++)
+    {
+      accumulators[i].emplace_back(&config);
+    }
+  }
+
+  // Only a single chunk of Euler angles and sphere coordinates is ever allocated
+  QVector<size_t> dims(1, 3);
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(chunkSize, dims, "PoleFigure_Eulers");
+  FloatArrayType::Pointer xyz0 = FloatArrayType::CreateArray(chunkSize * symSize0, dims, "PoleFigure_xyzCoords_0");
+  FloatArrayType::Pointer xyz1 = FloatArrayType::CreateArray(chunkSize * symSize1, dims, "PoleFigure_xyzCoords_1");
+  FloatArrayType::Pointer xyz2 = FloatArrayType::CreateArray(chunkSize * symSize2, dims, "PoleFigure_xyzCoords_2");
+  FloatArrayType* xyzCoords[3] = {xyz0.get(), xyz1.get(), xyz2.get()};
+
+  for(size_t start = 0; start < numOrientations; start += chunkSize)
+  {
+    size_t count = std::min(chunkSize, numOrientations - start);
+    if(count != eulers->getNumberOfTuples())
+    {
+      eulers->resize(count);
+    }
+    float* src = config.eulers->getPointer(start * 3);
+    std::copy(src, src + count * 3, eulers->getPointer(0));
+
+    // Generate the coords on the sphere **** Parallelized
+    generateSphereCoordsFromEulers(eulers.get(), xyz0.get(), xyz1.get(), xyz2.get());
+
+    size_t numCoords[3] = {count * symSize0, count * symSize1, count * symSize2};
+    AccumulatePoleFigureImpl impl(accumulators, xyzCoords, numCoords);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, 3 * numSlices, 1), impl, tbb::simple_partitioner());
+    }
+    else
+#endif
+    {
+      impl.accumulate(0, 3 * numSlices);
+    }
+  }
+
+  DoubleArrayType* intensity[3] = {intensity0, intensity1, intensity2};
+  for(int i = 0; i < 3; i++)
+  {
+    for(size_t s = 1; s < numSlices; s++)
+    {
+      accumulators[i][0].merge(accumulators[i][s]);
+    }
+    accumulators[i][0].createStereographicProjection(intensity[i]);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -126,6 +126,28 @@ class OrientationLib_EXPORT LaueOps
      */
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3) = 0;
 
+    /**
+     * @brief getMisoQuats Finds the misorientation for each of a batch of quaternion pairs. The
+     * symmetry loop runs over blocks of pairs so only one virtual call is made per batch.
+     * @param q1 Array of numPairs first quaternions
+     * @param q2 Array of numPairs second quaternions
+     * @param numPairs Number of quaternion pairs
+     * @param angles [output] Array of numPairs misorientation angles in radians
+     * @param axes [output] Array of 3 * numPairs normalized misorientation axes, or nullptr if only the angles are needed
+     */
+    virtual void getMisoQuats(const QuatF* q1, const QuatF* q2, size_t numPairs, float* angles, float* axes) = 0;
+
+    /**
+     * @brief isMisoQuatBelow Determines if the misorientation between two quaternions is less than
+     * the tolerance without computing the misorientation itself. Returns as soon as any symmetry
+     * operator brings the pair within tolerance.
+     * @param q1
+     * @param q2
+     * @param tolerance Misorientation tolerance in radians
+     * @return
+     */
+    virtual bool isMisoQuatBelow(const QuatF& q1, const QuatF& q2, float tolerance) = 0;
+
     /**
      * @brief getQuatSymOp Copies the symmetry operator at index i into q
      * @param i The index into the Symmetry operators array
@@ -213,6 +235,9 @@ class OrientationLib_EXPORT LaueOps
                         QuatF& q1, QuatF& q2,
                         float& n1, float& n2, float& n3);
 
+    void _calcMisoQuats(const QuatF* quatsym, int numsym, const QuatF* q1, const QuatF* q2, size_t numPairs, float* angles, float* axes);
+    bool _calcIsMisoQuatBelow(const QuatF* quatsym, int numsym, const QuatF& q1, const QuatF& q2, float tolerance);
+
     FOrientArrayType _calcRodNearestOrigin(const float rodsym[24][3], int numsym, FOrientArrayType rod);
     void _calcNearestQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2);
     void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
@@ -221,6 +246,22 @@ class OrientationLib_EXPORT LaueOps
     void _calcDetermineHomochoricValues(uint64_t seed, float init[3], float step[3], int32_t phi[3], int choose, float& r1, float& r2, float& r3);
     int _calcODFBin(float dim[3], float bins[3], float step[3], FOrientArrayType homochoric);
 
+    /**
+     * @brief generatePoleFigureIntensities Computes the stereographic intensity images of the three pole families for
+     * the Euler angles in the configuration. The orientations are passed through generateSphereCoordsFromEulers() in
+     * fixed size chunks and each chunk is binned into a set of partial projections that are summed once all chunks are
+     * done, so the memory needed does not grow with the number of orientations.
+     * @param config The pole figure configuration
+     * @param symSize0 Number of poles per orientation in the first family
+     * @param symSize1 Number of poles per orientation in the second family
+     * @param symSize2 Number of poles per orientation in the third family
+     * @param intensity0 [output] Intensity image of the first family
+     * @param intensity1 [output] Intensity image of the second family
+     * @param intensity2 [output] Intensity image of the third family
+     */
+    void generatePoleFigureIntensities(PoleFigureConfiguration_t& config, int symSize0, int symSize1, int symSize2, DoubleArrayType* intensity0, DoubleArrayType* intensity1,
+                                       DoubleArrayType* intensity2);
+
   public:
     LaueOps(const LaueOps&) = delete;        // Copy Constructor Not Implemented
     LaueOps(LaueOps&&) = delete;             // Move Constructor Not Implemented
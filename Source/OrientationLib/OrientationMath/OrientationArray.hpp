@@ -53,8 +53,10 @@ template<typename T>
  * Class is meant to allow easier use of the Rotation Transformation functions
  * included in the @see RotationTransformation class. The base implementation will
  * allocate the "size" number of elements which represent a single orientation
- * in space. Alternate constructors can allow the class to simply wrap an existing
- * array of values which makes looping through an array of orientations easier.
+ * in space. Arrays of up to 9 elements, which covers every representation, are
+ * stored inside the object itself so temporaries never touch the heap. Alternate
+ * constructors can allow the class to simply wrap an existing array of values
+ * which makes looping through an array of orientations easier.
  */
 class OrientationArray
 {
@@ -185,7 +187,7 @@ class OrientationArray
     {
       if(m_Ptr != nullptr && m_Owns == true)
       {
-        free(m_Ptr);
+        release();
       }
       m_Ptr = nullptr;
     }
@@ -199,8 +201,7 @@ class OrientationArray
     {
       if(m_Ptr != nullptr && m_Owns == true)
       {
-        free(m_Ptr);
-        m_Ptr = nullptr;
+        release();
 
         m_Size = rhs.size();
         allocate();
@@ -348,13 +349,36 @@ class OrientationArray
       {
         if(m_Ptr != nullptr && m_Owns == true)
         {
-          free(m_Ptr);
+          release();
         }
         m_Ptr = nullptr;
         m_Owns = false;
         m_Size = 0;
         return;
       }
+
+      // Moves into, out of or within the inline storage are done by hand since realloc
+      // can only be used on heap memory.
+      if (m_Ptr == m_Inline || newSize <= k_InlineSize)
+      {
+        newArray = (newSize <= k_InlineSize) ? m_Inline : reinterpret_cast<T*>(malloc(newSize * sizeof(T)));
+        if (!newArray)
+        {
+          return;
+        }
+        if (m_Ptr != nullptr && newArray != m_Ptr)
+        {
+          memcpy(newArray, m_Ptr, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
+          if (m_Ptr != m_Inline)
+          {
+            free(m_Ptr);
+          }
+        }
+        m_Size = newSize;
+        m_Ptr = newArray;
+        m_Owns = true;
+        return;
+      }
       // OS X's realloc does not free memory if the new block is smaller.  This
       // is a very serious problem and causes huge amount of memory to be
       // wasted. Do not use realloc on the Mac.
@@ -418,8 +442,7 @@ class OrientationArray
 
       if(m_Ptr != nullptr && m_Owns == true)
       {
-        free(m_Ptr);
-        m_Ptr = nullptr;
+        release();
       }
       else if(m_Ptr != nullptr && m_Owns == false)
       {
@@ -428,17 +451,32 @@ class OrientationArray
       // If we made it this far the pointer should be nullptr and we can go ahead and allocate our memory
       if(m_Ptr == nullptr)
       {
-        m_Ptr = reinterpret_cast<T*>(malloc(sizeof(T) * m_Size));
+        m_Ptr = (m_Size <= k_InlineSize) ? m_Inline : reinterpret_cast<T*>(malloc(sizeof(T) * m_Size));
         ::memset(m_Ptr, 0, sizeof(T) * m_Size);
         m_Owns = true;
       }
 
     }
 
+    /**
+     * @brief release Frees the owned memory unless it is the inline storage
+     */
+    void release()
+    {
+      if(m_Ptr != m_Inline)
+      {
+        free(m_Ptr);
+      }
+      m_Ptr = nullptr;
+    }
+
   private:
+    static const size_t k_InlineSize = 9;
+
     T* m_Ptr;
     size_t m_Size;
     bool m_Owns;
+    T m_Inline[k_InlineSize];
 
 };
 
@@ -0,0 +1,251 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationConverter.hpp"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The OrientationBatchConverter class converts whole arrays between the Euler,
+ * Orientation Matrix, Quaternion, Rodrigues and Homochoric representations with the
+ * OrientationBatchTransforms kernels. Each block of tuples is sanity checked with the
+ * same classes the OrientationConverter subclasses use, transposed into structure of
+ * arrays storage and run through a chain of kernels that meets at the quaternion
+ * (Euler angles and orientation matrices convert directly into each other). Only the
+ * final representation is written back, so the intermediate ones never leave the
+ * block buffers.
+ */
+template <typename T>
+class OrientationBatchConverter
+{
+public:
+  typedef OrientationBatchTransforms<T> BatchTransforms;
+  typedef typename OrientationConverter<T>::OrientationType OrientationType;
+
+  static const size_t k_BlockSize = BatchTransforms::k_BlockSize;
+
+  OrientationBatchConverter(T* inPtr, T* outPtr, OrientationType inType, OrientationType outType)
+  : m_InPtr(inPtr)
+  , m_OutPtr(outPtr)
+  , m_InType(inType)
+  , m_OutType(outType)
+  {
+    QVector<int> counts = OrientationConverter<T>::GetComponentCounts();
+    m_InStride = static_cast<size_t>(counts[inType]);
+    m_OutStride = static_cast<size_t>(counts[outType]);
+  }
+  ~OrientationBatchConverter() = default;
+
+  /**
+   * @brief IsSupported Returns true if there is a chain of batch kernels between the
+   * two representations. The kernels are written for the passive rotation convention.
+   * @param inType Input representation
+   * @param outType Output representation
+   * @return
+   */
+  static bool IsSupported(OrientationType inType, OrientationType outType)
+  {
+    return inType != outType && IsBatchType(inType) && IsBatchType(outType) && Rotations::Constants::epsijk == 1.0f;
+  }
+
+  /**
+   * @brief Convert Converts numTuples orientations from inType to outType. Every
+   * component of the output is written.
+   * @param inPtr Input orientations, sanity checked in place like the OrientationConverter classes do
+   * @param outPtr Output orientations
+   * @param numTuples Number of orientations
+   * @param inType Input representation
+   * @param outType Output representation
+   */
+  static void Convert(T* inPtr, T* outPtr, size_t numTuples, OrientationType inType, OrientationType outType)
+  {
+    OrientationBatchConverter<T> batch(inPtr, outPtr, inType, outType);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples, k_BlockSize), batch, tbb::auto_partitioner());
+#else
+    batch.convert(0, numTuples);
+#endif
+  }
+
+  /**
+   * @brief This is the main conversion routine
+   * @param start Starting index
+   * @param end Ending index
+   */
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<T> input(9 * k_BlockSize, static_cast<T>(0.0));
+    std::vector<T> quat(4 * k_BlockSize, static_cast<T>(0.0));
+    std::vector<T> output(9 * k_BlockSize, static_cast<T>(0.0));
+
+    for(size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+    {
+      size_t count = (end - blockStart < k_BlockSize) ? end - blockStart : k_BlockSize;
+      sanityCheck(blockStart, blockStart + count);
+
+      const T* inTuples = m_InPtr + blockStart * m_InStride;
+      for(size_t c = 0; c < m_InStride; c++)
+      {
+        for(size_t i = 0; i < count; i++)
+        {
+          input[c * k_BlockSize + i] = inTuples[i * m_InStride + c];
+        }
+      }
+
+      const T* result = output.data();
+      if(m_InType == OrientationConverter<T>::Euler && m_OutType == OrientationConverter<T>::OrientationMatrix)
+      {
+        BatchTransforms::eu2om(input.data(), output.data(), count);
+      }
+      else if(m_InType == OrientationConverter<T>::OrientationMatrix && m_OutType == OrientationConverter<T>::Euler)
+      {
+        BatchTransforms::om2eu(input.data(), output.data(), count);
+      }
+      else
+      {
+        const T* qu = quat.data();
+        switch(m_InType)
+        {
+        case OrientationConverter<T>::Euler:
+          BatchTransforms::eu2qu(input.data(), quat.data(), count);
+          break;
+        case OrientationConverter<T>::OrientationMatrix:
+          BatchTransforms::om2qu(input.data(), quat.data(), count);
+          break;
+        case OrientationConverter<T>::Rodrigues:
+          BatchTransforms::ro2qu(input.data(), quat.data(), count);
+          break;
+        case OrientationConverter<T>::Homochoric:
+          BatchTransforms::ho2qu(input.data(), quat.data(), count);
+          break;
+        default:
+          qu = input.data();
+          break;
+        }
+
+        switch(m_OutType)
+        {
+        case OrientationConverter<T>::Euler:
+          BatchTransforms::qu2eu(qu, output.data(), count);
+          break;
+        case OrientationConverter<T>::OrientationMatrix:
+          BatchTransforms::qu2om(qu, output.data(), count);
+          break;
+        case OrientationConverter<T>::Rodrigues:
+          BatchTransforms::qu2ro(qu, output.data(), count);
+          break;
+        case OrientationConverter<T>::Homochoric:
+          BatchTransforms::qu2ho(qu, output.data(), count);
+          break;
+        default:
+          result = qu;
+          break;
+        }
+      }
+
+      T* outTuples = m_OutPtr + blockStart * m_OutStride;
+      for(size_t i = 0; i < count; i++)
+      {
+        for(size_t c = 0; c < m_OutStride; c++)
+        {
+          outTuples[i * m_OutStride + c] = result[c * k_BlockSize + i];
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  T* m_InPtr = nullptr;
+  T* m_OutPtr = nullptr;
+  OrientationType m_InType;
+  OrientationType m_OutType;
+  size_t m_InStride = 0;
+  size_t m_OutStride = 0;
+
+  static bool IsBatchType(OrientationType type)
+  {
+    return type == OrientationConverter<T>::Euler || type == OrientationConverter<T>::OrientationMatrix || type == OrientationConverter<T>::Quaternion ||
+           type == OrientationConverter<T>::Rodrigues || type == OrientationConverter<T>::Homochoric;
+  }
+
+  /**
+   * @brief sanityCheck Runs the same input checks as the OrientationConverter classes
+   */
+  void sanityCheck(size_t start, size_t end) const
+  {
+    switch(m_InType)
+    {
+    case OrientationConverter<T>::Euler:
+      EulerSanityCheck<T>(m_InPtr, m_InStride).sanityCheck(start, end);
+      break;
+    case OrientationConverter<T>::OrientationMatrix:
+      OrientationMatrixSanityCheck<T>(m_InPtr, m_InStride).sanityCheck(start, end);
+      break;
+    case OrientationConverter<T>::Quaternion:
+      QuaternionSanityCheck<T>(m_InPtr, m_InStride).sanityCheck(start, end);
+      break;
+    case OrientationConverter<T>::Rodrigues:
+      RodriguesSanityCheck<T>(m_InPtr, m_InStride).sanityCheck(start, end);
+      break;
+    case OrientationConverter<T>::Homochoric:
+      HomochoricSanityCheck<T>(m_InPtr, m_InStride).sanityCheck(start, end);
+      break;
+    default:
+      break;
+    }
+  }
+};
@@ -0,0 +1,517 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationLibConstants.h"
+
+/**
+ * @brief The OrientationBatchTransforms class holds structure of arrays versions of the
+ * Euler, Orientation Matrix, Quaternion, Rodrigues and Homochoric conversions in
+ * OrientationTransforms. Each representation is stored as a block: component c of
+ * tuple i lives at data[c * k_BlockSize + i], so every kernel is a single loop whose
+ * body only uses arithmetic, sqrt and selects and can be auto-vectorized. The
+ * sin/cos/atan2 used here are polynomial evaluations accurate to a few ulp so they
+ * do not break the loop into library calls the way the scalar transforms do. Both
+ * sides of every select are computed up front; GCC still only vectorizes the loops
+ * when the including source is built with -fno-math-errno -fno-trapping-math.
+ *
+ * Quaternions use the <Vector>Scalar layout (x, y, z, w) and all kernels assume the
+ * passive rotation convention. The results match OrientationTransforms to within
+ * rounding, except that Euler angles that are a rounding error below zero wrap to
+ * 2Pi instead of 0.
+ */
+template <typename K>
+class OrientationBatchTransforms
+{
+public:
+  static const size_t k_BlockSize = 256;
+
+  /**
+   * @brief Euler angles to quaternion
+   * @param eu Block of Euler angles
+   * @param qu Block of quaternions
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void eu2qu(const K* eu, K* qu, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K sPhi = 0.0, cPhi = 0.0, sm = 0.0, cm = 0.0, sp = 0.0, cp = 0.0;
+      K phi1 = static_cast<K>(0.5) * eu[i];
+      K phi2 = static_cast<K>(0.5) * eu[2 * k_BlockSize + i];
+      SinCos(static_cast<K>(0.5) * eu[k_BlockSize + i], sPhi, cPhi);
+      SinCos(phi1 - phi2, sm, cm);
+      SinCos(phi1 + phi2, sp, cp);
+      K w = cPhi * cp;
+      K sign = (w < 0.0) ? static_cast<K>(-1.0) : static_cast<K>(1.0);
+      qu[i] = -sign * sPhi * cm;
+      qu[k_BlockSize + i] = -sign * sPhi * sm;
+      qu[2 * k_BlockSize + i] = -sign * cPhi * sp;
+      qu[3 * k_BlockSize + i] = sign * w;
+    }
+  }
+
+  /**
+   * @brief Quaternion to Euler angles. The degenerate Phi = 0 and Phi = Pi cases are
+   * selected per lane instead of branched on.
+   * @param qu Block of quaternions
+   * @param eu Block of Euler angles
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void qu2eu(const K* qu, K* eu, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K x = qu[i];
+      K y = qu[k_BlockSize + i];
+      K z = qu[2 * k_BlockSize + i];
+      K w = qu[3 * k_BlockSize + i];
+      K q03 = w * w + z * z;
+      K q12 = x * x + y * y;
+      K chi = std::sqrt(q03 * q12);
+      bool degenerate = (chi == 0.0);
+      bool top = (q12 == 0.0);
+      // Both scalar atan2 arguments are divided by chi > 0, which does not change the angle
+      K topY = static_cast<K>(-2.0) * w * z;
+      K topX = w * w - z * z;
+      K bottomY = static_cast<K>(2.0) * x * y;
+      K bottomX = x * x - y * y;
+      K y1 = -w * y + x * z;
+      K x1 = -w * x - y * z;
+      y1 = degenerate ? (top ? topY : bottomY) : y1;
+      x1 = degenerate ? (top ? topX : bottomX) : x1;
+      // Atan2(0, q03) = 0 and Atan2(0, -q12) = Pi give the degenerate Phi
+      K Phi = Atan2(static_cast<K>(2.0) * chi, q03 - q12);
+      // In the degenerate cases these arguments are both zero and Atan2 returns 0
+      eu[i] = WrapAngle(Atan2(y1, x1));
+      eu[k_BlockSize + i] = Phi;
+      eu[2 * k_BlockSize + i] = WrapAngle(Atan2(w * y + x * z, -w * x + y * z));
+    }
+  }
+
+  /**
+   * @brief Euler angles to orientation matrix
+   * @param eu Block of Euler angles
+   * @param om Block of orientation matrices in row major order
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void eu2om(const K* eu, K* om, size_t count)
+  {
+    const K eps = static_cast<K>(1.0E-7);
+    for(size_t i = 0; i < count; i++)
+    {
+      K s1 = 0.0, c1 = 0.0, s = 0.0, c = 0.0, s2 = 0.0, c2 = 0.0;
+      SinCos(eu[i], s1, c1);
+      SinCos(eu[k_BlockSize + i], s, c);
+      SinCos(eu[2 * k_BlockSize + i], s2, c2);
+      K res[9] = {c1 * c2 - s1 * s2 * c, s1 * c2 + c1 * s2 * c, s2 * s, -c1 * s2 - s1 * c2 * c, -s1 * s2 + c1 * c2 * c, c2 * s, s1 * s, -c1 * s, c};
+      for(size_t j = 0; j < 9; j++)
+      {
+        om[j * k_BlockSize + i] = (std::fabs(res[j]) < eps) ? static_cast<K>(0.0) : res[j];
+      }
+    }
+  }
+
+  /**
+   * @brief Orientation matrix to Euler angles
+   * @param om Block of orientation matrices in row major order
+   * @param eu Block of Euler angles
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void om2eu(const K* om, K* eu, size_t count)
+  {
+    const K thr = static_cast<K>(1.0E-6);
+    for(size_t i = 0; i < count; i++)
+    {
+      K o0 = om[i];
+      K o1 = om[k_BlockSize + i];
+      K o2 = om[2 * k_BlockSize + i];
+      K o5 = om[5 * k_BlockSize + i];
+      K o6 = om[6 * k_BlockSize + i];
+      K o7 = om[7 * k_BlockSize + i];
+      K o8 = om[8 * k_BlockSize + i];
+      bool close = std::fabs(std::fabs(o8) - static_cast<K>(1.0)) < thr;
+      // The scalar zeta = 1/sin(Phi) > 0 scales both atan2 arguments and is dropped.
+      // -atan2(-o1, o0) only differs from atan2(o1, o0) by a 2Pi that is wrapped away.
+      K phi1 = Atan2(o6, -o7);
+      K closePhi1 = Atan2(o1, o0);
+      // sin(Phi) is the length of (o2, o5), which needs no clamp the way acos(o8) does
+      K Phi = Atan2(std::sqrt(o2 * o2 + o5 * o5), o8);
+      K phi2 = WrapAngle(Atan2(o2, o5));
+      // Within thr of +-1 the sign of o8 tells Phi = 0 from Phi = Pi
+      K closePhi = (o8 < 0.0) ? static_cast<K>(SIMPLib::Constants::k_Pi) : static_cast<K>(0.0);
+      eu[i] = WrapAngle(close ? closePhi1 : phi1);
+      eu[k_BlockSize + i] = close ? closePhi : Phi;
+      eu[2 * k_BlockSize + i] = close ? static_cast<K>(0.0) : phi2;
+    }
+  }
+
+  /**
+   * @brief Quaternion to orientation matrix
+   * @param qu Block of quaternions
+   * @param om Block of orientation matrices in row major order
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void qu2om(const K* qu, K* om, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K x = qu[i];
+      K y = qu[k_BlockSize + i];
+      K z = qu[2 * k_BlockSize + i];
+      K w = qu[3 * k_BlockSize + i];
+      K qq = w * w - (x * x + y * y + z * z);
+      om[i] = qq + static_cast<K>(2.0) * x * x;
+      om[4 * k_BlockSize + i] = qq + static_cast<K>(2.0) * y * y;
+      om[8 * k_BlockSize + i] = qq + static_cast<K>(2.0) * z * z;
+      om[1 * k_BlockSize + i] = static_cast<K>(2.0) * (x * y - w * z);
+      om[5 * k_BlockSize + i] = static_cast<K>(2.0) * (y * z - w * x);
+      om[6 * k_BlockSize + i] = static_cast<K>(2.0) * (z * x - w * y);
+      om[3 * k_BlockSize + i] = static_cast<K>(2.0) * (y * x + w * z);
+      om[7 * k_BlockSize + i] = static_cast<K>(2.0) * (z * y + w * x);
+      om[2 * k_BlockSize + i] = static_cast<K>(2.0) * (x * z + w * y);
+    }
+  }
+
+  /**
+   * @brief Orientation matrix to quaternion. The component with the largest magnitude is
+   * taken from the diagonal and the other three from the off diagonal sums and differences,
+   * so no square root of a nearly cancelled value is taken for small or half turn rotations.
+   * @param om Block of orientation matrices in row major order
+   * @param qu Block of quaternions
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void om2qu(const K* om, K* qu, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K o[9];
+      for(size_t j = 0; j < 9; j++)
+      {
+        o[j] = om[j * k_BlockSize + i];
+      }
+      K tw = static_cast<K>(1.0) + o[0] + o[4] + o[8];
+      K tx = static_cast<K>(1.0) + o[0] - o[4] - o[8];
+      K ty = static_cast<K>(1.0) - o[0] + o[4] - o[8];
+      K tz = static_cast<K>(1.0) - o[0] - o[4] + o[8];
+      // The largest of the four, first one wins a tie
+      K txy = (tx >= ty) ? tx : ty;
+      K t = (txy >= tz) ? txy : tz;
+      t = (tw >= t) ? tw : t;
+      bool useW = (tw == t);
+      bool useX = !useW & (tx == t);
+      bool useY = !useW & !useX & (ty == t);
+      bool useZ = !useW & !useX & !useY;
+      K d = static_cast<K>(0.5) * std::sqrt(t);
+      K f = static_cast<K>(0.25) / d;
+      K wx = (o[7] - o[5]) * f;
+      K wy = (o[2] - o[6]) * f;
+      K wz = (o[3] - o[1]) * f;
+      K xy = (o[1] + o[3]) * f;
+      K xz = (o[2] + o[6]) * f;
+      K yz = (o[5] + o[7]) * f;
+      K w = useY ? wy : wz;
+      w = useX ? wx : w;
+      w = useW ? d : w;
+      K x = useY ? xy : xz;
+      x = useW ? wx : x;
+      x = useX ? d : x;
+      K y = useX ? xy : yz;
+      y = useW ? wy : y;
+      y = useY ? d : y;
+      K z = useX ? xz : yz;
+      z = useW ? wz : z;
+      z = useZ ? d : z;
+      // Normalized with a non negative scalar part like the scalar om2qu
+      K scale = static_cast<K>(1.0) / std::sqrt(w * w + x * x + y * y + z * z);
+      K negScale = -scale;
+      scale = (w < 0.0) ? negScale : scale;
+      qu[i] = x * scale;
+      qu[k_BlockSize + i] = y * scale;
+      qu[2 * k_BlockSize + i] = z * scale;
+      qu[3 * k_BlockSize + i] = w * scale;
+    }
+  }
+
+  /**
+   * @brief Quaternion to Rodrigues vector. tan(acos(w)) is evaluated as |(x, y, z)| / w,
+   * which keeps its precision for small rotations where 1 - w^2 cancels.
+   * @param qu Block of quaternions
+   * @param ro Block of Rodrigues vectors
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void qu2ro(const K* qu, K* ro, size_t count)
+  {
+    const K thr = static_cast<K>(1.0E-8);
+    const K inf = std::numeric_limits<K>::infinity();
+    for(size_t i = 0; i < count; i++)
+    {
+      K x = qu[i];
+      K y = qu[k_BlockSize + i];
+      K z = qu[2 * k_BlockSize + i];
+      K w = qu[3 * k_BlockSize + i];
+      K s = std::sqrt(x * x + y * y + z * z);
+      bool half = (w < thr);
+      bool identity = !half && (s < thr);
+      K invS = static_cast<K>(1.0) / (identity ? static_cast<K>(1.0) : s);
+      K scale = half ? static_cast<K>(1.0) : (identity ? static_cast<K>(0.0) : invS);
+      K tanW = s / (half ? static_cast<K>(1.0) : w);
+      ro[i] = x * scale;
+      ro[k_BlockSize + i] = y * scale;
+      ro[2 * k_BlockSize + i] = z * scale;
+      ro[3 * k_BlockSize + i] = half ? inf : (identity ? static_cast<K>(0.0) : tanW);
+    }
+  }
+
+  /**
+   * @brief Rodrigues vector to quaternion. cos(atan(t)) and sin(atan(t)) are evaluated
+   * as 1/sqrt(1 + t^2) and t/sqrt(1 + t^2), using 1/t for |t| > 1 so that large and
+   * infinite t need no special case.
+   * @param ro Block of Rodrigues vectors
+   * @param qu Block of quaternions
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void ro2qu(const K* ro, K* qu, size_t count)
+  {
+    const K inf = std::numeric_limits<K>::infinity();
+    for(size_t i = 0; i < count; i++)
+    {
+      K r0 = ro[i];
+      K r1 = ro[k_BlockSize + i];
+      K r2 = ro[2 * k_BlockSize + i];
+      K ta = ro[3 * k_BlockSize + i];
+      K len = std::sqrt(r0 * r0 + r1 * r1 + r2 * r2);
+      bool big = std::fabs(ta) > static_cast<K>(1.0);
+      K invT = static_cast<K>(1.0) / (big ? ta : static_cast<K>(1.0));
+      K u = big ? invT : ta;
+      K d = static_cast<K>(1.0) / std::sqrt(static_cast<K>(1.0) + u * u);
+      K ud = u * d;
+      K absUd = std::fabs(ud);
+      K negD = -d;
+      K c = big ? absUd : d;
+      K s = big ? ((ta < 0.0) ? negD : d) : ud;
+      // An infinite t keeps the axis as it is stored, like ro2ax
+      K invLen = static_cast<K>(1.0) / ((len > 0.0) ? len : static_cast<K>(1.0));
+      K scale = (ta == inf) ? static_cast<K>(1.0) : ((len > 0.0) ? invLen : static_cast<K>(0.0));
+      scale = scale * s;
+      scale = (ta == 0.0) ? static_cast<K>(0.0) : scale;
+      qu[i] = r0 * scale;
+      qu[k_BlockSize + i] = r1 * scale;
+      qu[2 * k_BlockSize + i] = r2 * scale;
+      qu[3 * k_BlockSize + i] = (ta == 0.0) ? static_cast<K>(1.0) : c;
+    }
+  }
+
+  /**
+   * @brief Quaternion to homochoric vector. omega is 2 atan2(|(x, y, z)|, w) instead of
+   * 2 acos(w) and (omega - sin(omega)) / omega^3 comes from its series for small angles,
+   * so small rotations do not lose their precision to cancellation. The cube root is a
+   * few Newton steps on a value between 0.15 and 1.
+   * @param qu Block of quaternions
+   * @param ho Block of homochoric vectors
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void qu2ho(const K* qu, K* ho, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K x = qu[i];
+      K y = qu[k_BlockSize + i];
+      K z = qu[2 * k_BlockSize + i];
+      K w = qu[3 * k_BlockSize + i];
+      K s = std::sqrt(x * x + y * y + z * z);
+      K omega = static_cast<K>(2.0) * Atan2(s, w);
+      K o2 = omega * omega;
+      K series = static_cast<K>(1.0 / 6.0) +
+                 o2 * (static_cast<K>(-1.0 / 120.0) +
+                       o2 * (static_cast<K>(1.0 / 5040.0) +
+                             o2 * (static_cast<K>(-1.0 / 362880.0) +
+                                   o2 * (static_cast<K>(1.0 / 39916800.0) +
+                                         o2 * (static_cast<K>(-1.0 / 6227020800.0) +
+                                               o2 * (static_cast<K>(1.0 / 1307674368000.0) + o2 * (static_cast<K>(-1.0 / 355687428096000.0) + o2 * static_cast<K>(1.0 / 121645100408832000.0))))))));
+      K sinO = 0.0, cosO = 0.0;
+      SinCos(omega, sinO, cosO);
+      bool small = omega < static_cast<K>(1.0);
+      K o3 = o2 * omega;
+      K ratio = (omega - sinO) / (small ? static_cast<K>(1.0) : o3);
+      K h = small ? series : ratio;
+      // f^(1/3) = omega * (0.75 * h)^(1/3) = 0.5 * omega * (6 * h)^(1/3)
+      K g = static_cast<K>(6.0) * h;
+      K root = static_cast<K>(0.6085) + static_cast<K>(0.3915) * g;
+      for(int n = 0; n < 6; n++)
+      {
+        root = root - (root * root * root - g) / (static_cast<K>(3.0) * root * root);
+      }
+      K scale = static_cast<K>(0.5) * omega * root / ((s > 0.0) ? s : static_cast<K>(1.0));
+      scale = (s > 0.0) ? scale : static_cast<K>(0.0);
+      ho[i] = x * scale;
+      ho[k_BlockSize + i] = y * scale;
+      ho[2 * k_BlockSize + i] = z * scale;
+    }
+  }
+
+  /**
+   * @brief Homochoric vector to quaternion. The fitted polynomial gives cos(omega/2)
+   * directly so no inverse trigonometric function is needed. 1 - cos(omega/2) is summed
+   * without the leading term so sin(omega/2) keeps its precision for small rotations.
+   * @param ho Block of homochoric vectors
+   * @param qu Block of quaternions
+   * @param count Number of tuples in the blocks, at most k_BlockSize
+   */
+  static void ho2qu(const K* ho, K* qu, size_t count)
+  {
+    for(size_t i = 0; i < count; i++)
+    {
+      K h0 = ho[i];
+      K h1 = ho[k_BlockSize + i];
+      K h2 = ho[2 * k_BlockSize + i];
+      K hmag = h0 * h0 + h1 * h1 + h2 * h2;
+      K p = static_cast<K>(LPs::tfit[15]);
+      for(int n = 14; n > 0; n--)
+      {
+        p = p * hmag + static_cast<K>(LPs::tfit[n]);
+      }
+      K oneMinusS = static_cast<K>(1.0 - LPs::tfit[0]) - hmag * p;
+      oneMinusS = std::min(std::max(oneMinusS, static_cast<K>(0.0)), static_cast<K>(2.0));
+      K s = static_cast<K>(1.0) - oneMinusS;
+      // ho2ax snaps omega to Pi when it is within 1.0E-8 of it
+      bool half = std::fabs(s) < static_cast<K>(0.5E-8);
+      s = half ? static_cast<K>(0.0) : s;
+      K sinHalf = std::sqrt(oneMinusS * (static_cast<K>(2.0) - oneMinusS));
+      sinHalf = half ? static_cast<K>(1.0) : sinHalf;
+      K scale = sinHalf / std::sqrt((hmag > 0.0) ? hmag : static_cast<K>(1.0));
+      scale = (hmag > 0.0) ? scale : static_cast<K>(0.0);
+      qu[i] = h0 * scale;
+      qu[k_BlockSize + i] = h1 * scale;
+      qu[2 * k_BlockSize + i] = h2 * scale;
+      qu[3 * k_BlockSize + i] = (hmag > 0.0) ? s : static_cast<K>(1.0);
+    }
+  }
+
+  /**
+   * @brief Sine and cosine of x for |x| < 2^30. x is reduced by multiples of Pi/2 with a
+   * three part Cody-Waite split and the Taylor series are evaluated on [-Pi/4, Pi/4].
+   */
+  static inline void SinCos(K x, K& s, K& c)
+  {
+    int32_t q = static_cast<int32_t>(x * static_cast<K>(2.0 / SIMPLib::Constants::k_Pi) + ((x < 0.0) ? static_cast<K>(-0.5) : static_cast<K>(0.5)));
+    K fq = static_cast<K>(q);
+    K r = ((x - fq * static_cast<K>(1.5703125)) - fq * static_cast<K>(4.837512969970703125E-4)) - fq * static_cast<K>(7.54978995489188216916E-8);
+    K z = r * r;
+    K sr = r * (static_cast<K>(1.0) +
+                z * (static_cast<K>(-1.0 / 6.0) +
+                     z * (static_cast<K>(1.0 / 120.0) +
+                          z * (static_cast<K>(-1.0 / 5040.0) +
+                               z * (static_cast<K>(1.0 / 362880.0) +
+                                    z * (static_cast<K>(-1.0 / 39916800.0) +
+                                         z * (static_cast<K>(1.0 / 6227020800.0) + z * (static_cast<K>(-1.0 / 1307674368000.0) + z * static_cast<K>(1.0 / 355687428096000.0)))))))));
+    K cr = static_cast<K>(1.0) +
+           z * (static_cast<K>(-0.5) +
+                z * (static_cast<K>(1.0 / 24.0) +
+                     z * (static_cast<K>(-1.0 / 720.0) +
+                          z * (static_cast<K>(1.0 / 40320.0) +
+                               z * (static_cast<K>(-1.0 / 3628800.0) +
+                                    z * (static_cast<K>(1.0 / 479001600.0) + z * (static_cast<K>(-1.0 / 87178291200.0) + z * static_cast<K>(1.0 / 20922789888000.0))))))));
+    bool swap = (q & 1) != 0;
+    K ss = swap ? cr : sr;
+    K cc = swap ? sr : cr;
+    s = ((q & 2) != 0) ? -ss : ss;
+    c = (((q + 1) & 2) != 0) ? -cc : cc;
+  }
+
+  /**
+   * @brief atan2(y, x) in [-Pi, Pi]. Returns 0 for (0, 0) and Pi for (+-0, x < 0).
+   */
+  static inline K Atan2(K y, K x)
+  {
+    K ax = std::fabs(x);
+    K ay = std::fabs(y);
+    K mx = std::max(ax, ay);
+    K mn = std::min(ax, ay);
+    K a = AtanUnit(mn / ((mx > 0.0) ? mx : static_cast<K>(1.0)));
+    K b = static_cast<K>(SIMPLib::Constants::k_PiOver2) - a;
+    a = (ay > ax) ? b : a;
+    b = static_cast<K>(SIMPLib::Constants::k_Pi) - a;
+    a = (x < 0.0) ? b : a;
+    b = -a;
+    return (y < 0.0) ? b : a;
+  }
+
+  /**
+   * @brief Maps an angle in [-Pi, Pi] to [0, 2Pi)
+   */
+  static inline K WrapAngle(K a)
+  {
+    K b = a + static_cast<K>(SIMPLib::Constants::k_2Pi);
+    return (a < 0.0) ? b : a;
+  }
+
+protected:
+  OrientationBatchTransforms() = default;
+
+  /**
+   * @brief atan(t) for t in [0, 1]. Three half angle steps bring t below tan(Pi/32)
+   * where nine terms of the series are enough for double precision.
+   */
+  static inline K AtanUnit(K t)
+  {
+    t = t / (static_cast<K>(1.0) + std::sqrt(static_cast<K>(1.0) + t * t));
+    t = t / (static_cast<K>(1.0) + std::sqrt(static_cast<K>(1.0) + t * t));
+    t = t / (static_cast<K>(1.0) + std::sqrt(static_cast<K>(1.0) + t * t));
+    K z = t * t;
+    K a = t * (static_cast<K>(1.0) +
+               z * (static_cast<K>(-1.0 / 3.0) +
+                    z * (static_cast<K>(1.0 / 5.0) +
+                         z * (static_cast<K>(-1.0 / 7.0) +
+                              z * (static_cast<K>(1.0 / 9.0) +
+                                   z * (static_cast<K>(-1.0 / 11.0) + z * (static_cast<K>(1.0 / 13.0) + z * (static_cast<K>(-1.0 / 15.0) + z * static_cast<K>(1.0 / 17.0)))))))));
+    return static_cast<K>(8.0) * a;
+  }
+
+private:
+  OrientationBatchTransforms(const OrientationBatchTransforms&) = delete; // Copy Constructor Not Implemented
+  void operator=(const OrientationBatchTransforms&) = delete;            // Move assignment Not Implemented
+};
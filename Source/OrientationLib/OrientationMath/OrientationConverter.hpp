@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 
 #include <QtCore/QVector>
@@ -332,9 +333,11 @@ OC_CONVERTOR_FUNCTOR(Cu2Ho, 3, 3, cu2ho)
 /**
  * @brief This templated class is a functor class that is used for 
  * the TBB classes to use to parallelize the conversion of orientation
- * representations
+ * representations. The input is sanity checked and the output zeroed in small
+ * blocks right before they are converted so both arrays are streamed through
+ * the cache once instead of once for each step.
  */
-template <typename T, class Converter>
+template <typename T, class Converter, class SanityCheck>
 class ConvertRepresentation
 {
   public:
@@ -353,13 +356,21 @@ class ConvertRepresentation
      */
     void convert(size_t start, size_t end) const
     {
+      static const size_t k_BlockSize = 1024;
       Converter conv;
+      SanityCheck check(m_InPtr, m_InStride);
       T* input = m_InPtr + (start * m_InStride);
       T* output = m_OutPtr + (start * m_OutStride);
-      for (size_t i = start; i < end; ++i) { 
-        conv(input, output);
-        input = input + m_InStride; /* Increment input pointer */ 
-        output = output + m_OutStride; /* Increment output pointer*/ 
+      for (size_t blockStart = start; blockStart < end; blockStart += k_BlockSize)
+      {
+        size_t blockEnd = std::min(blockStart + k_BlockSize, end);
+        check.sanityCheck(blockStart, blockEnd);
+        for (size_t i = blockStart; i < blockEnd; ++i) {
+          std::fill(output, output + m_OutStride, static_cast<T>(0));
+          conv(input, output);
+          input = input + m_InStride; /* Increment input pointer */
+          output = output + m_OutStride; /* Increment output pointer*/
+        }
       }
     } 
     
@@ -384,7 +395,6 @@ class ConvertRepresentation
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
-  sanityCheckInputData();\
   typename DataArray<T>::Pointer input = this->getInputData();\
   T* inPtr = input->getPointer(0);\
   size_t nTuples = this->getInputData()->getNumberOfTuples();\
@@ -392,17 +402,15 @@ class ConvertRepresentation
   size_t outStride = OUTSTRIDE;\
   QVector<size_t> cDims = {outStride};\
   typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */\
-  T* outPtr = output->getPointer(0);\
+  T* outPtr = output->getPointer(0); /* Sanity checking and zeroing happen inside the conversion */\
   tbb::task_scheduler_init init;\
   tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples),\
-  ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
+  ConvertRepresentation<T, Convertors::FUNCTOR<T>, SanityCheckType>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
   this->setOutputData(output);
 
 #else
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
-  sanityCheckInputData();\
   typename DataArray<T>::Pointer input = this->getInputData();\
   T* inPtr = input->getPointer(0);\
   size_t nTuples = this->getInputData()->getNumberOfTuples();\
@@ -410,9 +418,8 @@ class ConvertRepresentation
   size_t outStride = OUTSTRIDE;\
   QVector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/\
   typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
-  output->initializeWithZeros(); /* Intialize the array with Zeros */\
-  T* outPtr = output->getPointer(0);\
-  ConvertRepresentation<T, Convertors::FUNCTOR <T>> serial(inPtr, outPtr, inStride, outStride);\
+  T* outPtr = output->getPointer(0); /* Sanity checking and zeroing happen inside the conversion */\
+  ConvertRepresentation<T, Convertors::FUNCTOR <T>, SanityCheckType> serial(inPtr, outPtr, inStride, outStride);\
   serial.convert(0, nTuples);\
   this->setOutputData(output);
 
@@ -475,6 +482,8 @@ class EulerConverter : public OrientationConverter<T>
     SIMPL_CLASS_VERSION(1)
     
     SIMPL_STATIC_NEW_MACRO(EulerConverter<T> )
+
+    typedef EulerSanityCheck<T> SanityCheckType;
     
     virtual ~EulerConverter() {}
     
@@ -659,6 +668,8 @@ class OrientationMatrixConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(OrientationMatrixConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(OrientationMatrixConverter<T> )
+
+    typedef OrientationMatrixSanityCheck<T> SanityCheckType;
     
     virtual ~OrientationMatrixConverter() {}
     
@@ -667,7 +678,6 @@ class OrientationMatrixConverter : public OrientationConverter<T>
     
     virtual void toEulers()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(3, Eulers, om2eu, Om2Eu)
     }
     
@@ -681,31 +691,26 @@ class OrientationMatrixConverter : public OrientationConverter<T>
     
     virtual void toQuaternion()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(4, Quaternion, om2qu, Om2Qu)
     }
     
     virtual void toAxisAngle()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(4, AxisAngle, om2ax, Om2Ax)
     }
     
     virtual void toRodrigues()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(4, Rodrigues, om2ro, Om2Ro)
     }
     
     virtual void toHomochoric()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(3, Homochoric, om2ho, Om2Ho)
     }
     
     virtual void toCubochoric()
     {
-      sanityCheckInputData();
       OC_CONVERT_BODY(3, Cubochoric, om2cu, Om2Cu)
     }
     
@@ -826,6 +831,8 @@ class QuaternionConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(QuaternionConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(QuaternionConverter<T> )
+
+    typedef QuaternionSanityCheck<T> SanityCheckType;
     
     virtual ~QuaternionConverter() {}
     
@@ -988,6 +995,8 @@ class AxisAngleConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(AxisAngleConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(AxisAngleConverter<T> )
+
+    typedef AxisAngleSanityCheck<T> SanityCheckType;
     
     virtual ~AxisAngleConverter() {}
     
@@ -1151,6 +1160,8 @@ class RodriguesConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(RodriguesConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(RodriguesConverter<T> )
+
+    typedef RodriguesSanityCheck<T> SanityCheckType;
     
     
     virtual ~RodriguesConverter() {}
@@ -1317,6 +1328,8 @@ class HomochoricConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(HomochoricConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(HomochoricConverter<T> )
+
+    typedef HomochoricSanityCheck<T> SanityCheckType;
     
     
     virtual ~HomochoricConverter() {}
@@ -1484,6 +1497,8 @@ class CubochoricConverter : public OrientationConverter<T>
     SIMPL_TYPE_MACRO_SUPER(CubochoricConverter<T>, OrientationConverter<T>)
     SIMPL_CLASS_VERSION(1)
     SIMPL_STATIC_NEW_MACRO(CubochoricConverter<T> )
+
+    typedef CubochoricSanityCheck<T> SanityCheckType;
     
     
     virtual ~CubochoricConverter() {}
@@ -40,6 +40,8 @@ set(OrientationLib_OrientationMath_HDRS
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationTransforms.hpp
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationArray.hpp
   ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationConverter.hpp
+  ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationBatchTransforms.hpp
+  ${OrientationLib_SOURCE_DIR}/OrientationMath/OrientationBatchConverter.hpp
 )
 
 set(OrientationLib_OrientationMath_SRCS
@@ -0,0 +1,131 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+class LaueOpsTest
+{
+public:
+  LaueOpsTest()
+  {
+  }
+  virtual ~LaueOpsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::vector<QuatF> GenerateRandomQuats(size_t count, std::mt19937_64& generator)
+  {
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<QuatF> quats(count);
+    FOrientArrayType qu(4);
+    for(size_t i = 0; i < count; i++)
+    {
+      FOrientArrayType eu(distribution(generator) * SIMPLib::Constants::k_2Pi, acosf(2.0f * distribution(generator) - 1.0f), distribution(generator) * SIMPLib::Constants::k_2Pi);
+      FOrientTransformsType::eu2qu(eu, qu);
+      quats[i] = qu.toQuaternion();
+    }
+    return quats;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchMisorientation()
+  {
+    const size_t numPairs = 1000;
+    std::mt19937_64 generator(1234);
+    std::vector<QuatF> quats1 = GenerateRandomQuats(numPairs, generator);
+    std::vector<QuatF> quats2 = GenerateRandomQuats(numPairs, generator);
+
+    std::vector<LaueOps::Pointer> ops = LaueOps::getOrientationOpsVector();
+    for(size_t o = 0; o < ops.size(); o++)
+    {
+      std::vector<float> angles(numPairs, 0.0f);
+      std::vector<float> axes(3 * numPairs, 0.0f);
+      std::vector<float> anglesOnly(numPairs, 0.0f);
+      ops[o]->getMisoQuats(quats1.data(), quats2.data(), numPairs, angles.data(), axes.data());
+      ops[o]->getMisoQuats(quats1.data(), quats2.data(), numPairs, anglesOnly.data(), nullptr);
+
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+        QuatF q1 = quats1[i];
+        QuatF q2 = quats2[i];
+        float w = ops[o]->getMisoQuat(q1, q2, n1, n2, n3);
+
+        DREAM3D_REQUIRE(std::fabs(w - angles[i]) < 1.0E-3f)
+        DREAM3D_REQUIRE(std::fabs(w - anglesOnly[i]) < 1.0E-3f)
+        // Only compare axes away from ties between symmetry operators. Both kernels take the axis
+        // from the same winning product quaternion, so the axes must agree in sign as well
+        if(w > 0.01f)
+        {
+          float dot = n1 * axes[3 * i] + n2 * axes[3 * i + 1] + n3 * axes[3 * i + 2];
+          DREAM3D_REQUIRE(dot > 0.99f)
+        }
+
+        float tolerance = 5.0f * SIMPLib::Constants::k_PiOver180;
+        if(std::fabs(w - tolerance) > 1.0E-3f)
+        {
+          DREAM3D_REQUIRE_EQUAL(ops[o]->isMisoQuatBelow(q1, q2, tolerance), w < tolerance)
+        }
+        tolerance = w + 0.01f;
+        DREAM3D_REQUIRE_EQUAL(ops[o]->isMisoQuatBelow(q1, q2, tolerance), true)
+        tolerance = w - 0.01f;
+        DREAM3D_REQUIRE_EQUAL(ops[o]->isMisoQuatBelow(q1, q2, tolerance), false)
+      }
+    }
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestBatchMisorientation())
+  }
+
+private:
+  LaueOpsTest(const LaueOpsTest&);    // Copy Constructor Not Implemented
+  void operator=(const LaueOpsTest&); // Move assignment Not Implemented
+};
@@ -0,0 +1,398 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+
+class ModifiedLambertProjectionTest
+{
+public:
+  ModifiedLambertProjectionTest()
+  {
+  }
+  virtual ~ModifiedLambertProjectionTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  // The scalar square coordinate from before the batch form existed
+  // -----------------------------------------------------------------------------
+  bool ReferenceSquareCoord(float* xyz, float* sqCoord, float sphereRadius, float maxCoord)
+  {
+    bool nhCheck = false;
+    float adjust = 1.0;
+    if(xyz[2] >= 0.0)
+    {
+      adjust = -1.0;
+      nhCheck = true;
+    }
+    if(xyz[0] == 0 && xyz[1] == 0)
+    {
+      sqCoord[0] = 0.0;
+      sqCoord[1] = 0.0;
+      return nhCheck;
+    }
+    if(fabs(xyz[0]) >= fabs(xyz[1]))
+    {
+      sqCoord[0] = (xyz[0] / fabs(xyz[0])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * SIMPLib::Constants::k_HalfOfSqrtPi;
+      sqCoord[1] = (xyz[0] / fabs(xyz[0])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[1] / xyz[0]));
+    }
+    else
+    {
+      sqCoord[0] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[0] / xyz[1]));
+      sqCoord[1] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * sphereRadius * (sphereRadius + (xyz[2] * adjust))) * (SIMPLib::Constants::k_HalfOfSqrtPi);
+    }
+
+    if(sqCoord[0] >= maxCoord)
+    {
+      sqCoord[0] = (maxCoord)-.0001;
+    }
+    if(sqCoord[1] >= maxCoord)
+    {
+      sqCoord[1] = (maxCoord)-.0001;
+    }
+    return nhCheck;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The scalar square index from before the batch form existed
+  // -----------------------------------------------------------------------------
+  int ReferenceSquareIndex(float* sqCoord, int dimension, float stepSize, float maxCoord)
+  {
+    int x = (int)((sqCoord[0] + maxCoord) / stepSize);
+    if(x >= dimension)
+    {
+      x = dimension - 1;
+    }
+    if(x < 0)
+    {
+      x = 0;
+    }
+    int y = (int)((sqCoord[1] + maxCoord) / stepSize);
+    if(y >= dimension)
+    {
+      y = dimension - 1;
+    }
+    if(y < 0)
+    {
+      y = 0;
+    }
+    return y * dimension + x;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The scalar bin search of addInterpolatedValues from before the batch form existed.
+  // Each of the 4 weights is added to its bin on its own so that the corner bins, where
+  // two of the wrapped neighbors land on the same bin, receive both weights.
+  // -----------------------------------------------------------------------------
+  void ReferenceInterpolatedValues(float* sqCoord, double value, int dimension, float stepSize, std::vector<double>& square)
+  {
+    int abin1 = 0, bbin1 = 0;
+    int abin2 = 0, bbin2 = 0;
+    int abin3 = 0, bbin3 = 0;
+    int abin4 = 0, bbin4 = 0;
+    int abinSign, bbinSign;
+    float halfDimensionTimesStepSize = static_cast<float>(dimension) / 2.0 * stepSize;
+    float modX = (sqCoord[0] + halfDimensionTimesStepSize) / stepSize;
+    float modY = (sqCoord[1] + halfDimensionTimesStepSize) / stepSize;
+    int abin = (int)modX;
+    int bbin = (int)modY;
+    modX -= abin;
+    modY -= bbin;
+    modX -= 0.5;
+    modY -= 0.5;
+    if(modX == 0.0)
+    {
+      abinSign = 1;
+    }
+    else
+    {
+      abinSign = modX / fabs(modX);
+    }
+    if(modY == 0.0)
+    {
+      bbinSign = 1;
+    }
+    else
+    {
+      bbinSign = modY / fabs(modY);
+    }
+    abin1 = abin;
+    bbin1 = bbin;
+    abin2 = abin + abinSign;
+    bbin2 = bbin;
+    if(abin2 < 0 || abin2 > dimension - 1)
+    {
+      abin2 = abin2 - (abinSign * dimension), bbin2 = dimension - bbin2 - 1;
+    }
+    abin3 = abin;
+    bbin3 = bbin + bbinSign;
+    if(bbin3 < 0 || bbin3 > dimension - 1)
+    {
+      abin3 = dimension - abin3 - 1, bbin3 = bbin3 - (bbinSign * dimension);
+    }
+    abin4 = abin + abinSign;
+    bbin4 = bbin + bbinSign;
+    if((abin4 < 0 || abin4 > dimension - 1) && (bbin4 >= 0 && bbin4 <= dimension - 1))
+    {
+      abin4 = abin4 - (abinSign * dimension), bbin4 = dimension - bbin4 - 1;
+    }
+    else if((abin4 >= 0 && abin4 <= dimension - 1) && (bbin4 < 0 || bbin4 > dimension - 1))
+    {
+      abin4 = dimension - abin4 - 1, bbin4 = bbin4 - (bbinSign * dimension);
+    }
+    else if((abin4 < 0 || abin4 > dimension - 1) && (bbin4 < 0 || bbin4 > dimension - 1))
+    {
+      abin4 = abin4 - (abinSign * dimension), bbin4 = bbin4 - (bbinSign * dimension);
+    }
+    modX = fabs(modX);
+    modY = fabs(modY);
+
+    square[bbin1 * dimension + abin1] += value * (1.0 - modX) * (1.0 - modY);
+    square[bbin2 * dimension + abin2] += value * (modX) * (1.0 - modY);
+    square[bbin3 * dimension + abin3] += value * (1.0 - modX) * (modY);
+    square[bbin4 * dimension + abin4] += value * (modX) * (modY);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Unit vectors on the poles, on the equator along the square edges, on the |x| == |y|
+  // diagonals that map to the square corners and on random directions. There are more
+  // points than one block of the batch methods.
+  // -----------------------------------------------------------------------------
+  std::vector<float> GenerateCoords()
+  {
+    std::vector<float> xyz;
+    const float diag = 1.0f / std::sqrt(2.0f);
+    const float special[][3] = {{0.0f, 0.0f, 1.0f},   {0.0f, 0.0f, -1.0f},  {1.0f, 0.0f, 0.0f},  {-1.0f, 0.0f, 0.0f},   {0.0f, 1.0f, 0.0f},
+                                {0.0f, -1.0f, 0.0f},  {diag, diag, 0.0f},   {-diag, diag, 0.0f}, {diag, -diag, 0.0f},   {-diag, -diag, 0.0f},
+                                {0.5f, 0.5f, diag},   {-0.5f, 0.5f, -diag}, {0.5f, -0.5f, diag}, {-0.5f, -0.5f, -diag}, {0.6f, 0.0f, 0.8f},
+                                {0.0f, -0.6f, -0.8f}, {0.6f, 0.6f, 0.52915f}};
+    for(const auto& p : special)
+    {
+      xyz.insert(xyz.end(), p, p + 3);
+    }
+
+    std::mt19937_64 generator(4321);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < 1000; i++)
+    {
+      float v[3] = {distribution(generator), distribution(generator), distribution(generator)};
+      float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      // Every 10th point is pushed onto the equator and every 7th onto a diagonal
+      if(i % 10 == 0)
+      {
+        v[2] = 0.0f;
+        length = std::sqrt(v[0] * v[0] + v[1] * v[1]);
+      }
+      if(i % 7 == 0)
+      {
+        v[1] = std::copysign(v[0], v[1]);
+        length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      }
+      xyz.push_back(v[0] / length);
+      xyz.push_back(v[1] / length);
+      xyz.push_back(v[2] / length);
+    }
+    return xyz;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchSquareCoords()
+  {
+    std::vector<float> xyz = GenerateCoords();
+    size_t numCoords = xyz.size() / 3;
+    std::vector<float> x(numCoords), y(numCoords), z(numCoords);
+    for(size_t i = 0; i < numCoords; i++)
+    {
+      x[i] = xyz[3 * i];
+      y[i] = xyz[3 * i + 1];
+      z[i] = xyz[3 * i + 2];
+    }
+
+    const float radii[2] = {1.0f, 2.5f};
+    for(float radius : radii)
+    {
+      ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+      lambert->initializeSquares(36, radius);
+      float maxCoord = std::sqrt(4 * M_PI * radius * radius / 2.0) / 2.0;
+
+      std::vector<float> sqX(numCoords), sqY(numCoords);
+      std::vector<uint8_t> north(numCoords);
+      lambert->getSquareCoords(x.data(), y.data(), z.data(), numCoords, sqX.data(), sqY.data(), north.data());
+
+      for(size_t i = 0; i < numCoords; i++)
+      {
+        float point[3] = {x[i], y[i], z[i]};
+        float refCoord[2] = {0.0f, 0.0f};
+        bool refNorth = ReferenceSquareCoord(point, refCoord, radius, maxCoord);
+
+        DREAM3D_REQUIRE_EQUAL(north[i] != 0, refNorth)
+        DREAM3D_REQUIRE(std::fabs(sqX[i] - refCoord[0]) < 1.0E-6f)
+        DREAM3D_REQUIRE(std::fabs(sqY[i] - refCoord[1]) < 1.0E-6f)
+        DREAM3D_REQUIRE(sqX[i] < maxCoord && sqY[i] < maxCoord)
+
+        float sqCoord[2] = {0.0f, 0.0f};
+        DREAM3D_REQUIRE_EQUAL(lambert->getSquareCoord(point, sqCoord), refNorth)
+        DREAM3D_REQUIRE_EQUAL(sqCoord[0], sqX[i])
+        DREAM3D_REQUIRE_EQUAL(sqCoord[1], sqY[i])
+      }
+
+      // The poles map to the center of the square and the diagonals to the corners
+      DREAM3D_REQUIRE_EQUAL(sqX[0], 0.0f)
+      DREAM3D_REQUIRE_EQUAL(sqY[0], 0.0f)
+      DREAM3D_REQUIRE_EQUAL(north[0], 1)
+      DREAM3D_REQUIRE_EQUAL(north[1], 0)
+      DREAM3D_REQUIRE(std::fabs(std::fabs(sqX[6]) - maxCoord) < 1.0E-3f && std::fabs(std::fabs(sqY[6]) - maxCoord) < 1.0E-3f)
+      DREAM3D_REQUIRE(std::fabs(std::fabs(sqX[9]) - maxCoord) < 1.0E-3f && std::fabs(std::fabs(sqY[9]) - maxCoord) < 1.0E-3f)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchSquareIndices()
+  {
+    std::vector<float> xyz = GenerateCoords();
+    size_t numCoords = xyz.size() / 3;
+    std::vector<float> x(numCoords), y(numCoords), z(numCoords);
+    for(size_t i = 0; i < numCoords; i++)
+    {
+      x[i] = xyz[3 * i];
+      y[i] = xyz[3 * i + 1];
+      z[i] = xyz[3 * i + 2];
+    }
+
+    const int dimensions[3] = {2, 33, 72};
+    for(int dimension : dimensions)
+    {
+      ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+      lambert->initializeSquares(dimension, 1.0f);
+      float maxCoord = std::sqrt(4 * M_PI / 2.0) / 2.0;
+      float stepSize = std::sqrt(4 * M_PI / 2.0) / static_cast<float>(dimension);
+
+      std::vector<float> sqX(numCoords), sqY(numCoords);
+      std::vector<uint8_t> north(numCoords);
+      lambert->getSquareCoords(x.data(), y.data(), z.data(), numCoords, sqX.data(), sqY.data(), north.data());
+
+      // Points past every edge of the square must clamp onto the edge bins
+      const float outside[][2] = {{-2.0f * maxCoord, 0.0f}, {2.0f * maxCoord, 0.0f}, {0.0f, -2.0f * maxCoord}, {0.0f, 2.0f * maxCoord},
+                                  {maxCoord, maxCoord},     {-maxCoord, -maxCoord}, {-maxCoord, maxCoord},   {maxCoord, -maxCoord}};
+      for(const auto& p : outside)
+      {
+        sqX.push_back(p[0]);
+        sqY.push_back(p[1]);
+      }
+
+      std::vector<int> indices(sqX.size(), -1);
+      lambert->getSquareIndices(sqX.data(), sqY.data(), sqX.size(), indices.data());
+      for(size_t i = 0; i < sqX.size(); i++)
+      {
+        float sqCoord[2] = {sqX[i], sqY[i]};
+        int refIndex = ReferenceSquareIndex(sqCoord, dimension, stepSize, maxCoord);
+        DREAM3D_REQUIRE_EQUAL(indices[i], refIndex)
+        DREAM3D_REQUIRE_EQUAL(lambert->getSquareIndex(sqCoord), refIndex)
+        DREAM3D_REQUIRE(indices[i] >= 0 && indices[i] < dimension * dimension)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchInterpolatedValues()
+  {
+    std::vector<float> xyz = GenerateCoords();
+    size_t numCoords = xyz.size() / 3;
+
+    const int dimensions[3] = {2, 33, 72};
+    for(int dimension : dimensions)
+    {
+      float maxCoord = std::sqrt(4 * M_PI / 2.0) / 2.0;
+      float stepSize = std::sqrt(4 * M_PI / 2.0) / static_cast<float>(dimension);
+      std::vector<double> refNorth(dimension * dimension, 0.0);
+      std::vector<double> refSouth(dimension * dimension, 0.0);
+      for(size_t i = 0; i < numCoords; i++)
+      {
+        float sqCoord[2] = {0.0f, 0.0f};
+        bool nhCheck = ReferenceSquareCoord(xyz.data() + 3 * i, sqCoord, 1.0f, maxCoord);
+        ReferenceInterpolatedValues(sqCoord, 1.0, dimension, stepSize, nhCheck ? refNorth : refSouth);
+      }
+
+      // addCoords() goes through the batch square coordinates and the batch bin search
+      ModifiedLambertProjection::Pointer batch = ModifiedLambertProjection::New();
+      batch->initializeSquares(dimension, 1.0f);
+      batch->addCoords(xyz.data(), numCoords, 1.0);
+
+      // The scalar methods add one point at a time
+      ModifiedLambertProjection::Pointer scalar = ModifiedLambertProjection::New();
+      scalar->initializeSquares(dimension, 1.0f);
+      for(size_t i = 0; i < numCoords; i++)
+      {
+        float sqCoord[2] = {0.0f, 0.0f};
+        bool nhCheck = scalar->getSquareCoord(xyz.data() + 3 * i, sqCoord);
+        scalar->addInterpolatedValues(nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+      }
+
+      for(int i = 0; i < dimension * dimension; i++)
+      {
+        DREAM3D_REQUIRE(std::fabs(batch->getValue(ModifiedLambertProjection::NorthSquare, i) - refNorth[i]) < 1.0E-9)
+        DREAM3D_REQUIRE(std::fabs(batch->getValue(ModifiedLambertProjection::SouthSquare, i) - refSouth[i]) < 1.0E-9)
+        DREAM3D_REQUIRE_EQUAL(batch->getValue(ModifiedLambertProjection::NorthSquare, i), scalar->getValue(ModifiedLambertProjection::NorthSquare, i))
+        DREAM3D_REQUIRE_EQUAL(batch->getValue(ModifiedLambertProjection::SouthSquare, i), scalar->getValue(ModifiedLambertProjection::SouthSquare, i))
+      }
+    }
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestBatchSquareCoords())
+    DREAM3D_REGISTER_TEST(TestBatchSquareIndices())
+    DREAM3D_REGISTER_TEST(TestBatchInterpolatedValues())
+  }
+
+private:
+  ModifiedLambertProjectionTest(const ModifiedLambertProjectionTest&); // Copy Constructor Not Implemented
+  void operator=(const ModifiedLambertProjectionTest&);                // Move assignment Not Implemented
+};
@@ -0,0 +1,452 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLibTestFileLocations.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchConverter.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+class OrientationBatchTransformsTest
+{
+public:
+  typedef OrientationArray<double> DOrientArrayType;
+  typedef OrientationTransforms<DOrientArrayType, double> DOrientTransformsType;
+  typedef OrientationConverter<double>::OrientationType OrientationType;
+  typedef void (*ScalarTransform)(const DOrientArrayType&, DOrientArrayType&);
+
+  OrientationBatchTransformsTest()
+  {
+  }
+  virtual ~OrientationBatchTransformsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  // Random Euler angles plus the Phi = 0 and Phi = Pi degeneracies and angles that
+  // sit right next to the ends of their ranges
+  // -----------------------------------------------------------------------------
+  std::vector<double> GenerateEulers()
+  {
+    const double pi = SIMPLib::Constants::k_Pi;
+    std::vector<double> eulers = {0.0,      0.0,      0.0,        1.2,        0.0,  0.4,    0.3,          pi,     2.1,  pi,     0.5 * pi, pi,
+                                  2.5,      1.0E-9,   1.0,        2.0 * pi - 1.0E-9, 1.0E-7, 1.0E-9, 0.1, pi - 1.0E-9, 5.0,  4.0,    0.75,     6.2,
+                                  1.0E-4,   1.0E-2,   1.0E-4};
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * pi);
+    std::uniform_real_distribution<double> polar(-1.0, 1.0);
+    for(int i = 0; i < 3000; i++)
+    {
+      eulers.push_back(angle(generator));
+      eulers.push_back(std::acos(polar(generator)));
+      eulers.push_back(angle(generator));
+    }
+    return eulers;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs a scalar transform from OrientationTransforms over every tuple
+  // -----------------------------------------------------------------------------
+  std::vector<double> RunScalar(ScalarTransform transform, const std::vector<double>& input, size_t inComps, size_t outComps)
+  {
+    size_t numTuples = input.size() / inComps;
+    std::vector<double> output(numTuples * outComps, 0.0);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      DOrientArrayType in(const_cast<double*>(input.data()) + i * inComps, inComps);
+      DOrientArrayType out(output.data() + i * outComps, outComps);
+      transform(in, out);
+    }
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs a batch kernel over every tuple, one structure of arrays block at a time. The
+  // input is rounded to T on the way in so the float kernels are compared with the
+  // conversion of the unrounded values.
+  // -----------------------------------------------------------------------------
+  template <typename T> std::vector<double> RunKernel(void (*kernel)(const T*, T*, size_t), const std::vector<double>& input, size_t inComps, size_t outComps)
+  {
+    const size_t blockSize = OrientationBatchTransforms<T>::k_BlockSize;
+    size_t numTuples = input.size() / inComps;
+    std::vector<T> inBlock(inComps * blockSize, static_cast<T>(0.0));
+    std::vector<T> outBlock(outComps * blockSize, static_cast<T>(0.0));
+    std::vector<double> output(numTuples * outComps, 0.0);
+    for(size_t start = 0; start < numTuples; start += blockSize)
+    {
+      size_t count = std::min(blockSize, numTuples - start);
+      for(size_t i = 0; i < count; i++)
+      {
+        for(size_t c = 0; c < inComps; c++)
+        {
+          inBlock[c * blockSize + i] = static_cast<T>(input[(start + i) * inComps + c]);
+        }
+      }
+      kernel(inBlock.data(), outBlock.data(), count);
+      for(size_t i = 0; i < count; i++)
+      {
+        for(size_t c = 0; c < outComps; c++)
+        {
+          output[(start + i) * outComps + c] = static_cast<double>(outBlock[c * blockSize + i]);
+        }
+      }
+    }
+    return output;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rounds the values to the precision the kernel works in so the reference sees the same input
+  // -----------------------------------------------------------------------------
+  template <typename T> std::vector<double> RoundTo(const std::vector<double>& values)
+  {
+    std::vector<double> rounded(values.size(), 0.0);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      rounded[i] = static_cast<double>(static_cast<T>(values[i]));
+    }
+    return rounded;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Component wise comparison, relative for values larger than one
+  // -----------------------------------------------------------------------------
+  void CompareComponents(const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    DREAM3D_REQUIRE_EQUAL(batch.size(), reference.size())
+    for(size_t i = 0; i < reference.size(); i++)
+    {
+      if(std::isinf(reference[i]))
+      {
+        DREAM3D_REQUIRE_EQUAL(batch[i], reference[i])
+      }
+      else
+      {
+        DREAM3D_REQUIRE(std::fabs(batch[i] - reference[i]) <= tolerance * std::max(1.0, std::fabs(reference[i])))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // q and -q are the same rotation
+  // -----------------------------------------------------------------------------
+  void CompareQuaternions(const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    DREAM3D_REQUIRE_EQUAL(batch.size(), reference.size())
+    for(size_t i = 0; i < reference.size(); i += 4)
+    {
+      double same = 0.0;
+      double opposite = 0.0;
+      for(size_t c = 0; c < 4; c++)
+      {
+        same = std::max(same, std::fabs(batch[i + c] - reference[i + c]));
+        opposite = std::max(opposite, std::fabs(batch[i + c] + reference[i + c]));
+      }
+      DREAM3D_REQUIRE(std::min(same, opposite) <= tolerance)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Euler angles are not unique at the degeneracies so compare the rotations they describe
+  // -----------------------------------------------------------------------------
+  void CompareEulers(const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    ScalarTransform eu2om = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2om(in, out); };
+    CompareComponents(RunScalar(eu2om, batch, 3, 9), RunScalar(eu2om, reference, 3, 9), tolerance);
+  }
+
+  // -----------------------------------------------------------------------------
+  // tan(omega/2) grows without bound near Pi and the axis is arbitrary near the identity
+  // so the Rodrigues vectors are compared as the quaternions they describe
+  // -----------------------------------------------------------------------------
+  void CompareRodrigues(const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    DREAM3D_REQUIRE_EQUAL(batch.size(), reference.size())
+    std::vector<double> batchQuats(batch.size(), 0.0);
+    std::vector<double> referenceQuats(reference.size(), 0.0);
+    for(size_t i = 0; i < reference.size(); i += 4)
+    {
+      double batchAngle = std::atan(batch[i + 3]);
+      double referenceAngle = std::atan(reference[i + 3]);
+      for(size_t c = 0; c < 3; c++)
+      {
+        batchQuats[i + c] = batch[i + c] * std::sin(batchAngle);
+        referenceQuats[i + c] = reference[i + c] * std::sin(referenceAngle);
+      }
+      batchQuats[i + 3] = std::cos(batchAngle);
+      referenceQuats[i + 3] = std::cos(referenceAngle);
+    }
+    CompareQuaternions(batchQuats, referenceQuats, tolerance);
+  }
+
+  // -----------------------------------------------------------------------------
+  // h and -h are the same rotation when omega is Pi
+  // -----------------------------------------------------------------------------
+  void CompareHomochoric(const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    DREAM3D_REQUIRE_EQUAL(batch.size(), reference.size())
+    const double halfTurn = std::pow(0.75 * SIMPLib::Constants::k_Pi, 1.0 / 3.0);
+    for(size_t i = 0; i < reference.size(); i += 3)
+    {
+      double same = 0.0;
+      double opposite = 0.0;
+      double magnitude = 0.0;
+      for(size_t c = 0; c < 3; c++)
+      {
+        same = std::max(same, std::fabs(batch[i + c] - reference[i + c]));
+        opposite = std::max(opposite, std::fabs(batch[i + c] + reference[i + c]));
+        magnitude += reference[i + c] * reference[i + c];
+      }
+      DREAM3D_REQUIRE(same <= tolerance || (opposite <= tolerance && std::fabs(std::sqrt(magnitude) - halfTurn) <= tolerance))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareRepresentations(OrientationType type, const std::vector<double>& batch, const std::vector<double>& reference, double tolerance)
+  {
+    switch(type)
+    {
+    case OrientationConverter<double>::Euler:
+      CompareEulers(batch, reference, tolerance);
+      break;
+    case OrientationConverter<double>::Quaternion:
+      CompareQuaternions(batch, reference, tolerance);
+      break;
+    case OrientationConverter<double>::Rodrigues:
+      CompareRodrigues(batch, reference, tolerance);
+      break;
+    case OrientationConverter<double>::Homochoric:
+      CompareHomochoric(batch, reference, tolerance);
+      break;
+    default:
+      CompareComponents(batch, reference, tolerance);
+      break;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  ScalarTransform FromEuler(OrientationType type)
+  {
+    switch(type)
+    {
+    case OrientationConverter<double>::OrientationMatrix:
+      return [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2om(in, out); };
+    case OrientationConverter<double>::Quaternion:
+      return [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2qu(in, out); };
+    case OrientationConverter<double>::Rodrigues:
+      return [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2ro(in, out); };
+    case OrientationConverter<double>::Homochoric:
+      return [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2ho(in, out); };
+    default:
+      return [](const DOrientArrayType& in, DOrientArrayType& out) { out = in; };
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestEulerKernels(double tolerance)
+  {
+    typedef OrientationBatchTransforms<T> BatchType;
+    std::vector<double> eu = GenerateEulers();
+
+    ScalarTransform eu2qu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2qu(in, out); };
+    CompareQuaternions(RunKernel<T>(BatchType::eu2qu, eu, 3, 4), RunScalar(eu2qu, eu, 3, 4), tolerance);
+
+    ScalarTransform eu2om = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2om(in, out); };
+    CompareComponents(RunKernel<T>(BatchType::eu2om, eu, 3, 9), RunScalar(eu2om, eu, 3, 9), tolerance);
+
+    std::vector<double> qu = RunScalar(eu2qu, eu, 3, 4);
+    ScalarTransform qu2eu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::qu2eu(in, out); };
+    CompareEulers(RunKernel<T>(BatchType::qu2eu, qu, 4, 3), RunScalar(qu2eu, qu, 4, 3), tolerance);
+
+    std::vector<double> om = RunScalar(eu2om, eu, 3, 9);
+    ScalarTransform om2eu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::om2eu(in, out); };
+    CompareEulers(RunKernel<T>(BatchType::om2eu, om, 9, 3), RunScalar(om2eu, om, 9, 3), tolerance);
+
+    ScalarTransform qu2om = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::qu2om(in, out); };
+    CompareComponents(RunKernel<T>(BatchType::qu2om, qu, 4, 9), RunScalar(qu2om, qu, 4, 9), tolerance);
+
+    // The scalar om2qu takes the square root of every diagonal combination, which costs
+    // it about half of its digits for small rotations
+    ScalarTransform om2qu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::om2qu(in, out); };
+    CompareQuaternions(RunKernel<T>(BatchType::om2qu, om, 9, 4), RunScalar(om2qu, om, 9, 4), std::max(tolerance, 1.0E-7));
+  }
+
+  // -----------------------------------------------------------------------------
+  // The scalar qu2ho does its last steps in float, which limits the homochoric tolerance
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestQuaternionKernels(double tolerance, double homochoricTolerance)
+  {
+    typedef OrientationBatchTransforms<T> BatchType;
+    ScalarTransform eu2qu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::eu2qu(in, out); };
+    std::vector<double> qu = RunScalar(eu2qu, GenerateEulers(), 3, 4);
+
+    ScalarTransform qu2ro = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::qu2ro(in, out); };
+    CompareRodrigues(RunKernel<T>(BatchType::qu2ro, qu, 4, 4), RunScalar(qu2ro, qu, 4, 4), tolerance);
+
+    std::vector<double> ro = RunScalar(qu2ro, qu, 4, 4);
+    ScalarTransform ro2qu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::ro2qu(in, out); };
+    CompareQuaternions(RunKernel<T>(BatchType::ro2qu, ro, 4, 4), RunScalar(ro2qu, ro, 4, 4), tolerance);
+
+    ScalarTransform qu2ho = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::qu2ho(in, out); };
+    CompareComponents(RunKernel<T>(BatchType::qu2ho, qu, 4, 3), RunScalar(qu2ho, qu, 4, 3), homochoricTolerance);
+
+    std::vector<double> ho = RunScalar(qu2ho, qu, 4, 3);
+    ScalarTransform ho2qu = [](const DOrientArrayType& in, DOrientArrayType& out) { DOrientTransformsType::ho2qu(in, out); };
+    CompareQuaternions(RunKernel<T>(BatchType::ho2qu, ho, 3, 4), RunScalar(ho2qu, ho, 3, 4), tolerance);
+
+    // The special cases of the scalar transforms
+    std::vector<double> special = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 0.6, 0.0, 0.8, 0.0, 1.0, 0.0, 0.0, 1.0E-9};
+    CompareRodrigues(RunKernel<T>(BatchType::qu2ro, special, 4, 4), RunScalar(qu2ro, special, 4, 4), tolerance);
+    std::vector<double> infinite = {0.0, 0.0, 1.0, std::numeric_limits<double>::infinity(), 0.0, 0.0, 0.0, 0.0, 0.6, 0.8, 0.0, 1.0E12};
+    CompareQuaternions(RunKernel<T>(BatchType::ro2qu, infinite, 4, 4), RunScalar(ro2qu, infinite, 4, 4), tolerance);
+    std::vector<double> zero = {0.0, 0.0, 0.0};
+    CompareQuaternions(RunKernel<T>(BatchType::ho2qu, zero, 3, 4), RunScalar(ho2qu, zero, 3, 4), tolerance);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every supported pair goes through the fused chains, with a tuple count that leaves
+  // a partial last block, and is compared with the double precision OrientationConverter
+  // classes. The float scalar converters lose up to 5.0E-4 to the thresholds in om2qu
+  // so they are no reference for the float chains.
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestBatchConverter(double tolerance)
+  {
+    QVector<typename OrientationConverter<T>::OrientationType> types = OrientationConverter<T>::GetOrientationTypes();
+    QVector<OrientationType> dTypes = OrientationConverter<double>::GetOrientationTypes();
+    QVector<int> counts = OrientationConverter<double>::GetComponentCounts();
+
+    QVector<OrientationConverter<double>::Pointer> converters(7);
+    converters[0] = EulerConverter<double>::New();
+    converters[1] = OrientationMatrixConverter<double>::New();
+    converters[2] = QuaternionConverter<double>::New();
+    converters[3] = AxisAngleConverter<double>::New();
+    converters[4] = RodriguesConverter<double>::New();
+    converters[5] = HomochoricConverter<double>::New();
+    converters[6] = CubochoricConverter<double>::New();
+
+    std::vector<double> eu = GenerateEulers();
+    for(int inIndex = 0; inIndex < types.size(); inIndex++)
+    {
+      for(int outIndex = 0; outIndex < types.size(); outIndex++)
+      {
+        bool supported = OrientationBatchConverter<T>::IsSupported(types[inIndex], types[outIndex]);
+        bool batchTypes = dTypes[inIndex] != OrientationConverter<double>::AxisAngle && dTypes[inIndex] != OrientationConverter<double>::Cubochoric &&
+                          dTypes[outIndex] != OrientationConverter<double>::AxisAngle && dTypes[outIndex] != OrientationConverter<double>::Cubochoric;
+        DREAM3D_REQUIRE_EQUAL(supported, batchTypes && inIndex != outIndex)
+        if(!supported)
+        {
+          continue;
+        }
+
+        size_t inComps = static_cast<size_t>(counts[inIndex]);
+        size_t outComps = static_cast<size_t>(counts[outIndex]);
+        std::vector<double> input = RoundTo<T>(RunScalar(FromEuler(dTypes[inIndex]), eu, 3, inComps));
+        size_t numTuples = input.size() / inComps;
+
+        DoubleArrayType::Pointer scalarInput = DoubleArrayType::CreateArray(numTuples, QVector<size_t>(1, inComps), "Input");
+        std::copy(input.begin(), input.end(), scalarInput->getPointer(0));
+        converters[inIndex]->setInputData(scalarInput);
+        converters[inIndex]->convertRepresentationTo(dTypes[outIndex]);
+        DoubleArrayType::Pointer scalarOutput = converters[inIndex]->getOutputData();
+        DREAM3D_REQUIRE_VALID_POINTER(scalarOutput.get())
+
+        std::vector<T> batchInput(input.begin(), input.end());
+        std::vector<T> batchOutput(numTuples * outComps, static_cast<T>(-100.0));
+        OrientationBatchConverter<T>::Convert(batchInput.data(), batchOutput.data(), numTuples, types[inIndex], types[outIndex]);
+
+        // Both sanity check their input in place
+        for(size_t i = 0; i < input.size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(batchInput[i], static_cast<T>(scalarInput->getValue(i)))
+        }
+        std::vector<double> output(batchOutput.begin(), batchOutput.end());
+        std::vector<double> reference(scalarOutput->getPointer(0), scalarOutput->getPointer(0) + numTuples * outComps);
+        // A quaternion component near zero comes from the square root of a near zero sum
+        // of matrix elements, so it is only known to about the root of their rounding
+        double pairTolerance = tolerance;
+        if(dTypes[inIndex] == OrientationConverter<double>::OrientationMatrix)
+        {
+          pairTolerance = std::max(tolerance, std::sqrt(static_cast<double>(std::numeric_limits<T>::epsilon())));
+        }
+        CompareRepresentations(dTypes[outIndex], output, reference, pairTolerance);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchTransforms()
+  {
+    TestEulerKernels<double>(1.0E-9);
+    TestEulerKernels<float>(2.0E-6);
+    TestQuaternionKernels<double>(1.0E-9, 1.0E-6);
+    TestQuaternionKernels<float>(2.0E-6, 2.0E-6);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBatchConverters()
+  {
+    TestBatchConverter<double>(1.0E-6);
+    TestBatchConverter<float>(1.0E-5);
+  }
+
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestBatchTransforms())
+    DREAM3D_REGISTER_TEST(TestBatchConverters())
+  }
+
+private:
+  OrientationBatchTransformsTest(const OrientationBatchTransformsTest&); // Copy Constructor Not Implemented
+  void operator=(const OrientationBatchTransformsTest&);                 // Move assignment Not Implemented
+};
@@ -0,0 +1,212 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The AliasTable class draws bin indices from a discrete distribution such as an ODF, MDF or
+ * axis ODF in constant time using Walker's alias method (with Vose's construction). The table is built
+ * once in O(bins) and each draw then needs a single uniform random number and one table lookup instead
+ * of a scan through the cumulative distribution.
+ *
+ * Draws follow the same distribution as the cumulative scan this class replaces, which walks the bins
+ * in order until the running sum passes the random number and returns bin 0 if it never does. Weights
+ * that sum to less than 1 therefore give the missing weight to bin 0, and weight past a running sum of 1
+ * is never drawn. Callers can detect either case with isNormalized(). Negative, non-finite or all zero
+ * weights are rejected: build() returns false and the table is left empty.
+ */
+class AliasTable
+{
+public:
+  AliasTable() = default;
+
+  template <typename T> AliasTable(const T* weights, size_t count)
+  {
+    build(weights, count);
+  }
+
+  virtual ~AliasTable() = default;
+
+  /**
+   * @brief build Builds the table from the given bin weights
+   * @param weights Weight of each bin
+   * @param count Number of bins
+   * @return false if a weight is negative or not finite or every weight is zero
+   */
+  template <typename T> bool build(const T* weights, size_t count)
+  {
+    m_Probability.clear();
+    m_Alias.clear();
+    m_WeightSum = 0.0;
+
+    double sum = 0.0;
+    for(size_t i = 0; i < count; i++)
+    {
+      double weight = static_cast<double>(weights[i]);
+      if(!std::isfinite(weight) || weight < 0.0)
+      {
+        return false;
+      }
+      sum += weight;
+    }
+    if(sum <= 0.0)
+    {
+      return false;
+    }
+    m_WeightSum = sum;
+
+    // Turn the weights into the probability of each bin under the cumulative scan. The scale makes
+    // the average bin hold exactly 1.
+    m_Probability.assign(count, 0.0);
+    m_Alias.assign(count, 0);
+    double scale = static_cast<double>(count);
+    double cumulative = 0.0;
+    for(size_t i = 0; i < count; i++)
+    {
+      double lower = std::fmin(cumulative, 1.0);
+      cumulative += static_cast<double>(weights[i]);
+      m_Probability[i] = (std::fmin(cumulative, 1.0) - lower) * scale;
+    }
+    if(cumulative < 1.0)
+    {
+      m_Probability[0] += (1.0 - cumulative) * scale;
+    }
+
+    // Pair each under-full bin with an over-full one
+    std::vector<size_t> small;
+    std::vector<size_t> large;
+    for(size_t i = 0; i < count; i++)
+    {
+      if(m_Probability[i] < 1.0)
+      {
+        small.push_back(i);
+      }
+      else
+      {
+        large.push_back(i);
+      }
+    }
+
+    while(!small.empty() && !large.empty())
+    {
+      size_t s = small.back();
+      small.pop_back();
+      size_t l = large.back();
+      m_Alias[s] = static_cast<uint32_t>(l);
+      m_Probability[l] = (m_Probability[l] + m_Probability[s]) - 1.0;
+      if(m_Probability[l] < 1.0)
+      {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Whatever is left over is full up to round off
+    for(size_t i = 0; i < large.size(); i++)
+    {
+      m_Probability[large[i]] = 1.0;
+    }
+    for(size_t i = 0; i < small.size(); i++)
+    {
+      m_Probability[small[i]] = 1.0;
+    }
+    return true;
+  }
+
+  /**
+   * @brief sample Maps a uniform random number to a bin
+   * @param random Uniform random number in [0, 1)
+   * @return Bin index
+   */
+  size_t sample(double random) const
+  {
+    if(m_Probability.empty())
+    {
+      return 0;
+    }
+    // The integer part of the scaled random number picks the column and the fractional part
+    // decides between the column and its alias
+    double scaled = random * static_cast<double>(m_Probability.size());
+    size_t bin = static_cast<size_t>(scaled);
+    if(bin >= m_Probability.size())
+    {
+      bin = m_Probability.size() - 1;
+    }
+    return (scaled - static_cast<double>(bin)) < m_Probability[bin] ? bin : m_Alias[bin];
+  }
+
+  /**
+   * @brief size Returns the number of bins in the table
+   */
+  size_t size() const
+  {
+    return m_Probability.size();
+  }
+
+  /**
+   * @brief isValid Returns whether the last build() accepted its weights
+   */
+  bool isValid() const
+  {
+    return !m_Probability.empty();
+  }
+
+  /**
+   * @brief getWeightSum Returns the sum of the weights the table was built from
+   */
+  double getWeightSum() const
+  {
+    return m_WeightSum;
+  }
+
+  /**
+   * @brief isNormalized Returns whether the weights sum to 1 within the given tolerance
+   * @param tolerance Allowed difference from 1
+   */
+  bool isNormalized(double tolerance = 1.0e-3) const
+  {
+    return std::fabs(m_WeightSum - 1.0) <= tolerance;
+  }
+
+private:
+  std::vector<double> m_Probability;
+  std::vector<uint32_t> m_Alias;
+  double m_WeightSum = 0.0;
+};
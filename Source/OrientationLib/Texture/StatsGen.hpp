@@ -45,6 +45,7 @@
 #include "SIMPLib/SIMPLib.h"
 
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Texture/AliasTable.hpp"
 #include "OrientationLib/Texture/Texture.hpp"
 
 /**
@@ -243,29 +244,17 @@ public:
     SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
     int err = 0;
     int choose;
-    T totaldensity;
-    T random, density;
 
     CubicOps ops;
-    T td1;
-    // float* odfPtr = &(odf.front());
+    AliasTable odfTable(odf, CubicOps::k_OdfSize);
+    if(!odfTable.isValid())
+    {
+      return -1;
+    }
     for(size_t i = 0; i < npoints; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < CubicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(odfTable.sample(rg.genrand_res53()));
       FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
       eulers[3 * i + 0] = eu[0];
       eulers[3 * i + 1] = eu[1];
@@ -291,28 +280,17 @@ public:
     SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
     int err = 0;
     int choose;
-    float totaldensity;
-    float random, density;
     HexagonalOps ops;
+    AliasTable odfTable(odf, HexagonalOps::k_OdfSize);
+    if(!odfTable.isValid())
+    {
+      return -1;
+    }
 
-    float td1;
     for(int i = 0; i < npoints; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < HexagonalOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(odfTable.sample(rg.genrand_res53()));
       FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
       eulers[3 * i + 0] = eu[0];
       eulers[3 * i + 1] = eu[1];
@@ -338,28 +316,17 @@ public:
     SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
     int err = 0;
     int choose;
-    float totaldensity;
-    float random, density;
     OrthoRhombicOps ops;
+    AliasTable odfTable(odf, OrthoRhombicOps::k_OdfSize);
+    if(!odfTable.isValid())
+    {
+      return -1;
+    }
 
-    float td1;
     for(int i = 0; i < npoints; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(odfTable.sample(rg.genrand_res53()));
       FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
       eulers[3 * i + 0] = eu[0];
       eulers[3 * i + 1] = eu[1];
@@ -394,28 +361,17 @@ public:
     SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
     int err = 0;
     int choose;
-    float totaldensity;
-    float random, density;
     OrthoRhombicOps ops;
+    AliasTable odfTable(odf, OrthoRhombicOps::k_OdfSize);
+    if(!odfTable.isValid())
+    {
+      return -1;
+    }
 
-    float td1;
     for(int i = 0; i < npoints; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < OrthoRhombicOps::k_OdfSize; j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(odfTable.sample(rg.genrand_res53()));
       FOrientArrayType eu = ops.determineEulerAngles(m_Seed, choose);
       eulers[3 * i + 0] = eu[0];
       eulers[3 * i + 1] = eu[1];
@@ -441,37 +397,25 @@ public:
     SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
     int err = 0;
-    float density;
-    float totaldensity;
     int choose = 0;
-    float random;
     float w;
 
     CubicOps ops;
+    AliasTable mdfTable(mdf, CubicOps::k_MdfSize);
+    if(!mdfTable.isValid())
+    {
+      return -1;
+    }
 
     for(int i = 0; i < npoints; i++)
     {
       yval[i] = 0;
     }
 
-    float td1;
     for(int i = 0; i < size; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < CubicOps::k_MdfSize; j++)
-      {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(mdfTable.sample(rg.genrand_res53()));
       FOrientArrayType rod = ops.determineRodriguesVector(m_Seed, choose);
       FOrientArrayType ax(4, 0.0);
       FOrientTransformsType::ro2ax(rod, ax);
@@ -505,34 +449,22 @@ public:
 
     int err = 0;
     int choose = 0;
-    float density;
-    float totaldensity;
-    float random;
     HexagonalOps ops;
+    AliasTable mdfTable(mdf, HexagonalOps::k_MdfSize);
+    if(!mdfTable.isValid())
+    {
+      return -1;
+    }
 
     for(int i = 0; i < npoints; i++)
     {
       yval[i] = 0;
     }
     //    float ra1, ra2, ra3, rb1, rb2, rb3, rc1, rc2, rc3;
-    float td1;
     for(int i = 0; i < size; i++)
     {
       m_Seed++;
-      random = rg.genrand_res53();
-      choose = 0;
-      totaldensity = 0;
-      for(size_t j = 0; j < HexagonalOps::k_MdfSize; j++)
-      {
-        density = mdf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
+      choose = static_cast<int>(mdfTable.sample(rg.genrand_res53()));
       FOrientArrayType rod = ops.determineRodriguesVector(m_Seed, choose);
       FOrientArrayType ax(4, 0.0);
       FOrientTransformsType::ro2ax(rod, ax);
@@ -51,6 +51,7 @@
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Texture/AliasTable.hpp"
 
 /**
  * @class Texture Texture.h AIM/Common/Texture.h
@@ -490,8 +491,9 @@ public:
    * @param numEntries The number of elemnts in teh Angles/Axes/Weights arrays which should all the be same size or at least
    * the value passed here is the minium size of all the arrays. The sizes of the ODF and MDF arrays are
    * determined by calling the getODFSize and getMDFSize functions of the parameterized LaueOps class.
+   * @return -1 if the ODF has negative, non-finite or only zero weights, 0 otherwise
    */
-  template <typename T, class LaueOps> static void CalculateMDFData(T* angles, T* axes, T* weights, T* odf, T* mdf, size_t numEntries)
+  template <typename T, class LaueOps> static int CalculateMDFData(T* angles, T* axes, T* weights, T* odf, T* mdf, size_t numEntries)
   {
     LaueOps orientationOps;
     const int odfsize = orientationOps.getODFSize();
@@ -505,14 +507,18 @@ public:
     int choose1, choose2;
     QuatF q1;
     QuatF q2;
-    float totaldensity;
     float n1, n2, n3;
-    float random1, random2, density;
+    double random1, random2;
+    AliasTable odfTable(odf, odfsize);
 
     for(int i = 0; i < mdfsize; i++)
     {
       mdf[i] = 0.0;
     }
+    if(!odfTable.isValid())
+    {
+      return -1;
+    }
     int remainingcount = 10000;
     int aSize = static_cast<int>(numEntries);
     for(int i = 0; i < aSize; i++)
@@ -533,24 +539,8 @@ public:
       SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
       random1 = rg.genrand_res53();
       random2 = rg.genrand_res53();
-      choose1 = 0;
-      choose2 = 0;
-
-      totaldensity = 0;
-      for(int j = 0; j < odfsize; j++)
-      {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
-        {
-          choose1 = static_cast<int>(j);
-        }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
-      }
+      choose1 = static_cast<int>(odfTable.sample(random1));
+      choose2 = static_cast<int>(odfTable.sample(random2));
 
       FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
       FOrientArrayType qu(4);
@@ -586,6 +576,7 @@ public:
       }
       mdf[i] = mdf[i] / 10000.0;
     }
+    return 0;
   }
 
 protected:
@@ -31,50 +31,53 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ComputeStereographicProjection.h"
 
+#include <algorithm>
+
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 
-#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-ComputeStereographicProjection::ComputeStereographicProjection(FloatArrayType* xyzCoords, PoleFigureConfiguration_t* config, DoubleArrayType* intensity)
-: m_XYZCoords(xyzCoords)
-, m_Config(config)
-, m_Intensity(intensity)
+StereographicProjectionAccumulator::StereographicProjectionAccumulator(PoleFigureConfiguration_t* config)
+: m_Config(config)
 {
+  if(m_Config->discrete)
+  {
+    m_Discrete.assign(static_cast<size_t>(m_Config->imageDim * m_Config->imageDim), 0.0);
+  }
+  else
+  {
+    m_Lambert = ModifiedLambertProjection::New();
+    m_Lambert->initializeSquares(m_Config->lambertDim, m_Config->sphereRadius);
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-ComputeStereographicProjection::~ComputeStereographicProjection() = default;
+StereographicProjectionAccumulator::~StereographicProjectionAccumulator() = default;
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ComputeStereographicProjection::operator()() const
+void StereographicProjectionAccumulator::addCoords(float* xyzCoords, size_t numCoords)
 {
-  m_Intensity->resize(static_cast<size_t>(m_Config->imageDim * m_Config->imageDim));
-  m_Intensity->initializeWithZeros();
-
   if(m_Config->discrete)
   {
     int halfDim = m_Config->imageDim / 2;
-    double* intensity = m_Intensity->getPointer(0);
-    size_t numCoords = m_XYZCoords->getNumberOfTuples();
-    float* xyzPtr = m_XYZCoords->getPointer(0);
+    double* intensity = m_Discrete.data();
     for(size_t i = 0; i < numCoords; i++)
     {
-      if(xyzPtr[i * 3 + 2] < 0.0f)
+      float* xyz = xyzCoords + i * 3;
+      if(xyz[2] < 0.0f)
       {
-        xyzPtr[i * 3 + 0] *= -1.0f;
-        xyzPtr[i * 3 + 1] *= -1.0f;
-        xyzPtr[i * 3 + 2] *= -1.0f;
+        xyz[0] *= -1.0f;
+        xyz[1] *= -1.0f;
+        xyz[2] *= -1.0f;
       }
-      float x = xyzPtr[i * 3] / (1 + xyzPtr[i * 3 + 2]);
-      float y = xyzPtr[i * 3 + 1] / (1 + xyzPtr[i * 3 + 2]);
+      float x = xyz[0] / (1 + xyz[2]);
+      float y = xyz[1] / (1 + xyz[2]);
 
       int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
       int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
@@ -83,29 +86,69 @@ void ComputeStereographicProjection::operator()() const
 
       intensity[index]++;
     }
-#if 0
-    // This chunk is here for some debugging....
-    int dim = m_Config->imageDim;
-    QString filename = QString("/tmp/Discrete-%1-%2.h5").arg(m_Intensity->getName()).arg(dim);
-    hid_t file_id = H5Utilities::createFile(filename.toStdString());
-    hsize_t dims[2];
-    dims[0] = dim;
-    dims[1] = dim;
-    H5Lite::writePointerDataset(file_id, "Discrete", 2, dims, intensity);
-    H5Fclose(file_id);
-#endif
   }
   else
   {
-    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(m_XYZCoords, m_Config->lambertDim, m_Config->sphereRadius);
-    lambert->normalizeSquaresToMRD();
-#if 0
-    int dim = lambert->getDimension();
-    QString filename = QString("/tmp/Lambert-%1.h5").arg(dim).arg(m_Config->);
-    hid_t file_id = H5Utilities::createFile(filename.toStdString());
-    lambert->writeHDF5Data(file_id);
-    H5Fclose(file_id);
-#endif
-    lambert->createStereographicProjection(m_Config->imageDim, m_Intensity);
+    m_Lambert->addCoords(xyzCoords, numCoords, 1.0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StereographicProjectionAccumulator::merge(const StereographicProjectionAccumulator& other)
+{
+  if(m_Config->discrete)
+  {
+    for(size_t i = 0; i < m_Discrete.size(); i++)
+    {
+      m_Discrete[i] += other.m_Discrete[i];
+    }
+  }
+  else
+  {
+    m_Lambert->addSquares(*(other.m_Lambert));
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StereographicProjectionAccumulator::createStereographicProjection(DoubleArrayType* intensity)
+{
+  intensity->resize(static_cast<size_t>(m_Config->imageDim * m_Config->imageDim));
+  if(m_Config->discrete)
+  {
+    std::copy(m_Discrete.begin(), m_Discrete.end(), intensity->getPointer(0));
+  }
+  else
+  {
+    m_Lambert->normalizeSquaresToMRD();
+    m_Lambert->createStereographicProjection(m_Config->imageDim, intensity);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ComputeStereographicProjection::ComputeStereographicProjection(FloatArrayType* xyzCoords, PoleFigureConfiguration_t* config, DoubleArrayType* intensity)
+: m_XYZCoords(xyzCoords)
+, m_Config(config)
+, m_Intensity(intensity)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ComputeStereographicProjection::~ComputeStereographicProjection() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ComputeStereographicProjection::operator()() const
+{
+  StereographicProjectionAccumulator accumulator(m_Config);
+  accumulator.addCoords(m_XYZCoords->getPointer(0), m_XYZCoords->getNumberOfTuples());
+  accumulator.createStereographicProjection(m_Intensity);
+}
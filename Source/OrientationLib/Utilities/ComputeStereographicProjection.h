@@ -31,12 +31,64 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <vector>
+
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
 
 #include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
+/**
+ * @class StereographicProjectionAccumulator This class collects XYZ coordinates on the unit sphere into either a
+ * modified Lambert projection or, for discrete pole figures, directly into a stereographic intensity image. Coordinates
+ * can be added in any number of batches and several accumulators can be merged, which lets pole figures be built from
+ * chunks of orientations without ever holding the sphere coordinates of every orientation at once.
+ */
+class OrientationLib_EXPORT StereographicProjectionAccumulator
+{
+  public:
+    /**
+     * @brief StereographicProjectionAccumulator
+     * @param config The pole figure configuration that supplies the discrete flag and the lambert/image dimensions
+     */
+    StereographicProjectionAccumulator(PoleFigureConfiguration_t* config);
+
+    virtual ~StereographicProjectionAccumulator();
+
+    /**
+     * @brief addCoords Bins a batch of XYZ coordinates. In discrete mode the coordinates in the southern hemisphere are
+     * flipped in place.
+     * @param xyzCoords Pointer to numCoords * 3 floats
+     * @param numCoords The number of coordinates to bin
+     */
+    void addCoords(float* xyzCoords, size_t numCoords);
+
+    /**
+     * @brief merge Adds the bins of another accumulator built from the same configuration into this one.
+     * @param other
+     */
+    void merge(const StereographicProjectionAccumulator& other);
+
+    /**
+     * @brief createStereographicProjection Writes the final intensity image for all of the coordinates added so far.
+     * @param intensity [output] Resized to imageDim * imageDim
+     */
+    void createStereographicProjection(DoubleArrayType* intensity);
+
+  private:
+    PoleFigureConfiguration_t* m_Config = nullptr;
+    ModifiedLambertProjection::Pointer m_Lambert;
+    std::vector<double> m_Discrete;
+
+  public:
+    StereographicProjectionAccumulator(const StereographicProjectionAccumulator&) = delete; // Copy Constructor Not Implemented
+    StereographicProjectionAccumulator(StereographicProjectionAccumulator&&) = default;
+    StereographicProjectionAccumulator& operator=(const StereographicProjectionAccumulator&) = delete; // Copy Assignment Not Implemented
+    StereographicProjectionAccumulator& operator=(StereographicProjectionAccumulator&&) = delete;      // Move Assignment Not Implemented
+};
+
 /**
 * @class ComputeStereographicProjection This class is a wrapper around simply generating a stereo graphically projected intensity "image" (2D Array) based
 * off the intended final size of an image and a modified Lambert projection for a set of XYZ coordinates that represent
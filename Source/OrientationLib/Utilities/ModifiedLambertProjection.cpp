@@ -36,14 +36,70 @@
 
 #include "ModifiedLambertProjection.h"
 
+#include <algorithm>
+
 #include <QtCore/QSet>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
+namespace
+{
+// Number of points whose square coordinates and bins are computed together by the batch methods
+const size_t k_BlockSize = 256;
+
+// Smallest number of points worth giving their own partial projection in LambertBallToSquare
+const size_t k_MinPointsPerSlice = 16384;
+}
+
+/**
+ * @brief The LambertBallToSquareImpl class bins slices of a coordinate array into separate projections that are
+ * summed by the caller once every slice is done.
+ */
+class LambertBallToSquareImpl
+{
+  public:
+    LambertBallToSquareImpl(FloatArrayType* coords, std::vector<ModifiedLambertProjection::Pointer>* slices)
+    : m_Coords(coords)
+    , m_Slices(slices)
+    {
+    }
+    virtual ~LambertBallToSquareImpl() = default;
+
+    void generate(size_t start, size_t end) const
+    {
+      size_t npoints = m_Coords->getNumberOfTuples();
+      size_t numSlices = m_Slices->size();
+      const float* coords = m_Coords->getPointer(0);
+      for(size_t s = start; s < end; s++)
+      {
+        size_t first = npoints * s / numSlices;
+        size_t last = npoints * (s + 1) / numSlices;
+        (*m_Slices)[s]->addCoords(coords + first * 3, last - first, 1.0);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      generate(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    FloatArrayType* m_Coords;
+    std::vector<ModifiedLambertProjection::Pointer>* m_Slices;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -68,9 +124,6 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
 {
 
   size_t npoints = coords->getNumberOfTuples();
-  bool nhCheck = false;
-  float sqCoord[2];
-  //int sqIndex = 0;
   ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
   squareProj->initializeSquares(dimension, sphereRadius);
 
@@ -95,37 +148,46 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
   fprintf(f, "\n");
 
   fprintf(f, "DATASET UNSTRUCTURED_GRID\nPOINTS %lu float\n", coords->getNumberOfTuples() );
-#endif
-
+  float sqCoord[2];
   for(size_t i = 0; i < npoints; ++i)
   {
-    sqCoord[0] = 0.0;
-    sqCoord[1] = 0.0;
-    //get coordinates in square projection of crystal normal parallel to boundary normal
-    nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
+    squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
     fprintf(f, "%f %f 0\n", sqCoord[0], sqCoord[1]);
+  }
+  fclose(f);
 #endif
 
-    // Based on the XY coordinate, get the pointer index that the value corresponds to in the proper square
-//    sqIndex = squareProj->getSquareIndex(sqCoord);
-    if(nhCheck)
-    {
-      //north increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::NorthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
-    }
-    else
-    {
-      // south increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::SouthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
-    }
+  // Each slice of the points is binned into its own projection and the projections are summed at the end
+  std::vector<ModifiedLambertProjection::Pointer> slices(1, squareProj);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  size_t numSlices = std::min(static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()), npoints / k_MinPointsPerSlice);
+  for(size_t s = 1; s < numSlices; s++)
+  {
+    ModifiedLambertProjection::Pointer slice = ModifiedLambertProjection::New();
+    slice->initializeSquares(dimension, sphereRadius);
+    slices.push_back(slice);
   }
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
-  fclose(f);
 #endif
 
+  LambertBallToSquareImpl impl(coords, &slices);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel && slices.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, slices.size(), 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.generate(0, slices.size());
+  }
+
+  for(size_t s = 1; s < slices.size(); s++)
+  {
+    squareProj->addSquares(*(slices[s]));
+  }
+
   return squareProj;
 }
 
@@ -189,91 +251,112 @@ int ModifiedLambertProjection::readHDF5Data(hid_t groupId)
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCoord, double value)
 {
-  int abin1 = 0, bbin1 = 0;
-  int abin2 = 0, bbin2 = 0;
-  int abin3 = 0, bbin3 = 0;
-  int abin4 = 0, bbin4 = 0;
-  int abinSign, bbinSign;
-  float modX = (sqCoord[0] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  float modY = (sqCoord[1] + m_HalfDimensionTimesStepSize ) / m_StepSize;
-  int abin = (int) modX;
-  int bbin = (int) modY;
-  modX -= abin;
-  modY -= bbin;
-  modX -= 0.5;
-  modY -= 0.5;
-  if(modX == 0.0)
-  {
-    abinSign = 1;
-  }
-  else
-  {
-    abinSign = modX / fabs(modX);
-  }
-  if(modY == 0.0)
-  {
-    bbinSign = 1;
-  }
-  else
-  {
-    bbinSign = modY / fabs(modY);
-  }
-  abin1 = abin;
-  bbin1 = bbin;
-  abin2 = abin + abinSign;
-  bbin2 = bbin;
-  if(abin2 < 0 || abin2 > m_Dimension - 1)
-  {
-    abin2 = abin2 - (abinSign * m_Dimension), bbin2 = m_Dimension - bbin2 - 1;
-  }
-  abin3 = abin;
-  bbin3 = bbin + bbinSign;
-  if(bbin3 < 0 || bbin3 > m_Dimension - 1)
-  {
-    abin3 = m_Dimension - abin3 - 1, bbin3 = bbin3 - (bbinSign * m_Dimension);
-  }
-  abin4 = abin + abinSign;
-  bbin4 = bbin + bbinSign;
-  if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 >= 0 && bbin4 <= m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = m_Dimension - bbin4 - 1;
-  }
-  else if((abin4 >= 0 && abin4 <= m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = m_Dimension - abin4 - 1, bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  else if((abin4 < 0 || abin4 > m_Dimension - 1) && (bbin4 < 0 || bbin4 > m_Dimension - 1))
-  {
-    abin4 = abin4 - (abinSign * m_Dimension), bbin4 = bbin4 - (bbinSign * m_Dimension);
-  }
-  modX = fabs(modX);
-  modY = fabs(modY);
+  uint8_t north = (square == NorthSquare) ? 1 : 0;
+  addInterpolatedValues(sqCoord, sqCoord + 1, &north, 1, value);
+}
 
-  int index1 = bbin1 * m_Dimension + abin1;
-  int index2 = bbin2 * m_Dimension + abin2;
-  int index3 = bbin3 * m_Dimension + abin3;
-  int index4 = bbin4 * m_Dimension + abin4;
-  if (square == NorthSquare)
-  {
-    double v1 = m_NorthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_NorthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_NorthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_NorthSquare->getValue(index4) + value * (modX) * (modY);
-    m_NorthSquare->setValue(index1, v1);
-    m_NorthSquare->setValue(index2, v2);
-    m_NorthSquare->setValue(index3, v3);
-    m_NorthSquare->setValue(index4, v4);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addInterpolatedValues(const float* sqX, const float* sqY, const uint8_t* north, size_t numCoords, double value)
+{
+  int index1[k_BlockSize];
+  int index2[k_BlockSize];
+  int index3[k_BlockSize];
+  int index4[k_BlockSize];
+  double weight1[k_BlockSize];
+  double weight2[k_BlockSize];
+  double weight3[k_BlockSize];
+  double weight4[k_BlockSize];
+
+  double* northSquare = m_NorthSquare->getPointer(0);
+  double* southSquare = m_SouthSquare->getPointer(0);
+  const int dim = m_Dimension;
+
+  for(size_t start = 0; start < numCoords; start += k_BlockSize)
+  {
+    size_t count = std::min(k_BlockSize, numCoords - start);
+    const float* blockX = sqX + start;
+    const float* blockY = sqY + start;
+
+    // Find the 4 bins around each point. Neighbors that fall off an edge of the square wrap onto the
+    // opposite edge mirrored, exactly as the scalar bin search always has.
+    for(size_t j = 0; j < count; j++)
+    {
+      float modX = (blockX[j] + m_HalfDimensionTimesStepSize) / m_StepSize;
+      float modY = (blockY[j] + m_HalfDimensionTimesStepSize) / m_StepSize;
+      int abin = (int)modX;
+      int bbin = (int)modY;
+      modX -= abin;
+      modY -= bbin;
+      modX -= 0.5;
+      modY -= 0.5;
+      int abinSign = (modX < 0.0f) ? -1 : 1;
+      int bbinSign = (modY < 0.0f) ? -1 : 1;
+
+      int abinNext = abin + abinSign;
+      int bbinNext = bbin + bbinSign;
+      bool aOutside = (abinNext < 0 || abinNext > dim - 1);
+      bool bOutside = (bbinNext < 0 || bbinNext > dim - 1);
+      int abinWrapped = abinNext - (abinSign * dim);
+      int bbinWrapped = bbinNext - (bbinSign * dim);
+
+      int abin2 = aOutside ? abinWrapped : abinNext;
+      int bbin2 = aOutside ? dim - bbin - 1 : bbin;
+      int abin3 = bOutside ? dim - abin - 1 : abin;
+      int bbin3 = bOutside ? bbinWrapped : bbinNext;
+      int abin4 = aOutside ? abinWrapped : (bOutside ? dim - abinNext - 1 : abinNext);
+      int bbin4 = bOutside ? bbinWrapped : (aOutside ? dim - bbinNext - 1 : bbinNext);
+
+      modX = fabs(modX);
+      modY = fabs(modY);
+
+      index1[j] = bbin * dim + abin;
+      index2[j] = bbin2 * dim + abin2;
+      index3[j] = bbin3 * dim + abin3;
+      index4[j] = bbin4 * dim + abin4;
+      weight1[j] = value * (1.0 - modX) * (1.0 - modY);
+      weight2[j] = value * (modX) * (1.0 - modY);
+      weight3[j] = value * (1.0 - modX) * (modY);
+      weight4[j] = value * (modX) * (modY);
+    }
+
+    const uint8_t* blockNorth = north + start;
+    for(size_t j = 0; j < count; j++)
+    {
+      double* square = blockNorth[j] ? northSquare : southSquare;
+      square[index1[j]] += weight1[j];
+      square[index2[j]] += weight2[j];
+      square[index3[j]] += weight3[j];
+      square[index4[j]] += weight4[j];
+    }
   }
-  else
-  {
-    double v1 = m_SouthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_SouthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_SouthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_SouthSquare->getValue(index4) + value * (modX) * (modY);
-    m_SouthSquare->setValue(index1, v1);
-    m_SouthSquare->setValue(index2, v2);
-    m_SouthSquare->setValue(index3, v3);
-    m_SouthSquare->setValue(index4, v4);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addCoords(const float* xyz, size_t numCoords, double value)
+{
+  float x[k_BlockSize];
+  float y[k_BlockSize];
+  float z[k_BlockSize];
+  float sqX[k_BlockSize];
+  float sqY[k_BlockSize];
+  uint8_t north[k_BlockSize];
+
+  for(size_t start = 0; start < numCoords; start += k_BlockSize)
+  {
+    size_t count = std::min(k_BlockSize, numCoords - start);
+    const float* block = xyz + start * 3;
+    for(size_t j = 0; j < count; j++)
+    {
+      x[j] = block[j * 3];
+      y[j] = block[j * 3 + 1];
+      z[j] = block[j * 3 + 2];
+    }
+    getSquareCoords(x, y, z, count, sqX, sqY, north);
+    addInterpolatedValues(sqX, sqY, north, count, value);
   }
 }
 
@@ -282,7 +365,7 @@ void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCo
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::addValue(Square square, int index, double value)
 {
-  if (square == NorthSquare)
+  if(square == NorthSquare)
   {
     double v = m_NorthSquare->getValue(index) + value;
     m_NorthSquare->setValue(index, v);
@@ -294,6 +377,25 @@ void ModifiedLambertProjection::addValue(Square square, int index, double value)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addSquares(const ModifiedLambertProjection& other)
+{
+  size_t npoints = m_NorthSquare->getNumberOfTuples();
+  Q_ASSERT(npoints == other.m_NorthSquare->getNumberOfTuples());
+
+  double* north = m_NorthSquare->getPointer(0);
+  double* south = m_SouthSquare->getPointer(0);
+  const double* otherNorth = other.m_NorthSquare->getPointer(0);
+  const double* otherSouth = other.m_SouthSquare->getPointer(0);
+  for(size_t i = 0; i < npoints; ++i)
+  {
+    north[i] += otherNorth[i];
+    south[i] += otherSouth[i];
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -410,39 +512,41 @@ double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqC
 // -----------------------------------------------------------------------------
 bool ModifiedLambertProjection::getSquareCoord(float* xyz, float* sqCoord)
 {
-  bool nhCheck = false;
-  float adjust = 1.0;
-  if(xyz[2] >= 0.0)
-  {
-    adjust = -1.0;
-    nhCheck = true;
-  }
-  if(xyz[0] == 0 && xyz[1] == 0)
-  {
-    sqCoord[0] = 0.0;
-    sqCoord[1] = 0.0;
-    return nhCheck;
-  }
-  if(fabs(xyz[0]) >= fabs(xyz[1]))
-  {
-    sqCoord[0] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust) ) ) * SIMPLib::Constants::k_HalfOfSqrtPi;
-    sqCoord[1] = (xyz[0] / fabs(xyz[0]) ) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust) ) ) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[1] / xyz[0]));
-  }
-  else
-  {
-    sqCoord[0] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust))) * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(xyz[0] / xyz[1]));
-    sqCoord[1] = (xyz[1] / fabs(xyz[1])) * sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (xyz[2] * adjust))) * (SIMPLib::Constants::k_HalfOfSqrtPi);
-  }
+  uint8_t north = 0;
+  getSquareCoords(xyz, xyz + 1, xyz + 2, 1, sqCoord, sqCoord + 1, &north);
+  return (north != 0);
+}
 
-  if (sqCoord[0] >= m_MaxCoord)
-  {
-    sqCoord[0] = (m_MaxCoord) - .0001;
-  }
-  if (sqCoord[1] >= m_MaxCoord)
-  {
-    sqCoord[1] = (m_MaxCoord) - .0001;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::getSquareCoords(const float* x, const float* y, const float* z, size_t numCoords, float* sqX, float* sqY, uint8_t* north) const
+{
+  const float maxCoord = m_MaxCoord - .0001;
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    bool nhCheck = (z[i] >= 0.0);
+    float adjust = nhCheck ? -1.0f : 1.0f;
+
+    // The larger of |x| and |y| decides which square coordinate gets the arctangent term
+    bool xMajor = (fabs(x[i]) >= fabs(y[i]));
+    float major = xMajor ? x[i] : y[i];
+    float minor = xMajor ? y[i] : x[i];
+    // The pole itself (x == y == 0) maps to the center of the square
+    bool atPole = (major == 0.0f);
+    major = atPole ? 1.0f : major;
+
+    float sign = major / fabs(major);
+    double radius = sqrt(2.0 * m_SphereRadius * (m_SphereRadius + (z[i] * adjust)));
+    float a = sign * radius * SIMPLib::Constants::k_HalfOfSqrtPi;
+    float b = sign * radius * ((SIMPLib::Constants::k_2OverSqrtPi) * atan(minor / major));
+    float u = atPole ? 0.0f : (xMajor ? a : b);
+    float v = atPole ? 0.0f : (xMajor ? b : a);
+
+    sqX[i] = (u >= m_MaxCoord) ? maxCoord : u;
+    sqY[i] = (v >= m_MaxCoord) ? maxCoord : v;
+    north[i] = nhCheck ? 1 : 0;
   }
-  return nhCheck;
 }
 
 // -----------------------------------------------------------------------------
@@ -450,29 +554,29 @@ bool ModifiedLambertProjection::getSquareCoord(float* xyz, float* sqCoord)
 // -----------------------------------------------------------------------------
 int ModifiedLambertProjection::getSquareIndex(float* sqCoord)
 {
-  int x = (int)( (sqCoord[0] + m_MaxCoord) / m_StepSize);
-  if (x >= m_Dimension)
-  {
-    x = m_Dimension - 1;
-  }
-  if (x < 0)
-  {
-    x = 0;
-  }
-  int y = (int)( (sqCoord[1] + m_MaxCoord) / m_StepSize);
-  if (y >= m_Dimension)
-  {
-    y = m_Dimension - 1;
-  }
-  if (y < 0)
-  {
-    y = 0;
-  }
-  int index = y * m_Dimension + x;
+  int index = 0;
+  getSquareIndices(sqCoord, sqCoord + 1, 1, &index);
   Q_ASSERT(index < m_Dimension * m_Dimension);
   return index;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::getSquareIndices(const float* sqX, const float* sqY, size_t numCoords, int* indices) const
+{
+  const int maxIndex = m_Dimension - 1;
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    int x = (int)((sqX[i] + m_MaxCoord) / m_StepSize);
+    x = (x > maxIndex) ? maxIndex : x;
+    x = (x < 0) ? 0 : x;
+    int y = (int)((sqY[i] + m_MaxCoord) / m_StepSize);
+    y = (y > maxIndex) ? maxIndex : y;
+    y = (y < 0) ? 0 : y;
+    indices[i] = y * m_Dimension + x;
+  }
+}
 
 // -----------------------------------------------------------------------------
 //
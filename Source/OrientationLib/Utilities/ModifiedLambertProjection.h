@@ -103,6 +103,27 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     void addInterpolatedValues(Square square, float* sqCoord, double value);
 
+    /**
+     * @brief addInterpolatedValues Batch form of the method above for square coordinates stored as separate X and Y
+     * arrays. The bin indices and weights for a block of points are computed with selects instead of branches and then
+     * scattered into the squares in a second pass.
+     * @param sqX X coordinates in the modified Lambert square
+     * @param sqY Y coordinates in the modified Lambert square
+     * @param north Non-zero for each point that belongs in the north square
+     * @param numCoords The number of points
+     * @param value The value to distribute over the four nearest bins of each point
+     */
+    void addInterpolatedValues(const float* sqX, const float* sqY, const uint8_t* north, size_t numCoords, double value);
+
+    /**
+     * @brief addCoords Bins interleaved XYZ coordinates on the sphere into the squares. The coordinates are copied in
+     * blocks into separate X, Y and Z arrays and passed through getSquareCoords() and addInterpolatedValues().
+     * @param xyz Pointer to numCoords * 3 floats
+     * @param numCoords The number of coordinates
+     * @param value The value to add for each coordinate
+     */
+    void addCoords(const float* xyz, size_t numCoords, double value);
+
     /**
      * @brief addValue
      * @param square
@@ -111,6 +132,13 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     void addValue(Square square, int index, double value);
 
+    /**
+     * @brief addSquares Adds the bins of another projection into this one. Both projections must have been initialized
+     * with the same dimension.
+     * @param other The projection whose north and south squares are added to this projection
+     */
+    void addSquares(const ModifiedLambertProjection& other);
+
     /**
      * @brief This function sets the value of a bin in the lambert projection
      * @param square The North or South Squares
@@ -143,6 +171,18 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     bool getSquareCoord(float* xyz, float* sqCoord);
 
+    /**
+     * @brief getSquareCoords Batch form of getSquareCoord() for coordinates stored as separate X, Y and Z arrays.
+     * @param x Input X coordinates on the unit sphere
+     * @param y Input Y coordinates on the unit sphere
+     * @param z Input Z coordinates on the unit sphere
+     * @param numCoords The number of coordinates
+     * @param sqX [output] The X coordinates in the Modified Lambert Square
+     * @param sqY [output] The Y coordinates in the Modified Lambert Square
+     * @param north [output] 1 if the point is in the north square, 0 if it is in the south square
+     */
+    void getSquareCoords(const float* x, const float* y, const float* z, size_t numCoords, float* sqX, float* sqY, uint8_t* north) const;
+
     /**
      * @brief getSquareIndex
      * @param sqCoord
@@ -150,6 +190,16 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     int getSquareIndex(float* sqCoord);
 
+    /**
+     * @brief getSquareIndices Batch form of getSquareIndex() for square coordinates stored as separate X and Y arrays.
+     * Coordinates that fall outside of the square are clamped to the nearest edge bin.
+     * @param sqX X coordinates in the modified Lambert square
+     * @param sqY Y coordinates in the modified Lambert square
+     * @param numCoords The number of coordinates
+     * @param indices [output] The bin index of each coordinate
+     */
+    void getSquareIndices(const float* sqX, const float* sqY, size_t numCoords, int* indices) const;
+
     /**
      * @brief This function normalizes the squares by taking the value of each square and dividing by the sum of all the
      * values in all the squares.
@@ -51,6 +51,7 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/ConstrainedDoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/ConstrainedIntFilterParameter.h"
@@ -76,6 +77,8 @@ EMMPMFilter::EMMPMFilter()
 , m_CurvatureBetaC(1.0f)
 , m_CurvatureRMax(15.0f)
 , m_CurvatureEMLoopDelay(1)
+, m_UseStoppingThreshold(false)
+, m_StoppingThreshold(0.01f)
 , m_OutputDataArrayPath("", "", "")
 , m_EmmpmInitType(EMMPM_Basic)
 , m_Data(EMMPM_Data::New())
@@ -138,6 +141,12 @@ void EMMPMFilter::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_CONSTRAINED_DOUBLE_FP("Beta C", CurvatureBetaC, FilterParameter::Parameter, EMMPMFilter));
   parameters.push_back(SIMPL_NEW_CONSTRAINED_DOUBLE_FP("R Max", CurvatureRMax, FilterParameter::Parameter, EMMPMFilter));
   parameters.push_back(SIMPL_NEW_CONSTRAINED_INT_FP("EM Loop Delay", CurvatureEMLoopDelay, FilterParameter::Parameter, EMMPMFilter));
+  {
+    QStringList linkedProps;
+    linkedProps << "StoppingThreshold";
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stop When Mu/Sigma Converge", UseStoppingThreshold, FilterParameter::Parameter, EMMPMFilter, linkedProps));
+  }
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Convergence Threshold", StoppingThreshold, FilterParameter::Parameter, EMMPMFilter));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -171,6 +180,8 @@ void EMMPMFilter::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCurvatureBetaC(reader->readValue("CurvaturePenalty", getCurvatureBetaC()));
   setCurvatureRMax(reader->readValue("RMax", getCurvatureRMax()));
   setCurvatureEMLoopDelay(reader->readValue("EMLoopDelay", getCurvatureEMLoopDelay()));
+  setUseStoppingThreshold(reader->readValue("UseStoppingThreshold", getUseStoppingThreshold()));
+  setStoppingThreshold(reader->readValue("StoppingThreshold", getStoppingThreshold()));
   setOutputDataArrayPath(reader->readDataArrayPath("OutputDataArrayPath", getOutputDataArrayPath()));
   reader->closeFilterGroup();
 }
@@ -180,7 +191,8 @@ void EMMPMFilter::readFilterParameters(AbstractFilterParametersReader* reader, i
 // -----------------------------------------------------------------------------
 void EMMPMFilter::initialize()
 {
-  m_Data->initVariables();
+  // Start from a fresh workspace so the buffers of a previous run are released instead of leaked
+  m_Data = EMMPM_Data::New();
   m_Data->dims = 1; // We operate on a single channel | single component "image".
 
   m_PreviousMu.resize(getNumClasses() * m_Data->dims);
@@ -267,7 +279,18 @@ void EMMPMFilter::execute()
   initialize();
 
   // This is the routine that sets up the EM/MPM to segment the image
-  segment(getEmmpmInitType());
+  segmentArray(getEmmpmInitType());
+
+  /* Let the GUI know we are done with this filter */
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentArray(EMMPM_InitializationType initType)
+{
+  segment(initType);
 
   if(m_UseOneBasedValues && m_OutputImagePtr.lock() != nullptr)
   {
@@ -279,23 +302,48 @@ void EMMPMFilter::execute()
       outputArray->setValue(i, newVal);
     }
   }
-
-  /* Let the GUI know we are done with this filter */
-  notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void EMMPMFilter::segment(EMMPM_InitializationType initType)
+{
+  DataArrayPath dap = getInputDataArrayPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
+  QVector<size_t> tDims = am->getTupleDimensions();
+  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
+  QVector<size_t> cDims = iDataArray->getComponentDimensions();
+
+  segmentImage(m_Data, initType, m_InputImage, m_OutputImage, tDims[0], tDims[1], cDims[0], true);
+
+  // Grab the Mu/Sigma values from the current finished segmented image and use those as inputs
+  // into the initialization of the next Image to be Segmented
+  m_PreviousMu.resize(getNumClasses() * m_Data->dims);
+  m_PreviousSigma.resize(getNumClasses() * m_Data->dims);
+  for(int32_t i = 0; i < m_Data->classes; i++)
+  {
+    for(uint32_t d = 0; d < m_Data->dims; d++)
+    {
+      m_PreviousMu[i * m_Data->dims + d] = m_Data->mean[i * m_Data->dims + d];
+      m_PreviousSigma[i * m_Data->dims + d] = m_Data->variance[i * m_Data->dims + d];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentImage(const EMMPM_Data::Pointer& data, EMMPM_InitializationType initType, uint8_t* inputImage, uint8_t* outputImage, size_t columns, size_t rows, size_t channels,
+                               bool forwardMessages)
 {
   // Copy all the variables from the filter into the EMmpm Data structure.
-  m_Data->initType = initType;
+  data->initType = initType;
 
   InitializationFunction::Pointer initFunction = BasicInitialization::New();
 
   // Set the initialization function based on the parameters
-  switch(m_Data->initType)
+  switch(data->initType)
   {
   case EMMPM_ManualInit:
     initFunction = InitializationFunction::New();
@@ -308,59 +356,56 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
     break;
   }
 
-  m_Data->classes = getNumClasses();
-  m_Data->in_beta = getExchangeEnergy();
-  m_Data->emIterations = getHistogramLoops();
-  m_Data->mpmIterations = getSegmentationLoops();
+  data->classes = getNumClasses();
+  data->in_beta = getExchangeEnergy();
+  data->emIterations = getHistogramLoops();
+  data->mpmIterations = getSegmentationLoops();
 
   DynamicTableData tableDataObj = getEMMPMTableData();
   std::vector<std::vector<double> > tableData = tableDataObj.getTableData();
-  for(int32_t i = 0; i < m_Data->classes; i++)
+  for(int32_t i = 0; i < data->classes; i++)
   {
-    int32_t gray = 255 / (m_Data->classes - 1);
+    int32_t gray = 255 / (data->classes - 1);
     // Generate a Gray Scale Color Table
-    m_Data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
+    data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
     // Hard code the minimum variance to 4.5; This could be a user option.
-    m_Data->min_variance[i] = tableData[i][1];
+    data->min_variance[i] = tableData[i][1];
     // Do we know what w_gamma is?
-    m_Data->w_gamma[i] = tableData[i][0];
+    data->w_gamma[i] = tableData[i][0];
   }
 
-  DataArrayPath dap = getInputDataArrayPath();
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
-  QVector<size_t> tDims = am->getTupleDimensions();
-  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
-  QVector<size_t> cDims = iDataArray->getComponentDimensions();
-
-  m_Data->columns = tDims[0];
-  m_Data->rows = tDims[1];
-  m_Data->inputImageChannels = cDims[0];
+  data->columns = columns;
+  data->rows = rows;
+  data->inputImageChannels = channels;
 
-  m_Data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
-  m_Data->useGradientPenalty = static_cast<char>(getUseGradientPenalty());
-  m_Data->beta_e = getGradientBetaE();
-  m_Data->useCurvaturePenalty = static_cast<char>(getUseCurvaturePenalty());
-  m_Data->beta_c = getCurvatureBetaC();
-  m_Data->r_max = getCurvatureRMax();
-  m_Data->ccostLoopDelay = getCurvatureEMLoopDelay();
+  data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
+  data->useGradientPenalty = static_cast<char>(getUseGradientPenalty());
+  data->beta_e = getGradientBetaE();
+  data->useCurvaturePenalty = static_cast<char>(getUseCurvaturePenalty());
+  data->beta_c = getCurvatureBetaC();
+  data->r_max = getCurvatureRMax();
+  data->ccostLoopDelay = getCurvatureEMLoopDelay();
+  data->useStoppingThreshold = static_cast<char>(getUseStoppingThreshold());
+  data->stoppingThreshold = getStoppingThreshold();
 
   // Assign our Data array allocated input and output images into the EMMPData class
-  m_Data->inputImage = m_InputImage;
-  m_Data->xt = m_OutputImage;
+  data->inputImage = inputImage;
+  data->xt = outputImage;
 
-  // Allocate all the memory here
-  m_Data->allocateDataStructureMemory();
+  // Allocate all the memory here. Buffers that are still allocated from a previous segmentation with
+  // the same workspace are reused as is.
+  data->allocateDataStructureMemory();
 
   // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
   // variables
-  if(m_Data->initType == EMMPM_ManualInit)
+  if(data->initType == EMMPM_ManualInit)
   {
-    for(int32_t i = 0; i < m_Data->classes; i++)
+    for(int32_t i = 0; i < data->classes; i++)
     {
-      for(uint32_t d = 0; d < m_Data->dims; d++)
+      for(uint32_t d = 0; d < data->dims; d++)
       {
-        m_Data->mean[i * m_Data->dims + d] = m_PreviousMu[i * m_Data->dims + d];
-        m_Data->variance[i * m_Data->dims + d] = m_PreviousSigma[i * m_Data->dims + d];
+        data->mean[i * data->dims + d] = m_PreviousMu[i * data->dims + d];
+        data->variance[i * data->dims + d] = m_PreviousSigma[i * data->dims + d];
       }
     }
   }
@@ -371,24 +416,22 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
   // Start the EM/MPM process going
   EMMPM::Pointer emmpm = EMMPM::New();
 
-  emmpm->setData(m_Data);
+  emmpm->setData(data);
   emmpm->setStatsDelegate(statsDelegate.get());
   emmpm->setInitializationFunction(initFunction);
   emmpm->setMessagePrefix(getMessagePrefix());
 
   // Connect up the Error/Warning/Progress object so the filter can report those things
-  connect(emmpm.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
+  if(forwardMessages)
+  {
+    connect(emmpm.get(), SIGNAL(filterGeneratedMessage(const PipelineMessage&)), this, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
+  }
 
   emmpm->execute();
 
   // We manually set the pointers to nullptr so that the EMMPData class does not try to free the memory
-  m_Data->inputImage = nullptr;
-  m_Data->xt = nullptr;
-
-  // Grab the Mu/Sigma values from the current finished segmented image and use those as inputs
-  // into the initialization of the next Image to be Segmented
-  m_PreviousMu.resize(getNumClasses() * m_Data->dims);
-  m_PreviousSigma.resize(getNumClasses() * m_Data->dims);
+  data->inputImage = nullptr;
+  data->xt = nullptr;
 }
 
 // -----------------------------------------------------------------------------
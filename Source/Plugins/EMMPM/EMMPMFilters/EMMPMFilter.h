@@ -66,6 +66,8 @@ class EMMPM_EXPORT EMMPMFilter : public AbstractFilter
     PYB11_PROPERTY(double CurvatureBetaC READ getCurvatureBetaC WRITE setCurvatureBetaC)
     PYB11_PROPERTY(double CurvatureRMax READ getCurvatureRMax WRITE setCurvatureRMax)
     PYB11_PROPERTY(int CurvatureEMLoopDelay READ getCurvatureEMLoopDelay WRITE setCurvatureEMLoopDelay)
+    PYB11_PROPERTY(bool UseStoppingThreshold READ getUseStoppingThreshold WRITE setUseStoppingThreshold)
+    PYB11_PROPERTY(float StoppingThreshold READ getStoppingThreshold WRITE setStoppingThreshold)
     PYB11_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
 
 public:
@@ -117,6 +119,12 @@ public:
   SIMPL_FILTER_PARAMETER(int, CurvatureEMLoopDelay)
   Q_PROPERTY(int CurvatureEMLoopDelay READ getCurvatureEMLoopDelay WRITE setCurvatureEMLoopDelay)
 
+  SIMPL_FILTER_PARAMETER(bool, UseStoppingThreshold)
+  Q_PROPERTY(bool UseStoppingThreshold READ getUseStoppingThreshold WRITE setUseStoppingThreshold)
+
+  SIMPL_FILTER_PARAMETER(float, StoppingThreshold)
+  Q_PROPERTY(float StoppingThreshold READ getStoppingThreshold WRITE setStoppingThreshold)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, OutputDataArrayPath)
   Q_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
 
@@ -228,6 +236,29 @@ protected:
    */
   virtual void segment(EMMPM_InitializationType initType);
 
+  /**
+   * @brief segmentImage Runs the EM/MPM segmentation of a single gray scale image with the current filter parameters.
+   * Only the workspace and the output image are written, so several images can be segmented at the same time as long
+   * as each one uses its own workspace
+   * @param data The EM/MPM workspace. Buffers left from an earlier image of the same size are reused
+   * @param initType Enumeration of EMMPM initialization types
+   * @param inputImage The gray scale image to segment
+   * @param outputImage [output] The class of every pixel
+   * @param columns The width of the image
+   * @param rows The height of the image
+   * @param channels The number of components of the input image
+   * @param forwardMessages Whether the progress messages of the EM/MPM loops are passed on by this filter
+   */
+  void segmentImage(const EMMPM_Data::Pointer& data, EMMPM_InitializationType initType, uint8_t* inputImage, uint8_t* outputImage, size_t columns, size_t rows, size_t channels, bool forwardMessages);
+
+  /**
+   * @brief segmentArray Segments the currently bound input array and applies the 1-based offset. The EM/MPM
+   * workspace and the Mu/Sigma values of the last segmentation are kept between calls, so subclasses can
+   * segment several arrays in a row after a single call to initialize()
+   * @param initType Enumeration of EMMPM initialization types
+   */
+  void segmentArray(EMMPM_InitializationType initType);
+
   /**
    * @brief getPreviousMu
    * @return
@@ -34,6 +34,14 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "MultiEmmpmFilter.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_queue.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "EMMPM/EMMPMConstants.h"
 #include "EMMPM/EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPM/EMMPMLib/Common/EMTime.h"
@@ -53,6 +61,71 @@
 
 #include "EMMPM/EMMPMVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+/**
+ * @brief The MultiEmmpmImpl class segments a range of the selected arrays. Without the Mu/Sigma of the previous
+ * array every array is independent of the others, so the arrays are spread over the workers. A worker takes an
+ * EM/MPM workspace out of the shared pool for each array and returns it afterwards, so only as many workspaces
+ * are allocated as arrays are segmented at the same time and their buffers are reused for the following arrays.
+ */
+class MultiEmmpmImpl
+{
+public:
+  MultiEmmpmImpl(MultiEmmpmFilter* filter, const QVector<uint8_t*>& inputImages, const QVector<uint8_t*>& outputImages, const QVector<size_t>& tDims,
+                 tbb::concurrent_queue<EMMPM_Data::Pointer>* workspaces)
+  : m_Filter(filter)
+  , m_InputImages(inputImages)
+  , m_OutputImages(outputImages)
+  , m_TDims(tDims)
+  , m_Workspaces(workspaces)
+  {
+  }
+  virtual ~MultiEmmpmImpl() = default;
+
+  void segment(size_t start, size_t end) const
+  {
+    size_t numTuples = m_TDims[0] * m_TDims[1] * m_TDims[2];
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      EMMPM_Data::Pointer data;
+      if(!m_Workspaces->try_pop(data))
+      {
+        data = EMMPM_Data::New();
+        data->dims = 1; // We operate on a single channel | single component "image".
+      }
+
+      m_Filter->segmentImage(data, EMMPM_Basic, m_InputImages[i], m_OutputImages[i], m_TDims[0], m_TDims[1], 1, false);
+      if(m_Filter->getUseOneBasedValues())
+      {
+        uint8_t* outputImage = m_OutputImages[i];
+        for(size_t t = 0; t < numTuples; t++)
+        {
+          outputImage[t] = outputImage[t] + 1;
+        }
+      }
+
+      m_Workspaces->push(data);
+    }
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    segment(r.begin(), r.end());
+  }
+
+private:
+  MultiEmmpmFilter* m_Filter;
+  QVector<uint8_t*> m_InputImages;
+  QVector<uint8_t*> m_OutputImages;
+  QVector<size_t> m_TDims;
+  tbb::concurrent_queue<EMMPM_Data::Pointer>* m_Workspaces;
+};
+#endif
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -124,6 +197,8 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
   setCurvatureBetaC(reader->readValue("CurvaturePenalty", getCurvatureBetaC()));
   setCurvatureRMax(reader->readValue("RMax", getCurvatureRMax()));
   setCurvatureEMLoopDelay(reader->readValue("EMLoopDelay", getCurvatureEMLoopDelay()));
+  setUseStoppingThreshold(reader->readValue("UseStoppingThreshold", getUseStoppingThreshold()));
+  setStoppingThreshold(reader->readValue("StoppingThreshold", getStoppingThreshold()));
   setOutputAttributeMatrixName(reader->readString("OutputAttributeMatrixName", getOutputAttributeMatrixName()));
   setUsePreviousMuSigma(reader->readValue("UsePreviousMuSigma", getUsePreviousMuSigma()));
   setOutputArrayPrefix(reader->readString("OutputArrayPrefix", getOutputArrayPrefix()));
@@ -267,6 +342,8 @@ void MultiEmmpmFilter::execute()
   {
     return;
   }
+  // The EM/MPM workspace is set up once and shared by every array so its buffers are only allocated for the
+  // first one; each array also picks up the Mu/Sigma left behind by the previous one when requested
   initialize();
 
   DataArrayPath inputAMPath = DataArrayPath::GetAttributeMatrixPath(getInputDataArrayVector());
@@ -274,6 +351,20 @@ void MultiEmmpmFilter::execute()
   QList<QString> arrayNames = DataArrayPath::GetDataArrayNames(getInputDataArrayVector());
   QListIterator<QString> iter(arrayNames);
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Only the warm start chains each array to the one before it; otherwise the arrays are segmented concurrently
+  if(!getUsePreviousMuSigma() && arrayNames.size() > 1)
+  {
+    segmentArraysInParallel(inputAMPath, arrayNames);
+    if(getErrorCondition() < 0)
+    {
+      return;
+    }
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+#endif
+
   QString msgPrefix = getMessagePrefix();
   int32_t i = 1;
   // This is the routine that sets up the EM/MPM to segment the image
@@ -295,7 +386,7 @@ void MultiEmmpmFilter::execute()
 
     QString prefix = QObject::tr("%1 (Array %2 of %3)").arg(msgPrefix).arg(i).arg(arrayNames.size());
     setMessagePrefix(prefix);
-    if(i == 2 && getUsePreviousMuSigma())
+    if(i > 1 && getUsePreviousMuSigma())
     {
       setEmmpmInitType(EMMPM_ManualInit);
     }
@@ -304,7 +395,12 @@ void MultiEmmpmFilter::execute()
       setEmmpmInitType(EMMPM_Basic);
     }
 
-    EMMPMFilter::execute();
+    EMMPMFilter::dataCheck();
+    if(getErrorCondition() < 0)
+    {
+      break;
+    }
+    segmentArray(getEmmpmInitType());
     if(getErrorCondition() < 0)
     {
       break;
@@ -329,6 +425,44 @@ void MultiEmmpmFilter::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MultiEmmpmFilter::segmentArraysInParallel(const DataArrayPath& inputAMPath, const QList<QString>& arrayNames)
+{
+  QVector<size_t> cDims(1, 1);
+  QVector<uint8_t*> inputImages;
+  QVector<uint8_t*> outputImages;
+  for(const QString& name : arrayNames)
+  {
+    DataArrayPath inputPath = inputAMPath;
+    inputPath.setDataArrayName(name);
+    UInt8ArrayType::Pointer inputArray = getDataContainerArray()->getPrereqArrayFromPath<UInt8ArrayType, AbstractFilter>(this, inputPath, cDims);
+
+    // The output arrays were created by dataCheck()
+    DataArrayPath outputPath = inputAMPath;
+    outputPath.setAttributeMatrixName(getOutputAttributeMatrixName());
+    outputPath.setDataArrayName(getOutputArrayPrefix() + name);
+    UInt8ArrayType::Pointer outputArray = getDataContainerArray()->getPrereqArrayFromPath<UInt8ArrayType, AbstractFilter>(this, outputPath, cDims);
+    if(getErrorCondition() < 0 || nullptr == inputArray.get() || nullptr == outputArray.get())
+    {
+      return;
+    }
+    inputImages.push_back(inputArray->getPointer(0));
+    outputImages.push_back(outputArray->getPointer(0));
+  }
+  QVector<size_t> tDims = getDataContainerArray()->getAttributeMatrix(inputAMPath)->getTupleDimensions();
+
+  QString ss = QObject::tr("Segmenting %1 arrays in parallel").arg(arrayNames.size());
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+  tbb::task_scheduler_init init;
+  tbb::concurrent_queue<EMMPM_Data::Pointer> workspaces;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(arrayNames.size()), 1), MultiEmmpmImpl(this, inputImages, outputImages, tDims, &workspaces), tbb::simple_partitioner());
+}
+#endif
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -151,10 +151,21 @@ protected:
    */
   void initialize();
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  /**
+   * @brief segmentArraysInParallel Segments all selected arrays concurrently, each one from the basic initialization
+   * @param inputAMPath Path to the Attribute Matrix that holds the input arrays
+   * @param arrayNames Names of the input arrays
+   */
+  void segmentArraysInParallel(const DataArrayPath& inputAMPath, const QList<QString>& arrayNames);
+#endif
+
 private:
   DEFINE_DATAARRAY_VARIABLE(uint8_t, InputImage)
   DEFINE_DATAARRAY_VARIABLE(uint8_t, OutputImage)
 
+  friend class MultiEmmpmImpl;
+
 public:
   MultiEmmpmFilter(const MultiEmmpmFilter&) = delete; // Copy Constructor Not Implemented
   MultiEmmpmFilter(MultiEmmpmFilter&&) = delete;      // Move Constructor Not Implemented
@@ -190,7 +190,8 @@ void EMMPM::execute()
     return;
   }
 
-  /* Initialize the Curvature Penalty variables:  */
+  /* Initialize the Curvature Penalty variables. Buffers left over from an earlier run on the same data are released first */
+  free(data->ccost);
   data->ccost = nullptr;
   if(data->useCurvaturePenalty != 0)
   {
@@ -206,7 +207,11 @@ void EMMPM::execute()
   }
 
   /* Initialize the Edge Gradient Penalty variables */
-  data->nw = nullptr;
+  free(data->ns);
+  free(data->ew);
+  free(data->sw);
+  free(data->nw);
+  data->ns = nullptr;
   data->ew = nullptr;
   data->sw = nullptr;
   data->nw = nullptr;
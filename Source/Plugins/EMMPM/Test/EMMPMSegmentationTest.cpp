@@ -44,6 +44,7 @@
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/SIMPLib.h"
@@ -51,6 +52,17 @@
 
 #include "EMMPMTestFileLocations.h"
 
+namespace EMMPMSegmentationTestConsts
+{
+const QString k_DataContainerName("StackDataContainer");
+const QString k_CellAttributeMatrixName("CellData");
+const QString k_OutputAttributeMatrixName("SegmentedCellData");
+const QString k_OutputArrayPrefix("Segmented_");
+const size_t k_XDim = 64;
+const size_t k_YDim = 48;
+const int32_t k_NumSlices = 6;
+}
+
 class EMMPMSegmentationTest
 {
 public:
@@ -350,6 +362,131 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  // Each slice is dark to the left of a boundary column that moves from slice to slice and bright to its
+  // right, with a small deterministic texture on both sides
+  // -----------------------------------------------------------------------------
+  size_t SliceBoundary(int32_t slice)
+  {
+    return 16 + 5 * static_cast<size_t>(slice);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createImageStack()
+  {
+    using namespace EMMPMSegmentationTestConsts;
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {k_XDim, k_YDim, 1};
+    image->setDimensions(dims);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims = {k_XDim, k_YDim, 1};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(k_CellAttributeMatrixName, cellAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    for(int32_t slice = 0; slice < k_NumSlices; slice++)
+    {
+      QString name = QString("Slice_%1").arg(slice);
+      UInt8ArrayType::Pointer sliceArray = UInt8ArrayType::CreateArray(tDims, cDims, name);
+      for(size_t y = 0; y < k_YDim; y++)
+      {
+        for(size_t x = 0; x < k_XDim; x++)
+        {
+          uint8_t texture = static_cast<uint8_t>((x * 7 + y * 13 + slice) % 9);
+          sliceArray->setValue(y * k_XDim + x, (x < SliceBoundary(slice) ? 50 : 200) + texture);
+        }
+      }
+      cellAttrMat->addAttributeArray(name, sliceArray);
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runMultiEMMPM(bool usePreviousMuSigma)
+  {
+    using namespace EMMPMSegmentationTestConsts;
+    DataContainerArray::Pointer dca = createImageStack();
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("MultiEmmpmFilter");
+    DREAM3D_REQUIRE(filterFactory.get() != nullptr)
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVector<DataArrayPath> inputPaths;
+    for(int32_t slice = 0; slice < k_NumSlices; slice++)
+    {
+      inputPaths.push_back(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, QString("Slice_%1").arg(slice)));
+    }
+
+    QVariant var;
+    bool propWasSet;
+    var.setValue(inputPaths);
+    propWasSet = filter->setProperty("InputDataArrayVector", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_OutputAttributeMatrixName);
+    propWasSet = filter->setProperty("OutputAttributeMatrixName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_OutputArrayPrefix);
+    propWasSet = filter->setProperty("OutputArrayPrefix", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(usePreviousMuSigma);
+    propWasSet = filter->setProperty("UsePreviousMuSigma", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), NO_ERROR)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Without the warm start the slices are segmented concurrently. Every slice must come out the same as
+  // with the serial warm start chain, and both must split each slice at its boundary column.
+  // -----------------------------------------------------------------------------
+  int TestParallelMultiEMMPMSegmentation()
+  {
+    using namespace EMMPMSegmentationTestConsts;
+    DataContainerArray::Pointer parallelDca = runMultiEMMPM(false);
+    DataContainerArray::Pointer serialDca = runMultiEMMPM(true);
+
+    AttributeMatrix::Pointer parallelAM = parallelDca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_OutputAttributeMatrixName);
+    AttributeMatrix::Pointer serialAM = serialDca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_OutputAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(parallelAM.get())
+    DREAM3D_REQUIRE_VALID_POINTER(serialAM.get())
+
+    for(int32_t slice = 0; slice < k_NumSlices; slice++)
+    {
+      QString name = k_OutputArrayPrefix + QString("Slice_%1").arg(slice);
+      UInt8ArrayType::Pointer parallelArray = std::dynamic_pointer_cast<UInt8ArrayType>(parallelAM->getAttributeArray(name));
+      UInt8ArrayType::Pointer serialArray = std::dynamic_pointer_cast<UInt8ArrayType>(serialAM->getAttributeArray(name));
+      DREAM3D_REQUIRE_VALID_POINTER(parallelArray.get())
+      DREAM3D_REQUIRE_VALID_POINTER(serialArray.get())
+
+      for(size_t y = 0; y < k_YDim; y++)
+      {
+        for(size_t x = 0; x < k_XDim; x++)
+        {
+          size_t index = y * k_XDim + x;
+          // The classes are 1-based by default
+          uint8_t expected = (x < SliceBoundary(slice)) ? 1 : 2;
+          DREAM3D_REQUIRE_EQUAL(parallelArray->getValue(index), expected)
+          DREAM3D_REQUIRE_EQUAL(serialArray->getValue(index), expected)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -358,6 +495,7 @@ public:
 
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
+    DREAM3D_REGISTER_TEST(TestParallelMultiEMMPMSegmentation())
     if(m_ImageProcessingPluginLoaded)
     {
       DREAM3D_REGISTER_TEST(TestEMMPMSegmentation())
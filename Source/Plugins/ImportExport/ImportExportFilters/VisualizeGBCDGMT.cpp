@@ -35,6 +35,8 @@
 
 #include "VisualizeGBCDGMT.h"
 
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -48,6 +50,7 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
@@ -286,7 +289,6 @@ void VisualizeGBCDGMT::execute()
   float vec2[3] = {0.0f, 0.0f, 0.0f};
   float rotNormal[3] = {0.0f, 0.0f, 0.0f};
   float rotNormal2[3] = {0.0f, 0.0f, 0.0f};
-  float sqCoord[2] = {0.0f, 0.0f};
   float dg[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float dgt[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
   float dg1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
@@ -313,6 +315,16 @@ void VisualizeGBCDGMT::execute()
   // get number of symmetry operators
   int32_t n_sym = orientOps->getNumSymOps();
 
+  // Only the square coordinates are needed, so the projection is kept at a single bin
+  ModifiedLambertProjection::Pointer lambertProjection = ModifiedLambertProjection::New();
+  lambertProjection->initializeSquares(1, 1.0f);
+  std::vector<float> normX(2 * n_sym);
+  std::vector<float> normY(2 * n_sym);
+  std::vector<float> normZ(2 * n_sym);
+  std::vector<float> sqX(2 * n_sym);
+  std::vector<float> sqY(2 * n_sym);
+  std::vector<uint8_t> north(2 * n_sym);
+
   int32_t thetaPoints = 120;
   int32_t phiPoints = 30;
   float thetaRes = 360.0f / float(thetaPoints);
@@ -350,6 +362,22 @@ void VisualizeGBCDGMT::execute()
       vec[2] = cosf(phiRad);
       MatrixMath::Multiply3x3with3x1(dgt, vec, vec2);
 
+      // find symmetric poles in both crystal reference frames using the first symmetry operator and
+      // get their coordinates in the square projection in one batch
+      for(int32_t i = 0; i < n_sym; i++)
+      {
+        orientOps->getMatSymOp(i, sym1);
+        MatrixMath::Multiply3x3with3x1(sym1, vec, rotNormal);
+        MatrixMath::Multiply3x3with3x1(sym1, vec2, rotNormal2);
+        normX[i] = rotNormal[0];
+        normY[i] = rotNormal[1];
+        normZ[i] = rotNormal[2];
+        normX[n_sym + i] = rotNormal2[0];
+        normY[n_sym + i] = rotNormal2[1];
+        normZ[n_sym + i] = rotNormal2[2];
+      }
+      lambertProjection->getSquareCoords(normX.data(), normY.data(), normZ.data(), normX.size(), sqX.data(), sqY.data(), north.data());
+
       // Loop over all the symetry operators in the given cystal symmetry
       for(int32_t i = 0; i < n_sym; i++)
       {
@@ -373,13 +401,11 @@ void VisualizeGBCDGMT::execute()
             int32_t location1 = int32_t((mis_euler1[0] - gbcdLimits[0]) / gbcdDeltas[0]);
             int32_t location2 = int32_t((mis_euler1[1] - gbcdLimits[1]) / gbcdDeltas[1]);
             int32_t location3 = int32_t((mis_euler1[2] - gbcdLimits[2]) / gbcdDeltas[2]);
-            // find symmetric poles using the first symmetry operator
-            MatrixMath::Multiply3x3with3x1(sym1, vec, rotNormal);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(rotNormal, sqCoord);
+            // coordinates in square projection of the symmetric pole parallel to boundary normal
+            nhCheck = (north[i] != 0);
             // Note the switch to have theta in the 4 slot and cos(Phi) int he 3 slot
-            int32_t location4 = int32_t((sqCoord[0] - gbcdLimits[3]) / gbcdDeltas[3]);
-            int32_t location5 = int32_t((sqCoord[1] - gbcdLimits[4]) / gbcdDeltas[4]);
+            int32_t location4 = int32_t((sqX[i] - gbcdLimits[3]) / gbcdDeltas[3]);
+            int32_t location5 = int32_t((sqY[i] - gbcdLimits[4]) / gbcdDeltas[4]);
             if(location1 >= 0 && location2 >= 0 && location3 >= 0 && location4 >= 0 && location5 >= 0 && location1 < gbcdSizes[0] && location2 < gbcdSizes[1] && location3 < gbcdSizes[2] &&
                location4 < gbcdSizes[3] && location5 < gbcdSizes[4])
             {
@@ -406,13 +432,11 @@ void VisualizeGBCDGMT::execute()
             int32_t location1 = int32_t((mis_euler1[0] - gbcdLimits[0]) / gbcdDeltas[0]);
             int32_t location2 = int32_t((mis_euler1[1] - gbcdLimits[1]) / gbcdDeltas[1]);
             int32_t location3 = int32_t((mis_euler1[2] - gbcdLimits[2]) / gbcdDeltas[2]);
-            // find symmetric poles using the first symmetry operator
-            MatrixMath::Multiply3x3with3x1(sym1, vec2, rotNormal2);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(rotNormal2, sqCoord);
+            // coordinates in square projection of the symmetric pole parallel to boundary normal
+            nhCheck = (north[n_sym + i] != 0);
             // Note the switch to have theta in the 4 slot and cos(Phi) int he 3 slot
-            int32_t location4 = int32_t((sqCoord[0] - gbcdLimits[3]) / gbcdDeltas[3]);
-            int32_t location5 = int32_t((sqCoord[1] - gbcdLimits[4]) / gbcdDeltas[4]);
+            int32_t location4 = int32_t((sqX[n_sym + i] - gbcdLimits[3]) / gbcdDeltas[3]);
+            int32_t location5 = int32_t((sqY[n_sym + i] - gbcdLimits[4]) / gbcdDeltas[4]);
             if(location1 >= 0 && location2 >= 0 && location3 >= 0 && location4 >= 0 && location5 >= 0 && location1 < gbcdSizes[0] && location2 < gbcdSizes[1] && location3 < gbcdSizes[2] &&
                location4 < gbcdSizes[3] && location5 < gbcdSizes[4])
             {
@@ -457,30 +481,6 @@ void VisualizeGBCDGMT::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool VisualizeGBCDGMT::getSquareCoord(float* xstl1_norm1, float* sqCoord)
-{
-  bool nhCheck = false;
-  float adjust = 1.0;
-  if(xstl1_norm1[2] >= 0.0)
-  {
-    adjust = -1.0;
-    nhCheck = true;
-  }
-  if(fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
-  {
-    sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrt(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
-    sqCoord[1] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrt(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
-  }
-  else
-  {
-    sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
-    sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
-  }
-  return nhCheck;
-}
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
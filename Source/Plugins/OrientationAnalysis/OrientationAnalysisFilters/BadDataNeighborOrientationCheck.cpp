@@ -35,6 +35,15 @@
 
 #include "BadDataNeighborOrientationCheck.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -43,9 +52,94 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Processing/ProcessingFilters/HelperClasses/VoxelNeighborPropagation.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+/**
+ * @brief The CountAlignedNeighborsImpl class adds to the count of each listed voxel the number of
+ * its flagged neighbors that have the same (non zero) phase and lie within the misorientation
+ * tolerance of it.
+ */
+template <typename FlagType> class CountAlignedNeighborsImpl
+{
+public:
+  CountAlignedNeighborsImpl(const VoxelNeighborPropagation::Neighborhood& neighborhood, const std::vector<int64_t>& points, const FlagType* flags, bool neighborFirst, const QuatF* quats,
+                            const int32_t* cellPhases, const uint32_t* crystalStructures, const QVector<LaueOps::Pointer>& orientationOps, float tolerance, int32_t* neighborCount)
+  : m_Neighborhood(neighborhood)
+  , m_Points(points)
+  , m_Flags(flags)
+  , m_NeighborFirst(neighborFirst)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_Tolerance(tolerance)
+  , m_NeighborCount(neighborCount)
+  {
+  }
+  virtual ~CountAlignedNeighborsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      int64_t point = m_Points[i];
+      int32_t phase = m_CellPhases[point];
+      int32_t count = 0;
+      m_Neighborhood.forEachNeighbor(point, [&](int64_t neighbor) {
+        if(!m_Flags[neighbor] || phase <= 0 || m_CellPhases[neighbor] != phase)
+        {
+          return;
+        }
+        const QuatF& q1 = m_NeighborFirst ? m_Quats[neighbor] : m_Quats[point];
+        const QuatF& q2 = m_NeighborFirst ? m_Quats[point] : m_Quats[neighbor];
+        if(m_OrientationOps[m_CrystalStructures[phase]]->isMisoQuatBelow(q1, q2, m_Tolerance))
+        {
+          count++;
+        }
+      });
+      m_NeighborCount[point] += count;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const VoxelNeighborPropagation::Neighborhood& m_Neighborhood;
+  const std::vector<int64_t>& m_Points;
+  const FlagType* m_Flags;
+  bool m_NeighborFirst;
+  const QuatF* m_Quats;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float m_Tolerance;
+  int32_t* m_NeighborCount;
+};
+
+template <typename FlagType> void countAlignedNeighbors(const CountAlignedNeighborsImpl<FlagType>& impl, size_t numPoints, bool doParallel)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numPoints);
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -212,155 +306,99 @@ void BadDataNeighborOrientationCheck::execute()
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
-
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
 
-  QVector<int32_t> neighborCount(totalPoints, 0);
+  VoxelNeighborPropagation::Neighborhood neighborhood(udims);
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
+  std::vector<int64_t> badPoints;
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(!m_GoodVoxels[i])
     {
-      column = i % dims[0];
-      row = (i / dims[0]) % dims[1];
-      plane = i / (dims[0] * dims[1]);
-      for(int32_t j = 0; j < 6; j++)
-      {
-        good = 1;
-        neighbor = i + neighpoints[j];
-        if(j == 0 && plane == 0)
-        {
-          good = 0;
-        }
-        if(j == 5 && plane == (dims[2] - 1))
-        {
-          good = 0;
-        }
-        if(j == 1 && row == 0)
-        {
-          good = 0;
-        }
-        if(j == 4 && row == (dims[1] - 1))
-        {
-          good = 0;
-        }
-        if(j == 2 && column == 0)
-        {
-          good = 0;
-        }
-        if(j == 3 && column == (dims[0] - 1))
-        {
-          good = 0;
-        }
-        if(good == 1 && m_GoodVoxels[neighbor])
-        {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
+      badPoints.push_back(static_cast<int64_t>(i));
+    }
+  }
 
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
+  // Count the good neighbors of every bad voxel that agree with its orientation
+  std::vector<int32_t> neighborCount(totalPoints, 0);
+  countAlignedNeighbors(CountAlignedNeighborsImpl<bool>(neighborhood, badPoints, m_GoodVoxels, false, quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, misorientationTolerance,
+                                                        neighborCount.data()),
+                        badPoints.size(), doParallel);
+
+  // At each level, a bad voxel with enough agreeing good neighbors becomes good, which can bring
+  // its bad neighbors up to the level. Voxels only ever turn good, so the set reached at a level
+  // does not depend on the order they flip in: every round flips all the voxels that qualify and
+  // then only recounts the bad neighbors of the voxels it just flipped.
+  std::vector<uint8_t> flipped(totalPoints, 0);
+  std::vector<uint8_t> affectedFlags(totalPoints, 0);
+  std::vector<int64_t> candidates;
+  std::vector<int64_t> affected;
+  for(int32_t currentLevel = 6; currentLevel > m_NumberOfNeighbors; currentLevel--)
+  {
+    if(getCancel())
+    {
+      return;
+    }
 
-          if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-          {
-            w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-          }
-          if(w < misorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
-        }
+    candidates.clear();
+    size_t kept = 0;
+    for(const auto& point : badPoints)
+    {
+      if(m_GoodVoxels[point])
+      {
+        continue;
+      }
+      badPoints[kept++] = point;
+      if(neighborCount[point] >= currentLevel)
+      {
+        candidates.push_back(point);
       }
     }
-  }
+    badPoints.resize(kept);
 
-  int32_t currentLevel = 6;
-  int32_t counter = 0;
-
-  while(currentLevel > m_NumberOfNeighbors)
-  {
-    counter = 1;
-    while(counter > 0)
+    while(!candidates.empty())
     {
-      counter = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      for(const auto& point : candidates)
       {
-        if(neighborCount[i] >= currentLevel && !m_GoodVoxels[i])
-        {
-          m_GoodVoxels[i] = true;
-          counter++;
-          column = i % dims[0];
-          row = (i / dims[0]) % dims[1];
-          plane = i / (dims[0] * dims[1]);
-          for(int64_t j = 0; j < 6; j++)
+        m_GoodVoxels[point] = true;
+        flipped[point] = 1;
+      }
+
+      affected.clear();
+      for(const auto& point : candidates)
+      {
+        neighborhood.forEachNeighbor(point, [&](int64_t neighbor) {
+          if(!m_GoodVoxels[neighbor] && affectedFlags[neighbor] == 0)
           {
-            good = 1;
-            neighbor = i + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !m_GoodVoxels[neighbor])
-            {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-              {
-                w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-              }
-              if(w < misorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
-            }
+            affectedFlags[neighbor] = 1;
+            affected.push_back(neighbor);
           }
+        });
+      }
+      countAlignedNeighbors(CountAlignedNeighborsImpl<uint8_t>(neighborhood, affected, flipped.data(), true, quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, misorientationTolerance,
+                                                               neighborCount.data()),
+                            affected.size(), doParallel);
+
+      for(const auto& point : candidates)
+      {
+        flipped[point] = 0;
+      }
+      candidates.clear();
+      for(const auto& point : affected)
+      {
+        affectedFlags[point] = 0;
+        if(neighborCount[point] >= currentLevel)
+        {
+          candidates.push_back(point);
         }
       }
     }
-    currentLevel = currentLevel - 1;
   }
 
   // If there is an error set this to something negative and also set a message
@@ -36,6 +36,7 @@
 #include "ConvertOrientations.h"
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -43,6 +44,7 @@
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
+#include "OrientationLib/OrientationMath/OrientationBatchConverter.hpp"
 #include "OrientationLib/OrientationMath/OrientationConverter.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
@@ -52,6 +54,7 @@
 ConvertOrientations::ConvertOrientations()
 : m_InputType(0)
 , m_OutputType(1)
+, m_UseBatchConversion(false)
 {
 }
 
@@ -93,6 +96,8 @@ void ConvertOrientations::setupFilterParameters()
     parameters.push_back(parameter);
   }
 
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Batch Conversion", UseBatchConversion, FilterParameter::Parameter, ConvertOrientations));
+
   {
     DataArraySelectionFilterParameter::RequirementType req;
     req.daTypes = QVector<QString>(2, SIMPL::TypeNames::Double);
@@ -115,6 +120,7 @@ void ConvertOrientations::readFilterParameters(AbstractFilterParametersReader* r
   setOutputType(reader->readValue("OutputType", getOutputType()));
   setInputOrientationArrayPath(reader->readDataArrayPath("InputOrientationArrayPath", getInputOrientationArrayPath()));
   setOutputOrientationArrayName(reader->readString("OutputOrientationArrayName", getOutputOrientationArrayName()));
+  setUseBatchConversion(reader->readValue("UseBatchConversion", getUseBatchConversion()));
   reader->closeFilterGroup();
 }
 
@@ -226,6 +232,17 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
 {
   typedef typename DataArray<T>::Pointer ArrayType;
   typedef OrientationConverter<T> OCType;
+  QVector<typename OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
+  typename OCType::OrientationType inType = ocTypes[filter->getInputType()];
+  typename OCType::OrientationType outType = ocTypes[filter->getOutputType()];
+
+  // The batch kernels write straight into the output array instead of allocating an intermediate one
+  if(filter->getUseBatchConversion() && OrientationBatchConverter<T>::IsSupported(inType, outType))
+  {
+    OrientationBatchConverter<T>::Convert(inputOrientations->getPointer(0), outputOrientations->getPointer(0), inputOrientations->getNumberOfTuples(), inType, outType);
+    return;
+  }
+
   QVector<typename OCType::Pointer> converters(7);
 
   converters[0] = EulerConverter<T>::New();
@@ -236,10 +253,8 @@ template <typename T> void generateRepresentation(ConvertOrientations* filter, t
   converters[5] = HomochoricConverter<T>::New();
   converters[6] = CubochoricConverter<T>::New();
 
-  QVector<typename OCType::OrientationType> ocTypes = OCType::GetOrientationTypes();
-
   converters[filter->getInputType()]->setInputData(inputOrientations);
-  converters[filter->getInputType()]->convertRepresentationTo(ocTypes[filter->getOutputType()]);
+  converters[filter->getInputType()]->convertRepresentationTo(outType);
 
   ArrayType output = converters[filter->getInputType()]->getOutputData();
   if(nullptr == output.get())
@@ -55,6 +55,7 @@ class OrientationAnalysis_EXPORT ConvertOrientations : public AbstractFilter
     PYB11_PROPERTY(int OutputType READ getOutputType WRITE setOutputType)
     PYB11_PROPERTY(DataArrayPath InputOrientationArrayPath READ getInputOrientationArrayPath WRITE setInputOrientationArrayPath)
     PYB11_PROPERTY(QString OutputOrientationArrayName READ getOutputOrientationArrayName WRITE setOutputOrientationArrayName)
+    PYB11_PROPERTY(bool UseBatchConversion READ getUseBatchConversion WRITE setUseBatchConversion)
 public:
   SIMPL_SHARED_POINTERS(ConvertOrientations)
   SIMPL_FILTER_NEW_MACRO(ConvertOrientations)
@@ -74,6 +75,9 @@ public:
   SIMPL_FILTER_PARAMETER(QString, OutputOrientationArrayName)
   Q_PROPERTY(QString OutputOrientationArrayName READ getOutputOrientationArrayName WRITE setOutputOrientationArrayName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseBatchConversion)
+  Q_PROPERTY(bool UseBatchConversion READ getUseBatchConversion WRITE setUseBatchConversion)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -35,6 +35,14 @@
 
 #include "EbsdToH5Ebsd.h"
 
+#include <atomic>
+#include <memory>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include <QtCore/QDir>
 
 #include "H5Support/QH5Utilities.h"
@@ -42,6 +50,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "EbsdLib/HKL/H5CtfImporter.h"
@@ -51,6 +60,21 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+/**
+ * @brief The ParsedEbsdFile struct carries one input file from the parsing stage of the
+ * import pipeline to the stage that writes it into the HDF5 file.
+ */
+struct ParsedEbsdFile
+{
+  int32_t fileIndex = -1;
+  int32_t err = 0;
+  QString message;
+  std::shared_ptr<EbsdReader> reader;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -65,6 +89,7 @@ EbsdToH5Ebsd::EbsdToH5Ebsd()
 , m_FileSuffix("")
 , m_FileExtension("ang")
 , m_PaddingDigits(4)
+, m_CompressionLevel(0)
 {
   m_SampleTransformation.angle = 0.0f;
   m_SampleTransformation.h = 0.0f;
@@ -91,6 +116,7 @@ void EbsdToH5Ebsd::setupFilterParameters()
   FilterParameterVector parameters;
 
   parameters.push_back(EbsdToH5EbsdFilterParameter::New("Import Orientation Data", "OrientationData", getOutputFile(), FilterParameter::Parameter, this));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, EbsdToH5Ebsd));
 
   setFilterParameters(parameters);
 }
@@ -113,6 +139,7 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
   reader->closeFilterGroup();
 }
 
@@ -146,6 +173,13 @@ void EbsdToH5Ebsd::dataCheck()
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
 
+  if(m_CompressionLevel < 0 || m_CompressionLevel > 9)
+  {
+    ss = QObject::tr("The Compression Level must be between 0 (no compression) and 9");
+    setErrorCondition(-14);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
   bool hasMissingFiles = false;
   const bool stackLowToHigh = true;
   int increment = 1;
@@ -381,9 +415,6 @@ void EbsdToH5Ebsd::execute()
   }
 
   QVector<int32_t> indices;
-  // Loop on Each EBSD File
-  float total = static_cast<float>(m_ZEndIndex - m_ZStartIndex);
-  int32_t progress = 0;
   int64_t z = m_ZStartIndex;
   int64_t xDim = 0, yDim = 0;
   float xRes = 0.0f, yRes = 0.0f;
@@ -413,20 +444,26 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
-    progress = static_cast<int32_t>(z - m_ZStartIndex);
-    progress = (int32_t)(100.0f * (float)(progress) / total);
-    QString msg = "Converting File: " + ebsdFName;
+  fileImporter->setCompressionLevel(m_CompressionLevel);
 
+  // Writes one parsed file into the HDF5 file. This is only ever called for one file at a
+  // time and in file order, so the HDF5 library is never entered from two threads.
+  auto writeParsedFile = [&](const ParsedEbsdFile& parsed) -> bool {
+    QString msg = "Converting File: " + fileList.at(parsed.fileIndex);
     notifyStatusMessage(getHumanLabel(), msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName);
+    if(parsed.err < 0)
+    {
+      setErrorCondition(parsed.err);
+      notifyErrorMessage(getHumanLabel(), parsed.message, getErrorCondition());
+      return false;
+    }
+
+    err = fileImporter->writeFile(fileId, z, parsed.reader.get());
     if(err < 0)
     {
       setErrorCondition(err);
       notifyErrorMessage(getHumanLabel(), fileImporter->getPipelineMessage(), fileImporter->getErrorCondition());
-      return;
+      return false;
     }
     totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
 
@@ -441,21 +478,76 @@ void EbsdToH5Ebsd::execute()
       biggestyDim = yDim;
     }
 
-    if(err < 0)
-    {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1);
-      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    }
-
     indices.push_back(static_cast<int32_t>(z));
     ++z;
-    if(getCancel())
+    return !getCancel();
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    // Parse several files concurrently while a serial, in-order stage writes them out. The
+    // number of files in flight is bounded so only a few parsed slices are held in memory.
+    const size_t maxFilesInFlight = static_cast<size_t>(2 * tbb::task_scheduler_init::default_num_threads());
+    const int32_t numFiles = fileList.size();
+    int32_t fileIndex = 0;
+    std::atomic<bool> stopImport(false);
+    // The files in flight already occupy the TBB threads, so each one is parsed serially
+    // instead of starting its own set of parser threads.
+    fileImporter->setMaxParseThreads(1);
+
+    auto nextFile = [&](tbb::flow_control& fc) -> int32_t {
+      if(stopImport || fileIndex >= numFiles)
+      {
+        fc.stop();
+        return -1;
+      }
+      return fileIndex++;
+    };
+    auto parseFile = [&](int32_t index) -> std::shared_ptr<ParsedEbsdFile> {
+      std::shared_ptr<ParsedEbsdFile> parsed = std::make_shared<ParsedEbsdFile>();
+      parsed->fileIndex = index;
+      if(!stopImport)
+      {
+        parsed->err = fileImporter->parseFile(fileList.at(index), parsed->reader, parsed->message);
+      }
+      return parsed;
+    };
+    auto writeFile = [&](std::shared_ptr<ParsedEbsdFile> parsed) {
+      if(!stopImport && !writeParsedFile(*parsed))
+      {
+        stopImport = true;
+      }
+    };
+    tbb::parallel_pipeline(maxFilesInFlight, tbb::make_filter<void, int32_t>(tbb::filter::serial_in_order, nextFile) &
+                                                 tbb::make_filter<int32_t, std::shared_ptr<ParsedEbsdFile>>(tbb::filter::parallel, parseFile) &
+                                                 tbb::make_filter<std::shared_ptr<ParsedEbsdFile>, void>(tbb::filter::serial_in_order, writeFile));
+  }
+  else
+#endif
+  {
+    for(int32_t fileIndex = 0; fileIndex < fileList.size(); fileIndex++)
     {
-      return;
+      ParsedEbsdFile parsed;
+      parsed.fileIndex = fileIndex;
+      parsed.err = fileImporter->parseFile(fileList.at(fileIndex), parsed.reader, parsed.message);
+      if(!writeParsedFile(parsed))
+      {
+        break;
+      }
     }
   }
 
+  if(getErrorCondition() < 0 || getCancel())
+  {
+    return;
+  }
+
   // Write Z index start, Z index end and Z Resolution to the HDF5 file
   err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, m_ZStartIndex);
   if(err < 0)
@@ -541,6 +633,7 @@ AbstractFilter::Pointer EbsdToH5Ebsd::newFilterInstance(bool copyFilterParameter
     SIMPL_COPY_INSTANCEVAR(PaddingDigits)
     SIMPL_COPY_INSTANCEVAR(SampleTransformation)
     SIMPL_COPY_INSTANCEVAR(EulerTransformation)
+    SIMPL_COPY_INSTANCEVAR(CompressionLevel)
   }
   return filter;
 }
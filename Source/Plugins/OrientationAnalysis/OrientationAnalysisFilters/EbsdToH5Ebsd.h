@@ -59,6 +59,7 @@ class OrientationAnalysis_EXPORT EbsdToH5Ebsd : public AbstractFilter
     PYB11_PROPERTY(int PaddingDigits READ getPaddingDigits WRITE setPaddingDigits)
     PYB11_PROPERTY(AxisAngleInput_t SampleTransformation READ getSampleTransformation WRITE setSampleTransformation)
     PYB11_PROPERTY(AxisAngleInput_t EulerTransformation READ getEulerTransformation WRITE setEulerTransformation)
+    PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
 public:
   SIMPL_SHARED_POINTERS(EbsdToH5Ebsd)
   SIMPL_FILTER_NEW_MACRO(EbsdToH5Ebsd)
@@ -90,6 +91,9 @@ public:
 
   SIMPL_FILTER_PARAMETER(AxisAngleInput_t, EulerTransformation)
 
+  SIMPL_FILTER_PARAMETER(int, CompressionLevel)
+  Q_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
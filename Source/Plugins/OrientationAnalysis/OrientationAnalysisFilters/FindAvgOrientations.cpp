@@ -35,8 +35,18 @@
 
 #include "FindAvgOrientations.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -46,11 +56,109 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+/**
+ * @brief The FindAvgOrientationsImpl class averages the orientations of a range of features. The
+ * elements of each feature are visited in their original order, each one rotated to the symmetric
+ * equivalent nearest the running average of the ones before it. When refining, every element is then
+ * rotated again to the equivalent nearest that first average and the average is taken once more.
+ */
+class FindAvgOrientationsImpl
+{
+public:
+  FindAvgOrientationsImpl(const size_t* featureStarts, const size_t* featureElements, const int32_t* cellPhases, const uint32_t* crystalStructures, const QuatF* quats,
+                          const QVector<LaueOps::Pointer>& orientationOps, bool refineAverages, QuatF* avgQuats, float* featureEulerAngles)
+  : m_FeatureStarts(featureStarts)
+  , m_FeatureElements(featureElements)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(quats)
+  , m_OrientationOps(orientationOps)
+  , m_RefineAverages(refineAverages)
+  , m_AvgQuats(avgQuats)
+  , m_FeatureEulerAngles(featureEulerAngles)
+  {
+  }
+  virtual ~FindAvgOrientationsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    QuatF voxquat = QuaternionMathF::New();
+    QuatF curavgquat = QuaternionMathF::New();
+    for(size_t i = start; i < end; i++)
+    {
+      QuatF& avgQuat = m_AvgQuats[i];
+      QuaternionMathF::ElementWiseAssign(avgQuat, 0.0);
+      float count = 0.0f;
+      for(size_t j = m_FeatureStarts[i]; j < m_FeatureStarts[i + 1]; j++)
+      {
+        size_t point = m_FeatureElements[j];
+        count += 1.0f;
+        QuaternionMathF::Copy(m_Quats[point], voxquat);
+        QuaternionMathF::Copy(avgQuat, curavgquat);
+        QuaternionMathF::ScalarDivide(curavgquat, count);
+
+        if(count == 1.0f)
+        {
+          QuaternionMathF::Identity(curavgquat);
+        }
+        m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]]->getNearestQuat(curavgquat, voxquat);
+        QuaternionMathF::Add(avgQuat, voxquat, avgQuat);
+      }
+
+      if(count == 0.0f)
+      {
+        QuaternionMathF::Identity(avgQuat);
+      }
+      QuaternionMathF::ScalarDivide(avgQuat, count);
+      QuaternionMathF::UnitQuaternion(avgQuat);
+
+      if(m_RefineAverages && count > 0.0f)
+      {
+        QuaternionMathF::Copy(avgQuat, curavgquat);
+        QuaternionMathF::ElementWiseAssign(avgQuat, 0.0);
+        for(size_t j = m_FeatureStarts[i]; j < m_FeatureStarts[i + 1]; j++)
+        {
+          size_t point = m_FeatureElements[j];
+          QuaternionMathF::Copy(m_Quats[point], voxquat);
+          m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]]->getNearestQuat(curavgquat, voxquat);
+          QuaternionMathF::Add(avgQuat, voxquat, avgQuat);
+        }
+        QuaternionMathF::ScalarDivide(avgQuat, count);
+        QuaternionMathF::UnitQuaternion(avgQuat);
+      }
+
+      FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
+      FOrientTransformsType::qu2eu(FOrientArrayType(avgQuat), eu);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const size_t* m_FeatureStarts;
+  const size_t* m_FeatureElements;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const QuatF* m_Quats;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  bool m_RefineAverages;
+  QuatF* m_AvgQuats;
+  float* m_FeatureEulerAngles;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 FindAvgOrientations::FindAvgOrientations()
-: m_FeatureIdsArrayPath("", "", "")
+: m_RefineAverages(false)
+, m_FeatureIdsArrayPath("", "", "")
 , m_CellPhasesArrayPath("", "", "")
 , m_QuatsArrayPath("", "", "")
 , m_CrystalStructuresArrayPath("", "", "")
@@ -72,6 +180,7 @@ FindAvgOrientations::~FindAvgOrientations() = default;
 void FindAvgOrientations::setupFilterParameters()
 {
   FilterParameterVector parameters;
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Refine Average Orientations", RefineAverages, FilterParameter::Parameter, FindAvgOrientations));
   parameters.push_back(SeparatorFilterParameter::New("Element Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateCategoryRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Category::Element);
@@ -109,6 +218,7 @@ void FindAvgOrientations::setupFilterParameters()
 void FindAvgOrientations::readFilterParameters(AbstractFilterParametersReader* reader, int index)
 {
   reader->openFilterGroup(this, index);
+  setRefineAverages(reader->readValue("RefineAverages", getRefineAverages()));
   setAvgEulerAnglesArrayPath(reader->readDataArrayPath("AvgEulerAnglesArrayPath", getAvgEulerAnglesArrayPath()));
   setAvgQuatsArrayPath(reader->readDataArrayPath("AvgQuatsArrayPath", getAvgQuatsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
@@ -225,50 +335,55 @@ void FindAvgOrientations::execute()
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_AvgQuatsPtr.lock()->getNumberOfTuples();
 
-  std::vector<float> counts(totalFeatures, 0.0f);
-
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  for(size_t i = 1; i < totalFeatures; i++)
+  // Bucket the elements by feature, keeping their original order within each feature, so the
+  // features can then be averaged independently of each other
+  std::vector<size_t> featureStarts(totalFeatures + 1, 0);
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
+    if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
+    {
+      featureStarts[m_FeatureIds[i] + 1]++;
+    }
   }
-
+  for(size_t i = 1; i <= totalFeatures; i++)
+  {
+    featureStarts[i] += featureStarts[i - 1];
+  }
+  std::vector<size_t> featureElements(featureStarts[totalFeatures]);
+  std::vector<size_t> nextElement(featureStarts.begin(), featureStarts.end() - 1);
   for(size_t i = 0; i < totalPoints; i++)
   {
     if(m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
     {
-      counts[m_FeatureIds[i]] += 1.0f;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
-
-      if(counts[m_FeatureIds[i]] == 1.0f)
-      {
-        QuaternionMathF::Identity(curavgquat);
-      }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
+      featureElements[nextElement[m_FeatureIds[i]]++] = i;
     }
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  if(getCancel())
   {
-    if(counts[i] == 0.0f)
-    {
-      QuaternionMathF::Identity(avgQuats[i]);
-    }
-    QuaternionMathF::ScalarDivide(avgQuats[i], counts[i]);
-    QuaternionMathF::UnitQuaternion(avgQuats[i]);
+    return;
+  }
+
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-    FOrientArrayType eu(m_FeatureEulerAngles + (3 * i), 3);
-    FOrientTransformsType::qu2eu(FOrientArrayType(avgQuats[i]), eu);
+  FindAvgOrientationsImpl impl(featureStarts.data(), featureElements.data(), m_CellPhases, m_CrystalStructures, quats, m_OrientationOps, m_RefineAverages, avgQuats, m_FeatureEulerAngles);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel && totalFeatures > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, totalFeatures), impl, tbb::auto_partitioner());
   }
+  else
+#endif
+  {
+    impl.convert(1, totalFeatures);
+  }
+
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
@@ -50,6 +50,7 @@ class OrientationAnalysis_EXPORT FindAvgOrientations : public AbstractFilter
 {
   Q_OBJECT
     PYB11_CREATE_BINDINGS(FindAvgOrientations SUPERCLASS AbstractFilter)
+    PYB11_PROPERTY(bool RefineAverages READ getRefineAverages WRITE setRefineAverages)
     PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
     PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
     PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
@@ -63,6 +64,9 @@ public:
 
   ~FindAvgOrientations() override;
 
+  SIMPL_FILTER_PARAMETER(bool, RefineAverages)
+  Q_PROPERTY(bool RefineAverages READ getRefineAverages WRITE setRefineAverages)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureIdsArrayPath)
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
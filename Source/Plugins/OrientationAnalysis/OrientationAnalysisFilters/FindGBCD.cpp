@@ -35,6 +35,7 @@
 
 #include "FindGBCD.h"
 #include <utility>
+#include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/blocked_range.h>
@@ -57,6 +58,7 @@
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -82,6 +84,7 @@ class CalculateGBCDImpl
 
   UInt32ArrayType::Pointer m_CrystalStructuresArray;
   QVector<LaueOps::Pointer> m_OrientationOps;
+  ModifiedLambertProjection::Pointer m_LambertProjection;
 
 public:
   CalculateGBCDImpl(size_t i,
@@ -110,6 +113,9 @@ public:
   , m_CrystalStructuresArray(std::move(crystalStructures))
   {
     m_OrientationOps = LaueOps::getOrientationOpsQVector();
+    // Only the square coordinates are needed, so the projection is kept at a single bin
+    m_LambertProjection = ModifiedLambertProjection::New();
+    m_LambertProjection->initializeSquares(1, 1.0f);
   }
   virtual ~CalculateGBCDImpl() = default;
 
@@ -148,6 +154,12 @@ public:
     float sqCoord[2] = {0.0f, 0.0f}, sqCoordInv[2] = {0.0f, 0.0f};
     bool nhCheck = false, nhCheckInv = true;
     int32_t SYMcounter = 0;
+    std::vector<float> normX;
+    std::vector<float> normY;
+    std::vector<float> normZ;
+    std::vector<float> sqX;
+    std::vector<float> sqY;
+    std::vector<uint8_t> north;
     auto TRIcounter = static_cast<int64_t>(start - startOffset);
     int64_t TRIcounterShift = 0;
 
@@ -194,6 +206,12 @@ public:
           om.toGMatrix(g2);
 
           int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
+          normX.resize(nsym);
+          normY.resize(nsym);
+          normZ.resize(nsym);
+          sqX.resize(nsym);
+          sqY.resize(nsym);
+          north.resize(nsym);
           for(j = 0; j < nsym; j++)
           {
             // rotate g1 by symOp
@@ -201,8 +219,21 @@ public:
             MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
             // get the crystal directions along the triangle normals
             MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
-            // get coordinates in square projection of crystal normal parallel to boundary normal
-            nhCheck = getSquareCoord(xstl1_norm1, sqCoord);
+            normX[j] = xstl1_norm1[0];
+            normY[j] = xstl1_norm1[1];
+            normZ[j] = xstl1_norm1[2];
+          }
+          // get coordinates in square projection of crystal normals parallel to boundary normal
+          m_LambertProjection->getSquareCoords(normX.data(), normY.data(), normZ.data(), nsym, sqX.data(), sqY.data(), north.data());
+
+          for(j = 0; j < nsym; j++)
+          {
+            // rotate g1 by symOp
+            m_OrientationOps[cryst]->getMatSymOp(j, sym1);
+            MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+            sqCoord[0] = sqX[j];
+            sqCoord[1] = sqY[j];
+            nhCheck = (north[j] != 0);
             if(inversion == 1)
             {
               sqCoordInv[0] = -sqCoord[0];
@@ -326,29 +357,6 @@ public:
 
     return gbcd_index;
   }
-
-  bool getSquareCoord(float* xstl1_norm1, float* sqCoord) const
-  {
-    bool nhCheck = false;
-    float adjust = 1.0;
-    if(xstl1_norm1[2] >= 0.0)
-    {
-      adjust = -1.0;
-      nhCheck = true;
-    }
-    if(fabsf(xstl1_norm1[0]) >= fabsf(xstl1_norm1[1]))
-    {
-      sqCoord[0] = (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
-      sqCoord[1] =
-          (xstl1_norm1[0] / fabsf(xstl1_norm1[0])) * sqrtf(2.0f * 1.0f * (1.0f + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[1] / xstl1_norm1[0]));
-    }
-    else
-    {
-      sqCoord[0] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * ((2.0f / SIMPLib::Constants::k_SqrtPi) * atanf(xstl1_norm1[0] / xstl1_norm1[1]));
-      sqCoord[1] = (xstl1_norm1[1] / fabsf(xstl1_norm1[1])) * sqrtf(2.0 * 1.0 * (1.0 + (xstl1_norm1[2] * adjust))) * (SIMPLib::Constants::k_SqrtPi / 2.0f);
-    }
-    return nhCheck;
-  }
 };
 
 // -----------------------------------------------------------------------------
@@ -35,6 +35,18 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -48,6 +60,310 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+namespace
+{
+// The pair cache is only used if it fits in this many bytes, otherwise every kernel is evaluated on its own
+const size_t k_MaxPairCacheBytes = 256 * 1024 * 1024;
+
+/**
+ * @brief kernelMisorientation Returns the misorientation in degrees from q1 to q2 using the given Laue class.
+ */
+inline float kernelMisorientation(const LaueOps::Pointer& ops, const QuatF& q1, const QuatF& q2)
+{
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+  QuatF qa = QuaternionMathF::New();
+  QuatF qb = QuaternionMathF::New();
+  QuaternionMathF::Copy(q1, qa);
+  QuaternionMathF::Copy(q2, qb);
+  float w = ops->getMisoQuat(qa, qb, n1, n2, n3);
+  return w * (180.0f / SIMPLib::Constants::k_Pi);
+}
+
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class finds the kernel average misorientation of the voxels in a
+ * range of x rows. Each voxel walks its own kernel in z, y, x order and finds the misorientation from itself to
+ * every kernel voxel of the same feature with the Laue class of its own phase, so the voxels are independent of
+ * each other and the averages do not depend on how the rows are split between threads.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(const int64_t* dims, const int32_t* kernelMin, const int32_t* kernelMax, const int32_t* featureIds, const int32_t* cellPhases,
+                                   const uint32_t* crystalStructures, const QuatF* quats, const QVector<LaueOps::Pointer>& orientationOps, float* kernelAverageMisorientations)
+  : m_Dims(dims)
+  , m_KernelMin(kernelMin)
+  , m_KernelMax(kernelMax)
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(quats)
+  , m_OrientationOps(orientationOps)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  {
+  }
+  virtual ~FindKernelAvgMisorientationsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+    for(size_t r = start; r < end; r++)
+    {
+      int64_t row = static_cast<int64_t>(r) % yPoints;
+      int64_t plane = static_cast<int64_t>(r) / yPoints;
+      // Clip the kernel to the volume once per row instead of once per kernel voxel
+      int64_t jStart = std::max<int64_t>(m_KernelMin[2], -plane);
+      int64_t jEnd = std::min<int64_t>(m_KernelMax[2], zPoints - 1 - plane);
+      int64_t kStart = std::max<int64_t>(m_KernelMin[1], -row);
+      int64_t kEnd = std::min<int64_t>(m_KernelMax[1], yPoints - 1 - row);
+      for(int64_t col = 0; col < xPoints; col++)
+      {
+        int64_t point = (plane * yPoints + row) * xPoints + col;
+        if(m_FeatureIds[point] <= 0 || m_CellPhases[point] <= 0)
+        {
+          if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+          {
+            m_KernelAverageMisorientations[point] = 0.0f;
+          }
+          continue;
+        }
+        int64_t lStart = std::max<int64_t>(m_KernelMin[0], -col);
+        int64_t lEnd = std::min<int64_t>(m_KernelMax[0], xPoints - 1 - col);
+        float totalMisorientation = 0.0f;
+        int32_t numVoxel = 0;
+        const LaueOps::Pointer& ops = m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]];
+        for(int64_t j = jStart; j <= jEnd; j++)
+        {
+          for(int64_t k = kStart; k <= kEnd; k++)
+          {
+            int64_t neighbor = point + (j * yPoints + k) * xPoints + lStart;
+            for(int64_t l = lStart; l <= lEnd; l++, neighbor++)
+            {
+              if(m_FeatureIds[point] == m_FeatureIds[neighbor])
+              {
+                totalMisorientation = totalMisorientation + kernelMisorientation(ops, m_Quats[point], m_Quats[neighbor]);
+                numVoxel++;
+              }
+            }
+          }
+        }
+        m_KernelAverageMisorientations[point] = (numVoxel == 0) ? 0.0f : totalMisorientation / static_cast<float>(numVoxel);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const int64_t* m_Dims;
+  const int32_t* m_KernelMin;
+  const int32_t* m_KernelMax;
+  const int32_t* m_FeatureIds;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const QuatF* m_Quats;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float* m_KernelAverageMisorientations;
+};
+
+/**
+ * @brief The KernelPairCacheImpl class finds the kernel average misorientations one z plane at a time and
+ * finds the misorientation of each pair of kernel voxels only once. When a plane is filled, every voxel stores
+ * the misorientation to each voxel at a forward offset (one that comes later in memory). The kernel of that
+ * voxel reads the value back for the forward offset and the kernel of the other voxel reads it for the mirrored
+ * offset. The cache holds the planes that the kernels of the current plane reach back to, one value per voxel
+ * and forward offset, so its size does not depend on the number of planes. A pair is only stored if both voxels
+ * are in the same feature and have the same Laue class. Any other pair is found directly by the kernel that needs it.
+ */
+class KernelPairCacheImpl
+{
+public:
+  KernelPairCacheImpl(const int64_t* dims, const int32_t* kernelMin, const int32_t* kernelMax, const std::vector<int32_t>& pairOffsets, const std::vector<int32_t>& kernelSlots,
+                      int64_t cachePlanes, float* cache, const int32_t* featureIds, const int32_t* cellPhases, const uint32_t* crystalStructures, const QuatF* quats,
+                      const QVector<LaueOps::Pointer>& orientationOps, float* kernelAverageMisorientations)
+  : m_Dims(dims)
+  , m_KernelMin(kernelMin)
+  , m_KernelMax(kernelMax)
+  , m_PairOffsets(pairOffsets)
+  , m_KernelSlots(kernelSlots)
+  , m_CachePlanes(cachePlanes)
+  , m_Cache(cache)
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(quats)
+  , m_OrientationOps(orientationOps)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  {
+  }
+  virtual ~KernelPairCacheImpl() = default;
+
+  /**
+   * @brief setPlane Selects the z plane the next rows belong to and whether they fill the cache or
+   * find the averages
+   */
+  void setPlane(int64_t plane, bool fill)
+  {
+    m_Plane = plane;
+    m_Fill = fill;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    if(m_Fill)
+    {
+      fillRows(static_cast<int64_t>(start), static_cast<int64_t>(end));
+    }
+    else
+    {
+      averageRows(static_cast<int64_t>(start), static_cast<int64_t>(end));
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* cachePlane(int64_t plane) const
+  {
+    size_t numSlots = m_PairOffsets.size() / 3;
+    return m_Cache + static_cast<size_t>(plane % m_CachePlanes) * numSlots * static_cast<size_t>(m_Dims[0] * m_Dims[1]);
+  }
+
+  void fillRows(int64_t start, int64_t end) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+    int64_t planeSize = xPoints * yPoints;
+    size_t numSlots = m_PairOffsets.size() / 3;
+    float* cache = cachePlane(m_Plane);
+    for(int64_t row = start; row < end; row++)
+    {
+      for(int64_t col = 0; col < xPoints; col++)
+      {
+        int64_t inPlane = row * xPoints + col;
+        int64_t point = m_Plane * planeSize + inPlane;
+        bool good = (m_FeatureIds[point] > 0 && m_CellPhases[point] > 0);
+        for(size_t s = 0; s < numSlots; s++)
+        {
+          float w = std::numeric_limits<float>::quiet_NaN();
+          int64_t j = m_PairOffsets[3 * s];
+          int64_t k = m_PairOffsets[3 * s + 1];
+          int64_t l = m_PairOffsets[3 * s + 2];
+          if(good && m_Plane + j < zPoints && row + k >= 0 && row + k < yPoints && col + l >= 0 && col + l < xPoints)
+          {
+            int64_t neighbor = point + (j * yPoints + k) * xPoints + l;
+            if(m_FeatureIds[neighbor] == m_FeatureIds[point] && m_CellPhases[neighbor] > 0 &&
+               m_CrystalStructures[m_CellPhases[neighbor]] == m_CrystalStructures[m_CellPhases[point]])
+            {
+              w = kernelMisorientation(m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]], m_Quats[point], m_Quats[neighbor]);
+            }
+          }
+          cache[s * planeSize + inPlane] = w;
+        }
+      }
+    }
+  }
+
+  void averageRows(int64_t start, int64_t end) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+    int64_t planeSize = xPoints * yPoints;
+    int64_t kernelY = m_KernelMax[1] - m_KernelMin[1] + 1;
+    int64_t kernelX = m_KernelMax[0] - m_KernelMin[0] + 1;
+    int64_t plane = m_Plane;
+    int64_t jStart = std::max<int64_t>(m_KernelMin[2], -plane);
+    int64_t jEnd = std::min<int64_t>(m_KernelMax[2], zPoints - 1 - plane);
+    for(int64_t row = start; row < end; row++)
+    {
+      int64_t kStart = std::max<int64_t>(m_KernelMin[1], -row);
+      int64_t kEnd = std::min<int64_t>(m_KernelMax[1], yPoints - 1 - row);
+      for(int64_t col = 0; col < xPoints; col++)
+      {
+        int64_t inPlane = row * xPoints + col;
+        int64_t point = plane * planeSize + inPlane;
+        if(m_FeatureIds[point] <= 0 || m_CellPhases[point] <= 0)
+        {
+          if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+          {
+            m_KernelAverageMisorientations[point] = 0.0f;
+          }
+          continue;
+        }
+        int64_t lStart = std::max<int64_t>(m_KernelMin[0], -col);
+        int64_t lEnd = std::min<int64_t>(m_KernelMax[0], xPoints - 1 - col);
+        float totalMisorientation = 0.0f;
+        int32_t numVoxel = 0;
+        const LaueOps::Pointer& ops = m_OrientationOps[m_CrystalStructures[m_CellPhases[point]]];
+        for(int64_t j = jStart; j <= jEnd; j++)
+        {
+          for(int64_t k = kStart; k <= kEnd; k++)
+          {
+            int64_t offset = (j * yPoints + k) * xPoints;
+            const int32_t* slots = m_KernelSlots.data() + ((j - m_KernelMin[2]) * kernelY + (k - m_KernelMin[1])) * kernelX - m_KernelMin[0];
+            for(int64_t l = lStart; l <= lEnd; l++)
+            {
+              int64_t neighbor = point + offset + l;
+              if(m_FeatureIds[point] != m_FeatureIds[neighbor])
+              {
+                continue;
+              }
+              // A positive slot is a forward offset stored with this voxel, a negative one is the
+              // mirror of the forward offset stored with the neighbor
+              float w = std::numeric_limits<float>::quiet_NaN();
+              int32_t slot = slots[l];
+              if(slot > 0)
+              {
+                w = cachePlane(plane)[(slot - 1) * planeSize + inPlane];
+              }
+              else if(slot < 0)
+              {
+                w = cachePlane(plane + j)[(-slot - 1) * planeSize + inPlane + k * xPoints + l];
+              }
+              if(std::isnan(w))
+              {
+                w = kernelMisorientation(ops, m_Quats[point], m_Quats[neighbor]);
+              }
+              totalMisorientation = totalMisorientation + w;
+              numVoxel++;
+            }
+          }
+        }
+        m_KernelAverageMisorientations[point] = (numVoxel == 0) ? 0.0f : totalMisorientation / static_cast<float>(numVoxel);
+      }
+    }
+  }
+
+  const int64_t* m_Dims;
+  const int32_t* m_KernelMin;
+  const int32_t* m_KernelMax;
+  const std::vector<int32_t>& m_PairOffsets;
+  const std::vector<int32_t>& m_KernelSlots;
+  int64_t m_CachePlanes;
+  float* m_Cache;
+  const int32_t* m_FeatureIds;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const QuatF* m_Quats;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float* m_KernelAverageMisorientations;
+  int64_t m_Plane = 0;
+  bool m_Fill = true;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -220,99 +536,104 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
+  int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+  size_t numRows = udims[1] * udims[2];
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-  for(int64_t col = 0; col < xPoints; col++)
+  // The kernel has always spanned -x radius to +z radius along x. That extent is kept so the
+  // averages do not change.
+  int32_t kernelMin[3] = {-m_KernelSize.x, -m_KernelSize.y, -m_KernelSize.z};
+  int32_t kernelMax[3] = {m_KernelSize.z, m_KernelSize.y, m_KernelSize.z};
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Every pair of kernel voxels is a forward offset from one of its two voxels. Each forward offset whose
+  // offset or mirrored offset is in the kernel gets a slot in the pair cache, and each kernel offset
+  // points at the slot it reads.
+  int64_t kernelDims[3] = {kernelMax[0] - kernelMin[0] + 1, kernelMax[1] - kernelMin[1] + 1, kernelMax[2] - kernelMin[2] + 1};
+  std::vector<int32_t> kernelSlots(static_cast<size_t>(kernelDims[0] * kernelDims[1] * kernelDims[2]), 0);
+  std::vector<int32_t> pairOffsets;
+  int32_t reach[3] = {std::max(-kernelMin[0], kernelMax[0]), std::max(-kernelMin[1], kernelMax[1]), std::max(-kernelMin[2], kernelMax[2])};
+  for(int32_t j = 0; j <= reach[2]; j++)
   {
-    for(int64_t row = 0; row < yPoints; row++)
+    for(int32_t k = -reach[1]; k <= reach[1]; k++)
     {
-      for(int64_t plane = 0; plane < zPoints; plane++)
+      for(int32_t l = -reach[0]; l <= reach[0]; l++)
       {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
+        if(j == 0 && (k < 0 || (k == 0 && l <= 0)))
         {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
+          continue;
+        }
+        bool forward = (j <= kernelMax[2] && k >= kernelMin[1] && k <= kernelMax[1] && l >= kernelMin[0] && l <= kernelMax[0]);
+        bool mirrored = (-j >= kernelMin[2] && -k >= kernelMin[1] && -k <= kernelMax[1] && -l >= kernelMin[0] && -l <= kernelMax[0]);
+        if(!forward && !mirrored)
+        {
+          continue;
+        }
+        int32_t slot = static_cast<int32_t>(pairOffsets.size() / 3) + 1;
+        pairOffsets.push_back(j);
+        pairOffsets.push_back(k);
+        pairOffsets.push_back(l);
+        if(forward)
+        {
+          kernelSlots[static_cast<size_t>(((j - kernelMin[2]) * kernelDims[1] + (k - kernelMin[1])) * kernelDims[0] + (l - kernelMin[0]))] = slot;
+        }
+        if(mirrored)
+        {
+          kernelSlots[static_cast<size_t>(((-j - kernelMin[2]) * kernelDims[1] + (-k - kernelMin[1])) * kernelDims[0] + (-l - kernelMin[0]))] = -slot;
+        }
+      }
+    }
+  }
+
+  // The kernels of a plane read pairs stored with the planes down to -z radius below it
+  int64_t cachePlanes = std::min<int64_t>(-kernelMin[2], dims[2] - 1) + 1;
+  size_t cacheSize = static_cast<size_t>(cachePlanes) * (pairOffsets.size() / 3) * udims[0] * udims[1];
+  if(cacheSize * sizeof(float) > k_MaxPairCacheBytes)
+  {
+    FindKernelAvgMisorientationsImpl impl(dims, kernelMin, kernelMax, m_FeatureIds, m_CellPhases, m_CrystalStructures, quats, m_OrientationOps, m_KernelAverageMisorientations);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numRows);
+    }
+  }
+  else
+  {
+    std::vector<float> cache(cacheSize);
+    KernelPairCacheImpl impl(dims, kernelMin, kernelMax, pairOffsets, kernelSlots, cachePlanes, cache.data(), m_FeatureIds, m_CellPhases, m_CrystalStructures, quats, m_OrientationOps,
+                             m_KernelAverageMisorientations);
+    for(int64_t plane = 0; plane < dims[2]; plane++)
+    {
+      for(int32_t pass = 0; pass < 2; pass++)
+      {
+        impl.setPlane(plane, pass == 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        if(doParallel)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, udims[1]), impl, tbb::auto_partitioner());
         }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+        else
+#endif
         {
-          m_KernelAverageMisorientations[point] = 0.0f;
+          impl.convert(0, udims[1]);
         }
       }
+      if(getCancel())
+      {
+        return;
+      }
     }
   }
 
@@ -235,37 +235,36 @@ void FindMisorientations::execute()
 
   std::vector<std::vector<float>> misorientationlists;
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float w = 0.0f;
   size_t tempMisoList = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   uint32_t xtalType1 = 0, xtalType2 = 0;
   int32_t nname = 0;
 
+  // Pairs with matching crystal structures are gathered per Feature and handed to the Laue class in one batch
+  std::vector<QuatF> pairQuats1;
+  std::vector<QuatF> pairQuats2;
+  std::vector<float> pairAngles;
+  std::vector<size_t> pairNeighbors;
+
   misorientationlists.resize(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
     xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
     misorientationlists[i].assign(neighborlist[i].size(), -1.0);
+    tempMisoList = neighborlist[i].size();
+    pairQuats1.clear();
+    pairQuats2.clear();
+    pairNeighbors.clear();
     for(size_t j = 0; j < neighborlist[i].size(); j++)
     {
-      w = std::numeric_limits<float>::max();
       nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
       xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = neighborlist[i].size();
       if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(m_OrientationOps.size()))
       {
-        w = m_OrientationOps[xtalType1]->getMisoQuat(q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
-        if(m_FindAvgMisors)
-        {
-          m_AvgMisorientations[i] += misorientationlists[i][j];
-        }
+        pairQuats1.push_back(avgQuats[i]);
+        pairQuats2.push_back(avgQuats[nname]);
+        pairNeighbors.push_back(j);
       }
       else
       {
@@ -276,6 +275,19 @@ void FindMisorientations::execute()
         misorientationlists[i][j] = NAN;
       }
     }
+    if(!pairNeighbors.empty())
+    {
+      pairAngles.resize(pairNeighbors.size());
+      m_OrientationOps[xtalType1]->getMisoQuats(pairQuats1.data(), pairQuats2.data(), pairNeighbors.size(), pairAngles.data(), nullptr);
+      for(size_t k = 0; k < pairNeighbors.size(); k++)
+      {
+        misorientationlists[i][pairNeighbors[k]] = pairAngles[k] * SIMPLib::Constants::k_180OverPi;
+        if(m_FindAvgMisors)
+        {
+          m_AvgMisorientations[i] += misorientationlists[i][pairNeighbors[k]];
+        }
+      }
+    }
     if(m_FindAvgMisors)
     {
       if(tempMisoList != 0)
@@ -38,12 +38,10 @@
 #include <vector>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task_group.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
-#include <tbb/tick_count.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -55,54 +53,98 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Processing/ProcessingFilters/HelperClasses/VoxelNeighborPropagation.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-class NeighborOrientationCorrelationTransferDataImpl
+namespace
+{
+/**
+ * @brief The FindBestNeighborImpl class scores each neighbor of a low confidence voxel by how many
+ * of the other neighbors share its phase and lie within the misorientation tolerance of it, and
+ * records the last neighbor, in the order -z, -y, -x, +x, +y, +z, that has a non zero score.
+ */
+class FindBestNeighborImpl
 {
 public:
-  NeighborOrientationCorrelationTransferDataImpl() = delete;
-  NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default;
-
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, size_t totalPoints, const std::vector<int64_t>& bestNeighbor, IDataArray::Pointer dataArrayPtr)
-  : m_Filter(filter)
-  , m_TotalPoints(totalPoints)
+  FindBestNeighborImpl(const VoxelNeighborPropagation::Neighborhood& neighborhood, const float* confidenceIndex, float minConfidence, const QuatF* quats, const int32_t* cellPhases,
+                       const uint32_t* crystalStructures, const QVector<LaueOps::Pointer>& orientationOps, float tolerance, int64_t* bestNeighbor)
+  : m_Neighborhood(neighborhood)
+  , m_ConfidenceIndex(confidenceIndex)
+  , m_MinConfidence(minConfidence)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_Tolerance(tolerance)
   , m_BestNeighbor(bestNeighbor)
-  , m_DataArrayPtr(dataArrayPtr)
   {
   }
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelationTransferDataImpl&&) = default;                // Move Constructor Not Implemented
-  NeighborOrientationCorrelationTransferDataImpl& operator=(const NeighborOrientationCorrelationTransferDataImpl&) = delete; // Copy Assignment Not Implemented
-  NeighborOrientationCorrelationTransferDataImpl& operator=(NeighborOrientationCorrelationTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
+  virtual ~FindBestNeighborImpl() = default;
 
-  ~NeighborOrientationCorrelationTransferDataImpl() = default;
-
-  void operator()() const
+  void convert(size_t start, size_t end) const
   {
-    size_t progIncrement = static_cast<size_t>(m_TotalPoints / 50);
-    size_t prog = 1;
-    for(size_t i = 0; i < m_TotalPoints; i++)
+    const int32_t numNeighbors = VoxelNeighborPropagation::Neighborhood::k_NumNeighbors;
+    for(size_t i = start; i < end; i++)
     {
-      if(i > prog)
+      if(m_ConfidenceIndex[i] >= m_MinConfidence)
+      {
+        continue;
+      }
+      int64_t point = static_cast<int64_t>(i);
+      uint8_t mask = m_Neighborhood.getMask(point);
+      int32_t neighborSimCount[numNeighbors] = {0, 0, 0, 0, 0, 0};
+      for(int32_t j = 0; j < numNeighbors; j++)
       {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
+        if((mask & (1 << j)) == 0)
+        {
+          continue;
+        }
+        int64_t neighbor = point + m_Neighborhood.getOffset(j);
+        int32_t phase = m_CellPhases[neighbor];
+        for(int32_t k = j + 1; k < numNeighbors; k++)
+        {
+          if((mask & (1 << k)) == 0)
+          {
+            continue;
+          }
+          int64_t neighbor2 = point + m_Neighborhood.getOffset(k);
+          if(phase > 0 && m_CellPhases[neighbor2] == phase && m_OrientationOps[m_CrystalStructures[phase]]->isMisoQuatBelow(m_Quats[neighbor2], m_Quats[neighbor], m_Tolerance))
+          {
+            neighborSimCount[j]++;
+            neighborSimCount[k]++;
+          }
+        }
       }
-      int64_t neighbor = m_BestNeighbor[i];
-      if(neighbor != -1)
+      for(int32_t j = 0; j < numNeighbors; j++)
       {
-        // IDataArray::Pointer p = m_AttrMat->getAttributeArray(m_VoxelArrayNames[m_VoxelArrayIndex]);
-        m_DataArrayPtr->copyTuple(neighbor, i);
+        if(neighborSimCount[j] > 0)
+        {
+          m_BestNeighbor[i] = point + m_Neighborhood.getOffset(j);
+        }
       }
     }
   }
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
 private:
-  NeighborOrientationCorrelation* m_Filter = nullptr;
-  size_t m_TotalPoints = 0;
-  std::vector<int64_t> m_BestNeighbor;
-  IDataArray::Pointer m_DataArrayPtr;
+  const VoxelNeighborPropagation::Neighborhood& m_Neighborhood;
+  const float* m_ConfidenceIndex;
+  float m_MinConfidence;
+  const QuatF* m_Quats;
+  const int32_t* m_CellPhases;
+  const uint32_t* m_CrystalStructures;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  float m_Tolerance;
+  int64_t* m_BestNeighbor;
 };
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -270,9 +312,6 @@ void NeighborOrientationCorrelation::execute()
     return;
   }
 
-  m_Progress = 0;
-  m_TotalProgress = 0;
-
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_ConfidenceIndexArrayPath.getDataContainerName());
   size_t totalPoints = m_ConfidenceIndexPtr.lock()->getNumberOfTuples();
 
@@ -281,35 +320,26 @@ void NeighborOrientationCorrelation::execute()
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  size_t count = 1;
-  int32_t best = 0;
-  bool good = true;
-  bool good2 = true;
-  int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
-  int64_t column = 0, row = 0, plane = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
-
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  std::vector<int32_t> neighborDiffCount(totalPoints, 0);
-  std::vector<int32_t> neighborSimCount(6, 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
+
+  QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+  {
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+  }
+
+  VoxelNeighborPropagation::Neighborhood neighborhood(udims);
+  VoxelNeighborPropagation::TupleTransfer transfer(m->getAttributeMatrix(attrMatName), voxelArrayNames);
+
   std::vector<int64_t> bestNeighbor(totalPoints, -1);
+  std::vector<int64_t> targets;
+  std::vector<int64_t> sources;
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
   const int32_t startLevel = 6;
@@ -320,221 +350,42 @@ void NeighborOrientationCorrelation::execute()
       break;
     }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      if(int64_t(i) > prog)
-      {
-        progressInt = static_cast<int64_t>((static_cast<float>(i) / totalPoints) * 100.0f);
-        QString ss = QObject::tr("Level %1 of %2 || Processing Data %3%").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level).arg(progressInt);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        prog = prog + progIncrement;
-      }
-
-      if(m_ConfidenceIndex[i] < m_MinConfidence)
-      {
-        count = 0;
-        column = static_cast<int64_t>(i % dims[0]);
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        for(size_t j = 0; j < 6; j++)
-        {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
-
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
-
-            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
-            {
-              w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-            }
-            if(w > misorientationToleranceR)
-            {
-              neighborDiffCount[i]++;
-            }
-            for(size_t k = j + 1; k < 6; k++)
-            {
-              good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
-              if(k == 0 && plane == 0)
-              {
-                good2 = false;
-              }
-              if(k == 5 && plane == (dims[2] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 1 && row == 0)
-              {
-                good2 = false;
-              }
-              if(k == 4 && row == (dims[1] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 2 && column == 0)
-              {
-                good2 = false;
-              }
-              if(k == 3 && column == (dims[0] - 1))
-              {
-                good2 = false;
-              }
-              if(good2)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                }
-                if(w < misorientationToleranceR)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
-              }
-            }
-          }
-        }
-        for(size_t j = 0; j < 6; j++)
-        {
-          best = 0;
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            if(neighborSimCount[j] > best)
-            {
-              best = neighborSimCount[j];
-              bestNeighbor[i] = neighbor;
-            }
-            neighborSimCount[j] = 0;
-          }
-        }
-      }
-    }
-    QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
+    QString ss = QObject::tr("Level %1 of %2 || Processing Data").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-    if(getCancel())
+    FindBestNeighborImpl findBestNeighbor(neighborhood, m_ConfidenceIndex, m_MinConfidence, quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, misorientationToleranceR, bestNeighbor.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      return;
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), findBestNeighbor, tbb::auto_partitioner());
     }
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::task_scheduler_init init;
-    bool doParallel = true;
+    else
 #endif
-
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
     {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+      findBestNeighbor.convert(0, totalPoints);
     }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    // The idea for this parallel section is to parallelize over each Data Array that
-    // will need it's data adjusted. This should go faster than before by about 2x.
-    // Better speed up could be achieved if we had better data locality.
-    m_Progress = 0;
-    m_TotalProgress = 0;
-    if(doParallel)
+    if(getCancel())
     {
-      std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
-      AttributeMatrix* attrMat = m->getAttributeMatrix(attrMatName).get();
-      m_TotalProgress = voxelArrayNames.size() * totalPoints; // Total number of points to update
-      // Create and run all the tasks
-      for(const auto& arrayName : voxelArrayNames)
-      {
-        IDataArray::Pointer dataArrayPtr = attrMat->getAttributeArray(arrayName);
-        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, totalPoints, bestNeighbor, dataArrayPtr));
-      }
-      // Wait for them to complete.
-      taskGroup->wait();
+      return;
     }
-    else
-#endif
+
+    ss = QObject::tr("Level %1 of %2 || Copying Data").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+
+    // The voxels are replaced one after the other in index order, so a voxel whose best neighbor
+    // was replaced earlier in the same level receives the data that neighbor just took on
+    targets.clear();
+    sources.clear();
+    for(size_t i = 0; i < totalPoints; i++)
     {
-      progIncrement = static_cast<int64_t>(totalPoints / 100);
-      prog = 1;
-      progressInt = 0;
-      for(size_t i = 0; i < totalPoints; i++)
+      if(bestNeighbor[i] != -1)
       {
-        if(int64_t(i) > prog)
-        {
-          progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-          QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level).arg(progressInt);
-          notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-          prog = prog + progIncrement;
-        }
-        neighbor = bestNeighbor[i];
-        if(neighbor != -1)
-        {
-          for(const auto& iter : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(iter);
-            p->copyTuple(neighbor, i);
-          }
-        }
+        targets.push_back(static_cast<int64_t>(i));
+        sources.push_back(bestNeighbor[i]);
       }
     }
+    transfer.transfer(targets, sources, true, doParallel);
 
     currentLevel = currentLevel - 1;
     m_CurrentLevel = currentLevel;
@@ -549,8 +400,6 @@ void NeighborOrientationCorrelation::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
 // -----------------------------------------------------------------------------
 void NeighborOrientationCorrelation::updateProgress(size_t p)
 {
@@ -88,8 +88,6 @@ public:
   SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, IgnoredDataArrayPaths)
   Q_PROPERTY(QVector<DataArrayPath> IgnoredDataArrayPaths READ getIgnoredDataArrayPaths WRITE setIgnoredDataArrayPaths)
 
-  void updateProgress(size_t p);
-
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -191,8 +189,6 @@ protected:
   void initialize();
 
 private:
-  size_t m_Progress = 0;
-  size_t m_TotalProgress = 0;
   int32_t m_CurrentLevel = 0;
 
   QVector<LaueOps::Pointer> m_OrientationOps;
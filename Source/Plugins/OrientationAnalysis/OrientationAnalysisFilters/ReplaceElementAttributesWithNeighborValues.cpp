@@ -34,6 +34,15 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ReplaceElementAttributesWithNeighborValues.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -45,6 +54,8 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 
+#include "Processing/ProcessingFilters/HelperClasses/VoxelNeighborPropagation.hpp"
+
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
@@ -103,6 +114,57 @@ protected:
   GreaterThanComparison() = default;
 };
 
+/**
+ * @brief The FindBestNeighborImpl class finds, for each voxel that fails the threshold, the
+ * neighbor that passes it with the best value, keeping the previous choice when no neighbor is
+ * better than the voxel itself.
+ */
+template <typename T> class FindBestNeighborImpl
+{
+public:
+  FindBestNeighborImpl(const VoxelNeighborPropagation::Neighborhood& neighborhood, const T* data, float thresholdValue, const typename LessThanComparison<T>::Pointer& comp, int64_t* bestNeighbor)
+  : m_Neighborhood(neighborhood)
+  , m_Data(data)
+  , m_ThresholdValue(thresholdValue)
+  , m_Comp(comp)
+  , m_BestNeighbor(bestNeighbor)
+  {
+  }
+  virtual ~FindBestNeighborImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(!m_Comp->compare(m_Data[i], m_ThresholdValue))
+      {
+        continue;
+      }
+      float best = m_Data[i];
+      m_Neighborhood.forEachNeighbor(static_cast<int64_t>(i), [&](int64_t neighbor) {
+        if(m_Comp->compare1(m_Data[neighbor], m_ThresholdValue) && m_Comp->compare2(m_Data[neighbor], best))
+        {
+          best = m_Data[neighbor];
+          m_BestNeighbor[i] = neighbor;
+        }
+      });
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const VoxelNeighborPropagation::Neighborhood& m_Neighborhood;
+  const T* m_Data;
+  float m_ThresholdValue;
+  typename LessThanComparison<T>::Pointer m_Comp;
+  int64_t* m_BestNeighbor;
+};
+
 template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborValues* filter, IDataArray::Pointer inArrayPtr)
 {
   using DataArrayType = DataArray<T>;
@@ -114,26 +176,17 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
 
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  bool good = true;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<int64_t>(-dims[0]);
-  neighpoints[2] = static_cast<int64_t>(-1);
-  neighpoints[3] = static_cast<int64_t>(1);
-  neighpoints[4] = static_cast<int64_t>(dims[0]);
-  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
 
-  QVector<int64_t> bestNeighbor(totalPoints, -1);
+  std::vector<int64_t> bestNeighbor(totalPoints, -1);
 
   size_t count = 0;
-  float best = 0.0f;
   bool keepGoing = true;
 
   typename Detail::LessThanComparison<T>::Pointer comp = Detail::LessThanComparison<T>::New();
@@ -143,7 +196,7 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
   }
 
   DataArrayPointerType inData = std::dynamic_pointer_cast<DataArrayType>(inArrayPtr);
-  DataArrayType& data = *inData;
+  T* data = inData->getPointer(0);
 
   float thresholdValue = filter->getMinConfidence();
 
@@ -155,72 +208,29 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
 
+  VoxelNeighborPropagation::Neighborhood neighborhood(udims);
+  VoxelNeighborPropagation::TupleTransfer transfer(m->getAttributeMatrix(attrMatName), voxelArrayNames);
+  std::vector<int64_t> targets;
+  std::vector<int64_t> sources;
+
   while(keepGoing)
   {
     keepGoing = false;
-    count = 0;
     if(filter->getCancel())
     {
       break;
     }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 50);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    for(size_t i = 0; i < totalPoints; i++)
+    FindBestNeighborImpl<T> findBestNeighbor(neighborhood, data, thresholdValue, comp, bestNeighbor.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      if(comp->compare(data[i], thresholdValue))
-      {
-        column = i % dims[0];
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        count++;
-        best = data[i];
-        for(int64_t j = 0; j < 6; j++)
-        {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = false;
-          }
-          if(j == 5 && plane == (dims[2] - 1))
-          {
-            good = false;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = false;
-          }
-          if(j == 4 && row == (dims[1] - 1))
-          {
-            good = false;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = false;
-          }
-          if(j == 3 && column == (dims[0] - 1))
-          {
-            good = false;
-          }
-          if(good)
-          {
-            if(comp->compare1(data[neighbor], thresholdValue) && comp->compare2(data[neighbor], best))
-            {
-              best = data[neighbor];
-              bestNeighbor[i] = neighbor;
-            }
-          }
-        }
-      }
-      if(int64_t(i) > prog)
-      {
-        progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-        QString ss = QObject::tr("|| Processing Data Current Loop (%1) Progress: %2% Complete").arg(count).arg(progressInt);
-        filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
-        prog = prog + progIncrement;
-      }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), findBestNeighbor, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      findBestNeighbor.convert(0, totalPoints);
     }
 
     if(filter->getCancel())
@@ -228,29 +238,28 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
       break;
     }
 
-    progIncrement = static_cast<int64_t>(totalPoints / 50);
-    prog = 1;
-    progressInt = 0;
+    // The voxels are replaced one after the other in index order, so a voxel whose best neighbor
+    // was replaced earlier in the same loop receives the data that neighbor just took on
+    count = 0;
+    targets.clear();
+    sources.clear();
     for(size_t i = 0; i < totalPoints; i++)
     {
-      if(int64_t(i) > prog)
+      if(comp->compare(data[i], thresholdValue))
       {
-        progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-        QString ss = QObject::tr("|| Processing Data Current Loop (%1) || Transferring Cell Data: %2% Complete").arg(count).arg(progressInt);
-        filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
-        prog = prog + progIncrement;
+        count++;
       }
-
-      neighbor = bestNeighbor[i];
-      if(neighbor != -1)
+      if(bestNeighbor[i] != -1)
       {
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-          p->copyTuple(neighbor, i);
-        }
+        targets.push_back(static_cast<int64_t>(i));
+        sources.push_back(bestNeighbor[i]);
       }
     }
+
+    QString ss = QObject::tr("|| Processing Data Current Loop (%1) || Transferring Cell Data").arg(count);
+    filter->notifyStatusMessage(filter->getMessagePrefix(), filter->getHumanLabel(), ss);
+    transfer.transfer(targets, sources, true, doParallel);
+
     if(filter->getLoop() && count > 0)
     {
       keepGoing = true;
@@ -258,6 +267,7 @@ template <typename T> void ExecuteTemplate(ReplaceElementAttributesWithNeighborV
   }
 }
 }
+}
 
 // -----------------------------------------------------------------------------
 //
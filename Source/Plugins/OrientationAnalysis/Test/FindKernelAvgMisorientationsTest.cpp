@@ -0,0 +1,330 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+namespace FindKernelAvgMisorientationsTestConsts
+{
+const int64_t k_XDim = 9;
+const int64_t k_YDim = 7;
+const int64_t k_ZDim = 5;
+const QString k_DataContainerName("KamDataContainer");
+const QString k_CellAttributeMatrixName("CellData");
+const QString k_EnsembleAttributeMatrixName("EnsembleData");
+} // namespace FindKernelAvgMisorientationsTestConsts
+
+class FindKernelAvgMisorientationsTest
+{
+
+public:
+  FindKernelAvgMisorientationsTest() = default;
+  ~FindKernelAvgMisorientationsTest() = default;
+
+  SIMPL_TYPE_MACRO(FindKernelAvgMisorientationsTest)
+
+  FindKernelAvgMisorientationsTest(const FindKernelAvgMisorientationsTest&) = delete;            // Copy Constructor
+  FindKernelAvgMisorientationsTest(FindKernelAvgMisorientationsTest&&) = delete;                 // Move Constructor
+  FindKernelAvgMisorientationsTest& operator=(const FindKernelAvgMisorientationsTest&) = delete; // Copy Assignment
+  FindKernelAvgMisorientationsTest& operator=(FindKernelAvgMisorientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "FindKernelAvgMisorientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindKernelAvgMisorientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates three features of slowly varying orientations. The first phase is hexagonal
+  // and the second one cubic, and a few voxels have no feature, a negative feature or no phase.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createVolume()
+  {
+    using namespace FindKernelAvgMisorientationsTestConsts;
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {static_cast<size_t>(k_XDim), static_cast<size_t>(k_YDim), static_cast<size_t>(k_ZDim)};
+    image->setDimensions(dims);
+    dc->setGeometry(image);
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    QVector<size_t> tDims(1, totalPoints);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(k_CellAttributeMatrixName, cellAttrMat);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases);
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Quats);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::Phases, phases);
+    cellAttrMat->addAttributeArray(SIMPL::CellData::Quats, quats);
+
+    for(int64_t z = 0; z < k_ZDim; z++)
+    {
+      for(int64_t y = 0; y < k_YDim; y++)
+      {
+        for(int64_t x = 0; x < k_XDim; x++)
+        {
+          size_t i = static_cast<size_t>((z * k_YDim + y) * k_XDim + x);
+          int32_t feature = (x < 4) ? 1 : (y < 3 ? 2 : 3);
+          int32_t phase = (feature == 2) ? 1 : 2;
+          if(i % 23 == 5)
+          {
+            feature = 0;
+          }
+          if(i % 29 == 3)
+          {
+            feature = -1;
+          }
+          if(i % 31 == 7)
+          {
+            phase = 0;
+          }
+          featureIds->setValue(i, feature);
+          phases->setValue(i, phase);
+
+          // A rotation about a tilted axis whose angle changes a little from voxel to voxel
+          float angle = 0.2f * static_cast<float>(feature) + 0.013f * static_cast<float>((i * 7) % 11);
+          float axis[3] = {1.0f, 0.1f * static_cast<float>(feature), 0.05f * static_cast<float>(z)};
+          float norm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+          float s = std::sin(0.5f * angle) / norm;
+          quats->setComponent(i, 0, axis[0] * s);
+          quats->setComponent(i, 1, axis[1] * s);
+          quats->setComponent(i, 2, axis[2] * s);
+          quats->setComponent(i, 3, std::cos(0.5f * angle));
+        }
+      }
+    }
+
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, k_EnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(k_EnsembleAttributeMatrixName, ensembleAttrMat);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures);
+    crystalStructures->setValue(0, 999); // Ebsd::CrystalStructure::UnknownCrystalStructure
+    crystalStructures->setValue(1, 0);   // Ebsd::CrystalStructure::Hexagonal_High
+    crystalStructures->setValue(2, 1);   // Ebsd::CrystalStructure::Cubic_High
+    ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Finds the kernel average misorientation of every voxel by visiting its whole kernel, the way
+  // the filter did before it was parallelized. The kernel spans -x radius to +z radius along x.
+  // -----------------------------------------------------------------------------
+  std::vector<float> BruteForceKernel(const DataContainerArray::Pointer& dca, const IntVec3_t& kernelSize)
+  {
+    using namespace FindKernelAvgMisorientationsTestConsts;
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName);
+    int32_t* featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds)->getPointer(0);
+    int32_t* phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases)->getPointer(0);
+    QuatF* quats = reinterpret_cast<QuatF*>(cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::Quats)->getPointer(0));
+    uint32_t* crystalStructures = dca->getDataContainer(k_DataContainerName)
+                                      ->getAttributeMatrix(k_EnsembleAttributeMatrixName)
+                                      ->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)
+                                      ->getPointer(0);
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+
+    std::vector<float> kam(static_cast<size_t>(k_XDim * k_YDim * k_ZDim), 0.0f);
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    for(int64_t plane = 0; plane < k_ZDim; plane++)
+    {
+      for(int64_t row = 0; row < k_YDim; row++)
+      {
+        for(int64_t col = 0; col < k_XDim; col++)
+        {
+          int64_t point = (plane * k_YDim + row) * k_XDim + col;
+          if(featureIds[point] <= 0 || phases[point] <= 0)
+          {
+            continue;
+          }
+          float totalMisorientation = 0.0f;
+          int32_t numVoxel = 0;
+          QuaternionMathF::Copy(quats[point], q1);
+          uint32_t phase1 = crystalStructures[phases[point]];
+          for(int64_t j = -kernelSize.z; j < kernelSize.z + 1; j++)
+          {
+            for(int64_t k = -kernelSize.y; k < kernelSize.y + 1; k++)
+            {
+              for(int64_t l = -kernelSize.x; l < kernelSize.z + 1; l++)
+              {
+                if(plane + j < 0 || plane + j > k_ZDim - 1 || row + k < 0 || row + k > k_YDim - 1 || col + l < 0 || col + l > k_XDim - 1)
+                {
+                  continue;
+                }
+                int64_t neighbor = point + (j * k_YDim + k) * k_XDim + l;
+                if(featureIds[point] == featureIds[neighbor])
+                {
+                  QuaternionMathF::Copy(quats[neighbor], q2);
+                  float w = orientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
+                  totalMisorientation = totalMisorientation + w;
+                  numVoxel++;
+                }
+              }
+            }
+          }
+          kam[point] = (numVoxel == 0) ? 0.0f : totalMisorientation / static_cast<float>(numVoxel);
+        }
+      }
+    }
+    return kam;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunKernel(int32_t x, int32_t y, int32_t z)
+  {
+    using namespace FindKernelAvgMisorientationsTestConsts;
+    DataContainerArray::Pointer dca = createVolume();
+    IntVec3_t kernelSize;
+    kernelSize.IntVec3(x, y, z);
+
+    QString filtName = "FindKernelAvgMisorientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    bool propWasSet = true;
+    QVariant var;
+    var.setValue(kernelSize);
+    propWasSet = filter->setProperty("KernelSize", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, SIMPL::CellData::Phases));
+    propWasSet = filter->setProperty("CellPhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, SIMPL::CellData::Quats));
+    propWasSet = filter->setProperty("QuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(k_DataContainerName, k_EnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    int32_t err = filter->getErrorCondition();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    std::vector<float> expected = BruteForceKernel(dca, kernelSize);
+    FloatArrayType::Pointer kam = dca->getDataContainer(k_DataContainerName)
+                                      ->getAttributeMatrix(k_CellAttributeMatrixName)
+                                      ->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::KernelAverageMisorientations);
+    DREAM3D_REQUIRE_VALID_POINTER(kam.get())
+    DREAM3D_REQUIRE_EQUAL(kam->getNumberOfTuples(), expected.size())
+    // The filter keeps the summation order of the brute force kernel, but a pair that is shared by two
+    // kernels is found once with the quaternions in the order of the first voxel, so the averages may
+    // differ in the last bits
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(kam->getValue(i) - expected[i]) <= 1.0E-4f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindKernelAvgMisorientations()
+  {
+    int32_t kernels[5][3] = {{1, 1, 1}, {2, 1, 1}, {1, 2, 0}, {0, 1, 2}, {3, 2, 1}};
+    for(size_t i = 0; i < 5; i++)
+    {
+      int err = RunKernel(kernels[i][0], kernels[i][1], kernels[i][2]);
+      if(err != EXIT_SUCCESS)
+      {
+        return err;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFindKernelAvgMisorientations())
+  }
+};
@@ -378,9 +378,6 @@ void DetectEllipsoids::execute()
     std::reverse(std::begin(convCoords_Y), std::end(convCoords_Y));
     std::reverse(std::begin(convCoords_Z), std::end(convCoords_Z));
 
-    // Create offset array to use for convolutions
-    Int32ArrayType::Pointer convOffsetArray = createOffsetArray(orient_tDims);
-
     // Execute the smoothing filter
     int n_size = 3;
     QVector<size_t> smooth_tDims;
@@ -409,7 +406,7 @@ void DetectEllipsoids::execute()
       for(int i = 0; i < threads; i++)
       {
         m_ThreadWork[i] = 0;
-        g->run(DetectEllipsoidsImpl(i, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
+        g->run(DetectEllipsoidsImpl(i, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, smoothFil, smoothOffsetArray, axis_min,
                                     axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
                                     m_EllipseFeatureAttributeMatrixPtr));
       }
@@ -419,7 +416,7 @@ void DetectEllipsoids::execute()
     else
 #endif
     {
-      DetectEllipsoidsImpl impl(0, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
+      DetectEllipsoidsImpl impl(0, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, smoothFil, smoothOffsetArray, axis_min,
                                 axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
                                 m_EllipseFeatureAttributeMatrixPtr);
       m_ThreadWork[0] = 0;
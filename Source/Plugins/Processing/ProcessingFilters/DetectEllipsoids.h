@@ -291,7 +291,7 @@ private:
                          DE_ComplexDoubleVector& convCoords_Z);
 
   /**
-   * @brief createConvOffsetArray
+   * @brief createOffsetArray
    * @param kernel_tDims
    * @return
    */
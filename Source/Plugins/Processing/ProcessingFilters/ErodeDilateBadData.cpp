@@ -35,6 +35,10 @@
 
 #include "ErodeDilateBadData.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
@@ -46,6 +50,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/VoxelNeighborPropagation.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -58,7 +63,6 @@ ErodeDilateBadData::ErodeDilateBadData()
 , m_YDirOn(true)
 , m_ZDirOn(true)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
-, m_Neighbors(nullptr)
 {
 }
 
@@ -124,7 +128,6 @@ void ErodeDilateBadData::readFilterParameters(AbstractFilterParametersReader* re
 // -----------------------------------------------------------------------------
 void ErodeDilateBadData::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -180,175 +183,42 @@ void ErodeDilateBadData::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
 
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
 
-  for(size_t i = 0; i < totalPoints; i++)
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  QVector<int32_t> n(numfeatures + 1, 0);
-
-  for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
+  VoxelNeighborPropagation::Neighborhood neighborhood(udims, m_XDirOn, m_YDirOn, m_ZDirOn);
+  VoxelNeighborPropagation::TupleTransfer transfer(m->getAttributeMatrix(attrMatName), voxelArrayNames);
+  if(m_Direction == 0)
   {
-    for(int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || !m_XDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || !m_XDirOn))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if(feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if(m_Direction == 1)
-            {
-              for(int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if(l == 0 && k == 0)
-                {
-                  good = 0;
-                }
-                if(l == 5 && k == (dims[2] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 1 && j == 0)
-                {
-                  good = 0;
-                }
-                if(l == 4 && j == (dims[1] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 2 && i == 0)
-                {
-                  good = 0;
-                }
-                if(l == 3 && i == (dims[0] - 1))
-                {
-                  good = 0;
-                }
-                if(good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
-    {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
-    }
+    // Erode: every Feature voxel touching a bad voxel takes the data of its last bad neighbor
+    VoxelNeighborPropagation::propagate(this, neighborhood, m_FeatureIds, transfer, [](int32_t feature) { return feature > 0; }, [](int32_t feature) { return feature == 0; }, m_NumIterations,
+                                        doParallel);
+  }
+  else
+  {
+    // Dilate: every bad voxel touching a Feature takes the data of its most common Feature neighbor
+    VoxelNeighborPropagation::propagate(this, neighborhood, m_FeatureIds, transfer, [](int32_t feature) { return feature == 0; }, [](int32_t feature) { return feature > 0; }, m_NumIterations,
+                                        doParallel);
+  }
 
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if(neighbor >= 0)
-      {
-        if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
-        {
-          for(const auto& arrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
-    }
+  if(getCancel())
+  {
+    return;
   }
 
   // If there is an error set this to something negative and also set a message
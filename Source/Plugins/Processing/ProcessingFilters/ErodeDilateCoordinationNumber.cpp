@@ -35,6 +35,14 @@
 
 #include "ErodeDilateCoordinationNumber.h"
 
+#include <functional>
+#include <queue>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
@@ -45,6 +53,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/VoxelNeighborPropagation.hpp"
 #include "Processing/ProcessingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -54,7 +63,6 @@ ErodeDilateCoordinationNumber::ErodeDilateCoordinationNumber()
 : m_Loop(false)
 , m_CoordinationNumber(6)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
-, m_Neighbors(nullptr)
 {
 }
 
@@ -101,7 +109,6 @@ void ErodeDilateCoordinationNumber::readFilterParameters(AbstractFilterParameter
 // -----------------------------------------------------------------------------
 void ErodeDilateCoordinationNumber::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -160,43 +167,15 @@ void ErodeDilateCoordinationNumber::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
-  };
-
-  int32_t good = 1;
-  int64_t point = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t coordination = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
-
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
-  }
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
 
   QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
   QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
@@ -205,142 +184,120 @@ void ErodeDilateCoordinationNumber::execute()
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
 
-  QVector<int32_t> n(numfeatures + 1, 0);
-  QVector<int32_t> coordinationNumber(totalPoints, 0);
+  // The Feature Ids decide every later voxel of a sweep, so they are copied as soon as a voxel
+  // changes; the rest of the arrays are copied in one batch at the end of each sweep.
+  bool copyFeatureIds = voxelArrayNames.contains(m_FeatureIdsArrayPath.getDataArrayName());
+  voxelArrayNames.removeAll(m_FeatureIdsArrayPath.getDataArrayName());
+
+  VoxelNeighborPropagation::Neighborhood neighborhood(udims);
+  VoxelNeighborPropagation::TupleTransfer transfer(m->getAttributeMatrix(attrMatName), voxelArrayNames);
+
+  // A sweep visits the voxels in increasing index order and a change is seen by every voxel
+  // visited after it. Only the voxels next to a change can decide differently on their next visit,
+  // so after the first sweep only those are visited: the neighbors that come later in the current
+  // sweep, and the changed voxel and the neighbors that come before it in the next sweep.
+  std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t>> activePoints;
+  std::vector<uint8_t> active(totalPoints, 0);
+  std::vector<int64_t> nextActivePoints;
+  std::vector<uint8_t> nextActive(totalPoints, 0);
+  std::vector<int64_t> targets;
+  std::vector<int64_t> sources;
+
+  bool fullSweep = true;
   bool keepgoing = true;
-  int32_t counter = 1;
+  size_t counter = 1;
+
+  auto visit = [&](int64_t point) {
+    int32_t featurename = m_FeatureIds[point];
+    int32_t coordination = 0;
+    int64_t neighbor = -1;
+    if(featurename > 0)
+    {
+      neighborhood.forEachNeighbor(point, [&](int64_t neighpoint) { coordination += (m_FeatureIds[neighpoint] == 0) ? 1 : 0; });
+      neighbor = neighborhood.findMajorityNeighbor(point, m_FeatureIds, [](int32_t feature) { return feature == 0; });
+    }
+    else if(featurename == 0)
+    {
+      neighborhood.forEachNeighbor(point, [&](int64_t neighpoint) { coordination += (m_FeatureIds[neighpoint] > 0) ? 1 : 0; });
+      neighbor = neighborhood.findMajorityNeighbor(point, m_FeatureIds, [](int32_t feature) { return feature > 0; });
+    }
+    if(coordination < m_CoordinationNumber || coordination == 0)
+    {
+      return;
+    }
+
+    counter++;
+    targets.push_back(point);
+    sources.push_back(neighbor);
+    if(!copyFeatureIds)
+    {
+      return;
+    }
+    m_FeatureIds[point] = m_FeatureIds[neighbor];
+    if(nextActive[point] == 0)
+    {
+      nextActive[point] = 1;
+      nextActivePoints.push_back(point);
+    }
+    neighborhood.forEachNeighbor(point, [&](int64_t neighpoint) {
+      if(neighpoint > point)
+      {
+        if(!fullSweep && active[neighpoint] == 0)
+        {
+          active[neighpoint] = 1;
+          activePoints.push(neighpoint);
+        }
+      }
+      else if(nextActive[neighpoint] == 0)
+      {
+        nextActive[neighpoint] = 1;
+        nextActivePoints.push_back(neighpoint);
+      }
+    });
+  };
 
   while(counter > 0 && keepgoing)
   {
+    if(getCancel())
+    {
+      return;
+    }
+
     counter = 0;
     if(!m_Loop)
     {
       keepgoing = false;
     }
 
-    for(int64_t k = 0; k < dims[2]; k++)
+    targets.clear();
+    sources.clear();
+    if(fullSweep)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
+      for(size_t i = 0; i < totalPoints; i++)
       {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          point = kstride + jstride + i;
-          featurename = m_FeatureIds[point];
-          coordination = 0;
-          current = 0;
-          most = 0;
-          for(int32_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighpoint = point + neighpoints[l];
-            if(l == 0 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && k == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = 0;
-            }
-            if(l == 4 && j == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(l == 2 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && i == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
-              {
-                coordination = coordination + 1;
-                n[feature]++;
-                current = n[feature];
-                if(current > most)
-                {
-                  most = current;
-                  m_Neighbors[point] = neighpoint;
-                }
-              }
-            }
-          }
-          coordinationNumber[point] = coordination;
-          int32_t neighbor = m_Neighbors[point];
-          if(coordinationNumber[point] >= m_CoordinationNumber && coordinationNumber[point] > 0)
-          {
-            for(const auto& arrayName : voxelArrayNames)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-              p->copyTuple(neighbor, point);
-            }
-          }
-          for(int32_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighpoint = point + neighpoints[l];
-            if(l == 0 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && k == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = 0;
-            }
-            if(l == 4 && j == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(l == 2 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && i == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if(feature > 0)
-              {
-                n[feature] = 0;
-              }
-            }
-          }
-        }
+        visit(static_cast<int64_t>(i));
       }
+      fullSweep = false;
     }
-    for(int64_t k = 0; k < dims[2]; k++)
+    else
     {
-      kstride = static_cast<int64_t>(dims[0] * dims[1] * k);
-      for(int64_t j = 0; j < dims[1]; j++)
+      while(!activePoints.empty())
       {
-        jstride = static_cast<int64_t>(dims[0] * j);
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          point = kstride + jstride + i;
-          if(coordinationNumber[point] >= m_CoordinationNumber)
-          {
-            counter++;
-          }
-        }
+        int64_t point = activePoints.top();
+        activePoints.pop();
+        active[point] = 0;
+        visit(point);
       }
     }
+    transfer.transfer(targets, sources, true, doParallel);
+
+    for(const auto& point : nextActivePoints)
+    {
+      nextActive[point] = 0;
+      active[point] = 1;
+      activePoints.push(point);
+    }
+    nextActivePoints.clear();
   }
 
   // If there is an error set this to something negative and also set a message
@@ -171,8 +171,6 @@ protected:
   void initialize();
 
 private:
-  int32_t* m_Neighbors;
-
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
 public:
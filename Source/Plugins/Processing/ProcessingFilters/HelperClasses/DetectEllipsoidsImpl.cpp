@@ -36,6 +36,7 @@
 #include "DetectEllipsoidsImpl.h"
 
 #include "ProcessingFilters/HelperClasses/ComputeGradient.h"
+#include "ProcessingFilters/HelperClasses/FFTConvolution.hpp"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 // -----------------------------------------------------------------------------
@@ -43,7 +44,7 @@
 // -----------------------------------------------------------------------------
 DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, QVector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners,
                                            DE_ComplexDoubleVector convCoords_X, DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, QVector<size_t> kernel_tDims,
-                                           Int32ArrayType::Pointer convOffsetArray, std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max,
+                                           std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max,
                                            float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis,
                                            DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM)
 : m_Filter(filter)
@@ -54,7 +55,6 @@ DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* fi
 , m_ConvCoords_Y(convCoords_Y)
 , m_ConvCoords_Z(convCoords_Z)
 , m_ConvKernel_tDims(kernel_tDims)
-, m_ConvOffsetArray(convOffsetArray)
 , m_SmoothKernel(smoothFil)
 , m_SmoothOffsetArray(smoothOffsetArray)
 , m_Axis_Min(axis_min)
@@ -117,6 +117,13 @@ void DetectEllipsoidsImpl::operator()() const
     accum_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
   }
 
+  // The Hough kernels are applied in the frequency domain. Each thread keeps its own correlators
+  // so the FFT plans, kernel spectra and work buffers are reused across all of its objects
+  FFTConvolution<double> convolutionX(m_ConvCoords_X, m_ConvKernel_tDims[0], m_ConvKernel_tDims[1]);
+  FFTConvolution<double> convolutionY(m_ConvCoords_Y, m_ConvKernel_tDims[0], m_ConvKernel_tDims[1]);
+  DE_ComplexDoubleVector gradX_conv;
+  DE_ComplexDoubleVector gradY_conv;
+
   // Run the ellipse detection algorithm on each object
   int32_t featureId = m_Filter->getNextFeatureId();
   while(featureId > 0)
@@ -192,8 +199,8 @@ void DetectEllipsoidsImpl::operator()() const
       DoubleArrayType::Pointer gradY = grad.getGradY();
 
       // Convolute Gradient of object with convolution kernel
-      DE_ComplexDoubleVector gradX_conv = convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims);
-      DE_ComplexDoubleVector gradY_conv = convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims);
+      convolutionX.correlate(gradX->getPointer(0), paddedObj_xDim, paddedObj_yDim, gradX_conv);
+      convolutionY.correlate(gradY->getPointer(0), paddedObj_xDim, paddedObj_yDim, gradY_conv);
 
       // Calculate the magnitude matrix of the convolution.
       DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(gradX_conv.size(), QVector<size_t>(1, 1), "obj_conv_mag");
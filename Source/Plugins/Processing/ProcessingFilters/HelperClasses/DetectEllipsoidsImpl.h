@@ -55,7 +55,7 @@ class DetectEllipsoidsImpl
 {
 public:
   DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, QVector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners, DE_ComplexDoubleVector convCoords_X,
-                       DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, QVector<size_t> kernel_tDims, Int32ArrayType::Pointer convOffsetArray, std::vector<double> smoothFil,
+                       DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, QVector<size_t> kernel_tDims, std::vector<double> smoothFil,
                        Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max, float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis,
                        DoubleArrayType::Pointer minaxis, DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM);
 
@@ -324,7 +324,6 @@ private:
   DE_ComplexDoubleVector m_ConvCoords_Y;
   DE_ComplexDoubleVector m_ConvCoords_Z;
   QVector<size_t> m_ConvKernel_tDims;
-  Int32ArrayType::Pointer m_ConvOffsetArray;
   std::vector<double> m_SmoothKernel;
   Int32ArrayType::Pointer m_SmoothOffsetArray;
   double m_Axis_Min;
@@ -0,0 +1,297 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+/**
+ * @brief The FFTConvolution class correlates 2D images with a fixed kernel in the frequency domain.
+ * The result at each pixel p is the sum of kernel[j] * image[p + offset_j], where offset_j is the
+ * position of kernel entry j relative to the kernel center as laid out by DetectEllipsoids::createOffsetArray,
+ * and pixels outside of the image count as zero. This is the same result the spatial loop in
+ * DetectEllipsoidsImpl::convoluteImage produces, at O(N log N) instead of O(N * kernel size).
+ *
+ * The FFT plans and the kernel spectra are cached per padded size and the complex work buffer is
+ * reused, so one instance should be kept per thread and fed every image that thread processes.
+ * The template parameter selects the precision of the transforms (float or double).
+ */
+template <typename T> class FFTConvolution
+{
+public:
+  using ComplexType = std::complex<T>;
+
+  FFTConvolution(const std::vector<std::complex<double>>& kernel, size_t kernelXDim, size_t kernelYDim)
+  : m_Kernel(kernel)
+  , m_KernelXDim(kernelXDim)
+  , m_KernelYDim(kernelYDim)
+  {
+  }
+
+  virtual ~FFTConvolution() = default;
+
+  /**
+   * @brief correlate Correlates the kernel with an image
+   * @param image Row major image values
+   * @param xDim Image width
+   * @param yDim Image height
+   * @param result Resized to xDim * yDim and filled with the correlation
+   */
+  template <typename ImageType, typename ResultType> void correlate(const ImageType* image, size_t xDim, size_t yDim, std::vector<ResultType>& result)
+  {
+    size_t fftXDim = NextPowerOfTwo(xDim + m_KernelXDim - 1);
+    size_t fftYDim = NextPowerOfTwo(yDim + m_KernelYDim - 1);
+    const std::vector<ComplexType>& spectrum = kernelSpectrum(fftXDim, fftYDim);
+
+    m_Buffer.assign(fftXDim * fftYDim, ComplexType(0, 0));
+    for(size_t y = 0; y < yDim; y++)
+    {
+      for(size_t x = 0; x < xDim; x++)
+      {
+        m_Buffer[y * fftXDim + x] = ComplexType(static_cast<T>(image[y * xDim + x]), 0);
+      }
+    }
+
+    transform2D(m_Buffer, fftXDim, fftYDim, false);
+    for(size_t i = 0; i < m_Buffer.size(); i++)
+    {
+      m_Buffer[i] *= spectrum[i];
+    }
+    transform2D(m_Buffer, fftXDim, fftYDim, true);
+
+    T scale = static_cast<T>(1) / static_cast<T>(fftXDim * fftYDim);
+    result.resize(xDim * yDim);
+    for(size_t y = 0; y < yDim; y++)
+    {
+      for(size_t x = 0; x < xDim; x++)
+      {
+        ComplexType value = m_Buffer[y * fftXDim + x] * scale;
+        result[y * xDim + x] = ResultType(value.real(), value.imag());
+      }
+    }
+  }
+
+  /**
+   * @brief NextPowerOfTwo Returns the smallest power of two that is at least value
+   * @param value
+   * @return
+   */
+  static size_t NextPowerOfTwo(size_t value)
+  {
+    size_t power = 1;
+    while(power < value)
+    {
+      power <<= 1;
+    }
+    return power;
+  }
+
+private:
+  /**
+   * @brief The Plan struct holds the bit reversal permutation and twiddle factors of a 1D transform
+   */
+  struct Plan
+  {
+    std::vector<size_t> reversed;
+    std::vector<ComplexType> twiddles;
+  };
+
+  // Kernel spectra are dropped once the cache holds this many values so a few very large
+  // objects do not pin their spectra for the lifetime of the thread
+  static const size_t k_MaxCachedSpectrumValues = 1 << 22;
+
+  std::vector<std::complex<double>> m_Kernel;
+  size_t m_KernelXDim = 0;
+  size_t m_KernelYDim = 0;
+  std::map<size_t, Plan> m_Plans;
+  std::map<std::pair<size_t, size_t>, std::vector<ComplexType>> m_Spectra;
+  size_t m_CachedSpectrumValues = 0;
+  std::vector<ComplexType> m_Buffer;
+  std::vector<ComplexType> m_Column;
+
+  /**
+   * @brief plan Returns the cached plan for a transform of length n, creating it on first use
+   * @param n Transform length, a power of two
+   * @return
+   */
+  const Plan& plan(size_t n)
+  {
+    typename std::map<size_t, Plan>::iterator iter = m_Plans.find(n);
+    if(iter != m_Plans.end())
+    {
+      return iter->second;
+    }
+
+    Plan& newPlan = m_Plans[n];
+    size_t bits = 0;
+    while((static_cast<size_t>(1) << bits) < n)
+    {
+      bits++;
+    }
+    newPlan.reversed.resize(n);
+    for(size_t i = 0; i < n; i++)
+    {
+      size_t r = 0;
+      for(size_t b = 0; b < bits; b++)
+      {
+        r |= ((i >> b) & 1) << (bits - 1 - b);
+      }
+      newPlan.reversed[i] = r;
+    }
+    newPlan.twiddles.resize(n / 2);
+    for(size_t k = 0; k < n / 2; k++)
+    {
+      double angle = -SIMPLib::Constants::k_2Pi * static_cast<double>(k) / static_cast<double>(n);
+      newPlan.twiddles[k] = ComplexType(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+    return newPlan;
+  }
+
+  /**
+   * @brief transform1D Runs an in place radix-2 transform on n contiguous values
+   * @param data
+   * @param n
+   * @param inverse Runs the unscaled inverse transform when true
+   */
+  void transform1D(ComplexType* data, size_t n, bool inverse)
+  {
+    const Plan& p = plan(n);
+    for(size_t i = 0; i < n; i++)
+    {
+      size_t r = p.reversed[i];
+      if(i < r)
+      {
+        std::swap(data[i], data[r]);
+      }
+    }
+
+    for(size_t len = 2; len <= n; len <<= 1)
+    {
+      size_t half = len / 2;
+      size_t step = n / len;
+      for(size_t start = 0; start < n; start += len)
+      {
+        for(size_t k = 0; k < half; k++)
+        {
+          ComplexType w = inverse ? std::conj(p.twiddles[k * step]) : p.twiddles[k * step];
+          ComplexType u = data[start + k];
+          ComplexType v = data[start + k + half] * w;
+          data[start + k] = u + v;
+          data[start + k + half] = u - v;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief transform2D Transforms the rows and then the columns of a row major xDim x yDim buffer
+   * @param data
+   * @param xDim
+   * @param yDim
+   * @param inverse
+   */
+  void transform2D(std::vector<ComplexType>& data, size_t xDim, size_t yDim, bool inverse)
+  {
+    for(size_t y = 0; y < yDim; y++)
+    {
+      transform1D(data.data() + y * xDim, xDim, inverse);
+    }
+
+    m_Column.resize(yDim);
+    for(size_t x = 0; x < xDim; x++)
+    {
+      for(size_t y = 0; y < yDim; y++)
+      {
+        m_Column[y] = data[y * xDim + x];
+      }
+      transform1D(m_Column.data(), yDim, inverse);
+      for(size_t y = 0; y < yDim; y++)
+      {
+        data[y * xDim + x] = m_Column[y];
+      }
+    }
+  }
+
+  /**
+   * @brief kernelSpectrum Returns the transform of the mirrored, wrapped kernel for a padded size
+   * @param fftXDim
+   * @param fftYDim
+   * @return
+   */
+  const std::vector<ComplexType>& kernelSpectrum(size_t fftXDim, size_t fftYDim)
+  {
+    std::pair<size_t, size_t> key(fftXDim, fftYDim);
+    typename std::map<std::pair<size_t, size_t>, std::vector<ComplexType>>::iterator iter = m_Spectra.find(key);
+    if(iter != m_Spectra.end())
+    {
+      return iter->second;
+    }
+
+    if(m_CachedSpectrumValues + fftXDim * fftYDim > k_MaxCachedSpectrumValues)
+    {
+      m_Spectra.clear();
+      m_CachedSpectrumValues = 0;
+    }
+
+    // Correlating with the kernel is convolving with the kernel mirrored through its center, so
+    // the entry at offset (ox, oy) goes to (-ox, -oy), wrapped around the padded buffer
+    std::vector<ComplexType>& spectrum = m_Spectra[key];
+    spectrum.assign(fftXDim * fftYDim, ComplexType(0, 0));
+    int64_t centerX = static_cast<int64_t>(m_KernelXDim / 2);
+    int64_t centerY = static_cast<int64_t>(m_KernelYDim / 2);
+    for(size_t ky = 0; ky < m_KernelYDim; ky++)
+    {
+      for(size_t kx = 0; kx < m_KernelXDim; kx++)
+      {
+        int64_t mx = centerX - static_cast<int64_t>(kx);
+        int64_t my = centerY - static_cast<int64_t>(ky);
+        size_t x = static_cast<size_t>(mx < 0 ? mx + static_cast<int64_t>(fftXDim) : mx);
+        size_t y = static_cast<size_t>(my < 0 ? my + static_cast<int64_t>(fftYDim) : my);
+        const std::complex<double>& value = m_Kernel[ky * m_KernelXDim + kx];
+        spectrum[y * fftXDim + x] = ComplexType(static_cast<T>(value.real()), static_cast<T>(value.imag()));
+      }
+    }
+    transform2D(spectrum, fftXDim, fftYDim, false);
+    m_CachedSpectrumValues += spectrum.size();
+    return spectrum;
+  }
+};
@@ -5,6 +5,8 @@ set(${PLUGIN_NAME}_HelperClasses_SRCS "")
 set(${PLUGIN_NAME}_HelperClasses_HDRS ${${PLUGIN_NAME}_HelperClasses_HDRS}
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/ComputeGradient.h
     ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/DetectEllipsoidsImpl.h
+    ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/FFTConvolution.hpp
+    ${${PLUGIN_NAME}_SOURCE_DIR}/HelperClasses/VoxelNeighborPropagation.hpp
 )
 
 set(${PLUGIN_NAME}_HelperClasses_SRCS ${${PLUGIN_NAME}_HelperClasses_SRCS}
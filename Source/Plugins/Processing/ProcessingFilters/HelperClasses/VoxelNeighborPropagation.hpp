@@ -0,0 +1,579 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The VoxelNeighborPropagation namespace holds the pieces shared by the cleanup filters that
+ * repeatedly replace voxels of an image geometry with the data of one of their 6 face neighbors
+ * (MinSize, MinNeighbors, FillBadData, ErodeDilateBadData, ErodeDilateCoordinationNumber,
+ * BadDataNeighborOrientationCheck, NeighborOrientationCorrelation and
+ * ReplaceElementAttributesWithNeighborValues). Everything is header only so that filters in other
+ * plugins can use it without linking against the Processing plugin.
+ */
+namespace VoxelNeighborPropagation
+{
+
+/**
+ * @brief The Neighborhood class holds the offsets of the 6 face neighbors of a voxel in the order
+ * -z, -y, -x, +x, +y, +z, which is also increasing index order, together with the per axis masks
+ * that tell which of those neighbors exist. Whole axes can be switched off, in which case the
+ * neighbors along that axis are never visited.
+ */
+class Neighborhood
+{
+public:
+  static const int32_t k_NumNeighbors = 6;
+
+  Neighborhood(const size_t* dims, bool xDirOn = true, bool yDirOn = true, bool zDirOn = true)
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = static_cast<int64_t>(dims[d]);
+    }
+    m_Offsets[0] = -m_Dims[0] * m_Dims[1];
+    m_Offsets[1] = -m_Dims[0];
+    m_Offsets[2] = -1;
+    m_Offsets[3] = 1;
+    m_Offsets[4] = m_Dims[0];
+    m_Offsets[5] = m_Dims[0] * m_Dims[1];
+
+    buildAxisMask(m_XMask, m_Dims[0], xDirOn, 2, 3);
+    buildAxisMask(m_YMask, m_Dims[1], yDirOn, 1, 4);
+    buildAxisMask(m_ZMask, m_Dims[2], zDirOn, 0, 5);
+  }
+  virtual ~Neighborhood() = default;
+
+  size_t getNumberOfPoints() const
+  {
+    return static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+  }
+
+  int64_t getOffset(int32_t l) const
+  {
+    return m_Offsets[l];
+  }
+
+  /**
+   * @brief getMask Returns a bit mask where bit l is set when neighbor l of the point exists
+   */
+  uint8_t getMask(int64_t point) const
+  {
+    int64_t column = point % m_Dims[0];
+    int64_t row = (point / m_Dims[0]) % m_Dims[1];
+    int64_t plane = point / (m_Dims[0] * m_Dims[1]);
+    return m_XMask[column] | m_YMask[row] | m_ZMask[plane];
+  }
+
+  /**
+   * @brief forEachNeighbor Calls func(neighbor) for every existing neighbor of the point, in
+   * increasing index order
+   */
+  template <typename Func> void forEachNeighbor(int64_t point, Func func) const
+  {
+    uint8_t mask = getMask(point);
+    for(int32_t l = 0; l < k_NumNeighbors; l++)
+    {
+      if((mask & (1 << l)) != 0)
+      {
+        func(point + m_Offsets[l]);
+      }
+    }
+  }
+
+  /**
+   * @brief findMajorityNeighbor Returns the neighbor whose Feature occurs most often among the
+   * neighbors that satisfy isSource, or -1 if there is no such neighbor. Ties go to the neighbor
+   * that reached the winning count first.
+   */
+  template <typename SourcePredicate> int64_t findMajorityNeighbor(int64_t point, const int32_t* featureIds, SourcePredicate isSource) const
+  {
+    uint8_t mask = getMask(point);
+    int32_t features[k_NumNeighbors] = {0, 0, 0, 0, 0, 0};
+    int32_t numFeatures = 0;
+    int32_t most = 0;
+    int64_t best = -1;
+    for(int32_t l = 0; l < k_NumNeighbors; l++)
+    {
+      if((mask & (1 << l)) == 0)
+      {
+        continue;
+      }
+      int64_t neighbor = point + m_Offsets[l];
+      int32_t feature = featureIds[neighbor];
+      if(!isSource(feature))
+      {
+        continue;
+      }
+      int32_t current = 1;
+      for(int32_t k = 0; k < numFeatures; k++)
+      {
+        if(features[k] == feature)
+        {
+          current++;
+        }
+      }
+      features[numFeatures++] = feature;
+      if(current > most)
+      {
+        most = current;
+        best = neighbor;
+      }
+    }
+    return best;
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_Offsets[k_NumNeighbors] = {0, 0, 0, 0, 0, 0};
+  std::vector<uint8_t> m_XMask;
+  std::vector<uint8_t> m_YMask;
+  std::vector<uint8_t> m_ZMask;
+
+  static void buildAxisMask(std::vector<uint8_t>& mask, int64_t dim, bool enabled, int32_t lowerBit, int32_t upperBit)
+  {
+    mask.assign(static_cast<size_t>(dim), 0);
+    if(!enabled)
+    {
+      return;
+    }
+    for(int64_t i = 0; i < dim; i++)
+    {
+      if(i > 0)
+      {
+        mask[i] |= static_cast<uint8_t>(1 << lowerBit);
+      }
+      if(i < dim - 1)
+      {
+        mask[i] |= static_cast<uint8_t>(1 << upperBit);
+      }
+    }
+  }
+};
+
+/**
+ * @brief The ResolveSourcesImpl class finds, for copies that are applied one after the other in
+ * increasing target order, the voxel whose original tuple ends up in each target. A source that
+ * is itself an earlier target already holds the tuple of its own source when it is read.
+ */
+class ResolveSourcesImpl
+{
+public:
+  ResolveSourcesImpl(const std::vector<int64_t>& targets, const std::vector<int64_t>& sources, std::vector<int64_t>& resolved)
+  : m_Targets(targets)
+  , m_Sources(sources)
+  , m_Resolved(resolved)
+  {
+  }
+  virtual ~ResolveSourcesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      size_t current = i;
+      int64_t source = m_Sources[i];
+      while(source < m_Targets[current])
+      {
+        std::vector<int64_t>::const_iterator iter = std::lower_bound(m_Targets.begin(), m_Targets.begin() + current, source);
+        if(iter == m_Targets.begin() + current || *iter != source)
+        {
+          break;
+        }
+        current = static_cast<size_t>(iter - m_Targets.begin());
+        source = m_Sources[current];
+      }
+      m_Resolved[i] = source;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const std::vector<int64_t>& m_Targets;
+  const std::vector<int64_t>& m_Sources;
+  std::vector<int64_t>& m_Resolved;
+};
+
+/**
+ * @brief The CopyTuplesImpl class copies the tuple of sources[i] into the tuple of targets[i] for
+ * one array. Either side can be a contiguous staging buffer instead of the array itself, which is
+ * how copies whose sources are also targets are done in two passes without racing.
+ */
+template <typename T> class CopyTuplesImpl
+{
+public:
+  CopyTuplesImpl(const T* src, T* dest, size_t numComps, const std::vector<int64_t>* sources, const std::vector<int64_t>* targets)
+  : m_Src(src)
+  , m_Dest(dest)
+  , m_NumComps(numComps)
+  , m_Sources(sources)
+  , m_Targets(targets)
+  {
+  }
+  virtual ~CopyTuplesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      size_t source = (nullptr != m_Sources) ? static_cast<size_t>((*m_Sources)[i]) : i;
+      size_t target = (nullptr != m_Targets) ? static_cast<size_t>((*m_Targets)[i]) : i;
+      std::copy(m_Src + source * m_NumComps, m_Src + (source + 1) * m_NumComps, m_Dest + target * m_NumComps);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const T* m_Src;
+  T* m_Dest;
+  size_t m_NumComps;
+  const std::vector<int64_t>* m_Sources;
+  const std::vector<int64_t>* m_Targets;
+};
+
+/**
+ * @brief The TupleTransfer class copies whole tuples between voxels for a fixed set of cell arrays.
+ * The arrays are looked up once and the copies of every DataArray<T> run in parallel; any other
+ * kind of array falls back to IDataArray::copyTuple.
+ */
+class TupleTransfer
+{
+public:
+  TupleTransfer(const AttributeMatrix::Pointer& attrMat, const QList<QString>& arrayNames)
+  {
+    for(const auto& arrayName : arrayNames)
+    {
+      m_Arrays.push_back(attrMat->getAttributeArray(arrayName));
+    }
+  }
+  virtual ~TupleTransfer() = default;
+
+  /**
+   * @brief transfer Copies the tuple of sources[i] into targets[i] for every array. With sequential
+   * set the result is the same as applying the copies one at a time in the order given, which must
+   * then be increasing target order; otherwise no source may also be a target.
+   */
+  void transfer(const std::vector<int64_t>& targets, const std::vector<int64_t>& sources, bool sequential, bool doParallel) const
+  {
+    if(targets.empty())
+    {
+      return;
+    }
+    std::vector<int64_t> resolved;
+    if(sequential)
+    {
+      resolved.resize(targets.size());
+      ResolveSourcesImpl impl(targets, sources, resolved);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, targets.size()), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.convert(0, targets.size());
+      }
+    }
+
+    for(const auto& array : m_Arrays)
+    {
+      bool copied = transferTuples<int8_t>(array, targets, sources, resolved, sequential, doParallel) || transferTuples<uint8_t>(array, targets, sources, resolved, sequential, doParallel) ||
+                    transferTuples<int16_t>(array, targets, sources, resolved, sequential, doParallel) || transferTuples<uint16_t>(array, targets, sources, resolved, sequential, doParallel) ||
+                    transferTuples<int32_t>(array, targets, sources, resolved, sequential, doParallel) || transferTuples<uint32_t>(array, targets, sources, resolved, sequential, doParallel) ||
+                    transferTuples<int64_t>(array, targets, sources, resolved, sequential, doParallel) || transferTuples<uint64_t>(array, targets, sources, resolved, sequential, doParallel) ||
+                    transferTuples<float>(array, targets, sources, resolved, sequential, doParallel) || transferTuples<double>(array, targets, sources, resolved, sequential, doParallel) ||
+                    transferTuples<bool>(array, targets, sources, resolved, sequential, doParallel);
+      if(!copied)
+      {
+        for(size_t i = 0; i < targets.size(); i++)
+        {
+          array->copyTuple(static_cast<size_t>(sources[i]), static_cast<size_t>(targets[i]));
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<IDataArray::Pointer> m_Arrays;
+
+  template <typename T> static void runCopy(const CopyTuplesImpl<T>& impl, size_t count, bool doParallel)
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, count), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, count);
+    }
+  }
+
+  /**
+   * @brief transferTuples Copies the tuples of the array if it is a DataArray<T>
+   * @return false if the array is not a DataArray<T>
+   */
+  template <typename T>
+  static bool transferTuples(const IDataArray::Pointer& array, const std::vector<int64_t>& targets, const std::vector<int64_t>& sources, const std::vector<int64_t>& resolved, bool sequential,
+                             bool doParallel)
+  {
+    typename DataArray<T>::Pointer typedArray = std::dynamic_pointer_cast<DataArray<T>>(array);
+    if(nullptr == typedArray)
+    {
+      return false;
+    }
+    T* data = typedArray->getPointer(0);
+    size_t numComps = static_cast<size_t>(typedArray->getNumberOfComponents());
+    if(!sequential)
+    {
+      runCopy(CopyTuplesImpl<T>(data, data, numComps, &sources, &targets), targets.size(), doParallel);
+      return true;
+    }
+
+    // Gather the original tuples first so that no target is overwritten before it is read
+    std::unique_ptr<T[]> staging(new T[targets.size() * numComps]);
+    runCopy(CopyTuplesImpl<T>(data, staging.get(), numComps, &resolved, nullptr), targets.size(), doParallel);
+    runCopy(CopyTuplesImpl<T>(staging.get(), data, numComps, nullptr, &targets), targets.size(), doParallel);
+    return true;
+  }
+};
+
+/**
+ * @brief The FindFrontierImpl class flags every target voxel that has at least one source voxel
+ * among its neighbors.
+ */
+template <typename TargetPredicate, typename SourcePredicate> class FindFrontierImpl
+{
+public:
+  FindFrontierImpl(const Neighborhood& neighborhood, const int32_t* featureIds, uint8_t* queued, TargetPredicate isTarget, SourcePredicate isSource)
+  : m_Neighborhood(neighborhood)
+  , m_FeatureIds(featureIds)
+  , m_Queued(queued)
+  , m_IsTarget(isTarget)
+  , m_IsSource(isSource)
+  {
+  }
+  virtual ~FindFrontierImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(!m_IsTarget(m_FeatureIds[i]))
+      {
+        continue;
+      }
+      bool found = false;
+      m_Neighborhood.forEachNeighbor(static_cast<int64_t>(i), [&](int64_t neighbor) { found = found || m_IsSource(m_FeatureIds[neighbor]); });
+      m_Queued[i] = found ? 1 : 0;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const Neighborhood& m_Neighborhood;
+  const int32_t* m_FeatureIds;
+  uint8_t* m_Queued;
+  TargetPredicate m_IsTarget;
+  SourcePredicate m_IsSource;
+};
+
+/**
+ * @brief The FindMajorityNeighborImpl class picks the source neighbor of every voxel of a frontier
+ */
+template <typename SourcePredicate> class FindMajorityNeighborImpl
+{
+public:
+  FindMajorityNeighborImpl(const Neighborhood& neighborhood, const int32_t* featureIds, const std::vector<int64_t>& frontier, std::vector<int64_t>& sources, SourcePredicate isSource)
+  : m_Neighborhood(neighborhood)
+  , m_FeatureIds(featureIds)
+  , m_Frontier(frontier)
+  , m_Sources(sources)
+  , m_IsSource(isSource)
+  {
+  }
+  virtual ~FindMajorityNeighborImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Sources[i] = m_Neighborhood.findMajorityNeighbor(m_Frontier[i], m_FeatureIds, m_IsSource);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const Neighborhood& m_Neighborhood;
+  const int32_t* m_FeatureIds;
+  const std::vector<int64_t>& m_Frontier;
+  std::vector<int64_t>& m_Sources;
+  SourcePredicate m_IsSource;
+};
+
+/**
+ * @brief propagate Runs the passes of a neighbor voting cleanup. In every pass each target voxel
+ * that touches a source voxel takes, for all arrays of the transfer, the tuple of the source
+ * neighbor whose Feature occurs most often around it. A pass only looks at the state left by the
+ * previous one, so after the first pass only the targets next to the voxels that just changed are
+ * visited instead of the whole volume. The transfer is expected to include the Feature Ids, which
+ * is what turns a changed target into a source.
+ * @param maxPasses Number of passes to run, or a negative value to run until no target can change
+ * @return The number of voxels that were changed
+ */
+template <typename TargetPredicate, typename SourcePredicate>
+size_t propagate(AbstractFilter* filter, const Neighborhood& neighborhood, const int32_t* featureIds, const TupleTransfer& transfer, TargetPredicate isTarget, SourcePredicate isSource,
+                 int32_t maxPasses, bool doParallel)
+{
+  size_t totalPoints = neighborhood.getNumberOfPoints();
+
+  // The queued flags mark the voxels that have been part of a frontier, so none is visited twice
+  std::vector<uint8_t> queued(totalPoints, 0);
+  FindFrontierImpl<TargetPredicate, SourcePredicate> findFrontier(neighborhood, featureIds, queued.data(), isTarget, isSource);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), findFrontier, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    findFrontier.convert(0, totalPoints);
+  }
+
+  std::vector<int64_t> frontier;
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(queued[i] != 0)
+    {
+      frontier.push_back(static_cast<int64_t>(i));
+    }
+  }
+
+  size_t changed = 0;
+  std::vector<int64_t> sources;
+  std::vector<int64_t> nextFrontier;
+  for(int32_t pass = 0; !frontier.empty() && (maxPasses < 0 || pass < maxPasses); pass++)
+  {
+    if(filter->getCancel())
+    {
+      break;
+    }
+
+    sources.resize(frontier.size());
+    FindMajorityNeighborImpl<SourcePredicate> findSources(neighborhood, featureIds, frontier, sources, isSource);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size()), findSources, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      findSources.convert(0, frontier.size());
+    }
+
+    // A queued voxel only lacks a source if the Feature Ids are not part of the transfer
+    size_t kept = 0;
+    for(size_t i = 0; i < frontier.size(); i++)
+    {
+      if(sources[i] >= 0)
+      {
+        frontier[kept] = frontier[i];
+        sources[kept] = sources[i];
+        kept++;
+      }
+    }
+    frontier.resize(kept);
+    sources.resize(kept);
+
+    transfer.transfer(frontier, sources, false, doParallel);
+    changed += frontier.size();
+
+    // The next frontier is every target voxel that touches a voxel changed in this pass
+    nextFrontier.clear();
+    for(const auto& index : frontier)
+    {
+      neighborhood.forEachNeighbor(index, [&](int64_t neighbor) {
+        if(queued[neighbor] == 0 && isTarget(featureIds[neighbor]))
+        {
+          queued[neighbor] = 1;
+          nextFrontier.push_back(neighbor);
+        }
+      });
+    }
+    std::sort(nextFrontier.begin(), nextFrontier.end());
+    frontier.swap(nextFrontier);
+  }
+  return changed;
+}
+
+} // namespace VoxelNeighborPropagation
@@ -0,0 +1,709 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+namespace VoxelNeighborPropagationTestConsts
+{
+const size_t k_XDim = 14;
+const size_t k_YDim = 11;
+const size_t k_ZDim = 6;
+}
+
+/**
+ * @brief The VoxelNeighborPropagationTest class runs the cleanup filters built on the shared
+ * VoxelNeighborPropagation engine over a small fixture and compares every cell array with the
+ * serial loops those filters used before.
+ */
+class VoxelNeighborPropagationTest
+{
+
+public:
+  VoxelNeighborPropagationTest()
+  {
+  }
+  virtual ~VoxelNeighborPropagationTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames;
+    filtNames << "MinSize"
+              << "MinNeighbors"
+              << "FillBadData"
+              << "ErodeDilateBadData"
+              << "ErodeDilateCoordinationNumber";
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The VoxelNeighborPropagationTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocky Features with single voxel Features and scattered bad voxels sprinkled in,
+  // plus one bad region that is larger than the FillBadData defect size.
+  // -----------------------------------------------------------------------------
+  void CreateFixture(std::vector<int32_t>& featureIds, std::vector<float>& data)
+  {
+    using namespace VoxelNeighborPropagationTestConsts;
+    size_t totalPoints = k_XDim * k_YDim * k_ZDim;
+    featureIds.resize(totalPoints);
+    data.resize(3 * totalPoints);
+
+    int32_t nextSmallFeature = 25;
+    size_t index = 0;
+    for(size_t z = 0; z < k_ZDim; z++)
+    {
+      for(size_t y = 0; y < k_YDim; y++)
+      {
+        for(size_t x = 0; x < k_XDim; x++)
+        {
+          int32_t feature = static_cast<int32_t>(1 + (x / 4) + 4 * (y / 4) + 12 * (z / 3));
+          if((x * 5 + y * 3 + z * 7) % 37 == 0)
+          {
+            feature = nextSmallFeature++;
+          }
+          if((x * 3 + y * 7 + z * 11) % 13 == 0)
+          {
+            feature = 0;
+          }
+          if(x >= 9 && x < 12 && y >= 6 && y < 9 && z >= 2 && z < 4)
+          {
+            feature = 0;
+          }
+          featureIds[index] = feature;
+          for(size_t c = 0; c < 3; c++)
+          {
+            data[3 * index + c] = static_cast<float>(3 * index + c);
+          }
+          index++;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(const std::vector<int32_t>& featureIdValues, const std::vector<float>& dataValues)
+  {
+    using namespace VoxelNeighborPropagationTestConsts;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {k_XDim, k_YDim, k_ZDim};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    QVector<size_t> dims(3, 0);
+    dims[0] = k_XDim;
+    dims[1] = k_YDim;
+    dims[2] = k_ZDim;
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    size_t totalPoints = featureIdValues.size();
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, "FeatureIds", true);
+    std::copy(featureIdValues.begin(), featureIdValues.end(), featureIds->getPointer(0));
+    cellAM->addAttributeArray(featureIds->getName(), featureIds);
+
+    QVector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(totalPoints, cDims, "Data", true);
+    std::copy(dataValues.begin(), dataValues.end(), data->getPointer(0));
+    cellAM->addAttributeArray(data->getName(), data);
+
+    int32_t numFeatures = *std::max_element(featureIdValues.begin(), featureIdValues.end()) + 1;
+    QVector<size_t> featureDims(1, static_cast<size_t>(numFeatures));
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(featureDims, "FeatureData", AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix(featureAM->getName(), featureAM);
+
+    Int32ArrayType::Pointer numCells = Int32ArrayType::CreateArray(numFeatures, "NumCells", true);
+    numCells->initializeWithZeros();
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      numCells->setValue(featureIdValues[i], numCells->getValue(featureIdValues[i]) + 1);
+    }
+    featureAM->addAttributeArray(numCells->getName(), numCells);
+
+    Int32ArrayType::Pointer numNeighbors = Int32ArrayType::CreateArray(numFeatures, "NumNeighbors", true);
+    for(int32_t i = 0; i < numFeatures; i++)
+    {
+      numNeighbors->setValue(i, (i * 7) % 6);
+    }
+    featureAM->addAttributeArray(numNeighbors->getName(), numNeighbors);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SetFilterProperty(AbstractFilter::Pointer filter, const char* name, const QVariant& value)
+  {
+    bool ok = filter->setProperty(name, value);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    QVariant var;
+    var.setValue(DataArrayPath("Test", "CellData", "FeatureIds"));
+    SetFilterProperty(filter, "FeatureIdsArrayPath", var);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on a fresh copy of the fixture and requires its cell arrays to match
+  // the expected Feature Ids and data
+  // -----------------------------------------------------------------------------
+  void RunAndCompare(AbstractFilter::Pointer filter, const std::vector<int32_t>& featureIdValues, const std::vector<float>& dataValues, const std::vector<int32_t>& expectedIds,
+                     const std::vector<float>& expectedData)
+  {
+    DataContainerArray::Pointer dca = CreateTestData(featureIdValues, dataValues);
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    int err = filter->getErrorCondition();
+    DREAM3D_REQUIRE(err >= 0)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+    Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds");
+    FloatArrayType::Pointer data = cellAM->getAttributeArrayAs<FloatArrayType>("Data");
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    DREAM3D_REQUIRE_VALID_POINTER(data.get())
+
+    for(size_t i = 0; i < expectedIds.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), expectedIds[i])
+    }
+    for(size_t i = 0; i < expectedData.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(data->getValue(i), expectedData[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t FaceNeighbors(int64_t index, bool xDirOn, bool yDirOn, bool zDirOn, int64_t* neighbors)
+  {
+    using namespace VoxelNeighborPropagationTestConsts;
+    int64_t dims[3] = {static_cast<int64_t>(k_XDim), static_cast<int64_t>(k_YDim), static_cast<int64_t>(k_ZDim)};
+    int64_t column = index % dims[0];
+    int64_t row = (index / dims[0]) % dims[1];
+    int64_t plane = index / (dims[0] * dims[1]);
+    int32_t count = 0;
+    if(zDirOn && plane > 0)
+    {
+      neighbors[count++] = index - dims[0] * dims[1];
+    }
+    if(yDirOn && row > 0)
+    {
+      neighbors[count++] = index - dims[0];
+    }
+    if(xDirOn && column > 0)
+    {
+      neighbors[count++] = index - 1;
+    }
+    if(xDirOn && column < dims[0] - 1)
+    {
+      neighbors[count++] = index + 1;
+    }
+    if(yDirOn && row < dims[1] - 1)
+    {
+      neighbors[count++] = index + dims[0];
+    }
+    if(zDirOn && plane < dims[2] - 1)
+    {
+      neighbors[count++] = index + dims[0] * dims[1];
+    }
+    return count;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CopyTuple(std::vector<int32_t>& featureIds, std::vector<float>& data, int64_t source, int64_t dest)
+  {
+    featureIds[dest] = featureIds[source];
+    for(size_t c = 0; c < 3; c++)
+    {
+      data[3 * dest + c] = data[3 * source + c];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial sweep that MinSize, MinNeighbors and FillBadData ran before the shared
+  // propagation engine: every voxel with a negative Feature Id takes the tuple of the
+  // neighbor whose Feature first reaches the largest count, until no such voxel is left.
+  // -----------------------------------------------------------------------------
+  void ReferenceFill(std::vector<int32_t>& featureIds, std::vector<float>& data, int32_t minGoodId)
+  {
+    size_t totalPoints = featureIds.size();
+    int32_t numFeatures = *std::max_element(featureIds.begin(), featureIds.end()) + 1;
+    std::vector<int32_t> n(static_cast<size_t>(numFeatures), 0);
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    size_t counter = 1;
+    while(counter != 0)
+    {
+      counter = 0;
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        if(featureIds[i] >= 0)
+        {
+          continue;
+        }
+        counter++;
+        int32_t most = 0;
+        int32_t numNeighbors = FaceNeighbors(static_cast<int64_t>(i), true, true, true, neighpoints);
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          int32_t feature = featureIds[neighpoints[l]];
+          if(feature >= minGoodId)
+          {
+            n[feature]++;
+            if(n[feature] > most)
+            {
+              most = n[feature];
+              neighbors[i] = neighpoints[l];
+            }
+          }
+        }
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          int32_t feature = featureIds[neighpoints[l]];
+          if(feature >= minGoodId)
+          {
+            n[feature] = 0;
+          }
+        }
+      }
+      for(size_t j = 0; j < totalPoints; j++)
+      {
+        int64_t neighbor = neighbors[j];
+        if(featureIds[j] < 0 && neighbor >= 0 && featureIds[neighbor] >= minGoodId)
+        {
+          CopyTuple(featureIds, data, neighbor, static_cast<int64_t>(j));
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial ErodeDilateBadData loop before the shared propagation engine
+  // -----------------------------------------------------------------------------
+  void ReferenceErodeDilate(std::vector<int32_t>& featureIds, std::vector<float>& data, uint32_t direction, int32_t numIterations, bool xDirOn, bool yDirOn, bool zDirOn)
+  {
+    size_t totalPoints = featureIds.size();
+    int32_t numFeatures = *std::max_element(featureIds.begin(), featureIds.end()) + 1;
+    std::vector<int32_t> n(static_cast<size_t>(numFeatures), 0);
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    for(int32_t iteration = 0; iteration < numIterations; iteration++)
+    {
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        if(featureIds[i] != 0)
+        {
+          continue;
+        }
+        int32_t most = 0;
+        int32_t numNeighbors = FaceNeighbors(static_cast<int64_t>(i), xDirOn, yDirOn, zDirOn, neighpoints);
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          int32_t feature = featureIds[neighpoints[l]];
+          if(feature > 0 && direction == 0)
+          {
+            neighbors[neighpoints[l]] = static_cast<int64_t>(i);
+          }
+          if(feature > 0 && direction == 1)
+          {
+            n[feature]++;
+            if(n[feature] > most)
+            {
+              most = n[feature];
+              neighbors[i] = neighpoints[l];
+            }
+          }
+        }
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          n[featureIds[neighpoints[l]]] = 0;
+        }
+      }
+      for(size_t j = 0; j < totalPoints; j++)
+      {
+        int64_t neighbor = neighbors[j];
+        if(neighbor < 0)
+        {
+          continue;
+        }
+        if((featureIds[j] == 0 && featureIds[neighbor] > 0 && direction == 1) || (featureIds[j] > 0 && featureIds[neighbor] == 0 && direction == 0))
+        {
+          CopyTuple(featureIds, data, neighbor, static_cast<int64_t>(j));
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial ErodeDilateCoordinationNumber loop before the shared propagation engine
+  // -----------------------------------------------------------------------------
+  void ReferenceCoordinationNumber(std::vector<int32_t>& featureIds, std::vector<float>& data, int32_t coordinationNumber, bool loop)
+  {
+    size_t totalPoints = featureIds.size();
+    int32_t numFeatures = *std::max_element(featureIds.begin(), featureIds.end()) + 1;
+    std::vector<int32_t> n(static_cast<size_t>(numFeatures), 0);
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    std::vector<int32_t> coordination(totalPoints, 0);
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    bool keepGoing = true;
+    int32_t counter = 1;
+    while(counter > 0 && keepGoing)
+    {
+      counter = 0;
+      keepGoing = loop;
+      for(size_t point = 0; point < totalPoints; point++)
+      {
+        int32_t featurename = featureIds[point];
+        int32_t most = 0;
+        coordination[point] = 0;
+        int32_t numNeighbors = FaceNeighbors(static_cast<int64_t>(point), true, true, true, neighpoints);
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          int32_t feature = featureIds[neighpoints[l]];
+          if((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
+          {
+            coordination[point]++;
+            n[feature]++;
+            if(n[feature] > most)
+            {
+              most = n[feature];
+              neighbors[point] = neighpoints[l];
+            }
+          }
+        }
+        if(coordination[point] >= coordinationNumber && coordination[point] > 0)
+        {
+          CopyTuple(featureIds, data, neighbors[point], static_cast<int64_t>(point));
+        }
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          n[featureIds[neighpoints[l]]] = 0;
+        }
+      }
+      for(size_t point = 0; point < totalPoints; point++)
+      {
+        if(coordination[point] >= coordinationNumber)
+        {
+          counter++;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Removes the Features that fail the test and renumbers the rest the way
+  // AttributeMatrix::removeInactiveObjects does
+  // -----------------------------------------------------------------------------
+  void ReferenceRemoveFeatures(std::vector<int32_t>& featureIds, std::vector<float>& data, const std::vector<bool>& activeObjects)
+  {
+    for(auto& featureId : featureIds)
+    {
+      if(!activeObjects[featureId])
+      {
+        featureId = -1;
+      }
+    }
+    ReferenceFill(featureIds, data, 0);
+
+    std::vector<int32_t> newIds(activeObjects.size(), 0);
+    int32_t nextId = 0;
+    for(size_t i = 0; i < activeObjects.size(); i++)
+    {
+      if(activeObjects[i])
+      {
+        newIds[i] = nextId++;
+      }
+    }
+    for(auto& featureId : featureIds)
+    {
+      featureId = newIds[featureId];
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMinSize()
+  {
+    std::vector<int32_t> featureIds;
+    std::vector<float> data;
+    CreateFixture(featureIds, data);
+
+    const int32_t minSize = 2;
+    int32_t numFeatures = *std::max_element(featureIds.begin(), featureIds.end()) + 1;
+    std::vector<int32_t> numCells(static_cast<size_t>(numFeatures), 0);
+    for(const auto& featureId : featureIds)
+    {
+      numCells[featureId]++;
+    }
+    std::vector<bool> activeObjects(static_cast<size_t>(numFeatures), true);
+    int32_t numRemoved = 0;
+    for(int32_t i = 1; i < numFeatures; i++)
+    {
+      if(numCells[i] < minSize)
+      {
+        activeObjects[i] = false;
+        numRemoved++;
+      }
+    }
+    DREAM3D_REQUIRE(numRemoved > 0)
+
+    std::vector<int32_t> expectedIds(featureIds);
+    std::vector<float> expectedData(data);
+    ReferenceRemoveFeatures(expectedIds, expectedData, activeObjects);
+
+    AbstractFilter::Pointer filter = CreateFilter("MinSize");
+    QVariant var;
+    var.setValue(minSize);
+    SetFilterProperty(filter, "MinAllowedFeatureSize", var);
+    var.setValue(DataArrayPath("Test", "FeatureData", "NumCells"));
+    SetFilterProperty(filter, "NumCellsArrayPath", var);
+
+    RunAndCompare(filter, featureIds, data, expectedIds, expectedData);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMinNeighbors()
+  {
+    std::vector<int32_t> featureIds;
+    std::vector<float> data;
+    CreateFixture(featureIds, data);
+
+    const int32_t minNumNeighbors = 2;
+    int32_t numFeatures = *std::max_element(featureIds.begin(), featureIds.end()) + 1;
+    std::vector<bool> activeObjects(static_cast<size_t>(numFeatures), true);
+    for(int32_t i = 1; i < numFeatures; i++)
+    {
+      // Matches the NumNeighbors array that CreateTestData stores
+      activeObjects[i] = ((i * 7) % 6) >= minNumNeighbors;
+    }
+
+    std::vector<int32_t> expectedIds(featureIds);
+    std::vector<float> expectedData(data);
+    ReferenceRemoveFeatures(expectedIds, expectedData, activeObjects);
+
+    AbstractFilter::Pointer filter = CreateFilter("MinNeighbors");
+    QVariant var;
+    var.setValue(minNumNeighbors);
+    SetFilterProperty(filter, "MinNumNeighbors", var);
+    var.setValue(DataArrayPath("Test", "FeatureData", "NumNeighbors"));
+    SetFilterProperty(filter, "NumNeighborsArrayPath", var);
+
+    RunAndCompare(filter, featureIds, data, expectedIds, expectedData);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFillBadData()
+  {
+    using namespace VoxelNeighborPropagationTestConsts;
+
+    std::vector<int32_t> featureIds;
+    std::vector<float> data;
+    CreateFixture(featureIds, data);
+
+    // Bad regions smaller than the defect size are marked for filling, larger ones are kept
+    const int32_t minDefectSize = 10;
+    std::vector<int32_t> expectedIds(featureIds);
+    std::vector<float> expectedData(data);
+    std::vector<bool> checked(featureIds.size(), false);
+    std::vector<int64_t> region;
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    size_t numKept = 0;
+    for(size_t i = 0; i < expectedIds.size(); i++)
+    {
+      if(checked[i] || expectedIds[i] != 0)
+      {
+        continue;
+      }
+      region.assign(1, static_cast<int64_t>(i));
+      checked[i] = true;
+      for(size_t count = 0; count < region.size(); count++)
+      {
+        int32_t numNeighbors = FaceNeighbors(region[count], true, true, true, neighpoints);
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          if(expectedIds[neighpoints[l]] == 0 && !checked[neighpoints[l]])
+          {
+            region.push_back(neighpoints[l]);
+            checked[neighpoints[l]] = true;
+          }
+        }
+      }
+      if(static_cast<int32_t>(region.size()) < minDefectSize)
+      {
+        for(const auto& index : region)
+        {
+          expectedIds[index] = -1;
+        }
+      }
+      else
+      {
+        numKept += region.size();
+      }
+    }
+    DREAM3D_REQUIRE(numKept > 0)
+    ReferenceFill(expectedIds, expectedData, 1);
+
+    AbstractFilter::Pointer filter = CreateFilter("FillBadData");
+    QVariant var;
+    var.setValue(minDefectSize);
+    SetFilterProperty(filter, "MinAllowedDefectSize", var);
+    var.setValue(false);
+    SetFilterProperty(filter, "StoreAsNewPhase", var);
+
+    RunAndCompare(filter, featureIds, data, expectedIds, expectedData);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareErodeDilate(uint32_t direction, int32_t numIterations, bool xDirOn, bool yDirOn, bool zDirOn)
+  {
+    std::vector<int32_t> featureIds;
+    std::vector<float> data;
+    CreateFixture(featureIds, data);
+
+    std::vector<int32_t> expectedIds(featureIds);
+    std::vector<float> expectedData(data);
+    ReferenceErodeDilate(expectedIds, expectedData, direction, numIterations, xDirOn, yDirOn, zDirOn);
+
+    AbstractFilter::Pointer filter = CreateFilter("ErodeDilateBadData");
+    QVariant var;
+    var.setValue(direction);
+    SetFilterProperty(filter, "Direction", var);
+    var.setValue(numIterations);
+    SetFilterProperty(filter, "NumIterations", var);
+    var.setValue(xDirOn);
+    SetFilterProperty(filter, "XDirOn", var);
+    var.setValue(yDirOn);
+    SetFilterProperty(filter, "YDirOn", var);
+    var.setValue(zDirOn);
+    SetFilterProperty(filter, "ZDirOn", var);
+
+    RunAndCompare(filter, featureIds, data, expectedIds, expectedData);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestErodeDilateBadData()
+  {
+    CompareErodeDilate(0, 1, true, true, true);
+    CompareErodeDilate(0, 2, true, true, false);
+    CompareErodeDilate(1, 1, true, true, true);
+    CompareErodeDilate(1, 3, false, true, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareCoordinationNumber(int32_t coordinationNumber, bool loop)
+  {
+    std::vector<int32_t> featureIds;
+    std::vector<float> data;
+    CreateFixture(featureIds, data);
+
+    std::vector<int32_t> expectedIds(featureIds);
+    std::vector<float> expectedData(data);
+    ReferenceCoordinationNumber(expectedIds, expectedData, coordinationNumber, loop);
+
+    AbstractFilter::Pointer filter = CreateFilter("ErodeDilateCoordinationNumber");
+    QVariant var;
+    var.setValue(coordinationNumber);
+    SetFilterProperty(filter, "CoordinationNumber", var);
+    var.setValue(loop);
+    SetFilterProperty(filter, "Loop", var);
+
+    RunAndCompare(filter, featureIds, data, expectedIds, expectedData);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestErodeDilateCoordinationNumber()
+  {
+    CompareCoordinationNumber(4, false);
+    CompareCoordinationNumber(3, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMinSize())
+    DREAM3D_REGISTER_TEST(TestMinNeighbors())
+    DREAM3D_REGISTER_TEST(TestFillBadData())
+    DREAM3D_REGISTER_TEST(TestErodeDilateBadData())
+    DREAM3D_REGISTER_TEST(TestErodeDilateCoordinationNumber())
+  }
+
+private:
+  VoxelNeighborPropagationTest(const VoxelNeighborPropagationTest&); // Copy Constructor Not Implemented
+  void operator=(const VoxelNeighborPropagationTest&);               // Move assignment Not Implemented
+};
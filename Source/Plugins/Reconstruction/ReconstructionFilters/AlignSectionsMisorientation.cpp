@@ -35,12 +35,22 @@
 
 #include "AlignSectionsMisorientation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -50,12 +60,238 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+class AlignSectionsMisorientationImpl
+{
+public:
+  AlignSectionsMisorientationImpl(const int64_t* dims, QuatF* quats, int32_t* cellPhases, uint32_t* crystalStructures, bool* goodVoxels, bool useGoodVoxels, float misorientationTolerance,
+                                  const QVector<LaueOps::Pointer>& orientationOps, int64_t coarsestScale, std::vector<int64_t>& newXShifts, std::vector<int64_t>& newYShifts)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_UseGoodVoxels(useGoodVoxels)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_OrientationOps(orientationOps)
+  , m_CoarsestScale(coarsestScale)
+  , m_NewXShifts(newXShifts)
+  , m_NewYShifts(newYShifts)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~AlignSectionsMisorientationImpl() = default;
+
+  /**
+   * @brief findShifts Finds the shift between each slice pair in [start, end). Every pair is
+   * independent of the others, so ranges of pairs may be searched concurrently.
+   */
+  void findShifts(int64_t start, int64_t end) const
+  {
+    // Each range gets its own record of the shifts that have been visited
+    std::vector<bool> misorients(m_Dims[0] * m_Dims[1], false);
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      findShift(iter, misorients);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    findShifts(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int64_t m_Dims[3];
+  QuatF* m_Quats;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  bool* m_GoodVoxels;
+  bool m_UseGoodVoxels;
+  float m_MisorientationTolerance;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+  int64_t m_CoarsestScale;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+
+  /**
+   * @brief findShift Finds the shift of one slice pair. With a coarsest scale above one the whole
+   * range of shifts is first scanned on slices subsampled by that scale, and each finer level then
+   * walks from the shift the level above it found; the last walk is the full resolution search.
+   */
+  void findShift(int64_t iter, std::vector<bool>& misorients) const
+  {
+    const int64_t slice = (m_Dims[2] - 1) - iter;
+    int64_t xshift = 0;
+    int64_t yshift = 0;
+    if(m_CoarsestScale > 1)
+    {
+      scanShifts(slice, m_CoarsestScale, xshift, yshift);
+      for(int64_t scale = m_CoarsestScale / 2; scale > 1; scale = scale / 2)
+      {
+        std::fill(misorients.begin(), misorients.end(), false);
+        walkShifts(slice, scale, misorients, xshift, yshift);
+      }
+    }
+    std::fill(misorients.begin(), misorients.end(), false);
+    walkShifts(slice, 1, misorients, xshift, yshift);
+    m_NewXShifts[iter] = xshift;
+    m_NewYShifts[iter] = yshift;
+  }
+
+  /**
+   * @brief isBetter Returns whether a candidate shift should replace the best one found so far;
+   * ties go to the candidate closer to no shift at all.
+   */
+  bool isBetter(float disorientation, float mindisorientation, int64_t xshift, int64_t yshift, int64_t bestxshift, int64_t bestyshift) const
+  {
+    return disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(xshift) < llabs(bestxshift)) || (llabs(yshift) < llabs(bestyshift))));
+  }
+
+  /**
+   * @brief walkShifts Moves a 7x7 grid of shifts spaced scale Cells apart, centered on the best
+   * shift so far, until the center is the best shift in its grid
+   */
+  void walkShifts(int64_t slice, int64_t scale, std::vector<bool>& misorients, int64_t& newxshift, int64_t& newyshift) const
+  {
+    float disorientation = 0.0f;
+    float mindisorientation = std::numeric_limits<float>::max();
+    int64_t idx = 0; // This will be used to compute the index into the flat array
+    int64_t xIdx = 0;
+    int64_t yIdx = 0;
+
+    const int64_t halfDim0 = static_cast<int64_t>(m_Dims[0] * 0.5f);
+    const int64_t halfDim1 = static_cast<int64_t>(m_Dims[1] * 0.5f);
+
+    int64_t oldxshift = 0;
+    int64_t oldyshift = 0;
+    do
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          int64_t xshift = k * scale + oldxshift;
+          int64_t yshift = j * scale + oldyshift;
+          xIdx = xshift + halfDim0;
+          yIdx = yshift + halfDim1;
+          idx = (m_Dims[0] * yIdx) + xIdx;
+          if(llabs(xshift) < halfDim0 && llabs(yshift) < halfDim1 && !misorients[idx])
+          {
+            disorientation = computeDisorientation(slice, xshift, yshift, 4 * scale);
+            misorients[idx] = true;
+            if(isBetter(disorientation, mindisorientation, xshift, yshift, newxshift, newyshift))
+            {
+              newxshift = xshift;
+              newyshift = yshift;
+              mindisorientation = disorientation;
+            }
+          }
+        }
+      }
+    } while(newxshift != oldxshift || newyshift != oldyshift);
+  }
+
+  /**
+   * @brief scanShifts Tries every shift that is a multiple of scale and keeps at least half of
+   * each slice overlapping, comparing the slices only every 4 * scale Cells
+   */
+  void scanShifts(int64_t slice, int64_t scale, int64_t& newxshift, int64_t& newyshift) const
+  {
+    float mindisorientation = std::numeric_limits<float>::max();
+    const int64_t maxXShift = static_cast<int64_t>(m_Dims[0] * 0.25f) / scale * scale;
+    const int64_t maxYShift = static_cast<int64_t>(m_Dims[1] * 0.25f) / scale * scale;
+    for(int64_t yshift = -maxYShift; yshift <= maxYShift; yshift += scale)
+    {
+      for(int64_t xshift = -maxXShift; xshift <= maxXShift; xshift += scale)
+      {
+        float disorientation = computeDisorientation(slice, xshift, yshift, 4 * scale);
+        if(isBetter(disorientation, mindisorientation, xshift, yshift, newxshift, newyshift))
+        {
+          newxshift = xshift;
+          newyshift = yshift;
+          mindisorientation = disorientation;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief computeDisorientation Returns the fraction of the Cells sampled every stride Cells whose
+   * misorientation across the slice pair exceeds the tolerance when the lower slice is shifted
+   */
+  float computeDisorientation(int64_t slice, int64_t xshift, int64_t yshift, int64_t stride) const
+  {
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    float w = 0.0f;
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+    QuatF q1 = QuaternionMathF::New();
+    QuatF q2 = QuaternionMathF::New();
+    int64_t refposition = 0;
+    int64_t curposition = 0;
+    uint32_t phase1 = 0, phase2 = 0;
+
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+      {
+        if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
+        {
+          count++;
+          refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+          curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + yshift) * m_Dims[0]) + (n + xshift);
+          if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+          {
+            w = std::numeric_limits<float>::max();
+            if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+            {
+              QuaternionMathF::Copy(m_Quats[refposition], q1);
+              phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+              QuaternionMathF::Copy(m_Quats[curposition], q2);
+              phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+              if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
+              {
+                w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+              }
+            }
+            if(w > m_MisorientationTolerance)
+            {
+              disorientation++;
+            }
+          }
+          if(m_UseGoodVoxels)
+          {
+            if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
+            {
+              disorientation++;
+            }
+            if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
+            {
+              disorientation++;
+            }
+          }
+        }
+      }
+    }
+    return disorientation / count;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 AlignSectionsMisorientation::AlignSectionsMisorientation()
 : m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_UsePyramidSearch(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -84,6 +320,7 @@ void AlignSectionsMisorientation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMisorientation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMisorientation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Pyramid Search", UsePyramidSearch, FilterParameter::Parameter, AlignSectionsMisorientation));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -120,6 +357,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUsePyramidSearch(reader->readValue("UsePyramidSearch", getUsePyramidSearch()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
@@ -223,12 +461,6 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -236,138 +468,69 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], "_INTERNAL_USE_ONLY_Misorients");
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
-
-  const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
-  const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
-
-  // Loop over the Z Direction
-  for(int64_t iter = 1; iter < dims[2]; iter++)
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
+
+  // The optional pyramid search starts from slices subsampled by the largest power of two that
+  // still leaves at least 16 samples along each axis at the 4 Cell spacing of the full search
+  int64_t coarsestScale = 1;
+  if(m_UsePyramidSearch)
   {
-    progInt = ((float)iter / dims[2]) * 100.0f;
+    while(std::min(dims[0], dims[1]) / (8 * coarsestScale) >= 16)
+    {
+      coarsestScale = coarsestScale * 2;
+    }
+  }
+
+  // The shift between each pair of slices does not depend on any other pair, so the pairs are
+  // searched concurrently and only the running total of the shifts is accumulated in order.
+  std::vector<int64_t> newXShifts(dims[2], 0);
+  std::vector<int64_t> newYShifts(dims[2], 0);
+  AlignSectionsMisorientationImpl impl(dims, reinterpret_cast<QuatF*>(m_Quats), m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_UseGoodVoxels, misorientationTolerance, m_OrientationOps, coarsestScale,
+                                       newXShifts, newYShifts);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Pairs are handed out in batches so progress can be reported and a cancel honored between them
+  const int64_t k_PairsPerBatch = 64;
+  for(int64_t batchStart = 1; batchStart < dims[2]; batchStart += k_PairsPerBatch)
+  {
+    int64_t progInt = ((float)batchStart / dims[2]) * 100.0f;
     QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
     if(getCancel())
     {
       return;
     }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
-
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_Pif / 180.0f;
-
-    while(newxshift != oldxshift || newyshift != oldyshift)
+    int64_t batchEnd = std::min(batchStart + k_PairsPerBatch, dims[2]);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      QuaternionMathF::Copy(quats[refposition], q1);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
+      tbb::parallel_for(tbb::blocked_range<int64_t>(batchStart, batchEnd, 1), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.findShifts(batchStart, batchEnd);
     }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+  }
+
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
+
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newYShifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newXShifts[iter] << "	" << newYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
   }
   if(getWriteAlignmentShifts())
@@ -34,10 +34,20 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -48,12 +58,262 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+class AlignSectionsMutualInformationImpl
+{
+public:
+  AlignSectionsMutualInformationImpl(const int64_t* dims, int32_t* miFeatureIds, int32_t* featureCounts, int64_t coarsestScale, std::vector<int64_t>& newXShifts, std::vector<int64_t>& newYShifts)
+  : m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_CoarsestScale(coarsestScale)
+  , m_NewXShifts(newXShifts)
+  , m_NewYShifts(newYShifts)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+  virtual ~AlignSectionsMutualInformationImpl() = default;
+
+  /**
+   * @brief findShifts Finds the shift between each slice pair in [start, end). Every pair is
+   * independent of the others, so ranges of pairs may be searched concurrently.
+   */
+  void findShifts(int64_t start, int64_t end) const
+  {
+    // Each range gets its own record of the shifts that have been visited
+    std::vector<float> misorients(m_Dims[0] * m_Dims[1], 0.0f);
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      findShift(iter, misorients);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    findShifts(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int64_t m_Dims[3];
+  int32_t* m_MIFeatureIds;
+  int32_t* m_FeatureCounts;
+  int64_t m_CoarsestScale;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+
+  /**
+   * @brief The MutualInformation struct holds the joint and marginal histograms of the Feature
+   * Ids of one slice pair
+   */
+  struct MutualInformation
+  {
+    int32_t featurecount1;
+    int32_t featurecount2;
+    std::vector<float> mutualinfo12;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+  };
+
+  /**
+   * @brief findShift Finds the shift of one slice pair. With a coarsest scale above one the whole
+   * range of shifts is first scanned on slices subsampled by that scale, and each finer level then
+   * walks from the shift the level above it found; the last walk is the full resolution search.
+   */
+  void findShift(int64_t iter, std::vector<float>& misorients) const
+  {
+    const int64_t slice = (m_Dims[2] - 1) - iter;
+    MutualInformation info;
+    info.featurecount1 = m_FeatureCounts[slice];
+    info.featurecount2 = m_FeatureCounts[slice + 1];
+    info.mutualinfo12.assign(static_cast<size_t>(info.featurecount1) * info.featurecount2, 0.0f);
+    info.mutualinfo1.assign(info.featurecount1, 0.0f);
+    info.mutualinfo2.assign(info.featurecount2, 0.0f);
+
+    int64_t xshift = 0;
+    int64_t yshift = 0;
+    if(m_CoarsestScale > 1)
+    {
+      scanShifts(slice, m_CoarsestScale, info, xshift, yshift);
+      for(int64_t scale = m_CoarsestScale / 2; scale > 1; scale = scale / 2)
+      {
+        std::fill(misorients.begin(), misorients.end(), 0.0f);
+        walkShifts(slice, scale, info, misorients, xshift, yshift);
+      }
+    }
+    std::fill(misorients.begin(), misorients.end(), 0.0f);
+    walkShifts(slice, 1, info, misorients, xshift, yshift);
+    m_NewXShifts[iter] = xshift;
+    m_NewYShifts[iter] = yshift;
+  }
+
+  /**
+   * @brief walkShifts Moves a 7x7 grid of shifts spaced scale Cells apart, centered on the best
+   * shift so far, until the center is the best shift in its grid
+   */
+  void walkShifts(int64_t slice, int64_t scale, MutualInformation& info, std::vector<float>& misorients, int64_t& newxshift, int64_t& newyshift) const
+  {
+    float disorientation = 0.0f;
+    float mindisorientation = std::numeric_limits<float>::max();
+    int64_t idx = 0;
+
+    int64_t oldxshift = 0;
+    int64_t oldyshift = 0;
+    do
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          int64_t xshift = k * scale + oldxshift;
+          int64_t yshift = j * scale + oldyshift;
+          idx = ((xshift + m_Dims[0] / 2) * m_Dims[1]) + (yshift + m_Dims[1] / 2);
+          if(llabs(xshift) < (m_Dims[0] / 2) && llabs(yshift) < (m_Dims[1] / 2) && misorients[idx] == 0)
+          {
+            disorientation = computeDisorientation(slice, xshift, yshift, 4 * scale, scale == 1, info);
+            misorients[idx] = disorientation;
+            if(disorientation < mindisorientation)
+            {
+              newxshift = xshift;
+              newyshift = yshift;
+              mindisorientation = disorientation;
+            }
+          }
+        }
+      }
+    } while(newxshift != oldxshift || newyshift != oldyshift);
+  }
+
+  /**
+   * @brief scanShifts Tries every shift that is a multiple of scale and keeps at least half of
+   * each slice overlapping, comparing the slices only every 4 * scale Cells
+   */
+  void scanShifts(int64_t slice, int64_t scale, MutualInformation& info, int64_t& newxshift, int64_t& newyshift) const
+  {
+    float mindisorientation = std::numeric_limits<float>::max();
+    const int64_t maxXShift = (m_Dims[0] / 4) / scale * scale;
+    const int64_t maxYShift = (m_Dims[1] / 4) / scale * scale;
+    for(int64_t yshift = -maxYShift; yshift <= maxYShift; yshift += scale)
+    {
+      for(int64_t xshift = -maxXShift; xshift <= maxXShift; xshift += scale)
+      {
+        float disorientation = computeDisorientation(slice, xshift, yshift, 4 * scale, false, info);
+        if(disorientation < mindisorientation)
+        {
+          newxshift = xshift;
+          newyshift = yshift;
+          mindisorientation = disorientation;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief computeDisorientation Returns the inverse of the mutual information between the
+   * Feature Ids sampled every stride Cells across the slice pair when the lower slice is shifted.
+   * The full resolution search counts samples shifted off the slice into the first bins; the
+   * coarse levels leave them out, since over their wider range of shifts those counts alone
+   * would favor the largest shifts.
+   */
+  float computeDisorientation(int64_t slice, int64_t xshift, int64_t yshift, int64_t stride, bool countOutside, MutualInformation& info) const
+  {
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    int32_t refgnum = 0, curgnum = 0;
+    int64_t refposition = 0;
+    int64_t curposition = 0;
+    const int32_t featurecount1 = info.featurecount1;
+    const int32_t featurecount2 = info.featurecount2;
+    std::vector<float>& mutualinfo12 = info.mutualinfo12;
+    std::vector<float>& mutualinfo1 = info.mutualinfo1;
+    std::vector<float>& mutualinfo2 = info.mutualinfo2;
+
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+      {
+        if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
+        {
+          refposition = ((slice + 1) * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]) + n;
+          curposition = (slice * m_Dims[0] * m_Dims[1]) + ((l + yshift) * m_Dims[0]) + (n + xshift);
+          refgnum = m_MIFeatureIds[refposition];
+          curgnum = m_MIFeatureIds[curposition];
+          if(curgnum >= 0 && refgnum >= 0)
+          {
+            mutualinfo12[curgnum * featurecount2 + refgnum]++;
+            mutualinfo1[curgnum]++;
+            mutualinfo2[refgnum]++;
+            count++;
+          }
+        }
+        else if(countOutside)
+        {
+          mutualinfo12[0]++;
+          mutualinfo1[0]++;
+          mutualinfo2[0]++;
+        }
+      }
+    }
+    float ha = 0.0f;
+    float hb = 0.0f;
+    float hab = 0.0f;
+    for(int32_t b = 0; b < featurecount1; b++)
+    {
+      mutualinfo1[b] = mutualinfo1[b] / count;
+      if(mutualinfo1[b] != 0)
+      {
+        ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
+      }
+    }
+    for(int32_t c = 0; c < featurecount2; c++)
+    {
+      mutualinfo2[c] = mutualinfo2[c] / float(count);
+      if(mutualinfo2[c] != 0)
+      {
+        hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
+      }
+    }
+    for(int32_t b = 0; b < featurecount1; b++)
+    {
+      for(int32_t c = 0; c < featurecount2; c++)
+      {
+        float& joint = mutualinfo12[b * featurecount2 + c];
+        joint = joint / count;
+        if(joint != 0)
+        {
+          hab = hab + joint * logf(joint);
+        }
+        float value = 0.0f;
+        if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+        {
+          value = (joint / (mutualinfo1[b] * mutualinfo2[c]));
+        }
+        if(value != 0)
+        {
+          disorientation = disorientation + (joint * logf(value));
+        }
+      }
+    }
+    std::fill(mutualinfo12.begin(), mutualinfo12.end(), 0.0f);
+    std::fill(mutualinfo1.begin(), mutualinfo1.end(), 0.0f);
+    std::fill(mutualinfo2.begin(), mutualinfo2.end(), 0.0f);
+    return 1.0f / disorientation;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 AlignSectionsMutualInformation::AlignSectionsMutualInformation()
 : m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_UsePyramidSearch(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -84,6 +344,7 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMutualInformation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMutualInformation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Pyramid Search", UsePyramidSearch, FilterParameter::Parameter, AlignSectionsMutualInformation));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -116,6 +377,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   reader->openFilterGroup(this, index);
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUsePyramidSearch(reader->readValue("UsePyramidSearch", getUsePyramidSearch()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
@@ -226,12 +488,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   m_MIFeaturesPtr->initializeWithZeros();
   int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -239,180 +495,65 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  // The optional pyramid search starts from slices subsampled by the largest power of two that
+  // still leaves at least 16 samples along each axis at the 4 Cell spacing of the full search
+  int64_t coarsestScale = 1;
+  if(m_UsePyramidSearch)
   {
-    misorients[a].assign(dims[1], 0.0f);
+    while(std::min(dims[0], dims[1]) / (8 * coarsestScale) >= 16)
+    {
+      coarsestScale = coarsestScale * 2;
+    }
   }
 
-  for(int64_t iter = 1; iter < dims[2]; iter++)
+  // The shift between each pair of slices does not depend on any other pair, so the pairs are
+  // searched concurrently and only the running total of the shifts is accumulated in order.
+  std::vector<int64_t> newXShifts(dims[2], 0);
+  std::vector<int64_t> newYShifts(dims[2], 0);
+  AlignSectionsMutualInformationImpl impl(dims, miFeatureIds, featurecounts, coarsestScale, newXShifts, newYShifts);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Pairs are handed out in batches so progress can be reported between them
+  const int64_t k_PairsPerBatch = 64;
+  for(int64_t batchStart = 1; batchStart < dims[2]; batchStart += k_PairsPerBatch)
   {
-    float prog = ((float)iter / dims[2]) * 100;
+    float prog = ((float)batchStart / dims[2]) * 100;
     QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
+    int64_t batchEnd = std::min(batchStart + k_PairsPerBatch, dims[2]);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
     {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
+      tbb::parallel_for(tbb::blocked_range<int64_t>(batchStart, batchEnd, 1), impl, tbb::auto_partitioner());
     }
-    while(newxshift != oldxshift || newyshift != oldyshift)
+    else
+#endif
     {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
+      impl.findShifts(batchStart, batchEnd);
     }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+  }
+
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
+
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newXShifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newYShifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
+      outFile << slice << "	" << slice + 1 << "	" << newXShifts[iter] << "	" << newYShifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
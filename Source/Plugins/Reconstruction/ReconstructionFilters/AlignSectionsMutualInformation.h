@@ -54,6 +54,7 @@ class Reconstruction_EXPORT AlignSectionsMutualInformation : public AlignSection
     PYB11_CREATE_BINDINGS(AlignSectionsMutualInformation SUPERCLASS AlignSections)
     PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UsePyramidSearch READ getUsePyramidSearch WRITE setUsePyramidSearch)
     PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
     PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
@@ -73,6 +74,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, UseGoodVoxels)
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  SIMPL_FILTER_PARAMETER(bool, UsePyramidSearch)
+  Q_PROPERTY(bool UsePyramidSearch READ getUsePyramidSearch WRITE setUsePyramidSearch)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, QuatsArrayPath)
   Q_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
 
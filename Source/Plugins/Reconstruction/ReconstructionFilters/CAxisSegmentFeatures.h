@@ -56,6 +56,7 @@ class Reconstruction_EXPORT CAxisSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(QString CellFeatureAttributeMatrixName READ getCellFeatureAttributeMatrixName WRITE setCellFeatureAttributeMatrixName)
     PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseUnionFindSegmentation READ getUseUnionFindSegmentation WRITE setUseUnionFindSegmentation)
     PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
     PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
     PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
@@ -163,6 +164,16 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief isValidSeed Reimplemented from @see SegmentFeatures class
+   */
+  bool isValidSeed(int64_t point) override;
+
+  /**
+   * @brief areGroupable Reimplemented from @see SegmentFeatures class
+   */
+  bool areGroupable(int64_t point1, int64_t point2) override;
+
 protected:
   CAxisSegmentFeatures();
   /**
@@ -185,6 +196,16 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+   */
+  void resizeFeatureAttributeMatrix(size_t numFeatures) override;
+
 private:
   QVector<LaueOps::Pointer> m_OrientationOps;
 
@@ -41,6 +41,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -85,6 +86,7 @@ void EBSDSegmentFeatures::setupFilterParameters()
   SegmentFeatures::setupFilterParameters();
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, EBSDSegmentFeatures));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Union-Find Segmentation", UseUnionFindSegmentation, FilterParameter::Parameter, EBSDSegmentFeatures));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, EBSDSegmentFeatures, linkedProps));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
@@ -129,6 +131,7 @@ void EBSDSegmentFeatures::readFilterParameters(AbstractFilterParametersReader* r
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseUnionFindSegmentation(reader->readValue("UseUnionFindSegmentation", getUseUnionFindSegmentation()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -310,7 +313,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -318,16 +320,9 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   size_t randpoint = static_cast<size_t>(nextSeed);
   while(seed == -1 && randpoint < totalPoints)
   {
-    if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
+    if(m_FeatureIds[randpoint] == 0 && isValidSeed(randpoint)) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((!m_UseGoodVoxels || m_GoodVoxels[randpoint]) && m_CellPhases[randpoint] > 0)
-      {
-        seed = randpoint;
-      }
-      else
-      {
-        randpoint += 1;
-      }
+      seed = randpoint;
     }
     else
     {
@@ -337,9 +332,7 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
+    resizeFeatureAttributeMatrix(gnum + 1);
   }
   return seed;
 }
@@ -347,41 +340,65 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+bool EBSDSegmentFeatures::isValidSeed(int64_t point)
+{
+  return (!m_UseGoodVoxels || m_GoodVoxels[point]) && m_CellPhases[point] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* EBSDSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::resizeFeatureAttributeMatrix(size_t numFeatures)
 {
-  bool group = false;
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numFeatures);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
+}
 
-  // Get the phases for each voxel
-  int32_t phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
-  int32_t phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
-  // If either of the phases is 999 then we bail out now.
-  if(phase1 >= m_OrientationOps.size() || phase2 >= m_OrientationOps.size())
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+{
+  if(m_FeatureIds[neighborpoint] == 0 && areGroupable(referencepoint, neighborpoint))
   {
-    return group;
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
   }
+  return false;
+}
 
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::areGroupable(int64_t point1, int64_t point2)
+{
+  if(m_UseGoodVoxels && (!m_GoodVoxels[point1] || !m_GoodVoxels[point2]))
   {
-    float w = std::numeric_limits<float>::max();
-    QuatF q1 = QuaternionMathF::New();
-    QuatF q2 = QuaternionMathF::New();
-    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
-
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-    }
-    if(w < m_MisoTolerance)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+    return false;
   }
-  return group;
+  if(m_CellPhases[point1] != m_CellPhases[point2])
+  {
+    return false;
+  }
+  // If the phase is 999 then we bail out now.
+  uint32_t phase = m_CrystalStructures[m_CellPhases[point1]];
+  if(phase >= static_cast<uint32_t>(m_OrientationOps.size()))
+  {
+    return false;
+  }
+
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  return m_OrientationOps[phase]->isMisoQuatBelow(quats[point1], quats[point2], m_MisoTolerance);
 }
 
 // -----------------------------------------------------------------------------
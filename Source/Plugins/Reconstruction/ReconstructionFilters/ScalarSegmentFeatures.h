@@ -57,6 +57,7 @@ class Reconstruction_EXPORT ScalarSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(DataArrayPath ScalarArrayPath READ getScalarArrayPath WRITE setScalarArrayPath)
     PYB11_PROPERTY(float ScalarTolerance READ getScalarTolerance WRITE setScalarTolerance)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseUnionFindSegmentation READ getUseUnionFindSegmentation WRITE setUseUnionFindSegmentation)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
     PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
@@ -155,6 +156,16 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief isValidSeed Reimplemented from @see SegmentFeatures class
+   */
+  bool isValidSeed(int64_t point) override;
+
+  /**
+   * @brief areGroupable Reimplemented from @see SegmentFeatures class
+   */
+  bool areGroupable(int64_t point1, int64_t point2) override;
+
 protected:
   ScalarSegmentFeatures();
   /**
@@ -177,6 +188,16 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+   */
+  void resizeFeatureAttributeMatrix(size_t numFeatures) override;
+
 private:
   DEFINE_DATAARRAY_VARIABLE(bool, GoodVoxels)
   DEFINE_IDATAARRAY_VARIABLE(InputData)
@@ -35,6 +35,10 @@
 
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -42,11 +46,128 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+/**
+ * @brief FindRoot Returns the root of the set containing the given point, halving the path along the way.
+ * Roots are always the smallest index in their set, so parent[p] <= p holds for every point.
+ */
+template <typename IndexType> inline IndexType FindRoot(IndexType* parent, IndexType point)
+{
+  while(parent[point] != point)
+  {
+    parent[point] = parent[parent[point]];
+    point = parent[point];
+  }
+  return point;
+}
+
+/**
+ * @brief UnionPoints Joins the sets containing the two points, keeping the smaller index as the root
+ */
+template <typename IndexType> inline void UnionPoints(IndexType* parent, IndexType point1, IndexType point2)
+{
+  IndexType root1 = FindRoot(parent, point1);
+  IndexType root2 = FindRoot(parent, point2);
+  if(root1 < root2)
+  {
+    parent[root2] = root1;
+  }
+  else if(root2 < root1)
+  {
+    parent[root1] = root2;
+  }
+}
+} // namespace
+
+/**
+ * @brief The SegmentFeaturesUnionFindImpl class labels whole slabs of the grid. A slab is a contiguous run
+ * of layers (planes, or rows for 2D grids), so only the backward neighbors that fall inside the slab are
+ * joined and no two slabs ever touch the same parent entries. The parent array uses 32 bit indices whenever
+ * the grid is small enough, which halves the extra memory the segmentation needs.
+ */
+template <typename IndexType> class SegmentFeaturesUnionFindImpl
+{
+public:
+  SegmentFeaturesUnionFindImpl(SegmentFeatures* filter, IndexType* parent, const int64_t* dims, int64_t layerStride, int64_t numLayers, int64_t layersPerSlab)
+  : m_Filter(filter)
+  , m_Parent(parent)
+  , m_Dims(dims)
+  , m_LayerStride(layerStride)
+  , m_NumLayers(numLayers)
+  , m_LayersPerSlab(layersPerSlab)
+  {
+  }
+
+  void convert(int64_t startSlab, int64_t endSlab) const
+  {
+    for(int64_t slab = startSlab; slab < endSlab; slab++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t startLayer = slab * m_LayersPerSlab;
+      int64_t endLayer = std::min(startLayer + m_LayersPerSlab, m_NumLayers);
+      labelRange(startLayer * m_LayerStride, endLayer * m_LayerStride);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SegmentFeatures* m_Filter = nullptr;
+  IndexType* m_Parent = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int64_t m_LayerStride = 0;
+  int64_t m_NumLayers = 0;
+  int64_t m_LayersPerSlab = 0;
+
+  void labelRange(int64_t start, int64_t end) const
+  {
+    int64_t neighpoints[3] = {-1, -m_Dims[0], -(m_Dims[0] * m_Dims[1])};
+    for(int64_t point = start; point < end; point++)
+    {
+      int64_t col = point % m_Dims[0];
+      int64_t row = (point / m_Dims[0]) % m_Dims[1];
+      int64_t plane = point / (m_Dims[0] * m_Dims[1]);
+      bool good[3] = {col > 0, row > 0, plane > 0};
+      for(int32_t i = 0; i < 3; i++)
+      {
+        int64_t neighbor = point + neighpoints[i];
+        if(!good[i] || neighbor < start)
+        {
+          continue;
+        }
+        IndexType p = static_cast<IndexType>(point);
+        IndexType n = static_cast<IndexType>(neighbor);
+        if(FindRoot(m_Parent, p) != FindRoot(m_Parent, n) && m_Filter->areGroupable(neighbor, point))
+        {
+          UnionPoints(m_Parent, n, p);
+        }
+      }
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 SegmentFeatures::SegmentFeatures()
 : m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_UseUnionFindSegmentation(true)
 {
 }
 
@@ -111,6 +232,142 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isValidSeed(int64_t point)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::areGroupable(int64_t point1, int64_t point2)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SegmentFeatures::getFeatureIdsPointer()
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::resizeFeatureAttributeMatrix(size_t numFeatures)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename IndexType> void SegmentFeatures::executeUnionFind(const int64_t dims[3])
+{
+  int32_t* featureIds = getFeatureIdsPointer();
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+
+  // Slabs are runs of planes, or runs of rows when the grid is a single plane
+  int64_t layerStride = dims[0] * dims[1];
+  int64_t numLayers = dims[2];
+  if(dims[2] == 1)
+  {
+    layerStride = dims[0];
+    numLayers = dims[1];
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  int64_t numSlabs = static_cast<int64_t>(tbb::task_scheduler_init::default_num_threads()) * 4;
+#else
+  int64_t numSlabs = 1;
+#endif
+  numSlabs = std::max(static_cast<int64_t>(1), std::min(numSlabs, numLayers));
+  int64_t layersPerSlab = (numLayers + numSlabs - 1) / numSlabs;
+  numSlabs = (numLayers + layersPerSlab - 1) / layersPerSlab;
+
+  std::vector<IndexType> parentVec(totalPoints);
+  IndexType* parent = parentVec.data();
+  for(int64_t i = 0; i < totalPoints; i++)
+  {
+    parent[i] = static_cast<IndexType>(i);
+  }
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Labeling Slabs");
+  SegmentFeaturesUnionFindImpl<IndexType> impl(this, parent, dims, layerStride, numLayers, layersPerSlab);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, numSlabs, 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numSlabs);
+  }
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Join the labels across the slab boundaries; only the first layer of each slab has
+  // backward neighbors that live in the previous slab
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Merging Slab Boundaries");
+  int64_t neighpoints[3] = {-1, -dims[0], -(dims[0] * dims[1])};
+  for(int64_t slab = 1; slab < numSlabs; slab++)
+  {
+    int64_t start = slab * layersPerSlab * layerStride;
+    for(int64_t point = start; point < start + layerStride; point++)
+    {
+      int64_t col = point % dims[0];
+      int64_t row = (point / dims[0]) % dims[1];
+      int64_t plane = point / (dims[0] * dims[1]);
+      bool good[3] = {col > 0, row > 0, plane > 0};
+      for(int32_t i = 0; i < 3; i++)
+      {
+        int64_t neighbor = point + neighpoints[i];
+        if(!good[i] || neighbor >= start)
+        {
+          continue;
+        }
+        IndexType p = static_cast<IndexType>(point);
+        IndexType n = static_cast<IndexType>(neighbor);
+        if(FindRoot(parent, p) != FindRoot(parent, n) && areGroupable(neighbor, point))
+        {
+          UnionPoints(parent, n, p);
+        }
+      }
+    }
+  }
+
+  // Since parent[i] <= i, a single ascending pass flattens every point onto its root. The serial burn
+  // algorithm seeds each new Feature at the lowest unassigned valid seed, so numbering the roots in the
+  // order their first valid seed is encountered reproduces the serial Feature Ids exactly.
+  int32_t gnum = 1;
+  for(int64_t i = 0; i < totalPoints; i++)
+  {
+    parent[i] = parent[parent[i]];
+    if(featureIds[parent[i]] == 0 && isValidSeed(i))
+    {
+      featureIds[parent[i]] = gnum;
+      gnum++;
+    }
+  }
+  for(int64_t i = 0; i < totalPoints; i++)
+  {
+    featureIds[i] = featureIds[parent[i]];
+  }
+
+  resizeFeatureAttributeMatrix(static_cast<size_t>(gnum));
+  QString ss = QObject::tr("Total Features: %1").arg(gnum - 1);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -133,6 +390,20 @@ void SegmentFeatures::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
+  if(getUseUnionFindSegmentation() && nullptr != getFeatureIdsPointer())
+  {
+    if(dims[0] * dims[1] * dims[2] < static_cast<int64_t>(std::numeric_limits<int32_t>::max()))
+    {
+      executeUnionFind<int32_t>(dims);
+    }
+    else
+    {
+      executeUnionFind<int64_t>(dims);
+    }
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   int32_t gnum = 1;
   int64_t seed = 0;
   int64_t neighbor = 0;
@@ -60,6 +60,9 @@ public:
 
   SIMPL_INSTANCE_STRING_PROPERTY(DataContainerName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseUnionFindSegmentation)
+  Q_PROPERTY(bool UseUnionFindSegmentation READ getUseUnionFindSegmentation WRITE setUseUnionFindSegmentation)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -120,6 +123,24 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief isValidSeed Determines if a point may start a new Feature, regardless of whether it
+   * has already been assigned a Feature Id. Must not modify any state.
+   * @param point Point to check
+   * @return Boolean check for whether the point may be used as a seed
+   */
+  virtual bool isValidSeed(int64_t point);
+
+  /**
+   * @brief areGroupable Determines if two face adjacent points belong to the same Feature. Both points
+   * must be checked for validity (masks, phases, etc). Unlike determineGrouping() this must be symmetric
+   * and must not modify any state since it is called concurrently by the union-find segmentation.
+   * @param point1 First point
+   * @param point2 Second point
+   * @return Boolean check for whether the two points are grouped together
+   */
+  virtual bool areGroupable(int64_t point1, int64_t point2);
+
 signals:
   /**
    * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
@@ -172,6 +193,29 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Returns the raw Feature Ids array that is being segmented. Subclasses
+   * that implement isValidSeed() and areGroupable() return a valid pointer to enable the union-find
+   * segmentation; the default returns nullptr, which forces the serial burn algorithm.
+   * @return Raw pointer to the Feature Ids
+   */
+  virtual int32_t* getFeatureIdsPointer();
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Resizes the Feature Attribute Matrix to hold the given number of Features
+   * @param numFeatures Number of Features, including Feature 0
+   */
+  virtual void resizeFeatureAttributeMatrix(size_t numFeatures);
+
+private:
+  /**
+   * @brief executeUnionFind Segments the grid by labeling slabs of the grid in parallel with a union-find
+   * pass, merging the labels across the slab boundaries and then numbering the Features in the same order
+   * as the serial burn algorithm
+   * @param dims Dimensions of the grid
+   */
+  template <typename IndexType> void executeUnionFind(const int64_t dims[3]);
+
 public:
   SegmentFeatures(const SegmentFeatures&) = delete; // Copy Constructor Not Implemented
   SegmentFeatures(SegmentFeatures&&) = delete;      // Move Constructor Not Implemented
@@ -67,6 +67,7 @@ class Reconstruction_EXPORT SineParamsSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(QString CellFeatureAttributeMatrixName READ getCellFeatureAttributeMatrixName WRITE setCellFeatureAttributeMatrixName)
     PYB11_PROPERTY(DataArrayPath SineParamsArrayPath READ getSineParamsArrayPath WRITE setSineParamsArrayPath)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseUnionFindSegmentation READ getUseUnionFindSegmentation WRITE setUseUnionFindSegmentation)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
     PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
@@ -161,6 +162,16 @@ public:
   */
   void preflight() override;
 
+  /**
+   * @brief isValidSeed Reimplemented from @see SegmentFeatures class
+   */
+  bool isValidSeed(int64_t point) override;
+
+  /**
+   * @brief areGroupable Reimplemented from @see SegmentFeatures class
+   */
+  bool areGroupable(int64_t point1, int64_t point2) override;
+
 protected:
   SineParamsSegmentFeatures();
   /**
@@ -176,6 +187,16 @@ protected:
   virtual int64_t getSeed(int32_t gnum, int64_t nextSeed);
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief resizeFeatureAttributeMatrix Reimplemented from @see SegmentFeatures class
+   */
+  void resizeFeatureAttributeMatrix(size_t numFeatures) override;
+
 private:
   IDataArray::Pointer m_InputData;
 
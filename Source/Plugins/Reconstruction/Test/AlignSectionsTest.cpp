@@ -0,0 +1,322 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+namespace AlignSectionsTestConsts
+{
+// Large enough that the pyramid search starts from slices subsampled 4 times
+const size_t k_XDim = 256;
+const size_t k_YDim = 256;
+const size_t k_ZDim = 6;
+const int64_t k_GrainSize = 17;
+const int32_t k_NumOrientations = 25;
+// Offset of each slice into the shared grain map; every pair is at most 3 Cells apart
+const int64_t k_XOffsets[k_ZDim] = {0, 2, -1, 2, 5, 3};
+const int64_t k_YOffsets[k_ZDim] = {0, -3, -1, 1, 1, 4};
+}
+
+class AlignSectionsTest
+{
+
+public:
+  AlignSectionsTest()
+  {
+  }
+  virtual ~AlignSectionsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::AlignSectionsTest::ShiftsFile);
+    QFile::remove(UnitTest::AlignSectionsTest::PyramidShiftsFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames;
+    filtNames << "AlignSectionsMisorientation"
+              << "AlignSectionsMutualInformation";
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The AlignSectionsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Scatters one of k_NumOrientations orientations over square grains of a map that
+  // extends past the slices, so that no two nearby grains repeat in a regular pattern.
+  // -----------------------------------------------------------------------------
+  int32_t OrientationOf(int64_t x, int64_t y)
+  {
+    using namespace AlignSectionsTestConsts;
+    uint32_t grainX = static_cast<uint32_t>((x + 1000) / k_GrainSize);
+    uint32_t grainY = static_cast<uint32_t>((y + 1000) / k_GrainSize);
+    uint32_t hash = (grainX * 73856093u) ^ (grainY * 19349663u);
+    hash ^= hash >> 13;
+    hash *= 0x5bd1e995u;
+    hash ^= hash >> 15;
+    return static_cast<int32_t>(hash % k_NumOrientations);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    using namespace AlignSectionsTestConsts;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {k_XDim, k_YDim, k_ZDim};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    QVector<size_t> dims(3, 0);
+    dims[0] = k_XDim;
+    dims[1] = k_YDim;
+    dims[2] = k_ZDim;
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    size_t totalPoints = k_XDim * k_YDim * k_ZDim;
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, "Quats", true);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, cDims, "Phases", true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, cDims, "Mask", true);
+
+    size_t index = 0;
+    for(size_t z = 0; z < k_ZDim; z++)
+    {
+      for(size_t y = 0; y < k_YDim; y++)
+      {
+        for(size_t x = 0; x < k_XDim; x++)
+        {
+          int32_t orientation = OrientationOf(static_cast<int64_t>(x) + k_XOffsets[z], static_cast<int64_t>(y) + k_YOffsets[z]);
+          // Rotations about the sample Z axis 7 degrees apart
+          float angle = 7.0f * orientation * SIMPLib::Constants::k_PiOver180;
+          float* q = quats->getTuplePointer(index);
+          q[0] = 0.0f;
+          q[1] = 0.0f;
+          q[2] = std::sin(angle * 0.5f);
+          q[3] = std::cos(angle * 0.5f);
+          phases->setValue(index, 1);
+          mask->setValue(index, true);
+          index++;
+        }
+      }
+    }
+    cellAM->addAttributeArray(quats->getName(), quats);
+    cellAM->addAttributeArray(phases->getName(), phases);
+    cellAM->addAttributeArray(mask->getName(), mask);
+
+    QVector<size_t> ensDims(1, 2);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(ensDims, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(ensembleAM->getName(), ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, "CrystalStructures", true);
+    crystalStructures->setValue(0, 999); // Ebsd::CrystalStructure::UnknownCrystalStructure
+    crystalStructures->setValue(1, 4);   // Ebsd::CrystalStructure::Triclinic
+    ensembleAM->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName, bool usePyramidSearch, const QString& shiftsFile)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    QVariant var;
+    bool ok = false;
+
+    var.setValue(usePyramidSearch);
+    ok = filter->setProperty("UsePyramidSearch", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(false);
+    ok = filter->setProperty("UseGoodVoxels", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(DataArrayPath("Test", "CellData", "Mask"));
+    ok = filter->setProperty("GoodVoxelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(5.0f);
+    ok = filter->setProperty("MisorientationTolerance", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(DataArrayPath("Test", "CellData", "Quats"));
+    ok = filter->setProperty("QuatsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(DataArrayPath("Test", "CellData", "Phases"));
+    ok = filter->setProperty("CellPhasesArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+    ok = filter->setProperty("CrystalStructuresArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(true);
+    ok = filter->setProperty("WriteAlignmentShifts", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(shiftsFile);
+    ok = filter->setProperty("AlignmentShiftFileName", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter and reads back the shift it found between each slice and the one above it
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer RunAlignment(const QString& filtName, bool usePyramidSearch, const QString& shiftsFile, std::vector<int64_t>& xShifts, std::vector<int64_t>& yShifts)
+  {
+    using namespace AlignSectionsTestConsts;
+
+    AbstractFilter::Pointer filter = CreateFilter(filtName, usePyramidSearch, shiftsFile);
+    DataContainerArray::Pointer dca = CreateTestData();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    int err = filter->getErrorCondition();
+    DREAM3D_REQUIRE(err >= 0)
+
+    xShifts.assign(k_ZDim - 1, 0);
+    yShifts.assign(k_ZDim - 1, 0);
+    std::ifstream inFile(shiftsFile.toLatin1().data());
+    DREAM3D_REQUIRE(inFile.is_open())
+    int64_t slice = 0, nextSlice = 0, xShift = 0, yShift = 0, xTotal = 0, yTotal = 0;
+    size_t numLines = 0;
+    while(inFile >> slice >> nextSlice >> xShift >> yShift >> xTotal >> yTotal)
+    {
+      DREAM3D_REQUIRE(slice >= 0 && slice < static_cast<int64_t>(k_ZDim) - 1)
+      DREAM3D_REQUIRE_EQUAL(nextSlice, slice + 1)
+      xShifts[slice] = xShift;
+      yShifts[slice] = yShift;
+      numLines++;
+    }
+    DREAM3D_REQUIRE_EQUAL(numLines, k_ZDim - 1)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+    FloatArrayType::Pointer quats = cellAM->getAttributeArrayAs<FloatArrayType>("Quats");
+    DREAM3D_REQUIRE_VALID_POINTER(quats.get())
+    return quats;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The pyramid search must land on the same shifts as the full search, and both on the
+  // offsets the slices were built with.
+  // -----------------------------------------------------------------------------
+  int ComparePyramidSearch(const QString& filtName)
+  {
+    using namespace AlignSectionsTestConsts;
+
+    std::vector<int64_t> xShifts;
+    std::vector<int64_t> yShifts;
+    FloatArrayType::Pointer aligned = RunAlignment(filtName, false, UnitTest::AlignSectionsTest::ShiftsFile, xShifts, yShifts);
+
+    std::vector<int64_t> pyramidXShifts;
+    std::vector<int64_t> pyramidYShifts;
+    FloatArrayType::Pointer pyramidAligned = RunAlignment(filtName, true, UnitTest::AlignSectionsTest::PyramidShiftsFile, pyramidXShifts, pyramidYShifts);
+
+    for(size_t slice = 0; slice < k_ZDim - 1; slice++)
+    {
+      DREAM3D_REQUIRE_EQUAL(xShifts[slice], k_XOffsets[slice + 1] - k_XOffsets[slice])
+      DREAM3D_REQUIRE_EQUAL(yShifts[slice], k_YOffsets[slice + 1] - k_YOffsets[slice])
+      DREAM3D_REQUIRE_EQUAL(pyramidXShifts[slice], xShifts[slice])
+      DREAM3D_REQUIRE_EQUAL(pyramidYShifts[slice], yShifts[slice])
+    }
+
+    size_t numValues = aligned->getSize();
+    DREAM3D_REQUIRE_EQUAL(pyramidAligned->getSize(), numValues)
+    for(size_t i = 0; i < numValues; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(pyramidAligned->getValue(i), aligned->getValue(i))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAlignSectionsMisorientation()
+  {
+    ComparePyramidSearch("AlignSectionsMisorientation");
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAlignSectionsMutualInformation()
+  {
+    ComparePyramidSearch("AlignSectionsMutualInformation");
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestAlignSectionsMisorientation())
+    DREAM3D_REGISTER_TEST(TestAlignSectionsMutualInformation())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  AlignSectionsTest(const AlignSectionsTest&); // Copy Constructor Not Implemented
+  void operator=(const AlignSectionsTest&);    // Move assignment Not Implemented
+};
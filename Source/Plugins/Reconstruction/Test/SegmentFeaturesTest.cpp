@@ -0,0 +1,314 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <cmath>
+#include <map>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+namespace SegmentFeaturesTestConsts
+{
+const size_t k_XDim = 17;
+const size_t k_YDim = 13;
+const size_t k_ZDim = 6;
+}
+
+class SegmentFeaturesTest
+{
+
+public:
+  SegmentFeaturesTest()
+  {
+  }
+  virtual ~SegmentFeaturesTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames;
+    filtNames << "EBSDSegmentFeatures"
+              << "ScalarSegmentFeatures";
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The SegmentFeaturesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a grid of interleaved blocks and stripes so that Features wrap around each
+  // other and cross every slab boundary the union-find pass could choose.
+  // -----------------------------------------------------------------------------
+  int32_t RegionOf(size_t x, size_t y, size_t z)
+  {
+    if((x + 2 * y) % 11 < 2)
+    {
+      return 3;
+    }
+    return static_cast<int32_t>(((x / 5) + (y / 4) + (z / 2)) % 3);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    using namespace SegmentFeaturesTestConsts;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims_in[3] = {k_XDim, k_YDim, k_ZDim};
+    igeom->setDimensions(dims_in);
+    dc->setGeometry(igeom);
+    QVector<size_t> dims(3, 0);
+    dims[0] = k_XDim;
+    dims[1] = k_YDim;
+    dims[2] = k_ZDim;
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(dims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    size_t totalPoints = k_XDim * k_YDim * k_ZDim;
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, "Quats", true);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, cDims, "Phases", true);
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(totalPoints, cDims, "Scalars", true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, cDims, "Mask", true);
+
+    size_t index = 0;
+    for(size_t z = 0; z < k_ZDim; z++)
+    {
+      for(size_t y = 0; y < k_YDim; y++)
+      {
+        for(size_t x = 0; x < k_XDim; x++)
+        {
+          int32_t region = RegionOf(x, y, z);
+          // Rotations about the sample Z axis 20 degrees apart, with a little in-grain scatter
+          float angle = (20.0f * region + 0.5f * static_cast<float>((x + y + z) % 3)) * SIMPLib::Constants::k_PiOver180;
+          float* q = quats->getTuplePointer(index);
+          q[0] = 0.0f;
+          q[1] = 0.0f;
+          q[2] = std::sin(angle * 0.5f);
+          q[3] = std::cos(angle * 0.5f);
+          phases->setValue(index, 1);
+          scalars->setValue(index, 10 * region + static_cast<int32_t>((x + z) % 2));
+          mask->setValue(index, (x * 7 + y * 3 + z) % 23 != 0);
+          index++;
+        }
+      }
+    }
+    cellAM->addAttributeArray(quats->getName(), quats);
+    cellAM->addAttributeArray(phases->getName(), phases);
+    cellAM->addAttributeArray(scalars->getName(), scalars);
+    cellAM->addAttributeArray(mask->getName(), mask);
+
+    QVector<size_t> ensDims(1, 2);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(ensDims, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(ensembleAM->getName(), ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, "CrystalStructures", true);
+    crystalStructures->setValue(0, 999); // Ebsd::CrystalStructure::UnknownCrystalStructure
+    crystalStructures->setValue(1, 1);   // Ebsd::CrystalStructure::Cubic_High
+    ensembleAM->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName, bool useUnionFind, bool useMask)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    QVariant var;
+    bool ok = false;
+
+    var.setValue(useUnionFind);
+    ok = filter->setProperty("UseUnionFindSegmentation", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(useMask);
+    ok = filter->setProperty("UseGoodVoxels", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(DataArrayPath("Test", "CellData", "Mask"));
+    ok = filter->setProperty("GoodVoxelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    if(filtName == "EBSDSegmentFeatures")
+    {
+      var.setValue(5.0f);
+      ok = filter->setProperty("MisorientationTolerance", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      var.setValue(DataArrayPath("Test", "CellData", "Quats"));
+      ok = filter->setProperty("QuatsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      var.setValue(DataArrayPath("Test", "CellData", "Phases"));
+      ok = filter->setProperty("CellPhasesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      var.setValue(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+      ok = filter->setProperty("CrystalStructuresArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+    }
+    else
+    {
+      var.setValue(2.0f);
+      ok = filter->setProperty("ScalarTolerance", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+
+      var.setValue(DataArrayPath("Test", "CellData", "Scalars"));
+      ok = filter->setProperty("ScalarArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(ok, true)
+    }
+
+    var.setValue(QString("FeatureIds"));
+    ok = filter->setProperty("FeatureIdsArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(QString("FeatureData"));
+    ok = filter->setProperty("CellFeatureAttributeMatrixName", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    var.setValue(QString("Active"));
+    ok = filter->setProperty("ActiveArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(ok, true)
+
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer RunSegmentation(const QString& filtName, bool useUnionFind, bool useMask)
+  {
+    AbstractFilter::Pointer filter = CreateFilter(filtName, useUnionFind, useMask);
+    DataContainerArray::Pointer dca = CreateTestData();
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    int err = filter->getErrorCondition();
+    DREAM3D_REQUIRE(err >= 0)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+    Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds");
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The filters shuffle Feature Ids after segmenting, so the two runs are compared as
+  // partitions: every Feature of one run must map onto exactly one Feature of the other.
+  // -----------------------------------------------------------------------------
+  int CompareSegmentations(const QString& filtName, bool useMask)
+  {
+    Int32ArrayType::Pointer floodFill = RunSegmentation(filtName, false, useMask);
+    Int32ArrayType::Pointer unionFind = RunSegmentation(filtName, true, useMask);
+
+    size_t totalPoints = floodFill->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(unionFind->getNumberOfTuples(), totalPoints)
+
+    std::map<int32_t, int32_t> forward;
+    std::map<int32_t, int32_t> backward;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      int32_t a = floodFill->getValue(i);
+      int32_t b = unionFind->getValue(i);
+      DREAM3D_REQUIRE_EQUAL(a == 0, b == 0)
+      std::map<int32_t, int32_t>::iterator fwd = forward.find(a);
+      if(fwd == forward.end())
+      {
+        forward[a] = b;
+      }
+      else
+      {
+        DREAM3D_REQUIRE_EQUAL(fwd->second, b)
+      }
+      std::map<int32_t, int32_t>::iterator bwd = backward.find(b);
+      if(bwd == backward.end())
+      {
+        backward[b] = a;
+      }
+      else
+      {
+        DREAM3D_REQUIRE_EQUAL(bwd->second, a)
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(forward.size(), backward.size())
+    // The fixture is built to produce several Features, so the comparison is not vacuous
+    DREAM3D_REQUIRE(forward.size() > 4)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEBSDSegmentFeatures()
+  {
+    CompareSegmentations("EBSDSegmentFeatures", false);
+    CompareSegmentations("EBSDSegmentFeatures", true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestScalarSegmentFeatures()
+  {
+    CompareSegmentations("ScalarSegmentFeatures", false);
+    CompareSegmentations("ScalarSegmentFeatures", true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestEBSDSegmentFeatures())
+    DREAM3D_REGISTER_TEST(TestScalarSegmentFeatures())
+  }
+
+private:
+  SegmentFeaturesTest(const SegmentFeaturesTest&); // Copy Constructor Not Implemented
+  void operator=(const SegmentFeaturesTest&);      // Move assignment Not Implemented
+};
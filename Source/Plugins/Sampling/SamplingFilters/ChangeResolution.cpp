@@ -35,6 +35,10 @@
 
 #include "ChangeResolution.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -46,6 +50,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/util/ImageTupleRemap.hpp"
 #include "Sampling/SamplingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -346,70 +351,61 @@ void ChangeResolution::execute()
   }
   size_t totalPoints = m_XP * m_YP * m_ZP;
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  size_t col = 0, row = 0, plane = 0;
-  size_t index = 0;
-  size_t index_old = 0;
-  size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
   float res[3] = {0.0f, 0.0f, 0.0f};
   m->getGeometryAs<ImageGeom>()->getResolution(res);
 
+  // The old voxel of every new voxel is found axis by axis, so only the three axis maps are stored
+  ImageTupleRemap::AxisMaps maps;
+  maps.x.resize(m_XP);
+  maps.y.resize(m_YP);
+  maps.z.resize(m_ZP);
+  for(size_t k = 0; k < m_XP; k++)
+  {
+    float x = (k * m_Resolution.x);
+    maps.x[k] = size_t(x / res[0]);
+  }
+  for(size_t j = 0; j < m_YP; j++)
+  {
+    float y = (j * m_Resolution.y);
+    maps.y[j] = size_t(y / res[1]);
+  }
   for(size_t i = 0; i < m_ZP; i++)
   {
-    if(getCancel())
-    {
-      break;
-    }
-    progressInt = static_cast<size_t>((static_cast<float>(i) / m_ZP) * 100.0f);
-    QString ss = QObject::tr("Changing Resolution || %1% Complete").arg(progressInt);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    for(size_t j = 0; j < m_YP; j++)
-    {
-      for(size_t k = 0; k < m_XP; k++)
-      {
-        x = (k * m_Resolution.x);
-        y = (j * m_Resolution.y);
-        z = (i * m_Resolution.z);
-        col = size_t(x / res[0]);
-        row = size_t(y / res[1]);
-        plane = size_t(z / res[2]);
-        index_old = (plane * dims[1] * dims[0]) + (row * dims[0]) + col;
-        index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
-      }
-    }
+    float z = (i * m_Resolution.z);
+    maps.z[i] = size_t(z / res[2]);
   }
 
   QString ss = QObject::tr("Copying Data...");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
+
   QVector<size_t> tDims(3, 0);
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
   AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
 
+  // The arrays are done one at a time, each old array being released as soon as it has been
+  // resampled, so at most one extra array is held in memory
   QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
   for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
+    if(getCancel())
+    {
+      return;
+    }
     IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
     // Make a copy of the 'p' array that has the same name. When placed into
     // the data container this will over write the current array with
     // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = nullptr;
-    void* destination = nullptr;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for(size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
+    IDataArray::Pointer data = p->createNewArray(totalPoints, p->getComponentDimensions(), p->getName());
+    ImageTupleRemap::remap(p, data, dims, maps, doParallel);
     cellAttrMat->removeAttributeArray(*iter);
     newCellAttrMat->addAttributeArray(*iter, data);
   }
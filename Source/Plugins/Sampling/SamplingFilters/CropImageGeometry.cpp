@@ -35,6 +35,12 @@
 
 #include "CropImageGeometry.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
@@ -49,6 +55,7 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
 #include "Sampling/SamplingConstants.h"
+#include "Sampling/SamplingFilters/util/ImageTupleRemap.hpp"
 #include "Sampling/SamplingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -484,39 +491,40 @@ void CropImageGeometry::execute()
   int64_t YP = ((m_YMax - m_YMin) + 1);
   int64_t ZP = ((m_ZMax - m_ZMin) + 1);
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
-  int64_t index = 0;
-  int64_t index_old = 0;
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  ImageTupleRemap::AxisMaps maps;
+  maps.x.resize(XP);
+  maps.y.resize(YP);
+  maps.z.resize(ZP);
+  for(int64_t i = 0; i < XP; i++)
+  {
+    maps.x[i] = static_cast<size_t>(i + m_XMin);
+  }
+  for(int64_t i = 0; i < YP; i++)
+  {
+    maps.y[i] = static_cast<size_t>(i + m_YMin);
+  }
   for(int64_t i = 0; i < ZP; i++)
   {
-    if(getCancel())
-    {
-      break;
-    }
-    QString ss = QObject::tr("Cropping Volume || Slice %1 of %2 Complete").arg(i).arg(ZP);
-    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
-    for(int64_t j = 0; j < YP; j++)
-    {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
-      for(int64_t k = 0; k < XP; k++)
-      {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for(const auto& arrayName : voxelArrayNames)
-        {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(arrayName);
-          p->copyTuple(index_old, index);
-        }
-      }
-    }
+    maps.z[i] = static_cast<size_t>(i + m_ZMin);
+  }
+
+  std::vector<IDataArray::Pointer> voxelArrays;
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    voxelArrays.push_back(cellAttrMat->getAttributeArray(arrayName));
   }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#else
+  bool doParallel = false;
+#endif
+
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), QObject::tr("Cropping Volume || Moving %1 Arrays").arg(voxelArrays.size()));
+  ImageTupleRemap::remapInPlace(voxelArrays, udims, maps, doParallel);
+
   if(getCancel())
   {
     return;
@@ -0,0 +1,247 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace ImageTupleRemap
+{
+/**
+ * @brief The AxisMaps struct holds, for each x, y and z index of a destination image, the index
+ * along the same axis of the source voxel it takes its values from. Crops and resamples of an image
+ * map each axis independently, so the maps replace a full per voxel index map.
+ */
+struct AxisMaps
+{
+  std::vector<size_t> x;
+  std::vector<size_t> y;
+  std::vector<size_t> z;
+};
+
+/**
+ * @brief The RemapTuplesImpl class copies the tuples of a range of destination x rows from their
+ * source voxels. Runs of consecutive source voxels are moved with a single memmove.
+ */
+template <typename T> class RemapTuplesImpl
+{
+public:
+  RemapTuplesImpl(const T* source, T* destination, size_t numComps, const size_t* srcDims, const AxisMaps& maps)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_NumComps(numComps)
+  , m_SrcDims(srcDims)
+  , m_Maps(maps)
+  {
+  }
+  virtual ~RemapTuplesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    size_t xPoints = m_Maps.x.size();
+    size_t yPoints = m_Maps.y.size();
+    for(size_t row = start; row < end; row++)
+    {
+      size_t srcRowStart = (m_Maps.z[row / yPoints] * m_SrcDims[1] + m_Maps.y[row % yPoints]) * m_SrcDims[0];
+      T* destRow = m_Destination + row * xPoints * m_NumComps;
+      size_t k = 0;
+      while(k < xPoints)
+      {
+        size_t run = 1;
+        while(k + run < xPoints && m_Maps.x[k + run] == m_Maps.x[k] + run)
+        {
+          run++;
+        }
+        ::memmove(destRow + k * m_NumComps, m_Source + (srcRowStart + m_Maps.x[k]) * m_NumComps, run * m_NumComps * sizeof(T));
+        k += run;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const T* m_Source;
+  T* m_Destination;
+  size_t m_NumComps;
+  const size_t* m_SrcDims;
+  const AxisMaps& m_Maps;
+};
+
+/**
+ * @brief remapTuples Copies the tuples of the array if it is a DataArray<T>. The rows are copied in
+ * parallel unless the source and destination are the same array, in which case they are moved in order.
+ * @return false if the array is not a DataArray<T>
+ */
+template <typename T>
+bool remapTuples(const IDataArray::Pointer& source, const IDataArray::Pointer& destination, const size_t* srcDims, const AxisMaps& maps, bool doParallel)
+{
+  typename DataArray<T>::Pointer typedSource = std::dynamic_pointer_cast<DataArray<T>>(source);
+  typename DataArray<T>::Pointer typedDestination = std::dynamic_pointer_cast<DataArray<T>>(destination);
+  if(nullptr == typedSource || nullptr == typedDestination)
+  {
+    return false;
+  }
+  size_t numRows = maps.y.size() * maps.z.size();
+  RemapTuplesImpl<T> impl(typedSource->getPointer(0), typedDestination->getPointer(0), static_cast<size_t>(typedSource->getNumberOfComponents()), srcDims, maps);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel && source != destination)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numRows);
+  }
+  return true;
+}
+
+/**
+ * @brief remap Fills the destination array with the tuples of the source array selected by the axis
+ * maps, with the destination voxels in x, y, z order. The source and destination may be the same array
+ * as long as no destination voxel lies after its source voxel and every map is increasing, which is the
+ * case for a crop.
+ * @param source Array holding the tuples of the source image
+ * @param destination Array that receives the tuples of the destination image
+ * @param srcDims Dimensions of the source image
+ * @param maps Source index along each axis for every destination index
+ * @param doParallel Whether rows of distinct arrays may be copied in parallel
+ */
+inline void remap(const IDataArray::Pointer& source, const IDataArray::Pointer& destination, const size_t* srcDims, const AxisMaps& maps, bool doParallel)
+{
+  bool copied = remapTuples<int8_t>(source, destination, srcDims, maps, doParallel) || remapTuples<uint8_t>(source, destination, srcDims, maps, doParallel) ||
+                remapTuples<int16_t>(source, destination, srcDims, maps, doParallel) || remapTuples<uint16_t>(source, destination, srcDims, maps, doParallel) ||
+                remapTuples<int32_t>(source, destination, srcDims, maps, doParallel) || remapTuples<uint32_t>(source, destination, srcDims, maps, doParallel) ||
+                remapTuples<int64_t>(source, destination, srcDims, maps, doParallel) || remapTuples<uint64_t>(source, destination, srcDims, maps, doParallel) ||
+                remapTuples<float>(source, destination, srcDims, maps, doParallel) || remapTuples<double>(source, destination, srcDims, maps, doParallel) ||
+                remapTuples<bool>(source, destination, srcDims, maps, doParallel);
+  if(copied)
+  {
+    return;
+  }
+
+  // Any other kind of array is copied one tuple at a time
+  size_t index = 0;
+  for(size_t z = 0; z < maps.z.size(); z++)
+  {
+    for(size_t y = 0; y < maps.y.size(); y++)
+    {
+      size_t srcRowStart = (maps.z[z] * srcDims[1] + maps.y[y]) * srcDims[0];
+      for(size_t x = 0; x < maps.x.size(); x++)
+      {
+        size_t srcIndex = srcRowStart + maps.x[x];
+        if(source == destination)
+        {
+          source->copyTuple(srcIndex, index);
+        }
+        else
+        {
+          size_t tupleSize = source->getTypeSize() * static_cast<size_t>(source->getNumberOfComponents());
+          ::memcpy(destination->getVoidPointer(index * source->getNumberOfComponents()), source->getVoidPointer(srcIndex * source->getNumberOfComponents()), tupleSize);
+        }
+        index++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief The RemapArraysImpl class remaps a range of arrays in place, one array per task.
+ */
+class RemapArraysImpl
+{
+public:
+  RemapArraysImpl(const std::vector<IDataArray::Pointer>& arrays, const size_t* srcDims, const AxisMaps& maps)
+  : m_Arrays(arrays)
+  , m_SrcDims(srcDims)
+  , m_Maps(maps)
+  {
+  }
+  virtual ~RemapArraysImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      remap(m_Arrays[i], m_Arrays[i], m_SrcDims, m_Maps, false);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+private:
+  const std::vector<IDataArray::Pointer>& m_Arrays;
+  const size_t* m_SrcDims;
+  const AxisMaps& m_Maps;
+};
+
+/**
+ * @brief remapInPlace Remaps every array in place. The rows of one array have to be moved in order,
+ * so the arrays themselves are spread over the threads instead.
+ */
+inline void remapInPlace(const std::vector<IDataArray::Pointer>& arrays, const size_t* srcDims, const AxisMaps& maps, bool doParallel)
+{
+  RemapArraysImpl impl(arrays, srcDims, maps);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, arrays.size(), 1), impl, tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, arrays.size());
+  }
+}
+} // namespace ImageTupleRemap
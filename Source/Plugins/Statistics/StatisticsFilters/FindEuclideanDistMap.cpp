@@ -35,10 +35,14 @@
 
 #include "FindEuclideanDistMap.h"
 
+#include <cmath>
+#include <limits>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_group.h>
 #include <tbb/task_scheduler_init.h>
 #include <tbb/tick_count.h>
@@ -276,6 +280,147 @@ class ComputeDistanceMapImpl
     }
 };
 
+/**
+ * @brief The ExactDistanceTransformImpl class implements one pass of the separable exact Euclidean distance
+ * transform (Felzenszwalb & Huttenlocher). Each pass computes the lower envelope of the parabolas rooted at the
+ * Cells of every line of the volume along a single axis. The squared distances and the index of the nearest
+ * seed Cell are updated in place. Running the pass along X, then Y, then Z yields the exact distance.
+ */
+class ExactDistanceTransformImpl
+{
+public:
+  ExactDistanceTransformImpl(float* squaredDistances, int32_t* nearest, const int64_t dims[3], int32_t axis, double spacing)
+  : m_SquaredDistances(squaredDistances)
+  , m_Nearest(nearest)
+  , m_Axis(axis)
+  , m_Spacing(spacing)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~ExactDistanceTransformImpl() = default;
+
+  size_t getNumberOfLines() const
+  {
+    return static_cast<size_t>((m_Dims[0] * m_Dims[1] * m_Dims[2]) / m_Dims[m_Axis]);
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const int64_t n = m_Dims[m_Axis];
+    int64_t stride = 1;
+    if(m_Axis == 1)
+    {
+      stride = m_Dims[0];
+    }
+    else if(m_Axis == 2)
+    {
+      stride = m_Dims[0] * m_Dims[1];
+    }
+
+    std::vector<float> f(n, 0.0f);
+    std::vector<int32_t> fNearest(n, -1);
+    std::vector<int64_t> v(n, 0);
+    std::vector<double> z(n + 1, 0.0);
+    const double spacing2 = m_Spacing * m_Spacing;
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    for(size_t line = start; line < end; line++)
+    {
+      int64_t base = 0;
+      if(m_Axis == 0)
+      {
+        base = static_cast<int64_t>(line) * m_Dims[0];
+      }
+      else if(m_Axis == 1)
+      {
+        int64_t x = static_cast<int64_t>(line) % m_Dims[0];
+        int64_t plane = static_cast<int64_t>(line) / m_Dims[0];
+        base = plane * m_Dims[0] * m_Dims[1] + x;
+      }
+      else
+      {
+        base = static_cast<int64_t>(line);
+      }
+
+      for(int64_t q = 0; q < n; q++)
+      {
+        f[q] = m_SquaredDistances[base + q * stride];
+        fNearest[q] = m_Nearest[base + q * stride];
+      }
+
+      // Build the lower envelope of the parabolas rooted at the Cells that already have a distance
+      int64_t k = -1;
+      for(int64_t q = 0; q < n; q++)
+      {
+        if(f[q] == infinity)
+        {
+          continue;
+        }
+        double fq = static_cast<double>(f[q]) + spacing2 * static_cast<double>(q * q);
+        while(true)
+        {
+          if(k < 0)
+          {
+            k = 0;
+            v[0] = q;
+            z[0] = -std::numeric_limits<double>::infinity();
+            z[1] = std::numeric_limits<double>::infinity();
+            break;
+          }
+          int64_t r = v[k];
+          double fr = static_cast<double>(f[r]) + spacing2 * static_cast<double>(r * r);
+          double s = (fq - fr) / (2.0 * spacing2 * static_cast<double>(q - r));
+          if(s <= z[k])
+          {
+            k--;
+            continue;
+          }
+          k++;
+          v[k] = q;
+          z[k] = s;
+          z[k + 1] = std::numeric_limits<double>::infinity();
+          break;
+        }
+      }
+      if(k < 0)
+      {
+        continue; // Nothing on this line has a distance yet
+      }
+
+      // Sample the lower envelope
+      k = 0;
+      for(int64_t q = 0; q < n; q++)
+      {
+        while(z[k + 1] < static_cast<double>(q))
+        {
+          k++;
+        }
+        int64_t r = v[k];
+        double d = m_Spacing * static_cast<double>(q - r);
+        m_SquaredDistances[base + q * stride] = static_cast<float>(d * d + static_cast<double>(f[r]));
+        m_Nearest[base + q * stride] = fNearest[r];
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_SquaredDistances = nullptr;
+  int32_t* m_Nearest = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  int32_t m_Axis = 0;
+  double m_Spacing = 1.0;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -290,6 +435,7 @@ FindEuclideanDistMap::FindEuclideanDistMap()
 , m_DoQuadPoints(false)
 , m_SaveNearestNeighbors(false)
 , m_CalcManhattanDist(true)
+, m_UseExactEuclideanDistance(false)
 {
 }
 
@@ -305,6 +451,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance", CalcManhattanDist, FilterParameter::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Exact Euclidean Distance Transform", UseExactEuclideanDistance, FilterParameter::Parameter, FindEuclideanDistMap));
   QStringList linkedProps("GBDistancesArrayName");
 
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Parameter, FindEuclideanDistMap, linkedProps));
@@ -350,6 +497,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcManhattanDist()));
+  setUseExactEuclideanDistance(reader->readValue("UseExactEuclideanDistance", getUseExactEuclideanDistance()));
   reader->closeFilterGroup();
 }
 
@@ -655,6 +803,24 @@ void FindEuclideanDistMap::findDistanceMap()
     }
   }
 
+  // The exact transform is separable so each map is computed with one parallel pass per axis
+  if(!m_CalcManhattanDist && m_UseExactEuclideanDistance)
+  {
+    if(m_DoBoundaries)
+    {
+      findExactDistanceMap(MapType::FeatureBoundary, m_GBEuclideanDistances);
+    }
+    if(m_DoTripleLines)
+    {
+      findExactDistanceMap(MapType::TripleJunction, m_TJEuclideanDistances);
+    }
+    if(m_DoQuadPoints)
+    {
+      findExactDistanceMap(MapType::QuadPoint, m_QPEuclideanDistances);
+    }
+    return;
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -732,6 +898,82 @@ void FindEuclideanDistMap::findDistanceMap()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::findExactDistanceMap(MapType mapType, float* distances)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t udims[3] = {0, 0, 0};
+  std::tie(udims[0], udims[1], udims[2]) = imageGeom->getDimensions();
+  int64_t dims[3] = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  std::tie(res[0], res[1], res[2]) = imageGeom->getResolution();
+
+  const uint32_t mapIndex = static_cast<uint32_t>(mapType);
+  const float infinity = std::numeric_limits<float>::infinity();
+
+  // The seeded Cells start at a distance of zero and are their own nearest boundary Cell
+  std::vector<int32_t> nearest(totalPoints, -1);
+  for(size_t a = 0; a < totalPoints; a++)
+  {
+    if(m_FeatureIds[a] > 0 && m_NearestNeighbors[a * 3 + mapIndex] >= 0 && distances[a] == 0.0f)
+    {
+      nearest[a] = static_cast<int32_t>(a);
+    }
+    else
+    {
+      distances[a] = infinity;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  for(int32_t axis = 0; axis < 3; axis++)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+    ExactDistanceTransformImpl pass(distances, nearest.data(), dims, axis, static_cast<double>(res[axis]));
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, pass.getNumberOfLines()), pass, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      pass.convert(0, pass.getNumberOfLines());
+    }
+  }
+
+  for(size_t a = 0; a < totalPoints; a++)
+  {
+    if(m_FeatureIds[a] <= 0)
+    {
+      // Match the propagation based map where Cells outside of any Feature are their own nearest Cell
+      distances[a] = 0.0f;
+      nearest[a] = static_cast<int32_t>(a);
+    }
+    else if(distances[a] == infinity)
+    {
+      distances[a] = -1.0f;
+      nearest[a] = -1;
+    }
+    else
+    {
+      distances[a] = std::sqrt(distances[a]);
+    }
+    m_NearestNeighbors[a * 3 + mapIndex] = nearest[a];
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -58,6 +58,7 @@ class Statistics_EXPORT FindEuclideanDistMap : public AbstractFilter
     PYB11_PROPERTY(bool DoQuadPoints READ getDoQuadPoints WRITE setDoQuadPoints)
     PYB11_PROPERTY(bool SaveNearestNeighbors READ getSaveNearestNeighbors WRITE setSaveNearestNeighbors)
     PYB11_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
+    PYB11_PROPERTY(bool UseExactEuclideanDistance READ getUseExactEuclideanDistance WRITE setUseExactEuclideanDistance)
 public:
   SIMPL_SHARED_POINTERS(FindEuclideanDistMap)
   SIMPL_FILTER_NEW_MACRO(FindEuclideanDistMap)
@@ -104,6 +105,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, CalcManhattanDist)
   Q_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
 
+  SIMPL_FILTER_PARAMETER(bool, UseExactEuclideanDistance)
+  Q_PROPERTY(bool UseExactEuclideanDistance READ getUseExactEuclideanDistance WRITE setUseExactEuclideanDistance)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -210,6 +214,14 @@ protected:
    */
   void findDistanceMap();
 
+  /**
+   * @brief findExactDistanceMap Computes the exact Euclidean distance (and the nearest seed Cell) from every
+   * Cell to the closest Cell that was seeded for the given map type using a separable distance transform
+   * @param mapType The map (boundary, triple line or quadruple point) to compute
+   * @param distances The output distance array for the map
+   */
+  void findExactDistanceMap(MapType mapType, float* distances);
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
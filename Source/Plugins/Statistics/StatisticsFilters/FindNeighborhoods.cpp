@@ -35,6 +35,9 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <mutex>
 
 #include <QtCore/QDateTime>
@@ -144,6 +147,115 @@ private:
   const std::vector<float>& m_CriticalDistance;
 };
 
+/**
+ * @brief The FindNeighborhoodsGridImpl class finds the neighborhood of each feature by only visiting the
+ * features whose bins lie inside of the feature's critical distance. The features are sorted into a uniform
+ * grid keyed by their bins (cellStarts/cellFeatures is a compressed list of the features in each grid cell).
+ * Each feature only writes to its own neighborhood list so no locking is required.
+ */
+class FindNeighborhoodsGridImpl
+{
+public:
+  FindNeighborhoodsGridImpl(FindNeighborhoods* filter, size_t totalFeatures, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance, const int64_t gridMin[3],
+                            const int64_t gridDims[3], const std::vector<size_t>& cellStarts, const std::vector<int32_t>& cellFeatures, std::vector<std::vector<int32_t>>& neighborhoods)
+  : m_Filter(filter)
+  , m_TotalFeatures(totalFeatures)
+  , m_Bins(bins)
+  , m_CriticalDistance(criticalDistance)
+  , m_CellStarts(cellStarts)
+  , m_CellFeatures(cellFeatures)
+  , m_Neighborhoods(neighborhoods)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_GridMin[d] = gridMin[d];
+      m_GridDims[d] = gridDims[d];
+    }
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    size_t increment = (end - start) / 100;
+    size_t incCount = 0;
+    // NEVER start at 0.
+    if(start == 0)
+    {
+      start = 1;
+    }
+    int64_t lo[3] = {0, 0, 0};
+    int64_t hi[3] = {0, 0, 0};
+    for(size_t i = start; i < end; i++)
+    {
+      incCount++;
+      if(incCount == increment || i == end - 1)
+      {
+        incCount = 0;
+        m_Filter->updateProgress(increment, m_TotalFeatures);
+      }
+      if(m_Filter->getCancel())
+      {
+        break;
+      }
+
+      std::vector<int32_t>& neighborhood = m_Neighborhoods[i];
+      neighborhood.clear();
+      float criticalDistance = m_CriticalDistance[i];
+      if(!(criticalDistance > 0.0f))
+      {
+        continue;
+      }
+      // Two features are in the same neighborhood when every bin difference is < criticalDistance,
+      // which for integer bins means a difference of at most ceil(criticalDistance) - 1
+      double reach = std::ceil(static_cast<double>(criticalDistance)) - 1.0;
+      for(size_t d = 0; d < 3; d++)
+      {
+        double bin = static_cast<double>(m_Bins[3 * i + d] - m_GridMin[d]);
+        lo[d] = static_cast<int64_t>(std::max(bin - reach, 0.0));
+        hi[d] = static_cast<int64_t>(std::min(bin + reach, static_cast<double>(m_GridDims[d] - 1)));
+      }
+
+      for(int64_t z = lo[2]; z <= hi[2]; z++)
+      {
+        for(int64_t y = lo[1]; y <= hi[1]; y++)
+        {
+          size_t cell = static_cast<size_t>((z * m_GridDims[1] + y) * m_GridDims[0] + lo[0]);
+          for(int64_t x = lo[0]; x <= hi[0]; x++, cell++)
+          {
+            for(size_t k = m_CellStarts[cell]; k < m_CellStarts[cell + 1]; k++)
+            {
+              int32_t j = m_CellFeatures[k];
+              if(static_cast<size_t>(j) != i)
+              {
+                neighborhood.push_back(j);
+              }
+            }
+          }
+        }
+      }
+      // Keep the same (ascending) ordering that the pairwise search produces
+      std::sort(neighborhood.begin(), neighborhood.end());
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  FindNeighborhoods* m_Filter = nullptr;
+  size_t m_TotalFeatures = 0;
+  const std::vector<int64_t>& m_Bins;
+  const std::vector<float>& m_CriticalDistance;
+  int64_t m_GridMin[3] = {0, 0, 0};
+  int64_t m_GridDims[3] = {0, 0, 0};
+  const std::vector<size_t>& m_CellStarts;
+  const std::vector<int32_t>& m_CellFeatures;
+  std::vector<std::vector<int32_t>>& m_Neighborhoods;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -360,28 +472,98 @@ void FindNeighborhoods::execute()
     bins[3 * i + 2] = static_cast<int64_t>(zbin);
   }
 
+  // Sort the features into a uniform grid keyed by their bins so that each feature only has to look at
+  // the cells that are within its critical distance instead of every other feature
+  int64_t gridMin[3] = {std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max()};
+  int64_t gridMax[3] = {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min()};
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      gridMin[d] = std::min(gridMin[d], bins[3 * i + d]);
+      gridMax[d] = std::max(gridMax[d], bins[3 * i + d]);
+    }
+  }
+  int64_t gridDims[3] = {0, 0, 0};
+  double numCells = 1.0;
+  for(size_t d = 0; d < 3; d++)
+  {
+    gridDims[d] = (totalFeatures > 1) ? gridMax[d] - gridMin[d] + 1 : 1;
+    numCells *= static_cast<double>(gridDims[d]);
+  }
+  // The bins are normally bounded by the volume so the grid is about the size of the feature count. Only
+  // fall back to the pairwise search if the bins are spread so far apart that the grid can not be allocated.
+  bool useGrid = (numCells <= static_cast<double>(8 * totalFeatures + (1 << 20)));
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
 #endif
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(doParallel)
+  if(useGrid)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance), tbb::auto_partitioner());
+    std::vector<size_t> cellStarts(static_cast<size_t>(numCells) + 1, 0);
+    std::vector<int32_t> cellFeatures(totalFeatures > 0 ? totalFeatures - 1 : 0, 0);
+    std::vector<size_t> featureCells(totalFeatures, 0);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      featureCells[i] = static_cast<size_t>(((bins[3 * i + 2] - gridMin[2]) * gridDims[1] + (bins[3 * i + 1] - gridMin[1])) * gridDims[0] + (bins[3 * i] - gridMin[0]));
+      cellStarts[featureCells[i] + 1]++;
+    }
+    for(size_t c = 1; c < cellStarts.size(); c++)
+    {
+      cellStarts[c] += cellStarts[c - 1];
+    }
+    std::vector<size_t> cellFill(cellStarts.begin(), cellStarts.end() - 1);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      cellFeatures[cellFill[featureCells[i]]++] = static_cast<int32_t>(i);
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures),
+                        FindNeighborhoodsGridImpl(this, totalFeatures, bins, criticalDistance, gridMin, gridDims, cellStarts, cellFeatures, m_LocalNeighborhoodList), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FindNeighborhoodsGridImpl serial(this, totalFeatures, bins, criticalDistance, gridMin, gridDims, cellStarts, cellFeatures, m_LocalNeighborhoodList);
+      serial.convert(0, totalFeatures);
+    }
+
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      m_Neighborhoods[i] = static_cast<int32_t>(m_LocalNeighborhoodList[i].size());
+    }
   }
   else
-#endif
   {
-    FindNeighborhoodsImpl serial(this, totalFeatures, m_Centroids, bins, criticalDistance);
-    serial.convert(0, totalFeatures);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance), tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      FindNeighborhoodsImpl serial(this, totalFeatures, m_Centroids, bins, criticalDistance);
+      serial.convert(0, totalFeatures);
+    }
+
+    // The pairwise search appends from several threads so restore the ascending order
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      std::sort(m_LocalNeighborhoodList[i].begin(), m_LocalNeighborhoodList[i].end());
+    }
   }
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(m_LocalNeighborhoodList[i].begin(), m_LocalNeighborhoodList[i].end());
+    sharedNeiLst->swap(m_LocalNeighborhoodList[i]);
     m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 
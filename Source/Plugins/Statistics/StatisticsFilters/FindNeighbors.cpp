@@ -35,6 +35,8 @@
 
 #include "FindNeighbors.h"
 
+#include <algorithm>
+
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
@@ -49,6 +51,147 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The FindNeighborsImpl class scans a chunk of the x-lines of the volume and emits one (featureA, featureB)
+ * key for every face shared by two different Features, looking only at the +x, +y and +z neighbors so that each
+ * face is seen once. The keys of each chunk are sorted and reduced into (key, face count) pairs. Each chunk
+ * only writes into its own output vectors (and its own Cells of the boundary cells array) so no locking is required.
+ */
+class FindNeighborsImpl
+{
+public:
+  using FaceCountType = std::pair<uint64_t, int32_t>;
+
+  FindNeighborsImpl(int32_t* featureIds, const int64_t dims[3], int64_t linesPerChunk, std::vector<std::vector<FaceCountType>>& faceCounts, std::vector<std::vector<int32_t>>& surfaceFeatures,
+                    int8_t* boundaryCells, bool storeSurfaceFeatures)
+  : m_FeatureIds(featureIds)
+  , m_LinesPerChunk(linesPerChunk)
+  , m_FaceCounts(faceCounts)
+  , m_SurfaceFeatures(surfaceFeatures)
+  , m_BoundaryCells(boundaryCells)
+  , m_StoreSurfaceFeatures(storeSurfaceFeatures)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindNeighborsImpl() = default;
+
+  static uint64_t makeKey(int32_t featureA, int32_t featureB)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(featureA)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(featureB));
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    const int64_t numLines = m_Dims[1] * m_Dims[2];
+    const int64_t xyPoints = m_Dims[0] * m_Dims[1];
+    const int64_t neighpoints[6] = {-xyPoints, -m_Dims[0], -1, 1, m_Dims[0], xyPoints};
+
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      std::vector<uint64_t> keys;
+      std::vector<int32_t>& surfaceFeatures = m_SurfaceFeatures[chunk];
+      int32_t lastSurfaceFeature = 0;
+
+      int64_t lineStart = static_cast<int64_t>(chunk) * m_LinesPerChunk;
+      int64_t lineEnd = std::min(lineStart + m_LinesPerChunk, numLines);
+      for(int64_t line = lineStart; line < lineEnd; line++)
+      {
+        int64_t row = line % m_Dims[1];
+        int64_t plane = line / m_Dims[1];
+        int64_t lineOffset = line * m_Dims[0];
+        for(int64_t column = 0; column < m_Dims[0]; column++)
+        {
+          int64_t j = lineOffset + column;
+          int32_t feature = m_FeatureIds[j];
+          if(feature <= 0)
+          {
+            if(nullptr != m_BoundaryCells)
+            {
+              m_BoundaryCells[j] = 0;
+            }
+            continue;
+          }
+
+          if(m_StoreSurfaceFeatures && feature != lastSurfaceFeature)
+          {
+            bool onEdge = (column == 0 || column == m_Dims[0] - 1 || row == 0 || row == m_Dims[1] - 1);
+            if(m_Dims[2] != 1)
+            {
+              onEdge = onEdge || plane == 0 || plane == m_Dims[2] - 1;
+            }
+            if(onEdge)
+            {
+              surfaceFeatures.push_back(feature);
+              lastSurfaceFeature = feature;
+            }
+          }
+
+          bool good[6] = {plane != 0, row != 0, column != 0, column != m_Dims[0] - 1, row != m_Dims[1] - 1, plane != m_Dims[2] - 1};
+          int8_t onsurf = 0;
+          for(int32_t k = 0; k < 6; k++)
+          {
+            if(!good[k])
+            {
+              continue;
+            }
+            int32_t neighFeature = m_FeatureIds[j + neighpoints[k]];
+            if(neighFeature != feature && neighFeature > 0)
+            {
+              onsurf++;
+              // Only the +x, +y and +z faces are recorded so each shared face is counted once
+              if(k >= 3)
+              {
+                keys.push_back(feature < neighFeature ? makeKey(feature, neighFeature) : makeKey(neighFeature, feature));
+              }
+            }
+          }
+          if(nullptr != m_BoundaryCells)
+          {
+            m_BoundaryCells[j] = onsurf;
+          }
+        }
+      }
+
+      std::sort(keys.begin(), keys.end());
+      std::vector<FaceCountType>& faceCounts = m_FaceCounts[chunk];
+      for(const uint64_t& key : keys)
+      {
+        if(faceCounts.empty() || faceCounts.back().first != key)
+        {
+          faceCounts.push_back(FaceCountType(key, 0));
+        }
+        faceCounts.back().second++;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_LinesPerChunk = 1;
+  std::vector<std::vector<FaceCountType>>& m_FaceCounts;
+  std::vector<std::vector<int32_t>>& m_SurfaceFeatures;
+  int8_t* m_BoundaryCells = nullptr;
+  bool m_StoreSurfaceFeatures = false;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -226,7 +369,6 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
@@ -236,135 +378,126 @@ void FindNeighbors::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t currentMillis = millis;
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(m_StoreSurfaceFeatures)
     {
       m_SurfaceFeatures[i] = false;
     }
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Determining Shared Faces");
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  size_t numChunks = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) * 8;
+#else
+  size_t numChunks = 1;
+#endif
+
+  // Split the x-lines of the volume into chunks that each collect their own shared face counts
+  int64_t numLines = dims[1] * dims[2];
+  numChunks = std::max(static_cast<size_t>(1), std::min(numChunks, static_cast<size_t>(numLines)));
+  int64_t linesPerChunk = (numLines + static_cast<int64_t>(numChunks) - 1) / static_cast<int64_t>(numChunks);
+  numChunks = static_cast<size_t>((numLines + linesPerChunk - 1) / linesPerChunk);
+
+  std::vector<std::vector<FindNeighborsImpl::FaceCountType>> chunkFaceCounts(numChunks);
+  std::vector<std::vector<int32_t>> chunkSurfaceFeatures(numChunks);
+  FindNeighborsImpl impl(m_FeatureIds, dims, linesPerChunk, chunkFaceCounts, chunkSurfaceFeatures, m_StoreBoundaryCells ? m_BoundaryCells : nullptr, m_StoreSurfaceFeatures);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numChunks);
+  }
 
-    if(getCancel())
-    {
-      return;
-    }
+  if(getCancel())
+  {
+    return;
+  }
 
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
+  if(m_StoreSurfaceFeatures)
+  {
+    for(const std::vector<int32_t>& surfaceFeatures : chunkSurfaceFeatures)
     {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures)
+      for(const int32_t& feature : surfaceFeatures)
       {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
-        }
+        m_SurfaceFeatures[feature] = true;
       }
     }
-    if(m_StoreBoundaryCells)
+  }
+  chunkSurfaceFeatures.clear();
+
+  // Merge the per chunk counts into one sorted list of unique (featureA < featureB) pairs
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Merging Shared Faces");
+  size_t totalPairs = 0;
+  for(const std::vector<FindNeighborsImpl::FaceCountType>& faceCounts : chunkFaceCounts)
+  {
+    totalPairs += faceCounts.size();
+  }
+  std::vector<FindNeighborsImpl::FaceCountType> faceCounts;
+  faceCounts.reserve(totalPairs);
+  for(std::vector<FindNeighborsImpl::FaceCountType>& chunk : chunkFaceCounts)
+  {
+    faceCounts.insert(faceCounts.end(), chunk.begin(), chunk.end());
+    std::vector<FindNeighborsImpl::FaceCountType>().swap(chunk);
+  }
+  std::sort(faceCounts.begin(), faceCounts.end());
+  size_t numPairs = 0;
+  for(size_t p = 0; p < faceCounts.size(); p++)
+  {
+    if(numPairs > 0 && faceCounts[numPairs - 1].first == faceCounts[p].first)
+    {
+      faceCounts[numPairs - 1].second += faceCounts[p].second;
+    }
+    else
     {
-      m_BoundaryCells[j] = onsurf;
+      faceCounts[numPairs] = faceCounts[p];
+      numPairs++;
     }
   }
+  faceCounts.resize(numPairs);
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Build a compressed (CSR) layout that holds both directions of every pair. Walking the pairs in
+  // ascending (featureA, featureB) order fills each Feature's neighbors in ascending order.
+  std::vector<size_t> neighborStarts(totalFeatures + 1, 0);
+  for(const FindNeighborsImpl::FaceCountType& pair : faceCounts)
+  {
+    neighborStarts[static_cast<size_t>(pair.first >> 32) + 1]++;
+    neighborStarts[static_cast<size_t>(pair.first & 0xFFFFFFFF) + 1]++;
+  }
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    neighborStarts[i + 1] += neighborStarts[i];
+  }
+  std::vector<int32_t> neighbors(neighborStarts[totalFeatures], 0);
+  std::vector<int32_t> faceCountList(neighborStarts[totalFeatures], 0);
+  std::vector<size_t> cursor(neighborStarts.begin(), neighborStarts.end() - 1);
+  for(const FindNeighborsImpl::FaceCountType& pair : faceCounts)
+  {
+    int32_t featureA = static_cast<int32_t>(pair.first >> 32);
+    int32_t featureB = static_cast<int32_t>(pair.first & 0xFFFFFFFF);
+    neighbors[cursor[featureA]] = featureB;
+    faceCountList[cursor[featureA]++] = pair.second;
+    neighbors[cursor[featureB]] = featureA;
+    faceCountList[cursor[featureB]++] = pair.second;
+  }
+  std::vector<FindNeighborsImpl::FaceCountType>().swap(faceCounts);
 
   float xRes = 0.0f;
   float yRes = 0.0f;
@@ -387,42 +520,19 @@ void FindNeighbors::execute()
       return;
     }
 
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * xRes * yRes;
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    size_t first = neighborStarts[i];
+    size_t last = neighborStarts[i + 1];
+    m_NumNeighbors[i] = static_cast<int32_t>(last - first);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighbors.begin() + first, neighbors.begin() + last));
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(last - first));
+    for(size_t n = first; n < last; n++)
+    {
+      (*sharedSAL)[n - first] = float(faceCountList[n]) * xRes * yRes;
+    }
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 
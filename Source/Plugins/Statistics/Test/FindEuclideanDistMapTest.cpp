@@ -33,6 +33,8 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -305,6 +307,127 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int validateExactResults(DataContainerArray::Pointer dca, const QString& approxName, const QString& exactName)
+  {
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(k_FeatureIdsArrayPath);
+    ImageGeom::Pointer geom = dca->getDataContainer(k_FeatureIdsArrayPath.getDataContainerName())->getGeometryAs<ImageGeom>();
+    size_t dims[3] = {0, 0, 0};
+    std::tie(dims[0], dims[1], dims[2]) = geom->getDimensions();
+    float res[3] = {0.0f, 0.0f, 0.0f};
+    std::tie(res[0], res[1], res[2]) = geom->getResolution();
+
+    Int32ArrayType::Pointer featureIds = am->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsArrayPath.getDataArrayName());
+    FloatArrayType::Pointer approx = am->getAttributeArrayAs<FloatArrayType>(approxName);
+    FloatArrayType::Pointer exact = am->getAttributeArrayAs<FloatArrayType>(exactName);
+    DREAM3D_REQUIRE_VALID_POINTER(approx.get())
+    DREAM3D_REQUIRE_VALID_POINTER(exact.get())
+
+    // Both approaches start from the same set of zero distance Cells
+    std::vector<size_t> seeds;
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      if(featureIds->getValue(i) > 0 && approx->getValue(i) == 0.0f)
+      {
+        seeds.push_back(i);
+      }
+    }
+
+    for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+    {
+      float refValue = -1.0f;
+      if(featureIds->getValue(i) <= 0)
+      {
+        refValue = 0.0f;
+      }
+      else
+      {
+        for(const size_t& seed : seeds)
+        {
+          float dx = res[0] * (static_cast<float>(i % dims[0]) - static_cast<float>(seed % dims[0]));
+          float dy = res[1] * (static_cast<float>((i / dims[0]) % dims[1]) - static_cast<float>((seed / dims[0]) % dims[1]));
+          float dz = res[2] * (static_cast<float>(i / (dims[0] * dims[1])) - static_cast<float>(seed / (dims[0] * dims[1])));
+          float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+          if(refValue < 0.0f || dist < refValue)
+          {
+            refValue = dist;
+          }
+        }
+      }
+      float computedValue = exact->getValue(i);
+      DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
+      // The exact distance can never be larger than the propagation based distance
+      DREAM3D_REQUIRE(computedValue <= approx->getValue(i) + 1.0E-5f)
+    }
+
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunExactTest()
+  {
+    QVector<size_t> tDims = {10, 6, 1};
+    DataContainerArray::Pointer dca = initializeDataContainerArray(tDims);
+
+    QString filtName = "FindEuclideanDistMap";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(k_FeatureIdsArrayPath);
+    int err = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    var.setValue(false);
+    err = filter->setProperty("CalcManhattanDist", var);
+    DREAM3D_REQUIRE(err >= 0);
+    var.setValue(true);
+    err = filter->setProperty("DoTripleLines", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    var.setValue(QString("GBApproxDistance"));
+    err = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+    var.setValue(QString("TJApproxDistance"));
+    err = filter->setProperty("TJDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    //-------------------------------------------
+    var.setValue(true);
+    err = filter->setProperty("UseExactEuclideanDistance", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    var.setValue(QString("GBExactDistance"));
+    err = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+    var.setValue(QString("TJExactDistance"));
+    err = filter->setProperty("TJDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    err = validateExactResults(dca, "GBApproxDistance", "GBExactDistance");
+    DREAM3D_REQUIRE(err >= 0);
+    err = validateExactResults(dca, "TJApproxDistance", "TJExactDistance");
+    DREAM3D_REQUIRE(err >= 0);
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -316,6 +439,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(RunExactTest())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
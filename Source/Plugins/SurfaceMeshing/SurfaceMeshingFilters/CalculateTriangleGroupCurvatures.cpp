@@ -35,30 +35,104 @@
 
 #include "CalculateTriangleGroupCurvatures.h"
 
-#include <QtCore/QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/task.h>
-#include <tbb/task_group.h>
-#include <tbb/task_scheduler_init.h>
-#endif
+#include <QtCore/QtGlobal>
 
 #include <Eigen/Dense>
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+
+namespace
+{
+static const uint32_t k_MaxFitColumns = 7;
+
+/**
+ * @brief solveLeastSquares Solves the least squares problem min |A x - b| one row at a time using
+ * Givens rotations so that only a cols x cols triangular factor is ever stored, on the stack.
+ * @param rows Number of rows in the system
+ * @param cols Number of unknowns (at most k_MaxFitColumns)
+ * @param rowFunc Fills in one row of A and returns the matching value of b
+ * @param solution Output solution vector
+ * @return false if the system is rank deficient, in which case the caller should fall back to a
+ * rank revealing solver
+ */
+template <typename RowFunc> bool solveLeastSquares(size_t rows, uint32_t cols, RowFunc rowFunc, double* solution)
+{
+  if(rows < cols)
+  {
+    return false;
+  }
+
+  double r[k_MaxFitColumns][k_MaxFitColumns];
+  double qtb[k_MaxFitColumns];
+  ::memset(r, 0, sizeof(r));
+  ::memset(qtb, 0, sizeof(qtb));
+
+  double a[k_MaxFitColumns];
+  for(size_t m = 0; m < rows; ++m)
+  {
+    double rhs = rowFunc(m, a);
+    // Rotate the new row into the triangular factor one column at a time
+    for(uint32_t k = 0; k < cols; ++k)
+    {
+      if(a[k] == 0.0)
+      {
+        continue;
+      }
+      double h = std::hypot(r[k][k], a[k]);
+      double c = r[k][k] / h;
+      double s = a[k] / h;
+      for(uint32_t j = k; j < cols; ++j)
+      {
+        double t = r[k][j];
+        r[k][j] = c * t + s * a[j];
+        a[j] = c * a[j] - s * t;
+      }
+      double t = qtb[k];
+      qtb[k] = c * t + s * rhs;
+      rhs = c * rhs - s * t;
+    }
+  }
+
+  double maxDiag = 0.0;
+  for(uint32_t k = 0; k < cols; ++k)
+  {
+    maxDiag = std::max(maxDiag, std::fabs(r[k][k]));
+  }
+  for(uint32_t k = 0; k < cols; ++k)
+  {
+    if(std::fabs(r[k][k]) <= 1.0E-10 * maxDiag || maxDiag == 0.0)
+    {
+      return false;
+    }
+  }
+
+  for(int32_t k = static_cast<int32_t>(cols) - 1; k >= 0; --k)
+  {
+    double sum = qtb[k];
+    for(uint32_t j = k + 1; j < cols; ++j)
+    {
+      sum -= r[k][j] * solution[j];
+    }
+    solution[k] = sum / r[k][k];
+  }
+  return true;
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
+CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
                                                                    DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1,
                                                                    DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature,
                                                                    TriangleGeom::Pointer trianglesGeom, DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
                                                                    DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent)
 : m_NRing(nring)
-, m_TriangleIds(triangleIds)
 , m_UseNormalsForCurveFitting(useNormalsForCurveFitting)
 , m_PrincipleCurvature1(principleCurvature1)
 , m_PrincipleCurvature2(principleCurvature2)
@@ -72,6 +146,17 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
 , m_SurfaceMeshTriangleCentroids(surfaceMeshTriangleCentroids)
 , m_ParentFilter(parent)
 {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  m_Scratch = std::make_shared<tbb::enumerable_thread_specific<NRingScratch>>();
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CalculateTriangleGroupCurvatures::NRingScratch::NRingScratch()
+: nRingNeighborAlg(FindNRingNeighbors::New())
+{
 }
 
 // -----------------------------------------------------------------------------
@@ -79,86 +164,90 @@ CalculateTriangleGroupCurvatures::CalculateTriangleGroupCurvatures(int64_t nring
 // -----------------------------------------------------------------------------
 CalculateTriangleGroupCurvatures::~CalculateTriangleGroupCurvatures() = default;
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void subtractVector3d(DataArray<double>::Pointer data, double* v)
+void CalculateTriangleGroupCurvatures::operator()(const tbb::blocked_range<int64_t>& r) const
 {
-  size_t count = data->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    double* ptr = data->getPointer(i * 3);
-    ptr[0] = ptr[0] - v[0];
-    ptr[1] = ptr[1] - v[1];
-    ptr[2] = ptr[2] - v[2];
-  }
+  computeCurvatures(r.begin(), r.end());
 }
+#endif
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void CalculateTriangleGroupCurvatures::operator()() const
+void CalculateTriangleGroupCurvatures::computeCurvatures(int64_t start, int64_t end) const
 {
   int32_t err = 0;
 
-  if(m_TriangleIds.size() == 0)
-  {
-    return;
-  }
-
-  // Instantiate a FindNRingNeighbors class to use during the loop
-  FindNRingNeighbors::Pointer nRingNeighborAlg = FindNRingNeighbors::New();
+  // The N ring search keeps its buffers between triangles, as does the patch buffer, so nothing is
+  // allocated once they have grown. Each thread has its own pair that lives as long as this object.
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  NRingScratch& scratch = m_Scratch->local();
+#else
+  NRingScratch scratch;
+#endif
+  FindNRingNeighbors::Pointer& nRingNeighborAlg = scratch.nRingNeighborAlg;
+  nRingNeighborAlg->setRing(m_NRing);
+  std::vector<double>& patchCentroids = scratch.patchCentroids;
 
   int32_t* faceLabels = m_SurfaceMeshFaceLabels->getPointer(0);
-
-  int32_t* fl = faceLabels + m_TriangleIds[0] * 2;
-  int32_t feature0 = 0;
-  int32_t feature1 = 0;
-  if(fl[0] < fl[1])
-  {
-    feature0 = fl[0];
-    feature1 = fl[1];
-  }
-  else
-  {
-    feature0 = fl[1];
-    feature1 = fl[0];
-  }
+  double* centroids = m_SurfaceMeshTriangleCentroids->getPointer(0);
+  double* normals = m_SurfaceMeshFaceNormals->getPointer(0);
 
   bool computeGaussian = (m_GaussianCurvature.get() != nullptr);
   bool computeMean = (m_MeanCurvature.get() != nullptr);
   bool computeDirection = (m_PrincipleDirection1.get() != nullptr);
 
-  std::vector<int64_t>::size_type tCount = m_TriangleIds.size();
   // For each triangle in the group
-  for(std::vector<int64_t>::size_type i = 0; i < tCount; ++i)
+  for(int64_t triId = start; triId < end; ++triId)
   {
     if(m_ParentFilter->getCancel() == true)
     {
       return;
     }
-    int64_t triId = m_TriangleIds[i];
+    int32_t* fl = faceLabels + triId * 2;
+    int32_t feature0 = 0;
+    int32_t feature1 = 0;
+    if(fl[0] < fl[1])
+    {
+      feature0 = fl[0];
+      feature1 = fl[1];
+    }
+    else
+    {
+      feature0 = fl[1];
+      feature1 = fl[0];
+    }
+
     nRingNeighborAlg->setTriangleId(triId);
     nRingNeighborAlg->setRegionId0(feature0);
     nRingNeighborAlg->setRegionId1(feature1);
-    nRingNeighborAlg->setRing(m_NRing);
     err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
     Q_ASSERT(err >= 0);
 
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
+    const UniqueFaceIds_t& triPatch = nRingNeighborAlg->getNRingTriangles();
     Q_ASSERT(triPatch.size() > 1);
 
-    DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
-    DataArray<double>::Pointer patchNormals = extractPatchData(triId, triPatch, m_SurfaceMeshFaceNormals->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Normals"));
+    extractPatchData(triId, triPatch, centroids, patchCentroids);
+    size_t rows = triPatch.size();
 
     // Translate the patch to the 0,0,0 origin
-    double sub[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    subtractVector3d(patchCentroids, sub);
+    double sub[3] = {patchCentroids[0], patchCentroids[1], patchCentroids[2]};
+    for(size_t m = 0; m < rows; ++m)
+    {
+      double* ptr = patchCentroids.data() + m * 3;
+      ptr[0] = ptr[0] - sub[0];
+      ptr[1] = ptr[1] - sub[1];
+      ptr[2] = ptr[2] - sub[2];
+    }
 
-    double np[3] = {patchNormals->getComponent(0, 0), patchNormals->getComponent(0, 1), patchNormals->getComponent(0, 2)};
+    // Only the seed triangle's normal is needed to set up the local coordinate system
+    double np[3] = {normals[triId * 3], normals[triId * 3 + 1], normals[triId * 3 + 2]};
 
-    double seedCentroid[3] = {patchCentroids->getComponent(0, 0), patchCentroids->getComponent(0, 1), patchCentroids->getComponent(0, 2)};
-    double firstCentroid[3] = {patchCentroids->getComponent(1, 0), patchCentroids->getComponent(1, 1), patchCentroids->getComponent(1, 2)};
+    double seedCentroid[3] = {patchCentroids[0], patchCentroids[1], patchCentroids[2]};
+    double firstCentroid[3] = {patchCentroids[3], patchCentroids[4], patchCentroids[5]};
 
     double temp[3] = {firstCentroid[0] - seedCentroid[0], firstCentroid[1] - seedCentroid[1], firstCentroid[2] - seedCentroid[2]};
     double vp[3] = {0.0, 0.0, 0.0};
@@ -175,19 +264,12 @@ void CalculateTriangleGroupCurvatures::operator()() const
     // this constitutes a rotation matrix to a local coordinate system
     double rot[3][3] = {{up[0], up[1], up[2]}, {vp[0], vp[1], vp[2]}, {np[0], np[1], np[2]}};
     double out[3] = {0.0, 0.0, 0.0};
-    // Transform all centroids and normals to new coordinate system
-    for(size_t m = 0; m < patchCentroids->getNumberOfTuples(); ++m)
+    // Transform all centroids to new coordinate system. If we start using part 3 of Goldfeathers
+    // paper then the patch normals will need to be extracted and rotated as well.
+    for(size_t m = 0; m < rows; ++m)
     {
-      ::memcpy(out, patchCentroids->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchCentroids->getPointer(m * 3), out);
-      ::memcpy(patchCentroids->getPointer(m * 3), out, 3 * sizeof(double));
-
-      ::memcpy(out, patchNormals->getPointer(m * 3), 3 * sizeof(double));
-      MatrixMath::Multiply3x3with3x1(rot, patchNormals->getPointer(m * 3), out);
-      ::memcpy(patchNormals->getPointer(m * 3), out, 3 * sizeof(double));
-
-      // We rotate the normals now but we dont use them yet. If we start using part 3 of Goldfeathers paper then we
-      // will need the normals.
+      MatrixMath::Multiply3x3with3x1(rot, patchCentroids.data() + m * 3, out);
+      ::memcpy(patchCentroids.data() + m * 3, out, 3 * sizeof(double));
     }
 
     {
@@ -199,47 +281,50 @@ void CalculateTriangleGroupCurvatures::operator()() const
       {
         cols = USE_NORMALS;
       }
-      size_t rows = patchCentroids->getNumberOfTuples();
-      Eigen::MatrixXd A(rows, cols);
-      Eigen::VectorXd b(rows);
-      double x = 0.0, y = 0.0, z = 0.0;
-      for(size_t m = 0; m < rows; ++m)
+      const double* patch = patchCentroids.data();
+      bool useNormals = m_UseNormalsForCurveFitting;
+      auto fillRow = [patch, useNormals](size_t m, double* a) -> double {
+        double x = patch[m * 3];
+        double y = patch[m * 3 + 1];
+        a[0] = 0.5 * x * x; // 1/2 x^2
+        a[1] = x * y;       // x*y
+        a[2] = 0.5 * y * y; // 1/2 y^2
+        if(useNormals)
+        {
+          a[3] = x * x * x;
+          a[4] = x * x * y;
+          a[5] = x * y * y;
+          a[6] = y * y * y;
+        }
+        return patch[m * 3 + 2]; // The Z Values
+      };
+
+      double sln1[k_MaxFitColumns] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      if(!solveLeastSquares(rows, cols, fillRow, sln1))
       {
-        x = patchCentroids->getComponent(m, 0);
-        y = patchCentroids->getComponent(m, 1);
-        z = patchCentroids->getComponent(m, 2);
-
-        A(m) = 0.5 * x * x;            // 1/2 x^2
-        A(m + rows) = x * y;           // x*y
-        A(m + rows * 2) = 0.5 * y * y; // 1/2 y^2
-        if(m_UseNormalsForCurveFitting == true)
+        // Small or degenerate patches need the rank revealing solver
+        Eigen::MatrixXd A(rows, cols);
+        Eigen::VectorXd b(rows);
+        double a[k_MaxFitColumns];
+        for(size_t m = 0; m < rows; ++m)
         {
-          A(m + rows * 3) = x * x * x;
-          A(m + rows * 4) = x * x * y;
-          A(m + rows * 5) = x * y * y;
-          A(m + rows * 6) = y * y * y;
+          b[m] = fillRow(m, a);
+          for(uint32_t c = 0; c < cols; ++c)
+          {
+            A(m, c) = a[c];
+          }
+        }
+        Eigen::VectorXd sln = A.colPivHouseholderQr().solve(b);
+        for(uint32_t c = 0; c < cols; ++c)
+        {
+          sln1[c] = sln(c);
         }
-        b[m] = z; // The Z Values
       }
 
+      // Now that we have the A, B, C (and D, E, F & G) constants we can solve the Eigen value/vector problem
+      // to get the principal curvatures and pricipal directions.
       Eigen::Matrix2d M;
-
-      if(false == m_UseNormalsForCurveFitting)
-      {
-        typedef Eigen::Matrix<double, NO_NORMALS, 1> Vector3d;
-        Vector3d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
-      else
-      {
-        typedef Eigen::Matrix<double, USE_NORMALS, 1> Vector7d;
-        Vector7d sln1 = A.colPivHouseholderQr().solve(b);
-        // Now that we have the A, B, C, D, E, F & G constants we can solve the Eigen value/vector problem
-        // to get the principal curvatures and pricipal directions.
-        M << sln1(0), sln1(1), sln1(1), sln1(2);
-      }
+      M << sln1[0], sln1[1], sln1[1], sln1[2];
 
       Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(M);
       Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>::RealVectorType eValues = eig.eigenvalues();
@@ -284,28 +369,27 @@ void CalculateTriangleGroupCurvatures::operator()() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const
+void CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, const UniqueFaceIds_t& triPatch, double* data, std::vector<double>& patchData) const
 {
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name);
+  patchData.resize(triPatch.size() * 3);
   // This little chunk makes sure the current seed triangles centroid and normal data appear
   // first in the returned arrays which makes the next steps a tad easier.
-  int32_t i = 0;
-  extractedData->setComponent(i, 0, data[triId * 3]);
-  extractedData->setComponent(i, 1, data[triId * 3 + 1]);
-  extractedData->setComponent(i, 2, data[triId * 3 + 2]);
+  size_t i = 0;
+  patchData[0] = data[triId * 3];
+  patchData[1] = data[triId * 3 + 1];
+  patchData[2] = data[triId * 3 + 2];
   ++i;
-  triPatch.erase(triId);
 
-  for(UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
+  for(UniqueFaceIds_t::const_iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
   {
     int64_t t = *iter;
-    extractedData->setComponent(i, 0, data[t * 3]);
-    extractedData->setComponent(i, 1, data[t * 3 + 1]);
-    extractedData->setComponent(i, 2, data[t * 3 + 2]);
+    if(t == triId)
+    {
+      continue;
+    }
+    patchData[i * 3] = data[t * 3];
+    patchData[i * 3 + 1] = data[t * 3 + 1];
+    patchData[i * 3 + 2] = data[t * 3 + 2];
     ++i;
   }
-  triPatch.insert(triId);
-
-  return extractedData;
 }
@@ -35,31 +35,61 @@
 
 #pragma once
 
-#include <set>
+#include <memory>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/SIMPLib.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+
 /**
  * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
  * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
- * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed. The group is a
+ * contiguous range of triangle ids so that work can be divided evenly by triangle count.
  */
 class CalculateTriangleGroupCurvatures
 {
 public:
-  CalculateTriangleGroupCurvatures(int64_t nring, std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1,
-                                   DoubleArrayType::Pointer principleCurvature2, DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2,
-                                   DoubleArrayType::Pointer gaussianCurvature, DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom,
-                                   DataArray<int32_t>::Pointer surfaceMeshFaceLabels, DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids,
-                                   AbstractFilter* parent);
+  CalculateTriangleGroupCurvatures(int64_t nring, bool useNormalsForCurveFitting, DoubleArrayType::Pointer principleCurvature1, DoubleArrayType::Pointer principleCurvature2,
+                                   DoubleArrayType::Pointer principleDirection1, DoubleArrayType::Pointer principleDirection2, DoubleArrayType::Pointer gaussianCurvature,
+                                   DoubleArrayType::Pointer meanCurvature, TriangleGeom::Pointer trianglesGeom, DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
+                                   DataArray<double>::Pointer surfaceMeshFaceNormals, DataArray<double>::Pointer surfaceMeshTriangleCentroids, AbstractFilter* parent);
 
   virtual ~CalculateTriangleGroupCurvatures();
 
-  void operator()() const;
+  /**
+   * @brief computeCurvatures Computes the curvatures of the triangles in [start, end)
+   * @param start First triangle id
+   * @param end One past the last triangle id
+   */
+  void computeCurvatures(int64_t start, int64_t end) const;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const;
+#endif
 
-  typedef std::set<int64_t> UniqueFaceIds_t;
+  typedef std::vector<int64_t> UniqueFaceIds_t;
+
+  /**
+   * @brief The NRingScratch struct holds the N ring search and the patch buffer that a thread reuses for
+   * every triangle it computes, so nothing is allocated once the buffers have grown to the largest patch.
+   */
+  struct NRingScratch
+  {
+    NRingScratch();
+
+    FindNRingNeighbors::Pointer nRingNeighborAlg;
+    std::vector<double> patchCentroids;
+  };
 
 protected:
   CalculateTriangleGroupCurvatures();
@@ -69,14 +99,12 @@ protected:
    * @param triId The seed triangle Id
    * @param triPatch The group of triangles being used
    * @param data The data to extract from
-   * @param name The name of the data array being used
-   * @return Shared pointer to the extracted data
+   * @param patchData The extracted data with the seed triangle first. It is resized as needed so the same buffer can be reused
    */
-  DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
+  void extractPatchData(int64_t triId, const UniqueFaceIds_t& triPatch, double* data, std::vector<double>& patchData) const;
 
 private:
   int64_t m_NRing;
-  std::vector<int64_t> m_TriangleIds;
   bool m_UseNormalsForCurveFitting;
   DoubleArrayType::Pointer m_PrincipleCurvature1;
   DoubleArrayType::Pointer m_PrincipleCurvature2;
@@ -89,5 +117,8 @@ private:
   DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
   DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
   AbstractFilter* m_ParentFilter;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // Shared by the copies TBB makes of this object so each thread keeps its buffers across all of its ranges
+  std::shared_ptr<tbb::enumerable_thread_specific<NRingScratch>> m_Scratch;
+#endif
 };
-
@@ -34,9 +34,12 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FeatureFaceCurvatureFilter.h"
 
+#include <algorithm>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/task.h>
-#include <tbb/task_group.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
 #endif
 
@@ -180,8 +183,6 @@ void FeatureFaceCurvatureFilter::readFilterParameters(AbstractFilterParametersRe
 void FeatureFaceCurvatureFilter::initialize()
 {
   m_SurfaceMeshFaceEdges = nullptr;
-  m_TotalFeatureFaces = -1;
-  m_CompletedFeatureFaces = -1;
 }
 
 // -----------------------------------------------------------------------------
@@ -368,103 +369,46 @@ void FeatureFaceCurvatureFilter::execute()
     triangleGeom->findElementsContainingVert();
   }
 
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
-
-  int32_t maxFaceId = 0;
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    if(m_SurfaceMeshFeatureFaceIds[t] > maxFaceId)
-    {
-      maxFaceId = m_SurfaceMeshFeatureFaceIds[t];
-    }
-  }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
-
-  // Allocate all the vectors that we need
-  for(size_t iter = 0; iter < faceSizes.size(); ++iter)
-  {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
-  }
-
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
-  }
-
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
-  m_CompletedFeatureFaces = 0;
-
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
 #endif
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-#else
-
-#endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
+  CalculateTriangleGroupCurvatures curvature(m_NRing, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
+                                             m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
+                                             m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
+                                             m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
 
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
+  // Every triangle finds its own N ring within its Feature Face, so the triangles are divided up
+  // by count rather than by Feature Face; a few very large faces no longer leave threads idle.
+  // The work is done in batches so progress can be reported between them.
+  int64_t batchSize = std::max(numTriangles / 100, static_cast<int64_t>(1));
+  for(int64_t batchStart = 0; batchStart < numTriangles; batchStart += batchSize)
   {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
+    if(getCancel())
+    {
+      return;
+    }
+    QString ss = QObject::tr("Computing Curvature || %1/%2 Triangles Complete").arg(batchStart).arg(numTriangles);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-    FaceIds_t& triangleIds = (*iter).second;
+    int64_t batchEnd = std::min(batchStart + batchSize, numTriangles);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(doParallel == true)
     {
-      g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                              m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                              m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                              m_SurfaceMeshTriangleCentroidsPtr.lock(), this));
+      tbb::parallel_for(tbb::blocked_range<int64_t>(batchStart, batchEnd), curvature, tbb::auto_partitioner());
     }
     else
 #endif
     {
-      CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting, m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                                 m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(), m_SurfaceMeshGaussianCurvaturesPtr.lock(),
-                                                 m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(), this);
-      curvature();
+      curvature.computeCurvatures(batchStart, batchEnd);
     }
   }
-// *********************** END END END END END END  ********************************************************************
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  g->wait(); // Wait for all the threads to complete before moving on.
-  
-#endif
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-void FeatureFaceCurvatureFilter::tbbTaskProgress()
-{
-  m_CompletedFeatureFaces++;
-
-  QString ss = QObject::tr("%1/%2 Complete").arg(m_CompletedFeatureFaces).arg(m_TotalFeatureFaces);
-  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-}
-
-#endif
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -74,9 +74,6 @@ class SurfaceMeshing_EXPORT FeatureFaceCurvatureFilter : public SurfaceMeshFilte
 
      ~FeatureFaceCurvatureFilter() override;
 
-     typedef std::vector<int64_t> FaceIds_t;
-     typedef std::map<int32_t, FaceIds_t> SharedFeatureFaces_t;
-
      SIMPL_FILTER_PARAMETER(DataArrayPath, FaceAttributeMatrixPath)
      Q_PROPERTY(DataArrayPath FaceAttributeMatrixPath READ getFaceAttributeMatrixPath WRITE setFaceAttributeMatrixPath)
 
@@ -195,10 +192,6 @@ class SurfaceMeshing_EXPORT FeatureFaceCurvatureFilter : public SurfaceMeshFilte
       */
      void preflight() override;
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    virtual void tbbTaskProgress();
-#endif
-
   protected:
     FeatureFaceCurvatureFilter();
     /**
@@ -226,8 +219,6 @@ class SurfaceMeshing_EXPORT FeatureFaceCurvatureFilter : public SurfaceMeshFilte
     DEFINE_DATAARRAY_VARIABLE(double, SurfaceMeshMeanCurvatures)
 
     int32_t* m_SurfaceMeshFaceEdges;
-    int32_t  m_TotalFeatureFaces;
-    int32_t  m_CompletedFeatureFaces;
 
   public:
     FeatureFaceCurvatureFilter(const FeatureFaceCurvatureFilter&) = delete; // Copy Constructor Not Implemented
@@ -36,6 +36,9 @@
 
 #include "FindNRingNeighbors.h"
 
+#include <algorithm>
+#include <iterator>
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -74,7 +77,7 @@ FindNRingNeighbors::UniqueFaceIds_t& FindNRingNeighbors::getNRingTriangles()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels)
+int32_t FindNRingNeighbors::generate(const TriangleGeom::Pointer& triangleGeom, int32_t* faceLabels)
 {
   int64_t* triangles = triangleGeom->getTriPointer(0);
   int32_t err = 0;
@@ -108,16 +111,15 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
 #endif
 
   // Add our seed triangle
-  m_NRingTriangles.insert(m_TriangleId);
+  m_NRingTriangles.push_back(m_TriangleId);
+  m_RingTriangles.assign(1, m_TriangleId);
 
-  for(int64_t ring = 0; ring < m_Ring; ++ring)
+  for(int64_t ring = 0; ring < m_Ring && !m_RingTriangles.empty(); ++ring)
   {
-    // Make a copy of the 1 Ring Triangles that we just found so that we can use those triangles as the
-    // seed triangles for the 2 Ring triangles
-    UniqueFaceIds_t lcvTriangles(m_NRingTriangles);
-
-    // Now that we have the 1 ring triangles, get the 2 Ring neighbors from that list
-    for(UniqueFaceIds_t::iterator triIter = lcvTriangles.begin(); triIter != lcvTriangles.end(); ++triIter)
+    // Only the triangles that were added by the previous ring can contribute triangles that
+    // are not already in the set, so those are the only ones whose nodes are visited
+    m_Candidates.clear();
+    for(UniqueFaceIds_t::iterator triIter = m_RingTriangles.begin(); triIter != m_RingTriangles.end(); ++triIter)
     {
       int64_t triangleIdx = *triIter;
       // For each node, get the triangle ids that the node belongs to
@@ -127,7 +129,6 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
         uint16_t tCount = node2TrianglePtr->getNumberOfElements(triangles[triangleIdx * 3 + i]);
         int64_t* data = node2TrianglePtr->getElementListPointer(triangles[triangleIdx * 3 + i]);
 
-        // Copy all the triangles into our "2Ring" set which will be the unique set of triangle ids
         for(uint16_t t = 0; t < tCount; ++t)
         {
           int64_t tid = data[t];
@@ -135,11 +136,20 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
           check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
           if(check0 || check1)
           {
-            m_NRingTriangles.insert(tid);
+            m_Candidates.push_back(tid);
           }
         }
       }
     }
+    std::sort(m_Candidates.begin(), m_Candidates.end());
+    m_Candidates.erase(std::unique(m_Candidates.begin(), m_Candidates.end()), m_Candidates.end());
+
+    // The new ring is whatever was not already found, and it is merged into the sorted N ring
+    m_RingTriangles.clear();
+    std::set_difference(m_Candidates.begin(), m_Candidates.end(), m_NRingTriangles.begin(), m_NRingTriangles.end(), std::back_inserter(m_RingTriangles));
+    m_Merged.clear();
+    std::merge(m_NRingTriangles.begin(), m_NRingTriangles.end(), m_RingTriangles.begin(), m_RingTriangles.end(), std::back_inserter(m_Merged));
+    m_NRingTriangles.swap(m_Merged);
   }
   return err;
 }
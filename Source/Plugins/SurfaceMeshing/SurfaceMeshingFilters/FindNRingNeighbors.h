@@ -36,7 +36,7 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -54,7 +54,10 @@ class FindNRingNeighbors
 
     virtual ~FindNRingNeighbors();
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
+    /**
+     * @brief Triangle ids of the N ring, kept sorted and free of duplicates
+     */
+    typedef std::vector<int64_t> UniqueFaceIds_t;
 
     SIMPL_INSTANCE_PROPERTY(int64_t, TriangleId)
 
@@ -92,7 +95,7 @@ class FindNRingNeighbors
      * @param faceLabels Feature Id labels for the TriangleGeom
      * @return Integer error value
      */
-    int32_t generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
+    int32_t generate(const TriangleGeom::Pointer& triangleGeom, int32_t* faceLabels);
 
     SIMPL_INSTANCE_PROPERTY(bool, WriteBinaryFile)
     SIMPL_INSTANCE_PROPERTY(bool, WriteConformalMesh)
@@ -103,6 +106,11 @@ class FindNRingNeighbors
   private:
     UniqueFaceIds_t  m_NRingTriangles;
 
+    // Scratch buffers that are reused from one call to generate() to the next
+    UniqueFaceIds_t  m_RingTriangles;
+    UniqueFaceIds_t  m_Candidates;
+    UniqueFaceIds_t  m_Merged;
+
   public:
     FindNRingNeighbors(const FindNRingNeighbors&) = delete; // Copy Constructor Not Implemented
     FindNRingNeighbors(FindNRingNeighbors&&) = delete;      // Move Constructor Not Implemented
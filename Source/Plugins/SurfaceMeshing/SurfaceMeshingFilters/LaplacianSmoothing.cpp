@@ -35,8 +35,11 @@
 
 #include "LaplacianSmoothing.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <sstream>
+#include <vector>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -50,6 +53,131 @@
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+/**
+ * @brief The LaplacianSmoothingImpl class moves a chunk of the vertices one (Jacobi) smoothing step. Each vertex
+ * gathers the positions of its neighbors from the compressed (CSR) vertex adjacency, so the source positions are only
+ * read and each vertex only writes its own destination position. The largest squared distance a vertex of the chunk
+ * moved away from its reference position is stored for the convergence check.
+ */
+class LaplacianSmoothingImpl
+{
+public:
+  LaplacianSmoothingImpl(const float* src, float* dst, const float* reference, const std::vector<int64_t>& offsets, const std::vector<int64_t>& neighbors, const float* lambda, float factor,
+                         int64_t numVerts, int64_t chunkSize, std::vector<double>& chunkResiduals)
+  : m_Src(src)
+  , m_Dst(dst)
+  , m_Reference(reference)
+  , m_Offsets(offsets)
+  , m_Neighbors(neighbors)
+  , m_Lambda(lambda)
+  , m_Factor(factor)
+  , m_NumVerts(numVerts)
+  , m_ChunkSize(chunkSize)
+  , m_ChunkResiduals(chunkResiduals)
+  {
+  }
+
+  virtual ~LaplacianSmoothingImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      double residual = 0.0;
+      int64_t first = static_cast<int64_t>(chunk) * m_ChunkSize;
+      int64_t last = std::min(first + m_ChunkSize, m_NumVerts);
+      for(int64_t i = first; i < last; i++)
+      {
+        int64_t numNeighbors = m_Offsets[i + 1] - m_Offsets[i];
+        if(numNeighbors == 0)
+        {
+          // A vertex without any edges has nothing to be smoothed towards
+          for(int32_t j = 0; j < 3; j++)
+          {
+            m_Dst[3 * i + j] = m_Src[3 * i + j];
+          }
+          continue;
+        }
+
+        double delta[3] = {0.0, 0.0, 0.0};
+        for(int64_t n = m_Offsets[i]; n < m_Offsets[i + 1]; n++)
+        {
+          int64_t neighbor = m_Neighbors[n];
+          for(int32_t j = 0; j < 3; j++)
+          {
+            delta[j] += m_Src[3 * neighbor + j] - m_Src[3 * i + j];
+          }
+        }
+
+        float ll = m_Lambda[i] * m_Factor;
+        double distance = 0.0;
+        for(int32_t j = 0; j < 3; j++)
+        {
+          float value = static_cast<float>(m_Src[3 * i + j] + ll * (delta[j] / numNeighbors));
+          double moved = static_cast<double>(value) - m_Reference[3 * i + j];
+          distance += moved * moved;
+          m_Dst[3 * i + j] = value;
+        }
+        residual = std::max(residual, distance);
+      }
+      m_ChunkResiduals[chunk] = residual;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Src = nullptr;
+  float* m_Dst = nullptr;
+  const float* m_Reference = nullptr;
+  const std::vector<int64_t>& m_Offsets;
+  const std::vector<int64_t>& m_Neighbors;
+  const float* m_Lambda = nullptr;
+  float m_Factor = 1.0f;
+  int64_t m_NumVerts = 0;
+  int64_t m_ChunkSize = 1;
+  std::vector<double>& m_ChunkResiduals;
+};
+
+/**
+ * @brief runSmoothingStep Runs one smoothing step over all of the vertices and returns the largest distance any vertex moved
+ */
+double runSmoothingStep(const LaplacianSmoothingImpl& impl, size_t numChunks, const std::vector<double>& chunkResiduals)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool doParallel = true;
+  if(doParallel)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), impl, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    impl.convert(0, numChunks);
+  }
+  double residual = 0.0;
+  for(const double& chunkResidual : chunkResiduals)
+  {
+    residual = std::max(residual, chunkResidual);
+  }
+  return std::sqrt(residual);
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -66,6 +194,8 @@ LaplacianSmoothing::LaplacianSmoothing()
 , m_SurfaceQuadPointLambda(0.0f)
 , m_UseTaubinSmoothing(false)
 , m_MuFactor(-1.03f)
+, m_UseConvergenceTolerance(false)
+, m_ConvergenceTolerance(0.0001f)
 {
 }
 
@@ -89,6 +219,10 @@ void LaplacianSmoothing::setupFilterParameters()
   linkedProps << "MuFactor";
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Taubin Smoothing", UseTaubinSmoothing, FilterParameter::Parameter, LaplacianSmoothing, linkedProps));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Mu Factor", MuFactor, FilterParameter::Parameter, LaplacianSmoothing));
+  linkedProps.clear();
+  linkedProps << "ConvergenceTolerance";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stop When Converged", UseConvergenceTolerance, FilterParameter::Parameter, LaplacianSmoothing, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Convergence Tolerance", ConvergenceTolerance, FilterParameter::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Triple Line Lambda", TripleLineLambda, FilterParameter::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Quadruple Points Lambda", QuadPointLambda, FilterParameter::Parameter, LaplacianSmoothing));
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Outer Points Lambda", SurfacePointLambda, FilterParameter::Parameter, LaplacianSmoothing));
@@ -126,6 +260,8 @@ void LaplacianSmoothing::readFilterParameters(AbstractFilterParametersReader* re
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath()));
   setUseTaubinSmoothing(reader->readValue("UseTaubinSmoothing", getUseTaubinSmoothing()));
   setMuFactor(reader->readValue("MuFactor", getMuFactor()));
+  setUseConvergenceTolerance(reader->readValue("UseConvergenceTolerance", getUseConvergenceTolerance()));
+  setConvergenceTolerance(reader->readValue("ConvergenceTolerance", getConvergenceTolerance()));
   reader->closeFilterGroup();
 }
 
@@ -301,16 +437,40 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   int64_t* uedges = surfaceMesh->getEdgePointer(0);
   int64_t nedges = surfaceMesh->getNumberOfEdges();
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array");
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
+  // Build the vertex centered (CSR) adjacency once from the unique edges
+  std::vector<int64_t> offsets(nvert + 1, 0);
+  for(int64_t i = 0; i < nedges; i++)
+  {
+    offsets[uedges[2 * i] + 1]++;
+    offsets[uedges[2 * i + 1] + 1]++;
+  }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+  std::vector<int64_t> neighbors(offsets[nvert], 0);
+  {
+    std::vector<int64_t> cursor(offsets.begin(), offsets.end() - 1);
+    for(int64_t i = 0; i < nedges; i++)
+    {
+      int64_t in1 = uedges[2 * i];     // row of the first vertex
+      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
+      Q_ASSERT(in1 < nvert && in2 < nvert);
+      neighbors[cursor[in1]++] = in2;
+      neighbors[cursor[in2]++] = in1;
+    }
+  }
+
+  // The new positions are written into a second buffer so every step only reads the positions of the previous step
+  std::vector<float> smoothed(static_cast<size_t>(nvert * 3), 0.0f);
+  const int64_t chunkSize = 4096;
+  size_t numChunks = static_cast<size_t>((nvert + chunkSize - 1) / chunkSize);
+  std::vector<double> chunkResiduals(numChunks, 0.0);
 
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+#endif
 
-  double dlta = 0.0;
   for(int32_t q = 0; q < m_IterationSteps; q++)
   {
     if(getCancel())
@@ -319,85 +479,34 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
     }
     QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    // Compute the Deltas for each point
-    for(int64_t i = 0; i < nedges; i++)
-    {
-      int64_t in1 = uedges[2 * i];     // row of the first vertex
-      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(int32_t j = 0; j < 3; j++)
-      {
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-        dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
-      }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
-    }
 
-    // Move each point
-    float ll = 0.0f;
-    for(int64_t i = 0; i < nvert; i++)
-    {
-      for(int32_t j = 0; j < 3; j++)
-      {
-        int64_t in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
-
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
-      }
-      ncon[i] = 0; // reset for next iteration
-    }
+    // Compute the Deltas for each point and move it
+    LaplacianSmoothingImpl lambdaStep(verts, smoothed.data(), verts, offsets, neighbors, lambda, 1.0f, nvert, chunkSize, chunkResiduals);
+    double residual = runSmoothingStep(lambdaStep, numChunks, chunkResiduals);
 
     // Now optionally apply a negative lambda based on the mu Factor value.
     // This is from Taubin's paper on smoothing without shrinkage. This effectively
     // runs a low pass filter on the data
     if(m_UseTaubinSmoothing)
     {
-
       if(getCancel())
       {
         return -1;
       }
-      QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      // Compute the Delta's
-      for(int64_t i = 0; i < nedges; i++)
-      {
-        int64_t in1 = uedges[2 * i];     // row of the first vertex
-        int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          delta[3 * in1 + j] += dlta;
-          delta[3 * in2 + j] += -1.0 * dlta;
-        }
-        ncon[in1] += 1;
-        ncon[in2] += 1;
-      }
-
-      // MOve the points
-      float ll = 0.0f;
-      for(int64_t i = 0; i < nvert; i++)
-      {
-        for(int32_t j = 0; j < 3; j++)
-        {
-          int64_t in0 = 3 * i + j;
-          dlta = delta[in0] / ncon[i];
+      // The residual is measured against the positions at the start of the iteration
+      LaplacianSmoothingImpl muStep(smoothed.data(), verts, verts, offsets, neighbors, lambda, m_MuFactor, nvert, chunkSize, chunkResiduals);
+      residual = runSmoothingStep(muStep, numChunks, chunkResiduals);
+    }
+    else
+    {
+      std::copy(smoothed.begin(), smoothed.end(), verts);
+    }
 
-          ll = lambda[i] * m_MuFactor;
-          verts[3 * i + j] += ll * dlta;
-          delta[in0] = 0.0; // reset for next iteration
-        }
-        ncon[i] = 0; // reset for next iteration
-      }
+    if(m_UseConvergenceTolerance && residual < static_cast<double>(m_ConvergenceTolerance))
+    {
+      ss = QObject::tr("Converged after %1 of %2 iterations").arg(q + 1).arg(m_IterationSteps);
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      break;
     }
   }
 
@@ -64,6 +64,8 @@ class SurfaceMeshing_EXPORT LaplacianSmoothing : public SurfaceMeshFilter
     PYB11_PROPERTY(float SurfaceQuadPointLambda READ getSurfaceQuadPointLambda WRITE setSurfaceQuadPointLambda)
     PYB11_PROPERTY(bool UseTaubinSmoothing READ getUseTaubinSmoothing WRITE setUseTaubinSmoothing)
     PYB11_PROPERTY(float MuFactor READ getMuFactor WRITE setMuFactor)
+    PYB11_PROPERTY(bool UseConvergenceTolerance READ getUseConvergenceTolerance WRITE setUseConvergenceTolerance)
+    PYB11_PROPERTY(float ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
 public:
   SIMPL_SHARED_POINTERS(LaplacianSmoothing)
   SIMPL_FILTER_NEW_MACRO(LaplacianSmoothing)
@@ -107,6 +109,12 @@ public:
    SIMPL_FILTER_PARAMETER(float, MuFactor)
    Q_PROPERTY(float MuFactor READ getMuFactor WRITE setMuFactor)
 
+   SIMPL_FILTER_PARAMETER(bool, UseConvergenceTolerance)
+   Q_PROPERTY(bool UseConvergenceTolerance READ getUseConvergenceTolerance WRITE setUseConvergenceTolerance)
+
+   SIMPL_FILTER_PARAMETER(float, ConvergenceTolerance)
+   Q_PROPERTY(float ConvergenceTolerance READ getConvergenceTolerance WRITE setConvergenceTolerance)
+
    /* This class is designed to be subclassed so that thoes subclasses can add
     * more functionality such as constrained surface nodes or Triple Lines. We use
     * this array to assign each vertex a specific Lambda value. Subclasses can set
@@ -58,6 +58,13 @@
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 namespace
 {
 template <class T> inline void hashCombine(size_t& seed, const T& obj)
@@ -92,8 +99,258 @@ struct EdgeHasher
 
 using VertexMap = std::unordered_map<Vertex, int64_t, VertexHasher>;
 using EdgeMap = std::unordered_map<Edge, int64_t, EdgeHasher>;
+
+/**
+ * @brief visitPlaneFaces calls the functor with the four node indices of every voxel face in plane k that
+ * will be turned into a pair of triangles. The faces (and the nodes of each face) are visited in the same
+ * order as the serial mesher visits them, so numbering the nodes in the order they are seen reproduces
+ * the serial node numbering.
+ */
+template <typename Functor> void visitPlaneFaces(const int32_t* featureIds, const int64_t dims[3], int64_t k, Functor& functor)
+{
+  const int64_t xP = dims[0];
+  const int64_t yP = dims[1];
+  const int64_t zP = dims[2];
+  const int64_t nodePlane = (xP + 1) * (yP + 1);
+
+  for(int64_t j = 0; j < yP; j++)
+  {
+    for(int64_t i = 0; i < xP; i++)
+    {
+      int64_t point = (k * xP * yP) + (j * xP) + i;
+      // nXYZ is the node at (i + X, j + Y, k + Z)
+      int64_t n000 = (k * nodePlane) + (j * (xP + 1)) + i;
+      int64_t n100 = n000 + 1;
+      int64_t n010 = n000 + (xP + 1);
+      int64_t n110 = n010 + 1;
+      int64_t n001 = n000 + nodePlane;
+      int64_t n101 = n001 + 1;
+      int64_t n011 = n001 + (xP + 1);
+      int64_t n111 = n011 + 1;
+
+      if(i == 0)
+      {
+        functor(n000, n010, n001, n011);
+      }
+      if(j == 0)
+      {
+        functor(n000, n100, n001, n101);
+      }
+      if(k == 0)
+      {
+        functor(n000, n100, n010, n110);
+      }
+      if(i == (xP - 1) || featureIds[point] != featureIds[point + 1])
+      {
+        functor(n100, n110, n101, n111);
+      }
+      if(j == (yP - 1) || featureIds[point] != featureIds[point + xP])
+      {
+        functor(n110, n010, n111, n011);
+      }
+      if(k == (zP - 1) || featureIds[point] != featureIds[point + (xP * yP)])
+      {
+        functor(n101, n001, n111, n011);
+      }
+    }
+  }
+}
+
+/**
+ * @brief The DetermineActiveNodesImpl class numbers the active nodes of the mesh one z plane of voxels at a time.
+ * A node is owned by the lowest plane of voxels that touches it. The first pass marks the nodes on the top of
+ * each plane that the plane touches, the second pass numbers the nodes owned by each plane in visiting order
+ * (starting at 0) and counts the triangles of each plane, and the last pass shifts the numbers of each node
+ * plane by the node offsets of the owning planes. Every pass only writes to nodes owned by a single plane.
+ */
+class DetermineActiveNodesImpl
+{
+public:
+  enum class Pass : int32_t
+  {
+    MarkTouchedFromBelow = 0,
+    NumberNodes = 1,
+    OffsetNodes = 2
+  };
+
+  DetermineActiveNodesImpl(const int32_t* featureIds, const int64_t dims[3], Pass pass, int64_t* nodeIds, uint8_t* touchedFromBelow, int64_t* planeNodeCounts, int64_t* planeTriangleCounts,
+                           const int64_t* planeNodeOffsets)
+  : m_FeatureIds(featureIds)
+  , m_Pass(pass)
+  , m_NodeIds(nodeIds)
+  , m_TouchedFromBelow(touchedFromBelow)
+  , m_PlaneNodeCounts(planeNodeCounts)
+  , m_PlaneTriangleCounts(planeTriangleCounts)
+  , m_PlaneNodeOffsets(planeNodeOffsets)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~DetermineActiveNodesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    const int64_t nodePlane = (m_Dims[0] + 1) * (m_Dims[1] + 1);
+    for(size_t plane = start; plane < end; plane++)
+    {
+      int64_t k = static_cast<int64_t>(plane);
+      // The first node of node plane k + 1, which is the top of voxel plane k
+      int64_t topNodes = (k + 1) * nodePlane;
+
+      if(m_Pass == Pass::MarkTouchedFromBelow)
+      {
+        uint8_t* touchedFromBelow = m_TouchedFromBelow;
+        auto markNodes = [touchedFromBelow, topNodes](int64_t n1, int64_t n2, int64_t n3, int64_t n4) {
+          int64_t nodes[4] = {n1, n2, n3, n4};
+          for(const int64_t& n : nodes)
+          {
+            if(n >= topNodes)
+            {
+              touchedFromBelow[n] = 1;
+            }
+          }
+        };
+        visitPlaneFaces(m_FeatureIds, m_Dims, k, markNodes);
+      }
+      else if(m_Pass == Pass::NumberNodes)
+      {
+        int64_t nodeCount = 0;
+        int64_t triangleCount = 0;
+        int64_t* nodeIds = m_NodeIds;
+        const uint8_t* touchedFromBelow = m_TouchedFromBelow;
+        auto numberNodes = [nodeIds, touchedFromBelow, topNodes, &nodeCount, &triangleCount](int64_t n1, int64_t n2, int64_t n3, int64_t n4) {
+          int64_t nodes[4] = {n1, n2, n3, n4};
+          for(const int64_t& n : nodes)
+          {
+            // Nodes on the bottom of the plane that the plane below touched belong to that plane
+            if(n < topNodes && touchedFromBelow[n] != 0)
+            {
+              continue;
+            }
+            if(nodeIds[n] == -1)
+            {
+              nodeIds[n] = nodeCount;
+              nodeCount++;
+            }
+          }
+          triangleCount += 2;
+        };
+        visitPlaneFaces(m_FeatureIds, m_Dims, k, numberNodes);
+        m_PlaneNodeCounts[k] = nodeCount;
+        m_PlaneTriangleCounts[k] = triangleCount;
+      }
+      else
+      {
+        // Here the range runs over the node planes instead of the voxel planes
+        for(int64_t n = k * nodePlane; n < (k + 1) * nodePlane; n++)
+        {
+          if(m_NodeIds[n] >= 0)
+          {
+            int64_t owner = (k > 0 && m_TouchedFromBelow[n] != 0) ? k - 1 : k;
+            m_NodeIds[n] += m_PlaneNodeOffsets[owner];
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  Pass m_Pass = Pass::MarkTouchedFromBelow;
+  int64_t* m_NodeIds = nullptr;
+  uint8_t* m_TouchedFromBelow = nullptr;
+  int64_t* m_PlaneNodeCounts = nullptr;
+  int64_t* m_PlaneTriangleCounts = nullptr;
+  const int64_t* m_PlaneNodeOffsets = nullptr;
+};
 } // namespace
 
+/**
+ * @brief The CreateNodesAndTrianglesImpl class creates the nodes and triangles of every other z plane of voxels,
+ * starting at the given parity. Planes two apart do not share any nodes, so the planes of one parity can
+ * be meshed at the same time. Each plane writes its triangles starting at its own triangle offset.
+ */
+class CreateNodesAndTrianglesImpl
+{
+public:
+  CreateNodesAndTrianglesImpl(QuickSurfaceMesh* filter, const std::vector<int64_t>& nodeIds, const std::vector<int64_t>& triangleOffsets, std::vector<QuickSurfaceMesh::NodeOwnerList>& ownerLists,
+                              int64_t parity)
+  : m_Filter(filter)
+  , m_NodeIds(nodeIds)
+  , m_TriangleOffsets(triangleOffsets)
+  , m_OwnerLists(ownerLists)
+  , m_Parity(parity)
+  {
+  }
+
+  virtual ~CreateNodesAndTrianglesImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      int64_t k = static_cast<int64_t>(2 * slab) + m_Parity;
+      m_Filter->createNodesAndTrianglesInPlane(k, m_NodeIds, m_TriangleOffsets[k], m_OwnerLists);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  QuickSurfaceMesh* m_Filter = nullptr;
+  const std::vector<int64_t>& m_NodeIds;
+  const std::vector<int64_t>& m_TriangleOffsets;
+  std::vector<QuickSurfaceMesh::NodeOwnerList>& m_OwnerLists;
+  int64_t m_Parity = 0;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::NodeOwnerList::insert(int32_t featureId)
+{
+  if(featureId == -1)
+  {
+    m_OnBoundary = true;
+  }
+  for(int8_t i = 0; i < m_Count; i++)
+  {
+    if(m_FeatureIds[i] == featureId)
+    {
+      return;
+    }
+  }
+  // The node type saturates at 4 owners so there is no need to store more than that
+  if(m_Count < 4)
+  {
+    m_FeatureIds[m_Count] = featureId;
+    m_Count++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int8_t QuickSurfaceMesh::NodeOwnerList::getNodeType() const
+{
+  return m_OnBoundary ? static_cast<int8_t>(m_Count + 10) : m_Count;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -628,7 +885,7 @@ void QuickSurfaceMesh::correctProblemVoxels()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<int64_t>& m_NodeIds, int64_t& nodeCount, int64_t& triangleCount)
+void QuickSurfaceMesh::determineActiveNodes(std::vector<int64_t>& m_NodeIds, std::vector<int64_t>& triangleOffsets, int64_t& nodeCount, int64_t& triangleCount)
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
@@ -643,299 +900,54 @@ void QuickSurfaceMesh::determineActiveNodes(std::vector<int64_t>& m_NodeIds, int
       static_cast<int64_t>(udims[2]),
   };
 
-  int64_t xP = dims[0];
-  int64_t yP = dims[1];
   int64_t zP = dims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
+  std::vector<uint8_t> touchedFromBelow(m_NodeIds.size(), 0);
+  std::vector<int64_t> planeNodeCounts(zP, 0);
+  std::vector<int64_t> planeTriangleCounts(zP, 0);
+  std::vector<int64_t> planeNodeOffsets(zP, 0);
 
-  int64_t point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  int64_t nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
   // first determining which nodes are actually boundary nodes and
   // count number of nodes and triangles that will be created
-  for(int64_t k = 0; k < zP; k++)
+  DetermineActiveNodesImpl::Pass passes[3] = {DetermineActiveNodesImpl::Pass::MarkTouchedFromBelow, DetermineActiveNodesImpl::Pass::NumberNodes, DetermineActiveNodesImpl::Pass::OffsetNodes};
+  for(const DetermineActiveNodesImpl::Pass& pass : passes)
   {
-    for(int64_t j = 0; j < yP; j++)
+    if(pass == DetermineActiveNodesImpl::Pass::OffsetNodes)
     {
-      for(int64_t i = 0; i < xP; i++)
+      // Each plane's nodes and triangles follow those of the planes below it, just like the serial scan
+      for(int64_t k = 0; k < zP; k++)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId1] == -1)
-          {
-            m_NodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(m_NodeIds[nodeId2] == -1)
-          {
-            m_NodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(m_NodeIds[nodeId3] == -1)
-          {
-            m_NodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(m_NodeIds[nodeId4] == -1)
-          {
-            m_NodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
+        planeNodeOffsets[k] = nodeCount;
+        triangleOffsets[k] = triangleCount;
+        nodeCount += planeNodeCounts[k];
+        triangleCount += planeTriangleCounts[k];
       }
     }
+    // The offset pass runs over the zP + 1 node planes
+    size_t numPlanes = static_cast<size_t>(pass == DetermineActiveNodesImpl::Pass::OffsetNodes ? zP + 1 : zP);
+    DetermineActiveNodesImpl impl(m_FeatureIds, dims, pass, m_NodeIds.data(), touchedFromBelow.data(), planeNodeCounts.data(), planeTriangleCounts.data(), planeNodeOffsets.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPlanes), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numPlanes);
+    }
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<int64_t> m_NodeIds, int64_t nodeCount, int64_t triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(const std::vector<int64_t>& m_NodeIds, const std::vector<int64_t>& triangleOffsets, int64_t nodeCount, int64_t triangleCount)
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
@@ -959,6 +971,62 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<int64_t> m_NodeIds, i
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = grid->getDimensions();
 
+  int64_t zP = static_cast<int64_t>(udims[2]);
+
+  QVector<size_t> tDims(1, nodeCount);
+  sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays(tDims);
+  tDims[0] = triangleCount;
+  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+
+  updateVertexInstancePointers();
+  updateFaceInstancePointers();
+
+  std::vector<NodeOwnerList> ownerLists(nodeCount);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle.
+  // The even planes are meshed first and then the odd planes, so two planes that share nodes never run at the same time.
+  for(int64_t parity = 0; parity < 2; parity++)
+  {
+    size_t numSlabs = static_cast<size_t>((zP - parity + 1) / 2);
+    CreateNodesAndTrianglesImpl impl(this, m_NodeIds, triangleOffsets, ownerLists, parity);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.convert(0, numSlabs);
+    }
+  }
+
+  for(int64_t i = 0; i < nodeCount; i++)
+  {
+    m_NodeTypes[i] = ownerLists[i].getNodeType();
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void QuickSurfaceMesh::createNodesAndTrianglesInPlane(int64_t k, const std::vector<int64_t>& m_NodeIds, int64_t triangleIndex, std::vector<NodeOwnerList>& ownerLists)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
+
+  IGeometryGrid::Pointer grid = m->getGeometryAs<IGeometryGrid>();
+
+  size_t udims[3] = {0, 0, 0};
+  std::tie(udims[0], udims[1], udims[2]) = grid->getDimensions();
+
   int64_t dims[3] = {
       static_cast<int64_t>(udims[0]),
       static_cast<int64_t>(udims[1]),
@@ -969,8 +1037,6 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<int64_t> m_NodeIds, i
   int64_t yP = dims[1];
   int64_t zP = dims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
   int64_t point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
 
   int64_t nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
@@ -981,573 +1047,542 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<int64_t> m_NodeIds, i
 
   float* vertex = triangleGeom->getVertexPointer(0);
   int64_t* triangle = triangleGeom->getTriPointer(0);
+  for(int64_t j = 0; j < yP; j++)
+  {
+    for(int64_t i = 0; i < xP; i++)
+    {
+      point = (k * xP * yP) + (j * xP) + i;
+      neigh1 = point + 1; // <== What happens if we are at the end of a row?
+      neigh2 = point + xP;
+      neigh3 = point + (xP * yP);
 
-  QVector<size_t> tDims(1, nodeCount);
-  sm->getAttributeMatrix(getVertexAttributeMatrixName())->resizeAttributeArrays(tDims);
-  tDims[0] = triangleCount;
-  sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
+      if(i == 0)
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
 
-  updateVertexInstancePointers();
-  updateFaceInstancePointers();
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
 
-  ownerLists.resize(nodeCount);
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
 
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  int64_t triangleIndex = 0;
-  for(int64_t k = 0; k < zP; k++)
-  {
-    for(int64_t j = 0; j < yP; j++)
-    {
-      for(int64_t i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-        if(i == 0)
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+        triangleIndex++;
 
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        triangleIndex++;
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      if(j == 0)
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
 
-          triangleIndex++;
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
+        triangleIndex++;
 
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        triangleIndex++;
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      if(k == 0)
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
 
-          triangleIndex++;
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId3] * 3));
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId4] * 3));
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
+        triangleIndex++;
 
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId3] * 3));
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId4] * 3));
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        triangleIndex++;
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      if(i == (xP - 1)) // Takes care of the end of a Row...
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
 
-          triangleIndex++;
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          triangleIndex++;
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
+
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh1;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh1])
+        {
+          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
+          cIndex1 = point;
+          cIndex2 = neigh1;
+        }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          triangleIndex++;
+        triangleIndex++;
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh1;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh1])
+        {
+          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
+          cIndex1 = point;
+          cIndex2 = neigh1;
         }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
+
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+        triangleIndex++;
 
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
+      }
+      if(j == (yP - 1)) // Takes care of the end of a column
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh1;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
-            cIndex1 = point;
-            cIndex2 = neigh1;
-          }
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh1;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
-            cIndex1 = point;
-            cIndex2 = neigh1;
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+        triangleIndex++;
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
-        }
-        if(j == (yP - 1)) // Takes care of the end of a column
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
+      {
+        nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
+
+        nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh2;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh2])
+        {
           triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
           triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
+          cIndex1 = point;
+          cIndex2 = neigh2;
+        }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          triangleIndex++;
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh2;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh2])
+        {
           triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
           triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
+          cIndex1 = point;
+          cIndex2 = neigh2;
         }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
+
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
+        triangleIndex++;
 
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
+      }
+      if(k == (zP - 1)) // Takes care of the end of a Pillar
+      {
+        nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh2;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
-            cIndex1 = point;
-            cIndex2 = neigh2;
-          }
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh2;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
-            cIndex1 = point;
-            cIndex2 = neigh2;
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+        triangleIndex++;
 
-          triangleIndex++;
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
+        m_FaceLabels[triangleIndex * 2] = -1;
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock(), true)
+        }
 
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(-1);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(-1);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(-1);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(-1);
+      }
+      else if(m_FeatureIds[point] != m_FeatureIds[neigh3])
+      {
+        nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
+
+        nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
+
+        nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
+        getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
+
+        nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
+        getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
+
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh3;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh3])
+        {
           triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
           triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
+          cIndex1 = point;
+          cIndex2 = neigh3;
+        }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          triangleIndex++;
+        triangleIndex++;
 
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
+        triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
+        triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
+        m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
+        m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
+        cIndex1 = neigh3;
+        cIndex2 = point;
+        if(m_FeatureIds[point] < m_FeatureIds[neigh3])
+        {
           triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
           triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
+          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
+          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
+          cIndex1 = point;
+          cIndex2 = neigh3;
         }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh3;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
-            cIndex1 = point;
-            cIndex2 = neigh3;
-          }
 
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh3;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
-            cIndex1 = point;
-            cIndex2 = neigh3;
-          }
-
-          for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
+        for(int32_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
+                                    m_CreatedWeakPtrVector[i].lock())
+        }
 
-          triangleIndex++;
+        triangleIndex++;
 
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
-        }
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
+        ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
       }
     }
   }
-
-  for(int64_t i = 0; i < nodeCount; i++)
-  {
-    m_NodeTypes[i] = ownerLists[i].size();
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
-  }
-
-  notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
 // -----------------------------------------------------------------------------
@@ -1593,24 +1628,23 @@ void QuickSurfaceMesh::execute()
   int64_t yP = dims[1];
   int64_t zP = dims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
   int64_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
   std::vector<int64_t> m_NodeIds(possibleNumNodes, -1);
+  std::vector<int64_t> triangleOffsets(zP, 0);
 
   int64_t nodeCount = 0;
   int64_t triangleCount = 0;
 
   correctProblemVoxels();
 
-  determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
+  determineActiveNodes(m_NodeIds, triangleOffsets, nodeCount, triangleCount);
 
   // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triangleCount);
   triangleGeom->resizeVertexList(nodeCount);
 
-  createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(m_NodeIds, triangleOffsets, nodeCount, triangleCount);
 
   int64_t* triangle = triangleGeom->getTriPointer(0);
 
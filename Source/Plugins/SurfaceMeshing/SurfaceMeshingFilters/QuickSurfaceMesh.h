@@ -219,9 +219,36 @@ private:
 
   void correctProblemVoxels();
 
-  void determineActiveNodes(std::vector<int64_t>& m_NodeIds, int64_t& nodeCount, int64_t& triangleCount);
+  /**
+   * @brief The NodeOwnerList class stores the unique Feature Ids (and -1 for the outside of the volume) that
+   * share a node. Only the first 4 Ids are kept since the node type saturates at 4 owners.
+   */
+  class NodeOwnerList
+  {
+  public:
+    void insert(int32_t featureId);
+    int8_t getNodeType() const;
+
+  private:
+    int32_t m_FeatureIds[4] = {0, 0, 0, 0};
+    int8_t m_Count = 0;
+    bool m_OnBoundary = false;
+  };
+
+  friend class CreateNodesAndTrianglesImpl;
 
-  void createNodesAndTriangles(std::vector<int64_t> m_NodeIds, int64_t nodeCount, int64_t triangleCount);
+  void determineActiveNodes(std::vector<int64_t>& m_NodeIds, std::vector<int64_t>& triangleOffsets, int64_t& nodeCount, int64_t& triangleCount);
+
+  void createNodesAndTriangles(const std::vector<int64_t>& m_NodeIds, const std::vector<int64_t>& triangleOffsets, int64_t nodeCount, int64_t triangleCount);
+
+  /**
+   * @brief createNodesAndTrianglesInPlane Creates the nodes and triangles of a single z plane of voxels
+   * @param k Index of the plane
+   * @param m_NodeIds Node numbers of the grid points
+   * @param triangleIndex Index of the first triangle of the plane
+   * @param ownerLists Feature Ids that share each node
+   */
+  void createNodesAndTrianglesInPlane(int64_t k, const std::vector<int64_t>& m_NodeIds, int64_t triangleIndex, std::vector<NodeOwnerList>& ownerLists);
 
   /**
    * @brief updateFaceInstancePointers Updates raw Face pointers
@@ -0,0 +1,390 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+namespace LaplacianSmoothingTestConsts
+{
+const size_t k_XVerts = 7;
+const size_t k_YVerts = 6;
+const float k_Lambda = 0.25f;
+const float k_TripleLineLambda = 0.1f;
+const float k_QuadPointLambda = 0.05f;
+const float k_SurfacePointLambda = 0.02f;
+const float k_MuFactor = -1.03f;
+} // namespace LaplacianSmoothingTestConsts
+
+class LaplacianSmoothingTest
+{
+
+public:
+  LaplacianSmoothingTest() = default;
+  virtual ~LaplacianSmoothingTest() = default;
+
+  SIMPL_TYPE_MACRO(LaplacianSmoothingTest)
+
+  LaplacianSmoothingTest(const LaplacianSmoothingTest&) = delete;            // Copy Constructor Not Implemented
+  LaplacianSmoothingTest(LaplacianSmoothingTest&&) = delete;                 // Move Constructor Not Implemented
+  LaplacianSmoothingTest& operator=(const LaplacianSmoothingTest&) = delete; // Copy Assignment Not Implemented
+  LaplacianSmoothingTest& operator=(LaplacianSmoothingTest&&) = delete;      // Move Assignment Not Implemented
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The LaplacianSmoothingTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates a bumpy sheet of 7 x 6 nodes split into two triangles per quad. The border
+  // nodes are surface nodes, the middle row is a triple line and one node on that row
+  // is a quadruple point, so every lambda value of the filter is used.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createMesh()
+  {
+    using namespace LaplacianSmoothingTestConsts;
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addDataContainer(tdc);
+
+    size_t numVerts = k_XVerts * k_YVerts;
+    size_t numTris = 2 * (k_XVerts - 1) * (k_YVerts - 1);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+
+    QVector<size_t> tDims(1, numVerts);
+    AttributeMatrix::Pointer vertAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::VertexAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    tdc->addAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName, vertAttrMat);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(numVerts, SIMPL::VertexData::SurfaceMeshNodeType);
+    vertAttrMat->addAttributeArray(SIMPL::VertexData::SurfaceMeshNodeType, nodeTypes);
+
+    for(size_t y = 0; y < k_YVerts; y++)
+    {
+      for(size_t x = 0; x < k_XVerts; x++)
+      {
+        size_t v = y * k_XVerts + x;
+        vertices[3 * v + 0] = static_cast<float>(x) + 0.1f * static_cast<float>((v * 5) % 3);
+        vertices[3 * v + 1] = static_cast<float>(y) - 0.1f * static_cast<float>((v * 7) % 4);
+        vertices[3 * v + 2] = 0.3f * static_cast<float>((v * 11) % 5);
+
+        int8_t nodeType = SIMPL::SurfaceMesh::NodeType::Default;
+        if(x == 0 || y == 0 || x == k_XVerts - 1 || y == k_YVerts - 1)
+        {
+          nodeType = SIMPL::SurfaceMesh::NodeType::SurfaceDefault;
+        }
+        else if(y == 2)
+        {
+          nodeType = (x == 3) ? SIMPL::SurfaceMesh::NodeType::QuadPoint : SIMPL::SurfaceMesh::NodeType::TriplePoint;
+        }
+        nodeTypes->setValue(v, nodeType);
+      }
+    }
+
+    tDims[0] = numTris;
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    tdc->addAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName, faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    faceAttrMat->addAttributeArray(SIMPL::FaceData::SurfaceMeshFaceLabels, faceLabels);
+
+    size_t t = 0;
+    for(size_t y = 0; y < k_YVerts - 1; y++)
+    {
+      for(size_t x = 0; x < k_XVerts - 1; x++)
+      {
+        int64_t v0 = static_cast<int64_t>(y * k_XVerts + x);
+        int64_t v1 = v0 + 1;
+        int64_t v2 = v0 + static_cast<int64_t>(k_XVerts);
+        int64_t v3 = v2 + 1;
+        int32_t label = (y < 2) ? 1 : 2;
+
+        tris[3 * t + 0] = v0;
+        tris[3 * t + 1] = v1;
+        tris[3 * t + 2] = v2;
+        faceLabels->setComponent(t, 0, label);
+        faceLabels->setComponent(t, 1, label + 1);
+        t++;
+
+        tris[3 * t + 0] = v1;
+        tris[3 * t + 1] = v3;
+        tris[3 * t + 2] = v2;
+        faceLabels->setComponent(t, 0, label);
+        faceLabels->setComponent(t, 1, label + 1);
+        t++;
+      }
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The edge scatter smoothing loop the filter ran before the vertex gather
+  // -----------------------------------------------------------------------------
+  void ReferenceSmoothing(std::vector<float>& verts, const int64_t* uedges, int64_t nedges, const std::vector<float>& lambda, int32_t iterationSteps, bool useTaubin, float muFactor,
+                          float tolerance)
+  {
+    int64_t nvert = static_cast<int64_t>(lambda.size());
+    std::vector<int32_t> ncon(lambda.size(), 0);
+    std::vector<double> delta(3 * lambda.size(), 0.0);
+    int32_t numSteps = useTaubin ? 2 : 1;
+    for(int32_t q = 0; q < iterationSteps; q++)
+    {
+      std::vector<float> start = verts;
+      for(int32_t step = 0; step < numSteps; step++)
+      {
+        float factor = (step == 0) ? 1.0f : muFactor;
+        double dlta = 0.0;
+        for(int64_t i = 0; i < nedges; i++)
+        {
+          int64_t in1 = uedges[2 * i];
+          int64_t in2 = uedges[2 * i + 1];
+          for(int32_t j = 0; j < 3; j++)
+          {
+            dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
+            delta[3 * in1 + j] += dlta;
+            delta[3 * in2 + j] += -1.0 * dlta;
+          }
+          ncon[in1] += 1;
+          ncon[in2] += 1;
+        }
+        for(int64_t i = 0; i < nvert; i++)
+        {
+          float ll = (step == 0) ? lambda[i] : lambda[i] * factor;
+          for(int32_t j = 0; j < 3; j++)
+          {
+            int64_t in0 = 3 * i + j;
+            dlta = delta[in0] / ncon[i];
+            verts[in0] += ll * dlta;
+            delta[in0] = 0.0;
+          }
+          ncon[i] = 0;
+        }
+      }
+
+      if(tolerance > 0.0f)
+      {
+        double residual = 0.0;
+        for(int64_t i = 0; i < nvert; i++)
+        {
+          double distance = 0.0;
+          for(int32_t j = 0; j < 3; j++)
+          {
+            double moved = static_cast<double>(verts[3 * i + j]) - start[3 * i + j];
+            distance += moved * moved;
+          }
+          residual = std::max(residual, distance);
+        }
+        if(std::sqrt(residual) < static_cast<double>(tolerance))
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunSmoothing(int32_t iterationSteps, bool useTaubin, bool useConvergence, float tolerance)
+  {
+    using namespace LaplacianSmoothingTestConsts;
+    DataContainerArray::Pointer dca = createMesh();
+    DataContainer::Pointer tdc = dca->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    TriangleGeom::Pointer triangle = tdc->getGeometryAs<TriangleGeom>();
+    int64_t numVerts = triangle->getNumberOfVertices();
+    std::vector<float> expected(triangle->getVertexPointer(0), triangle->getVertexPointer(0) + 3 * numVerts);
+
+    QString filtName = "LaplacianSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer smoothFilter = factory->create();
+    DREAM3D_REQUIRE(smoothFilter.get() != nullptr)
+    smoothFilter->setDataContainerArray(dca);
+
+    bool propWasSet = true;
+    QVariant var;
+
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType));
+    propWasSet = smoothFilter->setProperty("SurfaceMeshNodeTypeArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels));
+    propWasSet = smoothFilter->setProperty("SurfaceMeshFaceLabelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(iterationSteps);
+    propWasSet = smoothFilter->setProperty("IterationSteps", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_Lambda);
+    propWasSet = smoothFilter->setProperty("Lambda", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_TripleLineLambda);
+    propWasSet = smoothFilter->setProperty("TripleLineLambda", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_QuadPointLambda);
+    propWasSet = smoothFilter->setProperty("QuadPointLambda", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_SurfacePointLambda);
+    propWasSet = smoothFilter->setProperty("SurfacePointLambda", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(useTaubin);
+    propWasSet = smoothFilter->setProperty("UseTaubinSmoothing", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(k_MuFactor);
+    propWasSet = smoothFilter->setProperty("MuFactor", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(useConvergence);
+    propWasSet = smoothFilter->setProperty("UseConvergenceTolerance", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(tolerance);
+    propWasSet = smoothFilter->setProperty("ConvergenceTolerance", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    smoothFilter->execute();
+    int32_t err = smoothFilter->getErrorCondition();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    // The filter created the unique edges, so the reference walks them in the same order
+    DREAM3D_REQUIRE_VALID_POINTER(triangle->getEdges().get())
+    Int8ArrayType::Pointer nodeTypes = tdc->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    std::vector<float> lambda(static_cast<size_t>(numVerts), 0.0f);
+    for(int64_t i = 0; i < numVerts; i++)
+    {
+      switch(nodeTypes->getValue(i))
+      {
+      case SIMPL::SurfaceMesh::NodeType::Default:
+        lambda[i] = k_Lambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::TriplePoint:
+        lambda[i] = k_TripleLineLambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::QuadPoint:
+        lambda[i] = k_QuadPointLambda;
+        break;
+      case SIMPL::SurfaceMesh::NodeType::SurfaceDefault:
+        lambda[i] = k_SurfacePointLambda;
+        break;
+      default:
+        break;
+      }
+    }
+    ReferenceSmoothing(expected, triangle->getEdgePointer(0), triangle->getNumberOfEdges(), lambda, iterationSteps, useTaubin, k_MuFactor, useConvergence ? tolerance : 0.0f);
+
+    float* verts = triangle->getVertexPointer(0);
+    for(int64_t i = 0; i < 3 * numVerts; i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(verts[i] - expected[i]) <= 1.0E-5f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLaplacianSmoothing()
+  {
+    return RunSmoothing(12, false, false, 0.0001f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTaubinSmoothing()
+  {
+    return RunSmoothing(12, true, false, 0.0001f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestConvergedSmoothing()
+  {
+    // Both runs stop well before the last iteration step
+    int err = RunSmoothing(500, false, true, 0.005f);
+    if(err != EXIT_SUCCESS)
+    {
+      return err;
+    }
+    return RunSmoothing(500, true, true, 0.001f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    std::cout << "---- " << getNameOfClass().toStdString() << " ----" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestLaplacianSmoothing())
+    DREAM3D_REGISTER_TEST(TestTaubinSmoothing())
+    DREAM3D_REGISTER_TEST(TestConvergedSmoothing())
+  }
+};
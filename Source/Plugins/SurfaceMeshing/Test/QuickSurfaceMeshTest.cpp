@@ -370,6 +370,380 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  // Meshes a 3 x 2 x 3 volume whose Features cross every z plane boundary, so the node
+  // ownership and triangle offsets of the parallel z slabs are exercised. The expected
+  // arrays were generated with the serial first-touch mesher that preceded the slabs.
+  // -----------------------------------------------------------------------------
+  int TestMultiPlaneMesh()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("MultiPlane");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {3, 2, 3};
+    image->setDimensions(dims);
+    dc->setGeometry(image);
+
+    QVector<size_t> tDims(1, 18);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(18, SIMPL::CellData::FeatureIds);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          int32_t feature = (x == 0) ? 1 : (z < 2 ? 2 : 3);
+          if(x == 2 && y == 1 && z == 0)
+          {
+            feature = 4;
+          }
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, feature);
+        }
+      }
+    }
+    cellAttrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIds);
+    dc->addAttributeMatrix("CellData", cellAttrMat);
+
+    tDims[0] = 5;
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, "CellFeatureData", AttributeMatrix::Type::CellFeature);
+    dc->addAttributeMatrix("CellFeatureData", featureAttrMat);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("QuickSurfaceMesh");
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet;
+    int err = 0;
+    DataArrayPath featureIdsPath("MultiPlane", "CellData", SIMPL::CellData::FeatureIds);
+    QString surfMeshName = "MultiPlaneSurfMesh";
+    QString tripleLineName = "MultiPlane TripleLines";
+    SET_FILTER_PROPERTY_WITH_CHECK(filter, "FeatureIdsArrayPath", featureIdsPath, err)
+    SET_FILTER_PROPERTY_WITH_CHECK(filter, "SurfaceDataContainerName", surfMeshName, err)
+    SET_FILTER_PROPERTY_WITH_CHECK(filter, "TripleLineDataContainerName", tripleLineName, err)
+    filter->execute();
+    err = filter->getErrorCondition();
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    const int64_t k_TriangleIndices[110][3] = {
+        /* 0 */ {0, 2, 1},
+        /* 1 */ {1, 2, 3},
+        /* 2 */ {0, 4, 2},
+        /* 3 */ {4, 5, 2},
+        /* 4 */ {0, 1, 4},
+        /* 5 */ {4, 1, 6},
+        /* 6 */ {4, 5, 6},
+        /* 7 */ {6, 5, 7},
+        /* 8 */ {4, 8, 5},
+        /* 9 */ {8, 9, 5},
+        /* 10 */ {4, 6, 8},
+        /* 11 */ {8, 6, 10},
+        /* 12 */ {8, 11, 9},
+        /* 13 */ {11, 12, 9},
+        /* 14 */ {8, 10, 11},
+        /* 15 */ {11, 10, 13},
+        /* 16 */ {11, 13, 12},
+        /* 17 */ {13, 14, 12},
+        /* 18 */ {13, 10, 14},
+        /* 19 */ {10, 15, 14},
+        /* 20 */ {1, 3, 16},
+        /* 21 */ {16, 3, 17},
+        /* 22 */ {1, 16, 6},
+        /* 23 */ {6, 16, 18},
+        /* 24 */ {6, 7, 18},
+        /* 25 */ {18, 7, 19},
+        /* 26 */ {18, 16, 19},
+        /* 27 */ {16, 17, 19},
+        /* 28 */ {6, 18, 10},
+        /* 29 */ {10, 18, 20},
+        /* 30 */ {10, 15, 20},
+        /* 31 */ {20, 15, 21},
+        /* 32 */ {20, 18, 21},
+        /* 33 */ {18, 19, 21},
+        /* 34 */ {10, 20, 13},
+        /* 35 */ {13, 20, 22},
+        /* 36 */ {13, 22, 14},
+        /* 37 */ {22, 23, 14},
+        /* 38 */ {22, 20, 23},
+        /* 39 */ {20, 21, 23},
+        /* 40 */ {14, 15, 23},
+        /* 41 */ {15, 21, 23},
+        /* 42 */ {2, 24, 3},
+        /* 43 */ {3, 24, 25},
+        /* 44 */ {2, 5, 24},
+        /* 45 */ {5, 26, 24},
+        /* 46 */ {5, 26, 7},
+        /* 47 */ {7, 26, 27},
+        /* 48 */ {5, 9, 26},
+        /* 49 */ {9, 28, 26},
+        /* 50 */ {28, 29, 26},
+        /* 51 */ {26, 29, 27},
+        /* 52 */ {9, 12, 28},
+        /* 53 */ {12, 30, 28},
+        /* 54 */ {12, 14, 30},
+        /* 55 */ {14, 31, 30},
+        /* 56 */ {30, 31, 28},
+        /* 57 */ {28, 31, 29},
+        /* 58 */ {3, 25, 17},
+        /* 59 */ {17, 25, 32},
+        /* 60 */ {7, 27, 19},
+        /* 61 */ {19, 27, 33},
+        /* 62 */ {19, 17, 33},
+        /* 63 */ {17, 32, 33},
+        /* 64 */ {21, 19, 34},
+        /* 65 */ {19, 33, 34},
+        /* 66 */ {29, 34, 27},
+        /* 67 */ {27, 34, 33},
+        /* 68 */ {14, 23, 31},
+        /* 69 */ {23, 35, 31},
+        /* 70 */ {23, 21, 35},
+        /* 71 */ {21, 34, 35},
+        /* 72 */ {31, 35, 29},
+        /* 73 */ {29, 35, 34},
+        /* 74 */ {24, 36, 25},
+        /* 75 */ {25, 36, 37},
+        /* 76 */ {24, 26, 36},
+        /* 77 */ {26, 38, 36},
+        /* 78 */ {26, 38, 27},
+        /* 79 */ {27, 38, 39},
+        /* 80 */ {38, 39, 36},
+        /* 81 */ {36, 39, 37},
+        /* 82 */ {26, 28, 38},
+        /* 83 */ {28, 40, 38},
+        /* 84 */ {40, 41, 38},
+        /* 85 */ {38, 41, 39},
+        /* 86 */ {28, 30, 40},
+        /* 87 */ {30, 42, 40},
+        /* 88 */ {30, 31, 42},
+        /* 89 */ {31, 43, 42},
+        /* 90 */ {42, 43, 40},
+        /* 91 */ {40, 43, 41},
+        /* 92 */ {25, 37, 32},
+        /* 93 */ {32, 37, 44},
+        /* 94 */ {27, 39, 33},
+        /* 95 */ {33, 39, 45},
+        /* 96 */ {33, 32, 45},
+        /* 97 */ {32, 44, 45},
+        /* 98 */ {39, 45, 37},
+        /* 99 */ {37, 45, 44},
+        /* 100 */ {34, 33, 46},
+        /* 101 */ {33, 45, 46},
+        /* 102 */ {41, 46, 39},
+        /* 103 */ {39, 46, 45},
+        /* 104 */ {31, 35, 43},
+        /* 105 */ {35, 47, 43},
+        /* 106 */ {35, 34, 47},
+        /* 107 */ {34, 46, 47},
+        /* 108 */ {43, 47, 41},
+        /* 109 */ {41, 47, 46},
+    };
+    const int32_t k_FaceLabels[110][2] = {
+        /* 0 */ {-1, 1},
+        /* 1 */ {-1, 1},
+        /* 2 */ {-1, 1},
+        /* 3 */ {-1, 1},
+        /* 4 */ {-1, 1},
+        /* 5 */ {-1, 1},
+        /* 6 */ {1, 2},
+        /* 7 */ {1, 2},
+        /* 8 */ {-1, 2},
+        /* 9 */ {-1, 2},
+        /* 10 */ {-1, 2},
+        /* 11 */ {-1, 2},
+        /* 12 */ {-1, 2},
+        /* 13 */ {-1, 2},
+        /* 14 */ {-1, 2},
+        /* 15 */ {-1, 2},
+        /* 16 */ {-1, 2},
+        /* 17 */ {-1, 2},
+        /* 18 */ {2, 4},
+        /* 19 */ {2, 4},
+        /* 20 */ {-1, 1},
+        /* 21 */ {-1, 1},
+        /* 22 */ {-1, 1},
+        /* 23 */ {-1, 1},
+        /* 24 */ {1, 2},
+        /* 25 */ {1, 2},
+        /* 26 */ {-1, 1},
+        /* 27 */ {-1, 1},
+        /* 28 */ {-1, 2},
+        /* 29 */ {-1, 2},
+        /* 30 */ {2, 4},
+        /* 31 */ {2, 4},
+        /* 32 */ {-1, 2},
+        /* 33 */ {-1, 2},
+        /* 34 */ {-1, 4},
+        /* 35 */ {-1, 4},
+        /* 36 */ {-1, 4},
+        /* 37 */ {-1, 4},
+        /* 38 */ {-1, 4},
+        /* 39 */ {-1, 4},
+        /* 40 */ {2, 4},
+        /* 41 */ {2, 4},
+        /* 42 */ {-1, 1},
+        /* 43 */ {-1, 1},
+        /* 44 */ {-1, 1},
+        /* 45 */ {-1, 1},
+        /* 46 */ {1, 2},
+        /* 47 */ {1, 2},
+        /* 48 */ {-1, 2},
+        /* 49 */ {-1, 2},
+        /* 50 */ {2, 3},
+        /* 51 */ {2, 3},
+        /* 52 */ {-1, 2},
+        /* 53 */ {-1, 2},
+        /* 54 */ {-1, 2},
+        /* 55 */ {-1, 2},
+        /* 56 */ {2, 3},
+        /* 57 */ {2, 3},
+        /* 58 */ {-1, 1},
+        /* 59 */ {-1, 1},
+        /* 60 */ {1, 2},
+        /* 61 */ {1, 2},
+        /* 62 */ {-1, 1},
+        /* 63 */ {-1, 1},
+        /* 64 */ {-1, 2},
+        /* 65 */ {-1, 2},
+        /* 66 */ {2, 3},
+        /* 67 */ {2, 3},
+        /* 68 */ {-1, 2},
+        /* 69 */ {-1, 2},
+        /* 70 */ {-1, 2},
+        /* 71 */ {-1, 2},
+        /* 72 */ {2, 3},
+        /* 73 */ {2, 3},
+        /* 74 */ {-1, 1},
+        /* 75 */ {-1, 1},
+        /* 76 */ {-1, 1},
+        /* 77 */ {-1, 1},
+        /* 78 */ {1, 3},
+        /* 79 */ {1, 3},
+        /* 80 */ {-1, 1},
+        /* 81 */ {-1, 1},
+        /* 82 */ {-1, 3},
+        /* 83 */ {-1, 3},
+        /* 84 */ {-1, 3},
+        /* 85 */ {-1, 3},
+        /* 86 */ {-1, 3},
+        /* 87 */ {-1, 3},
+        /* 88 */ {-1, 3},
+        /* 89 */ {-1, 3},
+        /* 90 */ {-1, 3},
+        /* 91 */ {-1, 3},
+        /* 92 */ {-1, 1},
+        /* 93 */ {-1, 1},
+        /* 94 */ {1, 3},
+        /* 95 */ {1, 3},
+        /* 96 */ {-1, 1},
+        /* 97 */ {-1, 1},
+        /* 98 */ {-1, 1},
+        /* 99 */ {-1, 1},
+        /* 100 */ {-1, 3},
+        /* 101 */ {-1, 3},
+        /* 102 */ {-1, 3},
+        /* 103 */ {-1, 3},
+        /* 104 */ {-1, 3},
+        /* 105 */ {-1, 3},
+        /* 106 */ {-1, 3},
+        /* 107 */ {-1, 3},
+        /* 108 */ {-1, 3},
+        /* 109 */ {-1, 3},
+    };
+    const float k_VertexCoords[48][3] = {
+        /* 0 */ {0.0f, 0.0f, 0.0f},
+        /* 1 */ {0.0f, 1.0f, 0.0f},
+        /* 2 */ {0.0f, 0.0f, 1.0f},
+        /* 3 */ {0.0f, 1.0f, 1.0f},
+        /* 4 */ {1.0f, 0.0f, 0.0f},
+        /* 5 */ {1.0f, 0.0f, 1.0f},
+        /* 6 */ {1.0f, 1.0f, 0.0f},
+        /* 7 */ {1.0f, 1.0f, 1.0f},
+        /* 8 */ {2.0f, 0.0f, 0.0f},
+        /* 9 */ {2.0f, 0.0f, 1.0f},
+        /* 10 */ {2.0f, 1.0f, 0.0f},
+        /* 11 */ {3.0f, 0.0f, 0.0f},
+        /* 12 */ {3.0f, 0.0f, 1.0f},
+        /* 13 */ {3.0f, 1.0f, 0.0f},
+        /* 14 */ {3.0f, 1.0f, 1.0f},
+        /* 15 */ {2.0f, 1.0f, 1.0f},
+        /* 16 */ {0.0f, 2.0f, 0.0f},
+        /* 17 */ {0.0f, 2.0f, 1.0f},
+        /* 18 */ {1.0f, 2.0f, 0.0f},
+        /* 19 */ {1.0f, 2.0f, 1.0f},
+        /* 20 */ {2.0f, 2.0f, 0.0f},
+        /* 21 */ {2.0f, 2.0f, 1.0f},
+        /* 22 */ {3.0f, 2.0f, 0.0f},
+        /* 23 */ {3.0f, 2.0f, 1.0f},
+        /* 24 */ {0.0f, 0.0f, 2.0f},
+        /* 25 */ {0.0f, 1.0f, 2.0f},
+        /* 26 */ {1.0f, 0.0f, 2.0f},
+        /* 27 */ {1.0f, 1.0f, 2.0f},
+        /* 28 */ {2.0f, 0.0f, 2.0f},
+        /* 29 */ {2.0f, 1.0f, 2.0f},
+        /* 30 */ {3.0f, 0.0f, 2.0f},
+        /* 31 */ {3.0f, 1.0f, 2.0f},
+        /* 32 */ {0.0f, 2.0f, 2.0f},
+        /* 33 */ {1.0f, 2.0f, 2.0f},
+        /* 34 */ {2.0f, 2.0f, 2.0f},
+        /* 35 */ {3.0f, 2.0f, 2.0f},
+        /* 36 */ {0.0f, 0.0f, 3.0f},
+        /* 37 */ {0.0f, 1.0f, 3.0f},
+        /* 38 */ {1.0f, 0.0f, 3.0f},
+        /* 39 */ {1.0f, 1.0f, 3.0f},
+        /* 40 */ {2.0f, 0.0f, 3.0f},
+        /* 41 */ {2.0f, 1.0f, 3.0f},
+        /* 42 */ {3.0f, 0.0f, 3.0f},
+        /* 43 */ {3.0f, 1.0f, 3.0f},
+        /* 44 */ {0.0f, 2.0f, 3.0f},
+        /* 45 */ {1.0f, 2.0f, 3.0f},
+        /* 46 */ {2.0f, 2.0f, 3.0f},
+        /* 47 */ {3.0f, 2.0f, 3.0f},
+    };
+    const int8_t k_NodeTypes[48] = {
+        12, 12, 12, 12, 13, 13, 13, 2, 12, 12, 13, 12, 12, 13, 13, 2, 12, 12, 13, 13, 13, 13, 12, 13,
+        12, 12, 14, 3, 13, 2, 13, 13, 12, 14, 13, 13, 12, 12, 13, 13, 12, 12, 12, 12, 12, 13, 12, 12,
+    };
+
+    DataContainer::Pointer surfDC = dca->getDataContainer(surfMeshName);
+    TriangleGeom::Pointer triangleGeom = surfDC->getGeometryAs<TriangleGeom>();
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfTris(), 110);
+    DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), 48);
+
+    Int32ArrayType::Pointer faceLabels = surfDC->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::FaceData::SurfaceMeshFaceLabels);
+    Int8ArrayType::Pointer nodeTypes = surfDC->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    DREAM3D_REQUIRE_VALID_POINTER(faceLabels.get())
+    DREAM3D_REQUIRE_VALID_POINTER(nodeTypes.get())
+
+    int64_t tri[3] = {0, 0, 0};
+    for(size_t t = 0; t < triangleGeom->getNumberOfTris(); t++)
+    {
+      triangleGeom->getVertsAtTri(t, tri);
+      DREAM3D_REQUIRE_EQUAL(tri[0], k_TriangleIndices[t][0]);
+      DREAM3D_REQUIRE_EQUAL(tri[1], k_TriangleIndices[t][1]);
+      DREAM3D_REQUIRE_EQUAL(tri[2], k_TriangleIndices[t][2]);
+      DREAM3D_REQUIRE_EQUAL(faceLabels->getComponent(t, 0), k_FaceLabels[t][0]);
+      DREAM3D_REQUIRE_EQUAL(faceLabels->getComponent(t, 1), k_FaceLabels[t][1]);
+    }
+
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t v = 0; v < triangleGeom->getNumberOfVertices(); v++)
+    {
+      triangleGeom->getCoords(v, coords);
+      DREAM3D_REQUIRE_EQUAL(coords[0], k_VertexCoords[v][0]);
+      DREAM3D_REQUIRE_EQUAL(coords[1], k_VertexCoords[v][1]);
+      DREAM3D_REQUIRE_EQUAL(coords[2], k_VertexCoords[v][2]);
+      DREAM3D_REQUIRE_EQUAL(nodeTypes->getValue(v), k_NodeTypes[v]);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -402,6 +776,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(TestMultiPlaneMesh())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
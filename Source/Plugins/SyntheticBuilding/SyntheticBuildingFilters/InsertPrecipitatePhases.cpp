@@ -330,6 +330,7 @@ void InsertPrecipitatePhases::initialize()
   m_EllipsoidOps = ShapeOps::NullPointer();
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   m_OrthoOps = OrthoRhombicOps::New();
+  m_AxisOdfTables.clear();
 
   m_Neighbors = nullptr;
   m_StatsDataArray = StatsDataArray::NullPointer();
@@ -889,10 +890,28 @@ void InsertPrecipitatePhases::place_precipitates(Int32ArrayType::Pointer exclusi
   m_FeatureSizeDist.resize(m_PrecipitatePhases.size());
   m_SimFeatureSizeDist.resize(m_PrecipitatePhases.size());
   m_FeatureSizeDistStep.resize(m_PrecipitatePhases.size());
+  m_AxisOdfTables.resize(numensembles);
   for(size_t i = 0; i < m_PrecipitatePhases.size(); i++)
   {
     phase = m_PrecipitatePhases[i];
     PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[phase]);
+    // The axis ODF of a phase does not change while precipitates are generated, so its sampling table is built once
+    FloatArrayType::Pointer axisodf = pp->getAxisOrientation();
+    if(!m_AxisOdfTables[phase].build(axisodf->getPointer(0), axisodf->getNumberOfTuples()))
+    {
+      QString ss = QObject::tr("The axis ODF of phase %1 has negative, non-finite or only zero weights").arg(phase);
+      setErrorCondition(-5011);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    if(!m_AxisOdfTables[phase].isNormalized())
+    {
+      QString ss = QObject::tr("The axis ODF weights of phase %1 sum to %2 instead of 1. Axis orientations are drawn as if the missing weight belonged to the first bin and weight past 1 is never drawn")
+                       .arg(phase)
+                       .arg(m_AxisOdfTables[phase].getWeightSum());
+      setWarningCondition(-5012);
+      notifyWarningMessage(getHumanLabel(), ss, getWarningCondition());
+    }
     m_FeatureSizeDist[i].resize(40);
     m_SimFeatureSizeDist[i].resize(40);
     m_FeatureSizeDistStep[i] = static_cast<float>(((2.0f * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / m_FeatureSizeDist[i].size());
@@ -1626,22 +1645,8 @@ void InsertPrecipitatePhases::generate_precipitate(int32_t phase, Precip_t* prec
     r2 = static_cast<float>(rg.genrand_beta(a2, b2));
     r3 = static_cast<float>(rg.genrand_beta(a3, b3));
   }
-  FloatArrayType::Pointer axisodf = pp->getAxisOrientation();
-  int32_t numbins = axisodf->getNumberOfTuples();
-  float random = static_cast<float>(rg.genrand_res53());
-  float totaldensity = 0.0f;
-  int32_t bin = 0;
-  for(int32_t j = 0; j < numbins; j++)
-  {
-    float density = axisodf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if(random < totaldensity && random >= td1)
-    {
-      bin = j;
-      break;
-    }
-  }
+  // The sampling table of the axis ODF is built for each precipitate phase before any precipitate is generated
+  int32_t bin = static_cast<int32_t>(m_AxisOdfTables[phase].sample(rg.genrand_res53()));
   FOrientArrayType eulers = OrthoOps->determineEulerAngles(m_Seed, bin);
   VectorOfFloatArray omega3 = pp->getFeatureSize_Omegas();
   float mf = omega3[0]->getValue(diameter);
@@ -39,6 +39,7 @@
 #include "OrientationLib/LaueOps/HexagonalOps.h"
 #include "OrientationLib/LaueOps/LaueOps.h"
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
+#include "OrientationLib/Texture/AliasTable.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Common/ShapeType.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
@@ -508,6 +509,7 @@ private:
   ShapeOps::Pointer m_EllipsoidOps;
   ShapeOps::Pointer m_SuperEllipsoidOps;
   OrthoRhombicOps::Pointer m_OrthoOps;
+  std::vector<AliasTable> m_AxisOdfTables;
 
   int64_t* m_Neighbors;
   StatsDataArray::WeakPointer m_StatsDataArray;
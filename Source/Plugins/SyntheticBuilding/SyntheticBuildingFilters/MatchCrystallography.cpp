@@ -35,6 +35,15 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -58,6 +67,53 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+namespace
+{
+// Kinds of trial moves of the swap/switch loop
+const int32_t k_NoFeatureTrial = 0;
+const int32_t k_SwapTrial = 1;
+const int32_t k_SwitchTrial = 2;
+
+// Number of trial moves that are drawn and evaluated together before they are committed one by one
+const int32_t k_TrialBatchSize = 256;
+} // namespace
+
+/**
+ * @brief The EvaluateSwapSwitchTrialsImpl class evaluates a batch of trial moves against the histograms as
+ * they were at the start of the batch
+ */
+class EvaluateSwapSwitchTrialsImpl
+{
+public:
+  EvaluateSwapSwitchTrialsImpl(const MatchCrystallography* filter, SwapSwitchTrial_t* trials, size_t ensem)
+  : m_Filter(filter)
+  , m_Trials(trials)
+  , m_Ensem(ensem)
+  {
+  }
+  virtual ~EvaluateSwapSwitchTrialsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Filter->evaluateTrial(m_Trials[i], m_Ensem);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const MatchCrystallography* m_Filter;
+  SwapSwitchTrial_t* m_Trials;
+  size_t m_Ensem;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -81,12 +137,14 @@ MatchCrystallography::MatchCrystallography()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
+  m_CurrentOdfError = m_CurrentMdfError = 0.0;
+  m_OdfErrorBins = m_MdfErrorBins = 0;
 
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
+  m_CurrentBatch = 0;
 
   m_OrientationOps = LaueOps::getOrientationOpsQVector();
 
@@ -205,7 +263,8 @@ void MatchCrystallography::initialize()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
+  m_CurrentOdfError = m_CurrentMdfError = 0.0;
+  m_OdfErrorBins = m_MdfErrorBins = 0;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -214,6 +273,10 @@ void MatchCrystallography::initialize()
   m_ActualMdf = FloatArrayType::NullPointer();
   m_SimMdf = FloatArrayType::NullPointer();
   m_MisorientationLists.clear();
+  m_CurrentBatch = 0;
+  m_FeatureBatches.clear();
+  m_SimOdfBatches.clear();
+  m_SimMdfBatches.clear();
 
   m_OrientationOps = LaueOps::getOrientationOpsQVector();
 }
@@ -483,6 +546,21 @@ void MatchCrystallography::initializeArrays(size_t ensem)
     return;
   }
 
+  if(!m_ActualOdfTable.build(m_ActualOdf->getPointer(0), m_ActualOdf->getNumberOfTuples()))
+  {
+    setErrorCondition(-55001);
+    QString ss = QObject::tr("The ODF of phase %1 has negative, non-finite or only zero weights").arg(ensem);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  if(!m_ActualOdfTable.isNormalized())
+  {
+    setWarningCondition(-55002);
+    QString ss = QObject::tr("The ODF weights of phase %1 sum to %2 instead of 1. Orientations are drawn as if the missing weight belonged to the first bin and weight past 1 is never drawn")
+                     .arg(ensem)
+                     .arg(m_ActualOdfTable.getWeightSum());
+    notifyWarningMessage(getHumanLabel(), ss, getWarningCondition());
+  }
   m_SimOdf = FloatArrayType::CreateArray(m_ActualOdf->getSize(), SIMPL::StringConstants::ODF);
   m_SimMdf = FloatArrayType::CreateArray(m_ActualMdf->getSize(), SIMPL::StringConstants::MisorientationBins);
   for(size_t j = 0; j < m_SimOdf->getSize(); j++)
@@ -577,7 +655,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 
   int32_t numbins = 0;
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  float random = 0.0f;
+  double random = 0.0;
   int32_t choose = 0, phase = 0;
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
@@ -591,7 +669,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
     if(phase == ensem)
     {
       m_Seed++;
-      random = static_cast<float>(rg.genrand_res53());
+      random = rg.genrand_res53();
 
       if(Ebsd::CrystalStructure::Cubic_High == m_CrystalStructures[phase])
       {
@@ -634,29 +712,22 @@ void MatchCrystallography::assign_eulers(size_t ensem)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
+int32_t MatchCrystallography::pick_euler(double random, int32_t numbins)
 {
-  int32_t choose = 0;
-  float totaldensity = 0.0f;
-
-  for(int32_t j = 0; j < numbins; j++)
+  // The table is built when the ODF for the phase is loaded and only needs to be redone if a
+  // different number of bins is asked for
+  size_t tableBins = std::min(static_cast<size_t>(numbins), m_ActualOdf->getNumberOfTuples());
+  if(m_ActualOdfTable.size() != tableBins)
   {
-    float density = m_ActualOdf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if(random < totaldensity && random >= td1)
-    {
-      choose = j;
-      break;
-    }
+    m_ActualOdfTable.build(m_ActualOdf->getPointer(0), tableBins);
   }
-  return choose;
+  return static_cast<int32_t>(m_ActualOdfTable.sample(random));
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
+void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2, float& mdfChange, std::vector<size_t>& mdfBins) const
 {
   float w = 0.0f;
   float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
@@ -686,12 +757,14 @@ void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j,
 
   FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
   newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
+  mdfBins.push_back(curmisobin);
+  mdfBins.push_back(newmisobin);
+  mdfChange = mdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
+                           ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
+                            (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
+  mdfChange = mdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
+                           ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
+                            (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
 }
 
 // -----------------------------------------------------------------------------
@@ -731,40 +804,335 @@ void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j,
   m_MisorientationLists[feature][3 * j] = miso1;
   m_MisorientationLists[feature][3 * j + 1] = miso2;
   m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
+  setSimMdfValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
+  setSimMdfValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::matchCrystallography(size_t ensem)
+void MatchCrystallography::computeHistogramErrors(size_t numbins)
+{
+  m_OdfErrorBins = std::min(numbins, m_ActualOdf->getNumberOfTuples());
+  m_MdfErrorBins = std::min(numbins, m_ActualMdf->getNumberOfTuples());
+
+  float* actualOdfPtr = m_ActualOdf->getPointer(0);
+  float* simOdfPtr = m_SimOdf->getPointer(0);
+  float* actualMdfPtr = m_ActualMdf->getPointer(0);
+  float* simMdfPtr = m_SimMdf->getPointer(0);
+  double delta = 0.0;
+
+  m_CurrentOdfError = 0.0;
+  for(size_t i = 0; i < m_OdfErrorBins; i++)
+  {
+    delta = actualOdfPtr[i] - simOdfPtr[i];
+    m_CurrentOdfError = m_CurrentOdfError + (delta * delta);
+  }
+  m_CurrentMdfError = 0.0;
+  for(size_t i = 0; i < m_MdfErrorBins; i++)
+  {
+    delta = actualMdfPtr[i] - simMdfPtr[i];
+    m_CurrentMdfError = m_CurrentMdfError + (delta * delta);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setSimOdfValue(size_t bin, float value)
+{
+  if(bin < m_OdfErrorBins)
+  {
+    double oldDelta = m_ActualOdf->getValue(bin) - m_SimOdf->getValue(bin);
+    double newDelta = m_ActualOdf->getValue(bin) - value;
+    m_CurrentOdfError = m_CurrentOdfError + (newDelta * newDelta) - (oldDelta * oldDelta);
+  }
+  m_SimOdf->setValue(bin, value);
+  m_SimOdfBatches[bin] = m_CurrentBatch;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setSimMdfValue(size_t bin, float value)
+{
+  if(bin < m_MdfErrorBins)
+  {
+    double oldDelta = m_ActualMdf->getValue(bin) - m_SimMdf->getValue(bin);
+    double newDelta = m_ActualMdf->getValue(bin) - value;
+    m_CurrentMdfError = m_CurrentMdfError + (newDelta * newDelta) - (oldDelta * oldDelta);
+  }
+  m_SimMdf->setValue(bin, value);
+  m_SimMdfBatches[bin] = m_CurrentBatch;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::evaluateTrial(SwapSwitchTrial_t& trial, size_t ensem) const
 {
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
   NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
   NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
+  uint32_t sym = m_CrystalStructures[ensem];
+
+  trial.m_Evaluated = true;
+  trial.m_OdfChange = 0.0f;
+  trial.m_MdfChange = 0.0f;
+  trial.m_MdfBins.clear();
+  if(trial.m_Type == k_NoFeatureTrial)
+  {
+    return;
+  }
+
+  QuatF q1;
+  QuatF q2;
+  FOrientArrayType rod(4, 0.0);
+  FOrientArrayType quat(4, 0.0);
+  int32_t feature1 = trial.m_Feature1;
+  int32_t feature2 = trial.m_Feature2;
+  float volume1 = m_Volumes[feature1] / m_UnbiasedVolume[ensem];
+
+  if(trial.m_Type == k_SwapTrial)
+  {
+    FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * feature1]), 3), rod);
+    trial.m_OdfBin1 = m_OrientationOps[sym]->getOdfBin(rod);
+
+    int32_t choose = trial.m_ChosenBin;
+    int32_t g1odfbin = trial.m_OdfBin1;
+    trial.m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
+                        ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + volume1)) * (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + volume1)));
+    trial.m_OdfChange = trial.m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
+                                             ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - volume1)) * (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - volume1))));
+
+    FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler1[0], trial.m_Euler1[1], trial.m_Euler1[2]), quat);
+    q1 = quat.toQuaternion();
+    size_t size = neighborlist[feature1].size();
+    for(size_t j = 0; j < size; j++)
+    {
+      int32_t neighbor = neighborlist[feature1][j];
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature1][j];
+      MC_LoopBody1(feature1, ensem, j, neighsurfarea, sym, q1, q2, trial.m_MdfChange, trial.m_MdfBins);
+    }
+    return;
+  }
+
+  // A switch gives each Feature the current orientation of the other one
+  float volume2 = m_Volumes[feature2] / m_UnbiasedVolume[ensem];
+  for(size_t i = 0; i < 3; i++)
+  {
+    trial.m_Euler1[i] = m_FeatureEulerAngles[3 * feature2 + i];
+    trial.m_Euler2[i] = m_FeatureEulerAngles[3 * feature1 + i];
+  }
+  FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * feature1]), 3), rod);
+  trial.m_OdfBin1 = m_OrientationOps[sym]->getOdfBin(rod);
+  FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * feature2]), 3), rod);
+  trial.m_OdfBin2 = m_OrientationOps[sym]->getOdfBin(rod);
+
+  int32_t g1odfbin = trial.m_OdfBin1;
+  int32_t g2odfbin = trial.m_OdfBin2;
+  trial.m_OdfChange = ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
+                      ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - volume1 + volume2)) * (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - volume1 + volume2)));
+  trial.m_OdfChange =
+      trial.m_OdfChange + (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
+                           ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - volume2 + volume1)) * (m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - volume2 + volume1))));
+
+  FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler1[0], trial.m_Euler1[1], trial.m_Euler1[2]), quat);
+  q1 = quat.toQuaternion();
+  size_t size = neighborlist[feature1].size();
+  for(size_t j = 0; j < size; j++)
+  {
+    int32_t neighbor = neighborlist[feature1][j];
+    if(neighbor != feature2)
+    {
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature1][j];
+      MC_LoopBody1(feature1, ensem, j, neighsurfarea, sym, q1, q2, trial.m_MdfChange, trial.m_MdfBins);
+    }
+  }
+
+  FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler2[0], trial.m_Euler2[1], trial.m_Euler2[2]), quat);
+  q1 = quat.toQuaternion();
+  size = neighborlist[feature2].size();
+  for(size_t j = 0; j < size; j++)
+  {
+    int32_t neighbor = neighborlist[feature2][j];
+    if(neighbor != feature1)
+    {
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature2][j];
+      MC_LoopBody1(feature2, ensem, j, neighsurfarea, sym, q1, q2, trial.m_MdfChange, trial.m_MdfBins);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MatchCrystallography::trialIsStale(const SwapSwitchTrial_t& trial) const
+{
+  if(!trial.m_Evaluated)
+  {
+    return true;
+  }
+  if(trial.m_Type == k_NoFeatureTrial)
+  {
+    return false;
+  }
+
+  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  int32_t features[2] = {trial.m_Feature1, trial.m_Feature2};
+  int32_t numFeatures = (trial.m_Type == k_SwitchTrial) ? 2 : 1;
+  for(int32_t i = 0; i < numFeatures; i++)
+  {
+    if(m_FeatureBatches[features[i]] == m_CurrentBatch)
+    {
+      return true;
+    }
+    for(const int32_t& neighbor : neighborlist[features[i]])
+    {
+      if(m_FeatureBatches[neighbor] == m_CurrentBatch)
+      {
+        return true;
+      }
+    }
+  }
+  if(m_SimOdfBatches[trial.m_OdfBin1] == m_CurrentBatch)
+  {
+    return true;
+  }
+  if(trial.m_Type == k_SwapTrial && m_SimOdfBatches[trial.m_ChosenBin] == m_CurrentBatch)
+  {
+    return true;
+  }
+  if(trial.m_Type == k_SwitchTrial && m_SimOdfBatches[trial.m_OdfBin2] == m_CurrentBatch)
+  {
+    return true;
+  }
+  for(const size_t& bin : trial.m_MdfBins)
+  {
+    if(m_SimMdfBatches[bin] == m_CurrentBatch)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::commitTrial(const SwapSwitchTrial_t& trial, size_t ensem)
+{
+  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
+  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
+  uint32_t sym = m_CrystalStructures[ensem];
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+
+  QuatF q1;
+  QuatF q2;
+  FOrientArrayType quat(4, 0.0);
+  int32_t feature1 = trial.m_Feature1;
+  int32_t feature2 = trial.m_Feature2;
+  float volume1 = m_Volumes[feature1] / m_UnbiasedVolume[ensem];
+
+  if(trial.m_Type == k_SwapTrial)
+  {
+    int32_t choose = trial.m_ChosenBin;
+    int32_t g1odfbin = trial.m_OdfBin1;
+    m_FeatureEulerAngles[3 * feature1] = trial.m_Euler1[0];
+    m_FeatureEulerAngles[3 * feature1 + 1] = trial.m_Euler1[1];
+    m_FeatureEulerAngles[3 * feature1 + 2] = trial.m_Euler1[2];
+    m_FeatureBatches[feature1] = m_CurrentBatch;
+    setSimOdfValue(choose, (m_SimOdf->getValue(choose) + volume1));
+    setSimOdfValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - volume1));
+
+    FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler1[0], trial.m_Euler1[1], trial.m_Euler1[2]), quat);
+    q1 = quat.toQuaternion();
+    QuaternionMathF::Copy(q1, avgQuats[feature1]);
+    size_t size = neighborlist[feature1].size();
+    for(size_t j = 0; j < size; j++)
+    {
+      int32_t neighbor = neighborlist[feature1][j];
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature1][j];
+      MC_LoopBody2(feature1, ensem, j, neighsurfarea, sym, q1, q2);
+    }
+    return;
+  }
+
+  float volume2 = m_Volumes[feature2] / m_UnbiasedVolume[ensem];
+  int32_t g1odfbin = trial.m_OdfBin1;
+  int32_t g2odfbin = trial.m_OdfBin2;
+  for(size_t i = 0; i < 3; i++)
+  {
+    m_FeatureEulerAngles[3 * feature1 + i] = trial.m_Euler1[i];
+    m_FeatureEulerAngles[3 * feature2 + i] = trial.m_Euler2[i];
+  }
+  m_FeatureBatches[feature1] = m_CurrentBatch;
+  m_FeatureBatches[feature2] = m_CurrentBatch;
+  setSimOdfValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + volume2 - volume1));
+  setSimOdfValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + volume1 - volume2));
+
+  FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler1[0], trial.m_Euler1[1], trial.m_Euler1[2]), quat);
+  q1 = quat.toQuaternion();
+  QuaternionMathF::Copy(q1, avgQuats[feature1]);
+  size_t size = neighborlist[feature1].size();
+  for(size_t j = 0; j < size; j++)
+  {
+    int32_t neighbor = neighborlist[feature1][j];
+    if(neighbor != feature2)
+    {
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature1][j];
+      MC_LoopBody2(feature1, ensem, j, neighsurfarea, sym, q1, q2);
+    }
+  }
+
+  FOrientTransformsType::eu2qu(FOrientArrayType(trial.m_Euler2[0], trial.m_Euler2[1], trial.m_Euler2[2]), quat);
+  q1 = quat.toQuaternion();
+  QuaternionMathF::Copy(q1, avgQuats[feature2]);
+  size = neighborlist[feature2].size();
+  for(size_t j = 0; j < size; j++)
+  {
+    int32_t neighbor = neighborlist[feature2][j];
+    if(neighbor != feature1)
+    {
+      FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
+      q2 = quat.toQuaternion();
+      float neighsurfarea = neighborsurfacearealist[feature2][j];
+      MC_LoopBody2(feature2, ensem, j, neighsurfarea, sym, q1, q2);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MatchCrystallography::matchCrystallography(size_t ensem)
+{
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
   uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
   int32_t numbins = 0;
   int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
+  double random = 0.0;
   size_t counter = 0;
 
-  QuatF q1;
-  QuatF q2;
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
   float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
   int32_t selectedfeature1 = 0, selectedfeature2 = 0;
   iterations = 0;
   badtrycount = 0;
@@ -777,12 +1145,26 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
     numbins = 36 * 36 * 12;
   }
 
+  // The errors are only touched in the bins an accepted move changes, so they are kept
+  // as running sums and recomputed from scratch now and then to drop accumulated round off
+  const int32_t k_ErrorRefreshInterval = 10000;
+  computeHistogramErrors(static_cast<size_t>(numbins));
+
+  // The trial moves of a batch are drawn in order from the random stream and evaluated in parallel against the
+  // histograms as they were at the start of the batch. They are then committed in order, and a trial that reads a
+  // Feature or a bin that an earlier move of the batch changed is evaluated again, so every move is accepted or
+  // rejected exactly as if the trials had been run one after the other.
+  std::vector<SwapSwitchTrial_t> trials(k_TrialBatchSize);
+  m_CurrentBatch = 0;
+  m_FeatureBatches.assign(totalFeatures, -1);
+  m_SimOdfBatches.assign(m_SimOdf->getNumberOfTuples(), -1);
+  m_SimMdfBatches.assign(m_SimMdf->getNumberOfTuples(), -1);
+
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
   int32_t lastIteration = 0;
   while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
-    m_Seed++;
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
     if(currentMillis - millis > 1000)
     {
@@ -796,31 +1178,15 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       millis = QDateTime::currentMSecsSinceEpoch();
       lastIteration = iterations;
     }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
-    {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
-    }
-    for(int32_t i = 0; i < (numbins); i++)
-    {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
-    }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>(rg.genrand_res53());
 
-    if(getCancel())
+    int32_t numTrials = std::min(k_TrialBatchSize, m_MaxIterations - iterations);
+    for(int32_t t = 0; t < numTrials; t++)
     {
-      return;
-    }
+      SwapSwitchTrial_t& trial = trials[t];
+      trial.m_Evaluated = false;
+      m_Seed++;
+      random = rg.genrand_res53();
 
-    if(random < 0.5) // SwapOutOrientation
-    {
       counter = 0;
       selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
       if(selectedfeature1 >= totalFeatures)
@@ -842,107 +1208,25 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       }
       if(counter == totalFeatures)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        trial.m_Type = k_NoFeatureTrial;
+        continue;
       }
-      else
-      {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        FOrientArrayType rod(4, 0.0);
-        FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
+      trial.m_Feature1 = selectedfeature1;
 
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-        random = static_cast<float>(rg.genrand_res53());
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
+      if(random < 0.5) // SwapOutOrientation
+      {
+        trial.m_Type = k_SwapTrial;
+        trial.m_Feature2 = selectedfeature1;
+        random = rg.genrand_res53();
+        trial.m_ChosenBin = pick_euler(random, numbins);
 
-        FOrientArrayType g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
+        FOrientArrayType g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, trial.m_ChosenBin);
         g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(g1ea);
-        FOrientArrayType quat(4, 0.0);
-        FOrientTransformsType::eu2qu(g1ea, quat);
-        q1 = quat.toQuaternion();
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(!neighborlist[selectedfeature1].empty())
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-          q1 = quat.toQuaternion();
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
-
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            FOrientArrayType quat(4);
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
+        trial.m_Euler1[0] = g1ea[0];
+        trial.m_Euler1[1] = g1ea[1];
+        trial.m_Euler1[2] = g1ea[2];
       }
-      if(getCancel())
-      {
-        return;
-      }
-    }
-    else // SwitchOrientation
-    {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      if(counter == totalFeatures)
-      {
-        badtrycount = 10 * m_NumFeatures[ensem];
-      }
-      else
+      else // SwitchOrientation
       {
         counter = 0;
         selectedfeature2 = int32_t(rg.genrand_res53() * totalFeatures);
@@ -965,141 +1249,55 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
         }
         if(counter == totalFeatures)
         {
-          badtrycount = 10 * m_NumFeatures[ensem];
+          trial.m_Type = k_NoFeatureTrial;
+          continue;
         }
-        else
-        {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature2]), 3), rod);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          FOrientArrayType quat(4);
-          FOrientTransformsType::eu2qu(FOrientArrayType(g2ea1, g2ea2, g2ea3), quat);
-          q1 = quat.toQuaternion();
+        trial.m_Type = k_SwitchTrial;
+        trial.m_Feature2 = selectedfeature2;
+      }
+    }
 
-          size_t size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
+    EvaluateSwapSwitchTrialsImpl impl(this, trials.data(), ensem);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(numTrials)), impl, tbb::auto_partitioner());
+    }
+#endif
 
-          FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-          q1 = quat.toQuaternion();
-          size = 0;
-          if(!neighborlist[selectedfeature2].empty())
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
+    m_CurrentBatch++;
+    for(int32_t t = 0; t < numTrials && badtrycount < (m_MaxIterations / 10); t++)
+    {
+      if(getCancel())
+      {
+        return;
+      }
+      if(iterations > 0 && iterations % k_ErrorRefreshInterval == 0)
+      {
+        computeHistogramErrors(static_cast<size_t>(numbins));
+      }
+      float currentodferror = static_cast<float>(m_CurrentOdfError);
+      float currentmdferror = static_cast<float>(m_CurrentMdfError);
+      iterations++;
+      badtrycount++;
 
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
+      SwapSwitchTrial_t& trial = trials[t];
+      if(trial.m_Type == k_NoFeatureTrial)
+      {
+        badtrycount = 10 * m_NumFeatures[ensem];
+        continue;
+      }
+      // Without the parallel pass every trial is evaluated here, against the current histograms
+      if(trialIsStale(trial))
+      {
+        impl.convert(static_cast<size_t>(t), static_cast<size_t>(t) + 1);
+      }
 
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-            size = 0;
-            if(!neighborlist[selectedfeature1].empty())
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-            size = 0;
-            if(!neighborlist[selectedfeature2].empty())
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-          }
-        }
+      deltaerror = (trial.m_OdfChange / currentodferror) + (trial.m_MdfChange / currentmdferror);
+      if(deltaerror > 0)
+      {
+        badtrycount = 0;
+        commitTrial(trial, ensem);
       }
     }
     if(getCancel())
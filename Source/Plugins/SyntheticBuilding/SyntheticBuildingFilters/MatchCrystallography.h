@@ -35,7 +35,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Texture/AliasTable.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
@@ -47,6 +50,26 @@
 
 #include "SyntheticBuilding/SyntheticBuildingDLLExport.h"
 
+/**
+ * @brief The SwapSwitchTrial_t struct holds one trial move of the swap/switch loop. The move is drawn up front, and the
+ * change it makes to the ODF and MDF errors is found before the move is committed.
+ */
+typedef struct
+{
+  int32_t m_Type;
+  int32_t m_Feature1;
+  int32_t m_Feature2;
+  int32_t m_ChosenBin;
+  float m_Euler1[3];
+  float m_Euler2[3];
+  int32_t m_OdfBin1;
+  int32_t m_OdfBin2;
+  float m_OdfChange;
+  float m_MdfChange;
+  bool m_Evaluated;
+  std::vector<size_t> m_MdfBins;
+} SwapSwitchTrial_t;
+
 /**
  * @brief The MatchCrystallography class. See [Filter documentation](@ref matchcrystallography) for details.
  */
@@ -246,11 +269,11 @@ protected:
 
   /**
    * @brief pick_euler Picks a random bin from the incoming orientation statistics
-   * @param random Key random value to compare for sampling
+   * @param random Uniform random value in [0, 1) used for sampling
    * @param numbins Number of possible bins to sample
    * @return Integer value for bin index
    */
-  int32_t pick_euler(float random, int32_t numbins);
+  int32_t pick_euler(double random, int32_t numbins);
 
   /**
    * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
@@ -261,8 +284,10 @@ protected:
    * @param sym Crystal structure index
    * @param q1 Quaterions for the Feature
    * @param q2 Quaterions for the Feature neighbor
+   * @param mdfChange Change of the MDF error the swap makes (in/out)
+   * @param mdfBins MDF bins the change was found from (out)
    */
-  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
+  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2, float& mdfChange, std::vector<size_t>& mdfBins) const;
 
   /**
    * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
@@ -276,6 +301,50 @@ protected:
    */
   void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
 
+  /**
+   * @brief computeHistogramErrors Sums the squared differences between the actual and
+   * simulated ODF and MDF into the running errors used by the swapping loop
+   * @param numbins Number of bins that take part in the errors
+   */
+  void computeHistogramErrors(size_t numbins);
+
+  /**
+   * @brief setSimOdfValue Sets a simulated ODF bin and updates the running ODF error
+   * @param bin ODF bin index
+   * @param value New value for the bin
+   */
+  void setSimOdfValue(size_t bin, float value);
+
+  /**
+   * @brief setSimMdfValue Sets a simulated MDF bin and updates the running MDF error
+   * @param bin MDF bin index
+   * @param value New value for the bin
+   */
+  void setSimMdfValue(size_t bin, float value);
+
+  /**
+   * @brief evaluateTrial Finds the change of the ODF and MDF errors a trial move would make. Nothing but the trial
+   * is written, so several trials may be evaluated at the same time.
+   * @param trial The trial move
+   * @param ensem Ensemble index of the current phase
+   */
+  void evaluateTrial(SwapSwitchTrial_t& trial, size_t ensem) const;
+
+  /**
+   * @brief trialIsStale Checks whether a trial move was not evaluated yet or reads a Feature or a bin that a move
+   * committed in the current batch has changed
+   * @param trial The trial move
+   * @return True if the trial needs to be evaluated again
+   */
+  bool trialIsStale(const SwapSwitchTrial_t& trial) const;
+
+  /**
+   * @brief commitTrial Applies an accepted trial move to the orientations and the simulated ODF and MDF
+   * @param trial The trial move
+   * @param ensem Ensemble index of the current phase
+   */
+  void commitTrial(const SwapSwitchTrial_t& trial, size_t ensem);
+
   /**
    * @brief matchCrystallography Swaps orientations for Features unitl convergence to
    * the input statistics
@@ -290,6 +359,8 @@ protected:
   void measure_misorientations(size_t ensem);
 
 private:
+  friend class EvaluateSwapSwitchTrialsImpl;
+
   // Cell Data
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
@@ -311,19 +382,28 @@ private:
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   // All other private instance variables
-  float m_MdfChange;
-  float m_OdfChange;
+  double m_CurrentOdfError;
+  double m_CurrentMdfError;
+  size_t m_OdfErrorBins;
+  size_t m_MdfErrorBins;
 
   std::vector<float> m_UnbiasedVolume;
   std::vector<float> m_TotalSurfaceArea;
 
   FloatArrayType::Pointer m_ActualOdf;
+  AliasTable m_ActualOdfTable;
   FloatArrayType::Pointer m_SimOdf;
   FloatArrayType::Pointer m_ActualMdf;
   FloatArrayType::Pointer m_SimMdf;
 
   std::vector<std::vector<float>> m_MisorientationLists;
 
+  // Batch in which each Feature, ODF bin and MDF bin was last changed by a committed move
+  int32_t m_CurrentBatch;
+  std::vector<int32_t> m_FeatureBatches;
+  std::vector<int32_t> m_SimOdfBatches;
+  std::vector<int32_t> m_SimMdfBatches;
+
   QVector<LaueOps::Pointer> m_OrientationOps;
 
 public:
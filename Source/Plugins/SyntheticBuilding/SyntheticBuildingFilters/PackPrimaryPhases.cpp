@@ -35,6 +35,7 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
 #include <fstream>
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -292,11 +293,14 @@ void PackPrimaryPhases::initialize()
   m_EllipsoidOps = ShapeOps::NullPointer();
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   m_OrthoOps = OrthoRhombicOps::New();
+  m_AxisOdfTables.clear();
 
   m_ColumnList.clear();
   m_RowList.clear();
   m_PlaneList.clear();
   m_EllipFuncList.clear();
+  m_Footprints.clear();
+  m_ExclusionFootprints.clear();
 
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
@@ -327,6 +331,7 @@ void PackPrimaryPhases::initialize()
   m_PrimaryPhaseFractions.clear();
 
   m_AvailablePointsCount = 1;
+  m_FillingErrorSum = 0;
   m_FillingError = m_OldFillingError = 0.0f;
   m_CurrentNeighborhoodError = m_OldNeighborhoodError = 0.0f;
   m_CurrentSizeDistError = m_OldSizeDistError = 0.0f;
@@ -1168,9 +1173,11 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrimaryFeatures::exclusions_owners");
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // This is the set that we are going to keep updated with the points that are not in an exclusion zone.
+  // availablePointsInv is a packed list of the free points whose first m_AvailablePointsCount entries are
+  // live; availablePoints holds the slot of each packing point in that list, or -1 if it is not free.
+  std::vector<int64_t> availablePoints(m_TotalPackingPoints, -1);
+  std::vector<int64_t> availablePointsInv(m_TotalPackingPoints, -1);
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1183,7 +1190,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   {
     if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
     {
-      availablePoints[i] = m_AvailablePointsCount;
+      availablePoints[i] = static_cast<int64_t>(m_AvailablePointsCount);
       availablePointsInv[m_AvailablePointsCount] = i;
       m_AvailablePointsCount++;
     }
@@ -1197,10 +1204,28 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   m_SimFeatureSizeDist.resize(m_PrimaryPhases.size());
   m_FeatureSizeDistStep.resize(m_PrimaryPhases.size());
   size_t numPrimaryPhases = m_PrimaryPhases.size();
+  m_AxisOdfTables.resize(totalEnsembles);
   for(size_t i = 0; i < numPrimaryPhases; i++)
   {
     phase = m_PrimaryPhases[i];
     PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[phase]);
+    // The axis ODF of a phase does not change while Features are generated, so its sampling table is built once
+    FloatArrayType::Pointer axisodf = pp->getAxisOrientation();
+    if(!m_AxisOdfTables[phase].build(axisodf->getPointer(0), axisodf->getNumberOfTuples()))
+    {
+      QString ss = QObject::tr("The axis ODF of phase %1 has negative, non-finite or only zero weights").arg(phase);
+      setErrorCondition(-78015);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    if(!m_AxisOdfTables[phase].isNormalized())
+    {
+      QString ss = QObject::tr("The axis ODF weights of phase %1 sum to %2 instead of 1. Axis orientations are drawn as if the missing weight belonged to the first bin and weight past 1 is never drawn")
+                       .arg(phase)
+                       .arg(m_AxisOdfTables[phase].getWeightSum());
+      setWarningCondition(-78016);
+      notifyWarningMessage(getHumanLabel(), ss, getWarningCondition());
+    }
     m_FeatureSizeDist[i].resize(40);
     m_SimFeatureSizeDist[i].resize(40);
     m_FeatureSizeDistStep[i] = static_cast<float>(((2 * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / m_FeatureSizeDist[i].size());
@@ -1400,10 +1425,13 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   }
 
   m_ColumnList.resize(totalFeatures);
+  m_Footprints.resize(totalFeatures);
+  m_ExclusionFootprints.resize(totalFeatures);
   m_RowList.resize(totalFeatures);
   m_PlaneList.resize(totalFeatures);
   m_EllipFuncList.resize(totalFeatures);
   m_PackQualities.resize(totalFeatures);
+  m_FillingErrorSum = m_TotalPackingPoints;
   m_FillingError = 1.0f;
 
   int64_t count = 0;
@@ -1443,6 +1471,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     {
       return;
     }
+    buildFootprints(i);
     count = 0;
     // now we randomly pick a place to try to place the feature
     xc = static_cast<float>(rg.genrand_res53() * m_SizeX);
@@ -1500,11 +1529,12 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
 
   // determine initial set of available points
   m_AvailablePointsCount = 0;
+  std::fill(availablePoints.begin(), availablePoints.end(), -1);
   for(int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
     {
-      availablePoints[i] = m_AvailablePointsCount;
+      availablePoints[i] = static_cast<int64_t>(m_AvailablePointsCount);
       availablePointsInv[m_AvailablePointsCount] = i;
       m_AvailablePointsCount++;
     }
@@ -1545,7 +1575,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
 
     if(writeErrorFile && iteration % 25 == 0)
     {
-      outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
+      outFile << iteration << " " << m_FillingError << "  " << m_FillingErrorSum << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
     }
 
     // JUMP - this option moves one feature to a random spot in the volume
@@ -1579,7 +1609,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       }
       m_Seed++;
 
-      if(!availablePoints.empty())
+      if(m_AvailablePointsCount > 0)
       {
         key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
         featureOwnersIdx = availablePointsInv[key];
@@ -1600,9 +1630,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       oldyc = m_Centroids[3 * randomfeature + 1];
       oldzc = m_Centroids[3 * randomfeature + 2];
       m_OldFillingError = m_FillingError;
-      m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      moveFeature(randomfeature, xc, yc, zc);
-      m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+      m_FillingError = moveFeatureFillingError(randomfeature, xc, yc, zc, featureOwnersPtr, exclusionOwnersPtr);
       m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
       if(m_FillingError <= m_OldFillingError)
       {
@@ -1612,9 +1640,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       }
       else if(m_FillingError > m_OldFillingError)
       {
-        m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        moveFeature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        m_FillingError = moveFeatureFillingError(randomfeature, oldxc, oldyc, oldzc, featureOwnersPtr, exclusionOwnersPtr);
         m_PointsToRemove.clear();
         m_PointsToAdd.clear();
       }
@@ -1681,9 +1707,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
         zc = oldzc;
       }
       m_OldFillingError = m_FillingError;
-      m_FillingError = checkFillingError(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      moveFeature(randomfeature, xc, yc, zc);
-      m_FillingError = checkFillingError(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+      m_FillingError = moveFeatureFillingError(randomfeature, xc, yc, zc, featureOwnersPtr, exclusionOwnersPtr);
       m_CurrentNeighborhoodError = checkNeighborhoodError(-1000, randomfeature);
       //      change2 = (currentneighborhooderror * currentneighborhooderror) - (oldneighborhooderror * oldneighborhooderror);
       //      if(fillingerror <= oldfillingerror && currentneighborhooderror >= oldneighborhooderror)
@@ -1696,9 +1720,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
       else if(m_FillingError > m_OldFillingError)
       {
-        m_FillingError = checkFillingError(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        moveFeature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = checkFillingError(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        m_FillingError = moveFeatureFillingError(randomfeature, oldxc, oldyc, oldzc, featureOwnersPtr, exclusionOwnersPtr);
         m_PointsToRemove.clear();
         m_PointsToAdd.clear();
       }
@@ -1843,22 +1865,8 @@ void PackPrimaryPhases::generateFeature(int32_t phase, Feature_t* feature, uint3
     r2 = static_cast<float>(rg.genrand_beta(a2, b2));
     r3 = static_cast<float>(rg.genrand_beta(a3, b3));
   }
-  FloatArrayType::Pointer axisodf = pp->getAxisOrientation();
-  int32_t numbins = axisodf->getNumberOfTuples();
-  float random = static_cast<float>(rg.genrand_res53());
-  float totaldensity = 0.0f;
-  int32_t bin = 0;
-  for(int32_t j = 0; j < numbins; j++)
-  {
-    float density = axisodf->getValue(j);
-    float td1 = totaldensity;
-    totaldensity = totaldensity + density;
-    if(random < totaldensity && random >= td1)
-    {
-      bin = j;
-      break;
-    }
-  }
+  // The sampling table of the axis ODF is built for each primary phase before any Feature is generated
+  int32_t bin = static_cast<int32_t>(m_AxisOdfTables[phase].sample(rg.genrand_res53()));
   FOrientArrayType eulers = m_OrthoOps->determineEulerAngles(m_Seed, bin);
   VectorOfFloatArray omega3 = pp->getFeatureSize_Omegas();
   float mf = omega3[0]->getValue(diameter);
@@ -2282,7 +2290,9 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
   int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
 
-  m_FillingError = m_FillingError * float(m_TotalPackingPoints);
+  // The error is tracked as an exact count of over/under-filled packing points so that the
+  // per-voxel updates below are integer adds and no rounding accumulates across moves
+  int64_t fillingErrorDelta = 0;
   int64_t col = 0, row = 0, plane = 0;
   int32_t k1 = 0, k2 = 0, k3 = 0;
   if(gadd > 0)
@@ -2342,7 +2352,7 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
           }
           exclusionOwners[featureOwnersIdx]++;
         }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+        fillingErrorDelta += k1 * currentFeatureOwner + k2;
         //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
         featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
         packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
@@ -2364,7 +2374,7 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
             }
             exclusionOwners[featureOwnersIdx]++;
           }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+          fillingErrorDelta += k1 * currentFeatureOwner + k2;
           //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
           featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
           packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
@@ -2429,7 +2439,7 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
             m_PointsToAdd.push_back(featureOwnersIdx);
           }
         }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+        fillingErrorDelta += k1 * currentFeatureOwner + k2;
         //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
         featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
       }
@@ -2447,47 +2457,324 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
               m_PointsToAdd.push_back(featureOwnersIdx);
             }
           }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+          fillingErrorDelta += k1 * currentFeatureOwner + k2;
           //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
           featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
         }
       }
     }
   }
-  m_FillingError = m_FillingError / float(m_TotalPackingPoints);
+  m_FillingErrorSum += fillingErrorDelta;
+  m_FillingError = static_cast<float>(static_cast<double>(m_FillingErrorSum) / static_cast<double>(m_TotalPackingPoints));
   return m_FillingError;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void PackPrimaryPhases::buildFootprints(size_t gnum)
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  std::vector<int64_t>& cl = m_ColumnList[gnum];
+  std::vector<int64_t>& rl = m_RowList[gnum];
+  std::vector<int64_t>& pl = m_PlaneList[gnum];
+  std::vector<float>& efl = m_EllipFuncList[gnum];
+  size_t size = cl.size();
+
+  auto build = [&](bool exclusionOnly, PackingFootprint_t& footprint) {
+    footprint.m_ColumnMin = 0;
+    footprint.m_RowMin = 0;
+    footprint.m_NumColumns = 0;
+    footprint.m_NumRows = 0;
+    footprint.m_LineStarts.assign(1, 0);
+    footprint.m_Runs.clear();
+
+    int64_t columnMax = 0, rowMax = 0;
+    size_t numVoxels = 0;
+    for(size_t i = 0; i < size; i++)
+    {
+      if(exclusionOnly && efl[i] <= 0.1f)
+      {
+        continue;
+      }
+      int64_t column = cl[i] - cl[0];
+      int64_t row = rl[i] - rl[0];
+      if(numVoxels == 0)
+      {
+        footprint.m_ColumnMin = columnMax = column;
+        footprint.m_RowMin = rowMax = row;
+      }
+      footprint.m_ColumnMin = std::min(footprint.m_ColumnMin, column);
+      footprint.m_RowMin = std::min(footprint.m_RowMin, row);
+      columnMax = std::max(columnMax, column);
+      rowMax = std::max(rowMax, row);
+      numVoxels++;
+    }
+    if(numVoxels == 0)
+    {
+      return;
+    }
+    footprint.m_NumColumns = columnMax - footprint.m_ColumnMin + 1;
+    footprint.m_NumRows = rowMax - footprint.m_RowMin + 1;
+    size_t numLines = static_cast<size_t>(footprint.m_NumColumns * footprint.m_NumRows);
+
+    // Bucket the planes of the voxels by their column/row line
+    std::vector<size_t> lineOffsets(numLines + 1, 0);
+    for(size_t i = 0; i < size; i++)
+    {
+      if(exclusionOnly && efl[i] <= 0.1f)
+      {
+        continue;
+      }
+      size_t line = static_cast<size_t>((cl[i] - cl[0] - footprint.m_ColumnMin) * footprint.m_NumRows + (rl[i] - rl[0] - footprint.m_RowMin));
+      lineOffsets[line + 1]++;
+    }
+    for(size_t line = 0; line < numLines; line++)
+    {
+      lineOffsets[line + 1] += lineOffsets[line];
+    }
+    std::vector<int64_t> planes(numVoxels, 0);
+    std::vector<size_t> next(lineOffsets.begin(), lineOffsets.end() - 1);
+    for(size_t i = 0; i < size; i++)
+    {
+      if(exclusionOnly && efl[i] <= 0.1f)
+      {
+        continue;
+      }
+      size_t line = static_cast<size_t>((cl[i] - cl[0] - footprint.m_ColumnMin) * footprint.m_NumRows + (rl[i] - rl[0] - footprint.m_RowMin));
+      planes[next[line]++] = pl[i] - pl[0];
+    }
+
+    // Merge the planes of each line into runs of consecutive planes
+    footprint.m_LineStarts.resize(numLines + 1);
+    for(size_t line = 0; line < numLines; line++)
+    {
+      footprint.m_LineStarts[line] = footprint.m_Runs.size();
+      std::vector<int64_t>::iterator first = planes.begin() + static_cast<std::ptrdiff_t>(lineOffsets[line]);
+      std::vector<int64_t>::iterator last = planes.begin() + static_cast<std::ptrdiff_t>(lineOffsets[line + 1]);
+      std::sort(first, last);
+      for(std::vector<int64_t>::iterator iter = first; iter != last; ++iter)
+      {
+        if(footprint.m_Runs.size() > footprint.m_LineStarts[line] && *iter <= footprint.m_Runs.back() + 1)
+        {
+          footprint.m_Runs.back() = std::max(footprint.m_Runs.back(), *iter);
+        }
+        else
+        {
+          footprint.m_Runs.push_back(*iter);
+          footprint.m_Runs.push_back(*iter);
+        }
+      }
+    }
+    footprint.m_LineStarts[numLines] = footprint.m_Runs.size();
+  };
+
+  build(false, m_Footprints[gnum]);
+  build(true, m_ExclusionFootprints[gnum]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PackPrimaryPhases::moveFeatureFillingError(size_t gnum, float xc, float yc, float zc, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr)
+{
+  std::vector<int64_t>& cl = m_ColumnList[gnum];
+  std::vector<int64_t>& rl = m_RowList[gnum];
+  std::vector<int64_t>& pl = m_PlaneList[gnum];
+  if(cl.empty())
+  {
+    moveFeature(gnum, xc, yc, zc);
+    return m_FillingError;
+  }
+  int64_t oldBase[3] = {cl[0], rl[0], pl[0]};
+  moveFeature(gnum, xc, yc, zc);
+  int64_t newBase[3] = {cl[0], rl[0], pl[0]};
+  if(oldBase[0] == newBase[0] && oldBase[1] == newBase[1] && oldBase[2] == newBase[2])
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    return m_FillingError;
+  }
+
+  int32_t* featureOwners = featureOwnersPtr->getPointer(0);
+  int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
+  int64_t fillingErrorDelta = 0;
+
+  // Adds or removes one packing point of the Feature the same way checkFillingError does
+  auto updatePoint = [&](int64_t col, int64_t row, int64_t plane, bool add, bool exclusion) {
+    if(m_PeriodicBoundaries)
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      col = col % m_PackingPoints[0];
+      row = row % m_PackingPoints[1];
+      plane = plane % m_PackingPoints[2];
+      if(col < 0)
+      {
+        col = col + m_PackingPoints[0];
+      }
+      if(row < 0)
+      {
+        row = row + m_PackingPoints[1];
+      }
+      if(plane < 0)
+      {
+        plane = plane + m_PackingPoints[2];
+      }
     }
-    m_AvailablePointsCount--;
+    else if(col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1] || plane < 0 || plane >= m_PackingPoints[2])
+    {
+      return;
+    }
+    size_t featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
+    if(exclusion)
+    {
+      if(add)
+      {
+        if(exclusionOwners[featureOwnersIdx] == 0)
+        {
+          m_PointsToRemove.push_back(featureOwnersIdx);
+        }
+        exclusionOwners[featureOwnersIdx]++;
+      }
+      else
+      {
+        exclusionOwners[featureOwnersIdx]--;
+        if(exclusionOwners[featureOwnersIdx] == 0)
+        {
+          m_PointsToAdd.push_back(featureOwnersIdx);
+        }
+      }
+      return;
+    }
+    int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+    if(add)
+    {
+      fillingErrorDelta += 2 * currentFeatureOwner - 1;
+      featureOwners[featureOwnersIdx] = currentFeatureOwner + 1;
+    }
+    else
+    {
+      fillingErrorDelta += 3 - 2 * currentFeatureOwner;
+      featureOwners[featureOwnersIdx] = currentFeatureOwner - 1;
+    }
+  };
+
+  // Visits the packing points of the footprint placed at base that the same footprint placed at
+  // otherBase does not cover. Both placements share the line layout, so each line is compared with
+  // the shifted line of the other placement by merging their sorted runs.
+  auto updateUncovered = [&](const PackingFootprint_t& footprint, const int64_t* base, const int64_t* otherBase, bool add, bool exclusion) {
+    int64_t shift[3] = {otherBase[0] - base[0], otherBase[1] - base[1], otherBase[2] - base[2]};
+    const int64_t* runs = footprint.m_Runs.data();
+    for(int64_t c = 0; c < footprint.m_NumColumns; c++)
+    {
+      for(int64_t r = 0; r < footprint.m_NumRows; r++)
+      {
+        size_t line = static_cast<size_t>(c * footprint.m_NumRows + r);
+        size_t runStart = footprint.m_LineStarts[line];
+        size_t runEnd = footprint.m_LineStarts[line + 1];
+        if(runStart == runEnd)
+        {
+          continue;
+        }
+        size_t otherRun = 0, otherRunEnd = 0;
+        int64_t oc = c - shift[0];
+        int64_t orow = r - shift[1];
+        if(oc >= 0 && oc < footprint.m_NumColumns && orow >= 0 && orow < footprint.m_NumRows)
+        {
+          size_t otherLine = static_cast<size_t>(oc * footprint.m_NumRows + orow);
+          otherRun = footprint.m_LineStarts[otherLine];
+          otherRunEnd = footprint.m_LineStarts[otherLine + 1];
+        }
+        int64_t col = base[0] + footprint.m_ColumnMin + c;
+        int64_t row = base[1] + footprint.m_RowMin + r;
+        for(size_t k = runStart; k < runEnd; k += 2)
+        {
+          int64_t p = runs[k];
+          int64_t last = runs[k + 1];
+          while(p <= last)
+          {
+            while(otherRun < otherRunEnd && runs[otherRun + 1] + shift[2] < p)
+            {
+              otherRun += 2;
+            }
+            int64_t coveredFirst = last + 1;
+            int64_t coveredLast = last;
+            if(otherRun < otherRunEnd)
+            {
+              coveredFirst = std::min(runs[otherRun] + shift[2], last + 1);
+              coveredLast = runs[otherRun + 1] + shift[2];
+            }
+            for(; p < coveredFirst; p++)
+            {
+              updatePoint(col, row, base[2] + p, add, exclusion);
+            }
+            if(p <= last)
+            {
+              p = coveredLast + 1;
+            }
+          }
+        }
+      }
+    }
+  };
+
+  // Remove the points only the old spot covers, then add the points only the new spot covers, which
+  // leaves the packing grid exactly as a full remove and add would
+  updateUncovered(m_Footprints[gnum], oldBase, newBase, false, false);
+  updateUncovered(m_ExclusionFootprints[gnum], oldBase, newBase, false, true);
+  updateUncovered(m_Footprints[gnum], newBase, oldBase, true, false);
+  updateUncovered(m_ExclusionFootprints[gnum], newBase, oldBase, true, true);
+
+  m_FillingErrorSum += fillingErrorDelta;
+#ifndef NDEBUG
+  Q_ASSERT(m_FillingErrorSum == countFillingErrorSum(featureOwners));
+#endif
+  m_FillingError = static_cast<float>(static_cast<double>(m_FillingErrorSum) / static_cast<double>(m_TotalPackingPoints));
+  return m_FillingError;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t PackPrimaryPhases::countFillingErrorSum(const int32_t* featureOwners)
+{
+  int64_t fillingErrorSum = 0;
+  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
+  {
+    int64_t excess = featureOwners[i] - 1;
+    fillingErrorSum += excess * excess;
   }
-  for(size_t i = 0; i < addSize; i++)
+  return fillingErrorSum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateAvailablePoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv)
+{
+  // A move first removes the Feature from its old spot (filling m_PointsToAdd) and then inserts it at the
+  // new spot (filling m_PointsToRemove), so the adds are applied first to follow that same order
+  for(const size_t& featureOwnersIdx : m_PointsToAdd)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
+    if(availablePoints[featureOwnersIdx] >= 0 || (m_UseMask && !m_Mask[featureOwnersIdx]))
+    {
+      continue;
+    }
+    availablePoints[featureOwnersIdx] = static_cast<int64_t>(m_AvailablePointsCount);
+    availablePointsInv[m_AvailablePointsCount] = static_cast<int64_t>(featureOwnersIdx);
     m_AvailablePointsCount++;
   }
+  // Removal swaps the last live entry into the freed slot; points that are already out of the list
+  // (or were never in it because of the mask) are skipped so the packed list cannot be corrupted
+  for(const size_t& featureOwnersIdx : m_PointsToRemove)
+  {
+    int64_t key = availablePoints[featureOwnersIdx];
+    if(key < 0)
+    {
+      continue;
+    }
+    int64_t val = availablePointsInv[m_AvailablePointsCount - 1];
+    availablePointsInv[key] = val;
+    availablePoints[val] = key;
+    availablePoints[featureOwnersIdx] = -1;
+    m_AvailablePointsCount--;
+  }
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
 }
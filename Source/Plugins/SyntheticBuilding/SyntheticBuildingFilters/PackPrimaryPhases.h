@@ -35,7 +35,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "OrientationLib/LaueOps/OrthoRhombicOps.h"
+#include "OrientationLib/Texture/AliasTable.hpp"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
 #include "SIMPLib/DataArrays/StringDataArray.h"
@@ -54,6 +57,21 @@ typedef struct
   int32_t m_Neighborhoods;
 } Feature_t;
 
+/**
+ * @brief The PackingFootprint_t struct holds the packing points of a Feature as runs of consecutive planes along
+ * each column/row line. All coordinates are relative to the first entry of the voxel lists of the Feature, so the
+ * footprint stays valid when the Feature is moved.
+ */
+typedef struct
+{
+  int64_t m_ColumnMin;
+  int64_t m_RowMin;
+  int64_t m_NumColumns;
+  int64_t m_NumRows;
+  std::vector<size_t> m_LineStarts;
+  std::vector<int64_t> m_Runs;
+} PackingFootprint_t;
+
 #include "SyntheticBuilding/SyntheticBuildingDLLExport.h"
 
 /**
@@ -359,11 +377,38 @@ protected:
   float checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief buildFootprints Builds the packing point footprint and the exclusion footprint of a Feature from its voxel lists
+   * @param gnum Id of the Feature
+   */
+  void buildFootprints(size_t gnum);
+
+  /**
+   * @brief moveFeatureFillingError Moves a Feature that is in the packing grid to a new centroid. Only the packing points
+   * that the old and the new position do not share are updated, and the filling error is updated from those points.
+   * @param gnum Id of the Feature to move
+   * @param xc New x centroid
+   * @param yc New y centroid
+   * @param zc New z centroid
+   * @param featureOwnersPtr Array of Feature Ids for each packing point
+   * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+   * @return Float percentage value for the ratio of unassinged/"garbage" packing points
+   */
+  float moveFeatureFillingError(size_t gnum, float xc, float yc, float zc, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
+
+  /**
+   * @brief countFillingErrorSum Counts the filling error of the whole packing grid. This is only used to check the
+   * running filling error in debug builds.
+   * @param featureOwners Array of Feature Ids for each packing point
+   * @return Sum of the squared differences between the number of owners of each packing point and 1
+   */
+  int64_t countFillingErrorSum(const int32_t* featureOwners);
+
+  /**
+   * @brief update_availablepoints Updates the packed free list of packing points with an "available" state
+   * @param availablePoints Slot of each packing point in the free list, or -1 if the point is not available
+   * @param availablePointsInv Packed free list of packing points; the first m_AvailablePointsCount entries are live
    */
-  void updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  void updateAvailablePoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv);
 
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -472,11 +517,14 @@ private:
   ShapeOps::Pointer m_EllipsoidOps;
   ShapeOps::Pointer m_SuperEllipsoidOps;
   OrthoRhombicOps::Pointer m_OrthoOps;
+  std::vector<AliasTable> m_AxisOdfTables;
 
   std::vector<std::vector<int64_t>> m_ColumnList;
   std::vector<std::vector<int64_t>> m_RowList;
   std::vector<std::vector<int64_t>> m_PlaneList;
   std::vector<std::vector<float>> m_EllipFuncList;
+  std::vector<PackingFootprint_t> m_Footprints;
+  std::vector<PackingFootprint_t> m_ExclusionFootprints;
 
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
@@ -512,6 +560,7 @@ private:
   std::vector<float> m_PrimaryPhaseFractions;
 
   size_t m_AvailablePointsCount;
+  int64_t m_FillingErrorSum;
   float m_FillingError, m_OldFillingError;
   float m_CurrentNeighborhoodError, m_OldNeighborhoodError;
   float m_CurrentSizeDistError, m_OldSizeDistError;